@@ -31,6 +31,7 @@
   V(File_ReadByte, 1)                                                          \
   V(File_WriteByte, 2)                                                         \
   V(File_Read, 2)                                                              \
+  V(File_Map, 2)                                                               \
   V(File_ReadInto, 4)                                                          \
   V(File_WriteFrom, 4)                                                         \
   V(File_Position, 1)                                                          \
@@ -18,7 +18,9 @@ static const int kMSPerSecond = 1000;
 // Forward declaration.
 static void FileService(Dart_Port, Dart_Port, Dart_CObject*);
 
-NativeService File::file_service_("FileService", FileService, 16);
+NativeService File::file_service_("FileService",
+                                   FileService,
+                                   File::kDefaultServicePorts);
 
 
 // The file pointer has been passed into Dart as an intptr_t and it is safe
@@ -210,6 +212,36 @@ void FUNCTION_NAME(File_Read)(Dart_NativeArguments args) {
 }
 
 
+void FUNCTION_NAME(File_Map)(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  File* file = GetFilePointer(Dart_GetNativeArgument(args, 0));
+  ASSERT(file != NULL);
+  Dart_Handle length_object = Dart_GetNativeArgument(args, 1);
+  int64_t length = 0;
+  if (DartUtils::GetInt64Value(length_object, &length)) {
+    MappedMemory* mapping = file->Map(length);
+    if (mapping != NULL) {
+      // The bytes are copied out of the mapping, so the result does not
+      // depend on the file once it has been returned.
+      uint8_t* buffer = NULL;
+      Dart_Handle external_array = IOBuffer::Allocate(mapping->size(), &buffer);
+      memmove(buffer, mapping->address(), mapping->size());
+      delete mapping;
+      Dart_SetReturnValue(args, external_array);
+    } else {
+      // The file cannot be mapped. The caller falls back to reading it.
+      Dart_SetReturnValue(args, Dart_Null());
+    }
+  } else {
+    OSError os_error(-1, "Invalid argument", OSError::kUnknown);
+    Dart_Handle err = DartUtils::NewDartOSError(&os_error);
+    if (Dart_IsError(err)) Dart_PropagateError(err);
+    Dart_SetReturnValue(args, err);
+  }
+  Dart_ExitScope();
+}
+
+
 void FUNCTION_NAME(File_ReadInto)(Dart_NativeArguments args) {
   Dart_EnterScope();
   File* file = GetFilePointer(Dart_GetNativeArgument(args, 0));
@@ -902,6 +934,24 @@ static CObject* FileWriteByteRequest(const CObjectArray& request) {
 }
 
 
+// Builds the response for a read request. The IO buffer is handed
+// over to the response without copying the data read.
+static CObject* FileReadResponse(Dart_CObject* io_buffer, int64_t bytes_read) {
+  if (bytes_read >= 0) {
+    CObjectExternalUint8Array* external_array =
+        new CObjectExternalUint8Array(io_buffer);
+    external_array->SetLength(bytes_read);
+    CObjectArray* result = new CObjectArray(CObject::NewArray(2));
+    result->SetAt(0, new CObjectIntptr(CObject::NewInt32(0)));
+    result->SetAt(1, external_array);
+    return result;
+  } else {
+    CObject::FreeIOBufferData(io_buffer);
+    return CObject::NewOSError();
+  }
+}
+
+
 static CObject* FileReadRequest(const CObjectArray& request) {
   if (request.Length() == 3 &&
       request[1]->IsIntptr() &&
@@ -913,18 +963,29 @@ static CObject* FileReadRequest(const CObjectArray& request) {
       Dart_CObject* io_buffer = CObject::NewIOBuffer(length);
       uint8_t* data = io_buffer->value.as_external_typed_data.data;
       int64_t bytes_read = file->Read(data, length);
-      if (bytes_read >= 0) {
-        CObjectExternalUint8Array* external_array =
-            new CObjectExternalUint8Array(io_buffer);
-        external_array->SetLength(bytes_read);
-        CObjectArray* result = new CObjectArray(CObject::NewArray(2));
-        result->SetAt(0, new CObjectIntptr(CObject::NewInt32(0)));
-        result->SetAt(1, external_array);
-        return result;
-      } else {
-        CObject::FreeIOBufferData(io_buffer);
-        return CObject::NewOSError();
-      }
+      return FileReadResponse(io_buffer, bytes_read);
+    } else {
+      return CObject::FileClosedError();
+    }
+  }
+  return CObject::IllegalArgumentError();
+}
+
+
+static CObject* FileReadAtRequest(const CObjectArray& request) {
+  if (request.Length() == 4 &&
+      request[1]->IsIntptr() &&
+      request[2]->IsInt32OrInt64() &&
+      request[3]->IsInt32OrInt64()) {
+    File* file = CObjectToFilePointer(request[1]);
+    ASSERT(file != NULL);
+    if (!file->IsClosed()) {
+      int64_t position = CObjectInt32OrInt64ToInt64(request[2]);
+      int64_t length = CObjectInt32OrInt64ToInt64(request[3]);
+      Dart_CObject* io_buffer = CObject::NewIOBuffer(length);
+      uint8_t* data = io_buffer->value.as_external_typed_data.data;
+      int64_t bytes_read = file->ReadAt(data, length, position);
+      return FileReadResponse(io_buffer, bytes_read);
     } else {
       return CObject::FileClosedError();
     }
@@ -1131,6 +1192,9 @@ static void FileService(Dart_Port dest_port_id,
         case File::kReadRequest:
           response = FileReadRequest(request);
           break;
+        case File::kReadAtRequest:
+          response = FileReadAtRequest(request);
+          break;
         case File::kReadIntoRequest:
           response = FileReadIntoRequest(request);
           break;
@@ -1158,6 +1222,11 @@ Dart_Port File::GetServicePort() {
 }
 
 
+void File::SetNumberOfServicePorts(int number_of_ports) {
+  file_service_.SetNumberOfPorts(number_of_ports);
+}
+
+
 void FUNCTION_NAME(File_NewServicePort)(Dart_NativeArguments args) {
   Dart_EnterScope();
   Dart_SetReturnValue(args, Dart_Null());
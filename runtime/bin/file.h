@@ -19,6 +19,24 @@
 // Forward declaration.
 class FileHandle;
 
+// A read only mapping of a file into memory. The mapping stays valid
+// after the file it was created from has been closed.
+class MappedMemory {
+ public:
+  MappedMemory(void* address, intptr_t size)
+      : address_(address), size_(size) { }
+  ~MappedMemory();
+
+  void* address() const { return address_; }
+  intptr_t size() const { return size_; }
+
+ private:
+  void* address_;
+  intptr_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(MappedMemory);
+};
+
 class File {
  public:
   enum FileOpenMode {
@@ -78,9 +96,14 @@ class File {
     kReadIntoRequest = 17,
     kWriteFromRequest = 18,
     kCreateLinkRequest = 19,
-    kDeleteLinkRequest = 20
+    kDeleteLinkRequest = 20,
+    kReadAtRequest = 21
   };
 
+  // Default number of native ports, and thereby requests handled
+  // concurrently, for the file service.
+  static const int kDefaultServicePorts = 16;
+
   ~File();
 
   // Read/Write attempt to transfer num_bytes to/from buffer. It returns
@@ -88,6 +111,12 @@ class File {
   int64_t Read(void* buffer, int64_t num_bytes);
   int64_t Write(const void* buffer, int64_t num_bytes);
 
+  // ReadAt attempts to read num_bytes into buffer starting at the
+  // given position in the file. It does not use the current file
+  // position, so several reads of the same file can be in flight at
+  // the same time. It returns the number of bytes read.
+  int64_t ReadAt(void* buffer, int64_t num_bytes, int64_t position);
+
   // ReadFully and WriteFully do attempt to transfer num_bytes to/from
   // the buffer. In the event of short accesses they will loop internally until
   // the whole buffer has been transferred or an error occurs. If an error
@@ -98,10 +127,19 @@ class File {
     return WriteFully(&byte, 1);
   }
 
+  // Get the OS file descriptor of the file.
+  intptr_t GetFD();
+
   // Get the length of the file. Returns a negative value if the length cannot
   // be determined (e.g. not seekable device).
   off_t Length();
 
+  // Map the first length bytes of the file into memory for reading.
+  // Changes to the file may become visible in the mapping. Returns NULL
+  // if the file cannot be mapped, e.g. because it is a pipe or a special
+  // device.
+  MappedMemory* Map(int64_t length);
+
   // Get the current position in the file.
   // Returns a negative value if position cannot be determined.
   off_t Position();
@@ -149,6 +187,7 @@ class File {
   static FileOpenMode DartModeToFileMode(DartFileOpenMode mode);
 
   static Dart_Port GetServicePort();
+  static void SetNumberOfServicePorts(int number_of_ports);
 
  private:
   explicit File(FileHandle* handle) : handle_(handle) { }
@@ -9,6 +9,7 @@
 
 #include <errno.h>  // NOLINT
 #include <fcntl.h>  // NOLINT
+#include <sys/mman.h>  // NOLINT
 #include <sys/stat.h>  // NOLINT
 #include <unistd.h>  // NOLINT
 #include <libgen.h>  // NOLINT
@@ -69,6 +70,13 @@ int64_t File::Write(const void* buffer, int64_t num_bytes) {
 }
 
 
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TEMP_FAILURE_RETRY(
+      pread(handle_->fd(), buffer, num_bytes, position));
+}
+
+
 off_t File::Position() {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(lseek(handle_->fd(), 0, SEEK_CUR));
@@ -93,6 +101,11 @@ bool File::Flush() {
 }
 
 
+intptr_t File::GetFD() {
+  return handle_->fd();
+}
+
+
 off_t File::Length() {
   ASSERT(handle_->fd() >= 0);
   struct stat st;
@@ -103,6 +116,35 @@ off_t File::Length() {
 }
 
 
+MappedMemory* File::Map(int64_t length) {
+  ASSERT(handle_->fd() >= 0);
+  struct stat st;
+  if (TEMP_FAILURE_RETRY(fstat(handle_->fd(), &st)) != 0 ||
+      !S_ISREG(st.st_mode) ||
+      length <= 0 ||
+      length > st.st_size ||
+      length > kIntptrMax) {
+    return NULL;
+  }
+  void* address = mmap(NULL,
+                       length,
+                       PROT_READ,
+                       MAP_PRIVATE,
+                       handle_->fd(),
+                       0);
+  if (address == MAP_FAILED) {
+    return NULL;
+  }
+  return new MappedMemory(address, length);
+}
+
+
+MappedMemory::~MappedMemory() {
+  int result = munmap(address_, size_);
+  ASSERT(result == 0);
+}
+
+
 File* File::Open(const char* name, FileOpenMode mode) {
   // Report errors for non-regular files.
   struct stat st;
@@ -26,6 +26,7 @@ patch class _RandomAccessFile {
   /* patch */ static int _close(int id) native "File_Close";
   /* patch */ static _readByte(int id) native "File_ReadByte";
   /* patch */ static _read(int id, int bytes) native "File_Read";
+  /* patch */ static _map(int id, int length) native "File_Map";
   /* patch */ static _readInto(int id, List<int> buffer, int start, int end)
       native "File_ReadInto";
   /* patch */ static _writeByte(int id, int value) native "File_WriteByte";
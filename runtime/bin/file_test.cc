@@ -56,3 +56,38 @@ UNIT_TEST_CASE(FilePosition) {
   EXPECT_EQ(18, file->Position());
   delete file;
 }
+
+
+UNIT_TEST_CASE(FileReadAt) {
+  char buf[42];
+  const char* kFilename =
+      GetFileName("runtime/tests/vm/data/fixed_length_file");
+  File* file = File::Open(kFilename, File::kRead);
+  EXPECT(file != NULL);
+  EXPECT(file->ReadFully(buf, 12));
+  EXPECT_EQ(12, file->Position());
+  char at[6];
+  EXPECT_EQ(6, file->ReadAt(at, 6, 6));
+  EXPECT_EQ(0, memcmp(at, buf + 6, 6));
+  EXPECT_EQ(2, file->ReadAt(at, 6, 40));  // Short read at end of file.
+  EXPECT_EQ(0, file->ReadAt(at, 6, 42));  // Read at end of file.
+  delete file;
+}
+
+
+UNIT_TEST_CASE(FileMap) {
+  char buf[42];
+  const char* kFilename =
+      GetFileName("runtime/tests/vm/data/fixed_length_file");
+  File* file = File::Open(kFilename, File::kRead);
+  EXPECT(file != NULL);
+  EXPECT(file->ReadFully(buf, 42));
+  EXPECT(file->Map(43) == NULL);  // Longer than the file.
+  MappedMemory* mapping = file->Map(42);
+  EXPECT(mapping != NULL);
+  delete file;
+  // The mapping stays valid after the file has been closed.
+  EXPECT_EQ(42, mapping->size());
+  EXPECT_EQ(0, memcmp(buf, mapping->address(), 42));
+  delete mapping;
+}
@@ -67,6 +67,29 @@ int64_t File::Write(const void* buffer, int64_t num_bytes) {
 }
 
 
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  // There is no pread on Windows. Use ReadFile with the position in
+  // the OVERLAPPED structure instead. For synchronous handles this
+  // still moves the file pointer, so ReadAt should not be mixed with
+  // Read on the same file.
+  HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(handle_->fd()));
+  OVERLAPPED overlapped;
+  memset(&overlapped, 0, sizeof(overlapped));
+  overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+  overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+  DWORD bytes_read = 0;
+  if (!ReadFile(handle,
+                buffer,
+                static_cast<DWORD>(num_bytes),
+                &bytes_read,
+                &overlapped)) {
+    return (GetLastError() == ERROR_HANDLE_EOF) ? 0 : -1;
+  }
+  return bytes_read;
+}
+
+
 off_t File::Position() {
   ASSERT(handle_->fd() >= 0);
   return lseek(handle_->fd(), 0, SEEK_CUR);
@@ -91,6 +114,11 @@ bool File::Flush() {
 }
 
 
+intptr_t File::GetFD() {
+  return handle_->fd();
+}
+
+
 off_t File::Length() {
   ASSERT(handle_->fd() >= 0);
   struct stat st;
@@ -101,6 +129,39 @@ off_t File::Length() {
 }
 
 
+MappedMemory* File::Map(int64_t length) {
+  ASSERT(handle_->fd() >= 0);
+  HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(handle_->fd()));
+  if (GetFileType(handle) != FILE_TYPE_DISK ||
+      length <= 0 ||
+      length > Length() ||
+      length > kIntptrMax) {
+    return NULL;
+  }
+  HANDLE mapping = CreateFileMapping(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == NULL) {
+    return NULL;
+  }
+  void* address = MapViewOfFile(mapping,
+                                FILE_MAP_READ,
+                                0,
+                                0,
+                                static_cast<SIZE_T>(length));
+  // The view keeps a reference to the mapping object.
+  CloseHandle(mapping);
+  if (address == NULL) {
+    return NULL;
+  }
+  return new MappedMemory(address, length);
+}
+
+
+MappedMemory::~MappedMemory() {
+  BOOL result = UnmapViewOfFile(address_);
+  ASSERT(result);
+}
+
+
 File* File::Open(const char* name, FileOpenMode mode) {
   int flags = O_RDONLY | O_BINARY | O_NOINHERIT;
   if ((mode & kWrite) != 0) {
@@ -78,27 +78,95 @@ void FUNCTION_NAME(Filter_CreateZLibDeflate)(Dart_NativeArguments args) {
   Dart_ExitScope();
 }
 
-void FUNCTION_NAME(Filter_Process)(Dart_NativeArguments args) {
-  Dart_EnterScope();
-  Dart_Handle filter_obj = Dart_GetNativeArgument(args, 0);
-  Filter* filter = GetFilter(filter_obj);
-  Dart_Handle data_obj = Dart_GetNativeArgument(args, 1);
-  intptr_t length;
+// Growable list of processed chunks. The chunks are kept in a Dart list,
+// so nothing is leaked if an error is propagated.
+class ProcessedChunks {
+ public:
+  ProcessedChunks()
+      : list_(Dart_NewList(kInitialCapacity)),
+        length_(0),
+        capacity_(kInitialCapacity) {}
+
+  void Add(Dart_Handle chunk) {
+    if (length_ == capacity_) {
+      list_ = CopyList(capacity_ * 2);
+      capacity_ *= 2;
+    }
+    Dart_ListSetAt(list_, length_++, chunk);
+  }
+
+  Dart_Handle ToList() {
+    return (length_ == capacity_) ? list_ : CopyList(length_);
+  }
+
+ private:
+  static const intptr_t kInitialCapacity = 4;
+
+  Dart_Handle CopyList(intptr_t capacity) {
+    Dart_Handle list = Dart_NewList(capacity);
+    for (intptr_t i = 0; i < length_; i++) {
+      Dart_ListSetAt(list, i, Dart_ListGetAt(list_, i));
+    }
+    return list;
+  }
+
+  Dart_Handle list_;
+  intptr_t length_;
+  intptr_t capacity_;
+};
+
+
+// Create a Dart object for the processed data in the output chunk of the
+// filter. A chunk which is at least half full is handed over to the Dart
+// object without copying the data.
+static Dart_Handle ProcessedToTypedData(Filter* filter, intptr_t length) {
+  if (length >= filter->output_chunk_size() / 2) {
+    uint8_t* chunk = filter->TakeOutputChunk();
+    Dart_Handle result = Dart_NewExternalTypedData(kUint8,
+                                                   chunk, length,
+                                                   chunk, IOBuffer::Finalizer);
+    if (Dart_IsError(result)) {
+      IOBuffer::Free(chunk);
+      Dart_PropagateError(result);
+    }
+    return result;
+  }
+  uint8_t* io_buffer;
+  Dart_Handle result = IOBuffer::Allocate(length, &io_buffer);
+  memmove(io_buffer, filter->output_chunk(), length);
+  return result;
+}
+
+
+// Run the filter until it has no more processed data. Returns false on
+// errors.
+static bool Drain(Filter* filter, bool flush, ProcessedChunks* processed) {
+  intptr_t read;
+  while ((read = filter->Processed(filter->output_chunk(),
+                                   filter->output_chunk_size(),
+                                   flush)) > 0) {
+    processed->Add(ProcessedToTypedData(filter, read));
+  }
+  return read == 0;
+}
+
+
+// Filter the bytes of data_obj. Byte typed data is read in place, other
+// lists are copied first. Returns false on errors.
+static bool ProcessData(Filter* filter,
+                        Dart_Handle data_obj,
+                        ProcessedChunks* processed) {
   Dart_TypedData_Type type;
   uint8_t* buffer = NULL;
+  intptr_t length;
   Dart_Handle result = Dart_TypedDataAcquireData(
       data_obj, &type, reinterpret_cast<void**>(&buffer), &length);
-  if (!Dart_IsError(result)) {
-    uint8_t* zlib_buffer = new uint8_t[length];
-    if (zlib_buffer == NULL) {
-      Dart_TypedDataReleaseData(data_obj);
-      Dart_ThrowException(DartUtils::NewInternalError(
-          "Failed to allocate buffer for zlib"));
-    }
-    memmove(zlib_buffer, buffer, length);
+  bool is_bytes = !Dart_IsError(result);
+  if (is_bytes && type != kUint8 && type != kUint8Clamped && type != kInt8) {
     Dart_TypedDataReleaseData(data_obj);
-    buffer = zlib_buffer;
-  } else {
+    is_bytes = false;
+  }
+  if (!is_bytes) {
     if (Dart_IsError(Dart_ListLength(data_obj, &length))) {
       Dart_ThrowException(DartUtils::NewInternalError(
           "Failed to get list length"));
@@ -109,44 +177,66 @@ void FUNCTION_NAME(Filter_Process)(Dart_NativeArguments args) {
       Dart_ThrowException(DartUtils::NewInternalError(
           "Failed to get list bytes"));
     }
-  }
-  // Process will take ownership of buffer, if successful.
-  if (!filter->Process(buffer, length)) {
+    filter->Process(buffer, length);
+    bool success = Drain(filter, false, processed);
     delete[] buffer;
-    EndFilter(filter_obj, filter);
-    Dart_ThrowException(DartUtils::NewInternalError(
-        "Call to Process while still processing data"));
+    return success;
   }
-  Dart_ExitScope();
+  // The data can move when Dart objects are allocated, so it is released
+  // while the processed data is handed to Dart and acquired again after.
+  intptr_t offset = 0;
+  intptr_t read;
+  while (true) {
+    filter->Process(buffer + offset, length - offset);
+    read = filter->Processed(filter->output_chunk(),
+                             filter->output_chunk_size(),
+                             false);
+    offset = length - filter->Pending();
+    Dart_TypedDataReleaseData(data_obj);
+    if (read <= 0) break;
+    processed->Add(ProcessedToTypedData(filter, read));
+    result = Dart_TypedDataAcquireData(
+        data_obj, &type, reinterpret_cast<void**>(&buffer), &length);
+    if (Dart_IsError(result)) Dart_PropagateError(result);
+  }
+  return read == 0;
 }
 
 
-void FUNCTION_NAME(Filter_Processed)(Dart_NativeArguments args) {
+void FUNCTION_NAME(Filter_Process)(Dart_NativeArguments args) {
   Dart_EnterScope();
   Dart_Handle filter_obj = Dart_GetNativeArgument(args, 0);
   Filter* filter = GetFilter(filter_obj);
-  Dart_Handle flush_obj = Dart_GetNativeArgument(args, 1);
+  Dart_Handle chunks_obj = Dart_GetNativeArgument(args, 1);
+  Dart_Handle flush_obj = Dart_GetNativeArgument(args, 2);
   bool flush;
   if (Dart_IsError(Dart_BooleanValue(flush_obj, &flush))) {
     Dart_ThrowException(DartUtils::NewInternalError(
         "Failed to get 'flush' parameter"));
   }
-  intptr_t read = filter->Processed(filter->processed_buffer(),
-                                    filter->processed_buffer_size(),
-                                    flush);
-  if (read < 0) {
+  intptr_t chunks_length;
+  if (Dart_IsError(Dart_ListLength(chunks_obj, &chunks_length))) {
+    Dart_ThrowException(DartUtils::NewInternalError(
+        "Failed to get list length"));
+  }
+  ProcessedChunks processed;
+  bool success = true;
+  for (intptr_t i = 0; success && i < chunks_length; i++) {
+    Dart_Handle data_obj = Dart_ListGetAt(chunks_obj, i);
+    if (Dart_IsError(data_obj)) Dart_PropagateError(data_obj);
+    success = ProcessData(filter, data_obj, &processed);
+  }
+  if (success && flush) {
+    filter->Process(NULL, 0);
+    success = Drain(filter, true, &processed);
+  }
+  if (!success) {
     // Error, end filter.
     EndFilter(filter_obj, filter);
     Dart_ThrowException(DartUtils::NewInternalError(
         "Filter error, bad data"));
-  } else if (read == 0) {
-    Dart_SetReturnValue(args, Dart_Null());
-  } else {
-    uint8_t* io_buffer;
-    Dart_Handle result = IOBuffer::Allocate(read, &io_buffer);
-    memmove(io_buffer, filter->processed_buffer(), read);
-    Dart_SetReturnValue(args, result);
   }
+  Dart_SetReturnValue(args, processed.ToList());
   Dart_ExitScope();
 }
 
@@ -178,7 +268,6 @@ Dart_Handle Filter::GetFilterPointerNativeField(Dart_Handle filter,
 
 
 ZLibDeflateFilter::~ZLibDeflateFilter() {
-  delete[] current_buffer_;
   if (initialized()) deflateEnd(&stream_);
 }
 
@@ -187,6 +276,8 @@ bool ZLibDeflateFilter::Init() {
   stream_.zalloc = Z_NULL;
   stream_.zfree = Z_NULL;
   stream_.opaque = Z_NULL;
+  stream_.next_in = Z_NULL;
+  stream_.avail_in = 0;
   int result = deflateInit2(
       &stream_,
       level_,
@@ -202,13 +293,17 @@ bool ZLibDeflateFilter::Init() {
 }
 
 
-bool ZLibDeflateFilter::Process(uint8_t* data, intptr_t length) {
-  if (current_buffer_ != NULL) return false;
+void ZLibDeflateFilter::Process(uint8_t* data, intptr_t length) {
   stream_.avail_in = length;
-  stream_.next_in = current_buffer_ = data;
-  return true;
+  stream_.next_in = data;
+}
+
+
+intptr_t ZLibDeflateFilter::Pending() {
+  return stream_.avail_in;
 }
 
+
 intptr_t ZLibDeflateFilter::Processed(uint8_t* buffer,
                                       intptr_t length,
                                       bool flush) {
@@ -217,35 +312,24 @@ intptr_t ZLibDeflateFilter::Processed(uint8_t* buffer,
   switch (deflate(&stream_, flush ? Z_SYNC_FLUSH : Z_NO_FLUSH)) {
     case Z_OK: {
       intptr_t processed = length - stream_.avail_out;
-      if (processed == 0) {
-        delete[] current_buffer_;
-        current_buffer_ = NULL;
-        return 0;
-      } else {
-        // We processed data, should be called again.
-        return processed;
-      }
+      // If we processed data, we should be called again.
+      return processed;
     }
 
     case Z_STREAM_END:
     case Z_BUF_ERROR:
       // We processed all available input data.
-      delete[] current_buffer_;
-      current_buffer_ = NULL;
       return 0;
 
     default:
     case Z_STREAM_ERROR:
       // An error occoured.
-      delete[] current_buffer_;
-      current_buffer_ = NULL;
       return -1;
   }
 }
 
 
 ZLibInflateFilter::~ZLibInflateFilter() {
-  delete[] current_buffer_;
   if (initialized()) inflateEnd(&stream_);
 }
 
@@ -254,6 +338,8 @@ bool ZLibInflateFilter::Init() {
   stream_.zalloc = Z_NULL;
   stream_.zfree = Z_NULL;
   stream_.opaque = Z_NULL;
+  stream_.next_in = Z_NULL;
+  stream_.avail_in = 0;
   int result = inflateInit2(&stream_,
                             kZLibFlagWindowBits | kZLibFlagAcceptAnyHeader);
   if (result == Z_OK) {
@@ -264,14 +350,18 @@ bool ZLibInflateFilter::Init() {
 }
 
 
-bool ZLibInflateFilter::Process(uint8_t* data, intptr_t length) {
-  if (current_buffer_ != NULL) return false;
+void ZLibInflateFilter::Process(uint8_t* data, intptr_t length) {
   stream_.avail_in = length;
-  stream_.next_in = current_buffer_ = data;
-  return true;
+  stream_.next_in = data;
 }
 
 
+intptr_t ZLibInflateFilter::Pending() {
+  return stream_.avail_in;
+}
+
+
+
 intptr_t ZLibInflateFilter::Processed(uint8_t* buffer,
                                       intptr_t length,
                                       bool flush) {
@@ -280,21 +370,13 @@ intptr_t ZLibInflateFilter::Processed(uint8_t* buffer,
   switch (inflate(&stream_, flush ? Z_SYNC_FLUSH : Z_NO_FLUSH)) {
     case Z_OK: {
       intptr_t processed = length - stream_.avail_out;
-      if (processed == 0) {
-        delete[] current_buffer_;
-        current_buffer_ = NULL;
-        return 0;
-      } else {
-        // We processed data, should be called again.
-        return processed;
-      }
+      // If we processed data, we should be called again.
+      return processed;
     }
 
     case Z_STREAM_END:
     case Z_BUF_ERROR:
       // We processed all available input data.
-      delete[] current_buffer_;
-      current_buffer_ = NULL;
       return 0;
 
     default:
@@ -303,8 +385,6 @@ intptr_t ZLibInflateFilter::Processed(uint8_t* buffer,
     case Z_DATA_ERROR:
     case Z_STREAM_ERROR:
       // An error occoured.
-      delete[] current_buffer_;
-      current_buffer_ = NULL;
       return -1;
   }
 }
@@ -6,24 +6,30 @@
 #define BIN_FILTER_H_
 
 #include "bin/builtin.h"
+#include "bin/io_buffer.h"
 #include "bin/utils.h"
 
 #include "../third_party/zlib/zlib.h"
 
 class Filter {
  public:
-  virtual ~Filter() {}
+  virtual ~Filter() {
+    IOBuffer::Free(output_chunk_);
+  }
 
   virtual bool Init() = 0;
 
   /**
-   * On a succesfull call to Process, Process will take ownership of data. On
-   * successive calls to either Processed or ~Filter, data will be freed with
-   * a delete[] call.
+   * Set the next input data for the filter. Process does not take ownership
+   * of data, which has to stay valid until a call to Processed returns 0 or
+   * Process is called again.
    */
-  virtual bool Process(uint8_t* data, intptr_t length) = 0;
+  virtual void Process(uint8_t* data, intptr_t length) = 0;
   virtual intptr_t Processed(uint8_t* buffer, intptr_t length, bool finish) = 0;
 
+  // Number of bytes of the data passed to Process not yet consumed.
+  virtual intptr_t Pending() = 0;
+
   static Dart_Handle SetFilterPointerNativeField(Dart_Handle filter,
                                                  Filter* filter_pointer);
   static Dart_Handle GetFilterPointerNativeField(Dart_Handle filter,
@@ -31,16 +37,30 @@ class Filter {
 
   bool initialized() const { return initialized_; }
   void set_initialized(bool value) { initialized_ = value; }
-  uint8_t* processed_buffer() { return processed_buffer_; }
-  intptr_t processed_buffer_size() const { return kFilterBufferSize; }
+
+  // The output chunk is an IO buffer that processed data is written to.
+  // It is reused until it is handed over to a Dart object with
+  // TakeOutputChunk.
+  uint8_t* output_chunk() {
+    if (output_chunk_ == NULL) {
+      output_chunk_ = IOBuffer::Allocate(kFilterBufferSize);
+    }
+    return output_chunk_;
+  }
+  uint8_t* TakeOutputChunk() {
+    uint8_t* chunk = output_chunk_;
+    output_chunk_ = NULL;
+    return chunk;
+  }
+  intptr_t output_chunk_size() const { return kFilterBufferSize; }
 
  protected:
-  Filter() : initialized_(false) {}
+  Filter() : initialized_(false), output_chunk_(NULL) {}
 
  private:
   static const intptr_t kFilterBufferSize = 64 * KB;
-  uint8_t processed_buffer_[kFilterBufferSize];
   bool initialized_;
+  uint8_t* output_chunk_;
 
   DISALLOW_COPY_AND_ASSIGN(Filter);
 };
@@ -48,17 +68,17 @@ class Filter {
 class ZLibDeflateFilter : public Filter {
  public:
   ZLibDeflateFilter(bool gzip = false, int level = 6)
-    : gzip_(gzip), level_(level), current_buffer_(NULL) {}
+    : gzip_(gzip), level_(level) {}
   virtual ~ZLibDeflateFilter();
 
   virtual bool Init();
-  virtual bool Process(uint8_t* data, intptr_t length);
+  virtual void Process(uint8_t* data, intptr_t length);
   virtual intptr_t Processed(uint8_t* buffer, intptr_t length, bool finish);
+  virtual intptr_t Pending();
 
  private:
   const bool gzip_;
   const int level_;
-  uint8_t* current_buffer_;
   z_stream stream_;
 
   DISALLOW_COPY_AND_ASSIGN(ZLibDeflateFilter);
@@ -66,15 +86,15 @@ class ZLibDeflateFilter : public Filter {
 
 class ZLibInflateFilter : public Filter {
  public:
-  ZLibInflateFilter() : current_buffer_(NULL) {}
+  ZLibInflateFilter() {}
   virtual ~ZLibInflateFilter();
 
   virtual bool Init();
-  virtual bool Process(uint8_t* data, intptr_t length);
+  virtual void Process(uint8_t* data, intptr_t length);
   virtual intptr_t Processed(uint8_t* buffer, intptr_t length, bool finish);
+  virtual intptr_t Pending();
 
  private:
-  uint8_t* current_buffer_;
   z_stream stream_;
 
   DISALLOW_COPY_AND_ASSIGN(ZLibInflateFilter);
@@ -4,9 +4,8 @@
 
 
 class _FilterImpl extends NativeFieldWrapperClass1 implements _Filter {
-  void process(List<int> data) native "Filter_Process";
-
-  List<int> processed({bool flush: true}) native "Filter_Processed";
+  List<List<int>> process(List<List<int>> chunks, bool flush)
+      native "Filter_Process";
 
   void end() native "Filter_End";
 }
@@ -67,6 +67,18 @@ static bool has_compile_all = false;
 static bool has_print_script = false;
 
 
+// Files to load type feedback from before running the script and to save the
+// type feedback collected by the script to.
+// (These pointers point into an argv buffer and do not need to be free'd.)
+static const char* load_type_feedback_filename = NULL;
+static const char* save_type_feedback_filename = NULL;
+
+
+// File to write the CPU profile of the script to.
+// (This pointer points into an argv buffer and does not need to be free'd.)
+static const char* cpu_profile_filename = NULL;
+
+
 static bool IsValidFlag(const char* name,
                         const char* prefix,
                         intptr_t prefix_length) {
@@ -188,6 +200,19 @@ static bool ProcessVmStatsRootOption(const char* arg) {
 }
 
 
+static bool ProcessFileIOWorkersOption(const char* arg) {
+  ASSERT(arg != NULL);
+  int workers = atoi(arg);
+  if (workers <= 0) {
+    Log::PrintErr("unrecognized --file-io-workers option syntax. "
+                    "Use --file-io-workers=<number of workers>\n");
+    return false;
+  }
+  File::SetNumberOfServicePorts(workers);
+  return true;
+}
+
+
 static bool ProcessGenScriptSnapshotOption(const char* filename) {
   if (filename != NULL && strlen(filename) != 0) {
     // Ensure that are already running using a full snapshot.
@@ -208,6 +233,36 @@ static bool ProcessGenScriptSnapshotOption(const char* filename) {
 }
 
 
+static bool ProcessLoadTypeFeedbackOption(const char* filename) {
+  if ((filename == NULL) || (*filename == '\0')) {
+    Log::PrintErr("No file name given with --load-type-feedback\n");
+    return false;
+  }
+  load_type_feedback_filename = filename;
+  return true;
+}
+
+
+static bool ProcessSaveTypeFeedbackOption(const char* filename) {
+  if ((filename == NULL) || (*filename == '\0')) {
+    Log::PrintErr("No file name given with --save-type-feedback\n");
+    return false;
+  }
+  save_type_feedback_filename = filename;
+  return true;
+}
+
+
+static bool ProcessCpuProfileOption(const char* filename) {
+  if ((filename == NULL) || (*filename == '\0')) {
+    Log::PrintErr("No file name given with --cpu-profile\n");
+    return false;
+  }
+  cpu_profile_filename = filename;
+  return true;
+}
+
+
 static struct {
   const char* option_name;
   bool (*process)(const char* option);
@@ -228,6 +283,10 @@ static struct {
   { "--stats-root=", ProcessVmStatsRootOption },
   { "--stats", ProcessVmStatsOption },
   { "--print-script", ProcessPrintScriptOption },
+  { "--file-io-workers=", ProcessFileIOWorkersOption },
+  { "--load-type-feedback=", ProcessLoadTypeFeedbackOption },
+  { "--save-type-feedback=", ProcessSaveTypeFeedbackOption },
+  { "--cpu-profile=", ProcessCpuProfileOption },
   { NULL, NULL }
 };
 
@@ -554,6 +613,7 @@ static void PrintUsage() {
 "\n"
 "--generate-script-snapshot=<file_name>\n"
 "  loads Dart script and generates a snapshot in the specified file\n"
+"  (includes the type feedback given with --load-type-feedback)\n"
 "\n"
 "--print-script\n"
 "  generates Dart source code back and prints it after parsing a Dart script\n"
@@ -566,6 +626,22 @@ static void PrintUsage() {
 "  where to find static files used by the vmstats application\n"
 "  (used during vmstats plug-in development)\n"
 "\n"
+"--file-io-workers=<number of workers>\n"
+"  number of asynchronous file operations handled concurrently\n"
+"  (default is 16)\n"
+"\n"
+"--load-type-feedback=<file_name>\n"
+"  loads type feedback saved by an earlier run of the script, so that its\n"
+"  hot functions are optimized early\n"
+"\n"
+"--save-type-feedback=<file_name>\n"
+"  saves the type feedback collected while running the script to the\n"
+"  specified file\n"
+"\n"
+"--cpu-profile=<file_name>\n"
+"  samples the script with the CPU profiler and writes the profile to the\n"
+"  specified file, as text if its name ends in .txt and for pprof otherwise\n"
+"\n"
 "The following options are only used for VM development and may\n"
 "be changed in any future version:\n");
     const char* print_flags = "--print_flags";
@@ -636,6 +712,76 @@ static void ShutdownIsolate(void* callback_data) {
 }
 
 
+static Dart_Handle LoadTypeFeedback(const char* filename) {
+  File* file = File::Open(filename, File::kRead);
+  if (file == NULL) {
+    return Dart_NewApiError("Unable to open type feedback file");
+  }
+  intptr_t size = file->Length();
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(malloc(size));
+  bool bytes_read = file->ReadFully(buffer, size);
+  delete file;
+  Dart_Handle result = bytes_read ?
+      Dart_LoadTypeFeedback(buffer, size) :
+      Dart_NewApiError("Unable to read type feedback file");
+  free(buffer);
+  return result;
+}
+
+
+static Dart_Handle SaveTypeFeedback(const char* filename) {
+  uint8_t* buffer = NULL;
+  intptr_t size = 0;
+  Dart_Handle result = Dart_SaveTypeFeedback(&buffer, &size);
+  if (Dart_IsError(result)) {
+    return result;
+  }
+  File* file = File::Open(filename, File::kWriteTruncate);
+  if (file == NULL) {
+    return Dart_NewApiError("Unable to open type feedback file");
+  }
+  bool bytes_written = file->WriteFully(buffer, size);
+  delete file;
+  if (!bytes_written) {
+    return Dart_NewApiError("Unable to write type feedback file");
+  }
+  return result;
+}
+
+
+static Dart_Handle WriteCpuProfile(const char* filename) {
+  // Text files get the flat profile followed by the call tree.
+  const intptr_t length = strlen(filename);
+  const bool is_text =
+      (length >= 4) && (strcmp(filename + length - 4, ".txt") == 0);
+  Dart_ProfileFormat formats[] = { Dart_kFlatProfile, Dart_kTreeProfile };
+  intptr_t num_formats = 2;
+  if (!is_text) {
+    formats[0] = Dart_kPprofProfile;
+    num_formats = 1;
+  }
+  File* file = File::Open(filename, File::kWriteTruncate);
+  if (file == NULL) {
+    return Dart_NewApiError("Unable to open CPU profile file");
+  }
+  Dart_Handle result = Dart_Null();
+  for (intptr_t i = 0; i < num_formats; i++) {
+    uint8_t* buffer = NULL;
+    intptr_t size = 0;
+    result = Dart_GetProfile(formats[i], &buffer, &size);
+    if (Dart_IsError(result)) {
+      break;
+    }
+    if (!file->WriteFully(buffer, size)) {
+      result = Dart_NewApiError("Unable to write CPU profile file");
+      break;
+    }
+  }
+  delete file;
+  return result;
+}
+
+
 static Dart_Handle GenerateScriptSource() {
   Dart_Handle library_url = Dart_LibraryUrl(Dart_RootLibrary());
   if (Dart_IsError(library_url)) {
@@ -759,6 +905,16 @@ int main(int argc, char** argv) {
   Dart_EnterScope();
 
   if (generate_script_snapshot) {
+    // Include the type feedback of an earlier run in the snapshot.
+    if (load_type_feedback_filename != NULL) {
+      result = LoadTypeFeedback(load_type_feedback_filename);
+      if (Dart_IsError(result)) {
+        return ErrorExit("Error loading type feedback from '%s': %s\n",
+                         load_type_feedback_filename,
+                         Dart_GetError(result));
+      }
+    }
+
     // First create a snapshot.
     Dart_Handle result;
     uint8_t* buffer = NULL;
@@ -813,6 +969,22 @@ int main(int argc, char** argv) {
         return ErrorExit("%s\n", Dart_GetError(result));
       }
     } else {
+      if (load_type_feedback_filename != NULL) {
+        result = LoadTypeFeedback(load_type_feedback_filename);
+        if (Dart_IsError(result)) {
+          return ErrorExit("Error loading type feedback from '%s': %s\n",
+                           load_type_feedback_filename,
+                           Dart_GetError(result));
+        }
+      }
+
+      if (cpu_profile_filename != NULL) {
+        result = Dart_StartProfiling();
+        if (Dart_IsError(result)) {
+          return ErrorExit("%s\n", Dart_GetError(result));
+        }
+      }
+
       // Lookup and invoke the top level main function.
       result = Dart_Invoke(library, DartUtils::NewString("main"), 0, NULL);
       if (Dart_IsError(result)) {
@@ -824,6 +996,25 @@ int main(int argc, char** argv) {
       if (Dart_IsError(result)) {
         return ErrorExit("%s\n", Dart_GetError(result));
       }
+
+      if (save_type_feedback_filename != NULL) {
+        result = SaveTypeFeedback(save_type_feedback_filename);
+        if (Dart_IsError(result)) {
+          return ErrorExit("Error saving type feedback to '%s': %s\n",
+                           save_type_feedback_filename,
+                           Dart_GetError(result));
+        }
+      }
+
+      if (cpu_profile_filename != NULL) {
+        Dart_StopProfiling();
+        result = WriteCpuProfile(cpu_profile_filename);
+        if (Dart_IsError(result)) {
+          return ErrorExit("Error writing CPU profile to '%s': %s\n",
+                           cpu_profile_filename,
+                           Dart_GetError(result));
+        }
+      }
     }
   }
 
@@ -27,6 +27,22 @@ NativeService::~NativeService() {
 }
 
 
+void NativeService::SetNumberOfPorts(int number_of_ports) {
+  ASSERT(number_of_ports > 0);
+  MutexLocker lock(&mutex_);
+  for (int i = 0; i < service_ports_size_; i++) {
+    ASSERT(service_ports_[i] == ILLEGAL_PORT);
+  }
+  delete[] service_ports_;
+  service_ports_size_ = number_of_ports;
+  service_ports_ = new Dart_Port[service_ports_size_];
+  for (int i = 0; i < service_ports_size_; i++) {
+    service_ports_[i] = ILLEGAL_PORT;
+  }
+  service_ports_index_ = 0;
+}
+
+
 Dart_Port NativeService::GetServicePort() {
   MutexLocker lock(&mutex_);
   Dart_Port result = service_ports_[service_ports_index_];
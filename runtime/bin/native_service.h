@@ -27,6 +27,12 @@ class NativeService {
   // Get a Dart native port for this native service.
   Dart_Port GetServicePort();
 
+  // Change the number of native ports allocated for this service. As
+  // the messages for each native port are handled one at a time this
+  // bounds the number of requests handled concurrently. Must be
+  // called before the first call to GetServicePort.
+  void SetNumberOfPorts(int number_of_ports);
+
  private:
   // Name and handler for the native service.
   const char* name_;
@@ -226,6 +226,42 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
 }
 
 
+void FUNCTION_NAME(Socket_SendFile)(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  static bool short_socket_writes = Dart_IsVMFlagSet("short_socket_write");
+  Dart_Handle socket_obj = Dart_GetNativeArgument(args, 0);
+  intptr_t socket = 0;
+  Dart_Handle err = Socket::GetSocketIdNativeField(socket_obj, &socket);
+  if (Dart_IsError(err)) Dart_PropagateError(err);
+  File* file = reinterpret_cast<File*>(
+      DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 1)));
+  ASSERT(file != NULL);
+  int64_t position = 0;
+  int64_t length = 0;
+  if (DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 2), &position) &&
+      DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 3), &length) &&
+      position >= 0 &&
+      length >= 0) {
+    if (short_socket_writes) {
+      length = (length + 1) / 2;
+    }
+    int64_t bytes_sent = Socket::SendFile(socket, file, position, length);
+    if (bytes_sent >= 0) {
+      Dart_SetReturnValue(args, Dart_NewInteger(bytes_sent));
+    } else if (bytes_sent == Socket::kEndOfFile) {
+      OSError os_error(-1, "Unexpected end of file", OSError::kUnknown);
+      Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+    } else {
+      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    }
+  } else {
+    OSError os_error(-1, "Invalid argument", OSError::kUnknown);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+  }
+  Dart_ExitScope();
+}
+
+
 void FUNCTION_NAME(Socket_GetPort)(Dart_NativeArguments args) {
   Dart_EnterScope();
   Dart_Handle socket_obj = Dart_GetNativeArgument(args, 0);
@@ -365,6 +401,69 @@ void FUNCTION_NAME(ServerSocket_Accept)(Dart_NativeArguments args) {
 }
 
 
+void FUNCTION_NAME(ServerSocket_AcceptMultiple)(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  Dart_Handle socket_obj = Dart_GetNativeArgument(args, 0);
+  intptr_t socket = 0;
+  Dart_Handle err = Socket::GetSocketIdNativeField(socket_obj, &socket);
+  if (Dart_IsError(err)) Dart_PropagateError(err);
+  int64_t max = 0;
+  if (DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 1), &max) &&
+      max > 0) {
+    if (max > ServerSocket::kMaxAcceptBatchSize) {
+      max = ServerSocket::kMaxAcceptBatchSize;
+    }
+    intptr_t sockets[ServerSocket::kMaxAcceptBatchSize];
+    intptr_t count = ServerSocket::AcceptMultiple(socket, sockets, max);
+    if (count >= 0) {
+      Dart_Handle list = Dart_NewList(count);
+      if (Dart_IsError(list)) Dart_PropagateError(list);
+      for (intptr_t i = 0; i < count; i++) {
+        Dart_ListSetAt(list, i, Dart_NewInteger(sockets[i]));
+      }
+      Dart_SetReturnValue(args, list);
+    } else {
+      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    }
+  } else {
+    OSError os_error(-1, "Invalid argument", OSError::kUnknown);
+    Dart_Handle err = DartUtils::NewDartOSError(&os_error);
+    if (Dart_IsError(err)) Dart_PropagateError(err);
+    Dart_SetReturnValue(args, err);
+  }
+  Dart_ExitScope();
+}
+
+
+void FUNCTION_NAME(Socket_SetSocketId)(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  Dart_Handle socket_obj = Dart_GetNativeArgument(args, 0);
+  intptr_t id =
+      DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 1));
+  Dart_Handle err = Socket::SetSocketIdNativeField(socket_obj, id);
+  if (Dart_IsError(err)) Dart_PropagateError(err);
+  Dart_ExitScope();
+}
+
+
+intptr_t ServerSocket::AcceptMultiple(intptr_t fd,
+                                      intptr_t* sockets,
+                                      intptr_t max) {
+  intptr_t count = 0;
+  while (count < max) {
+    intptr_t socket = Accept(fd);
+    if (socket >= 0) {
+      sockets[count++] = socket;
+    } else if (socket == kTemporaryFailure || count > 0) {
+      break;
+    } else {
+      return -1;
+    }
+  }
+  return count;
+}
+
+
 static CObject* LookupRequest(const CObjectArray& request) {
   if (request.Length() == 2 && request[1]->IsString()) {
     CObjectString host(request[1]);
@@ -6,6 +6,7 @@
 #define BIN_SOCKET_H_
 
 #include "bin/builtin.h"
+#include "bin/file.h"
 #include "bin/utils.h"
 
 #include "platform/globals.h"
@@ -30,10 +31,21 @@ class Socket {
     kLookupRequest = 0,
   };
 
+  static const intptr_t kEndOfFile = -2;
+
   static bool Initialize();
   static intptr_t Available(intptr_t fd);
   static int Read(intptr_t fd, void* buffer, intptr_t num_bytes);
   static int Write(intptr_t fd, const void* buffer, intptr_t num_bytes);
+  // Send up to length bytes of file, starting at position, to the
+  // socket. Where the platform supports it the data is not copied
+  // through user space. Returns the number of bytes sent, 0 if the
+  // socket would block, kEndOfFile if position is at the end of the
+  // file and -1 on errors.
+  static int64_t SendFile(intptr_t fd,
+                          File* file,
+                          int64_t position,
+                          int64_t length);
   static intptr_t CreateConnect(const char* host, const intptr_t port);
   static intptr_t GetPort(intptr_t fd);
   static bool GetRemotePeer(intptr_t fd, char* host, intptr_t* port);
@@ -69,8 +81,19 @@ class ServerSocket {
  public:
   static const intptr_t kTemporaryFailure = -2;
 
+  // Maximum number of connections accepted by one call to AcceptMultiple.
+  static const intptr_t kMaxAcceptBatchSize = 64;
+
   static intptr_t Accept(intptr_t fd);
 
+  // Accepts up to max pending connections on the listening socket fd
+  // and stores the new sockets in sockets. Returns the number of
+  // accepted connections, which is 0 if no connection was ready. If
+  // the first accept fails -1 is returned (errno set). A failure after
+  // at least one connection has been accepted just ends the batch; the
+  // error is reported by the next call.
+  static intptr_t AcceptMultiple(intptr_t fd, intptr_t* sockets, intptr_t max);
+
   // Returns a positive integer if the call is successful. In case of failure
   // it returns:
   //
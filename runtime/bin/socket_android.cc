@@ -9,6 +9,7 @@
 #include <stdio.h>  // NOLINT
 #include <stdlib.h>  // NOLINT
 #include <string.h>  // NOLINT
+#include <sys/sendfile.h>  // NOLINT
 #include <unistd.h>  // NOLINT
 #include <netinet/tcp.h>  // NOLINT
 
@@ -90,6 +91,25 @@ int Socket::Write(intptr_t fd, const void* buffer, intptr_t num_bytes) {
 }
 
 
+int64_t Socket::SendFile(intptr_t fd,
+                         File* file,
+                         int64_t position,
+                         int64_t length) {
+  ASSERT(fd >= 0);
+  off_t offset = position;
+  ssize_t sent_bytes =
+      TEMP_FAILURE_RETRY(sendfile(fd, file->GetFD(), &offset, length));
+  if (sent_bytes == -1 && errno == EWOULDBLOCK) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes sent.
+    sent_bytes = 0;
+  } else if (sent_bytes == 0 && length > 0) {
+    return kEndOfFile;
+  }
+  return sent_bytes;
+}
+
+
 intptr_t Socket::GetPort(intptr_t fd) {
   ASSERT(fd >= 0);
   struct sockaddr_in socket_address;
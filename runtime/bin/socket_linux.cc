@@ -10,6 +10,7 @@
 #include <stdlib.h>  // NOLINT
 #include <string.h>  // NOLINT
 #include <sys/stat.h>  // NOLINT
+#include <sys/sendfile.h>  // NOLINT
 #include <unistd.h>  // NOLINT
 #include <netinet/tcp.h>  // NOLINT
 
@@ -96,6 +97,25 @@ int Socket::Write(intptr_t fd, const void* buffer, intptr_t num_bytes) {
 }
 
 
+int64_t Socket::SendFile(intptr_t fd,
+                         File* file,
+                         int64_t position,
+                         int64_t length) {
+  ASSERT(fd >= 0);
+  off_t offset = position;
+  ssize_t sent_bytes =
+      TEMP_FAILURE_RETRY(sendfile(fd, file->GetFD(), &offset, length));
+  if (sent_bytes == -1 && errno == EWOULDBLOCK) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes sent.
+    sent_bytes = 0;
+  } else if (sent_bytes == 0 && length > 0) {
+    return kEndOfFile;
+  }
+  return sent_bytes;
+}
+
+
 intptr_t Socket::GetPort(intptr_t fd) {
   ASSERT(fd >= 0);
   struct sockaddr_in socket_address;
@@ -250,7 +270,12 @@ intptr_t ServerSocket::Accept(intptr_t fd) {
   intptr_t socket;
   struct sockaddr clientaddr;
   socklen_t addrlen = sizeof(clientaddr);
-  socket = TEMP_FAILURE_RETRY(accept(fd, &clientaddr, &addrlen));
+  // Use accept4 to get a non-blocking, close-on-exec socket without
+  // additional fcntl system calls for each new connection.
+  socket = TEMP_FAILURE_RETRY(accept4(fd,
+                                      &clientaddr,
+                                      &addrlen,
+                                      SOCK_NONBLOCK | SOCK_CLOEXEC));
   if (socket == -1) {
     if (IsTemporaryAcceptError(errno)) {
       // We need to signal to the caller that this is actually not an
@@ -259,8 +284,6 @@ intptr_t ServerSocket::Accept(intptr_t fd) {
       ASSERT(kTemporaryFailure != -1);
       socket = kTemporaryFailure;
     }
-  } else {
-    Socket::SetNonBlocking(socket);
   }
   return socket;
 }
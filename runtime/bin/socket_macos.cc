@@ -10,6 +10,7 @@
 #include <stdlib.h>  // NOLINT
 #include <string.h>  // NOLINT
 #include <sys/stat.h>  // NOLINT
+#include <sys/uio.h>  // NOLINT
 #include <unistd.h>  // NOLINT
 #include <netinet/tcp.h>  // NOLINT
 
@@ -92,6 +93,25 @@ int Socket::Write(intptr_t fd, const void* buffer, intptr_t num_bytes) {
 }
 
 
+int64_t Socket::SendFile(intptr_t fd,
+                         File* file,
+                         int64_t position,
+                         int64_t length) {
+  ASSERT(fd >= 0);
+  // On return len holds the number of bytes sent, also when the call
+  // is interrupted or would block after sending part of the data.
+  off_t len = length;
+  int result = sendfile(file->GetFD(), fd, position, &len, NULL, 0);
+  if (result == -1 && errno != EWOULDBLOCK && errno != EINTR) {
+    return -1;
+  }
+  if (result == 0 && len == 0 && length > 0) {
+    return kEndOfFile;
+  }
+  return len;
+}
+
+
 intptr_t Socket::GetPort(intptr_t fd) {
   ASSERT(fd >= 0);
   struct sockaddr_in socket_address;
@@ -54,6 +54,10 @@ class _NativeSocket extends NativeFieldWrapperClass1 {
   // Native port messages.
   static const HOST_NAME_LOOKUP = 0;
 
+  // Maximum number of pending connections accepted for each read
+  // event on a listening socket.
+  static const int ACCEPT_BATCH_SIZE = 64;
+
   // Socket close state
   bool isClosed = false;
   bool isClosedRead = false;
@@ -186,12 +190,39 @@ class _NativeSocket extends NativeFieldWrapperClass1 {
     return result;
   }
 
+  // Sends up to length bytes of file, starting at position, directly
+  // from the file to the socket. Returns the number of bytes sent.
+  int sendFile(_RandomAccessFile file, int position, int length) {
+    if (isClosed) return 0;
+    if (length == 0) return 0;
+    var result = nativeSendFile(file._id, position, length);
+    if (result is OSError) {
+      reportError(result, "Send file failed");
+      result = 0;
+    }
+    return result;
+  }
+
   _NativeSocket accept() {
     var socket = new _NativeSocket.normal();
     if (nativeAccept(socket) != true) return null;
     return socket;
   }
 
+  // Accepts all pending connections, up to ACCEPT_BATCH_SIZE, in one
+  // native call.
+  List<_NativeSocket> acceptMultiple() {
+    var fds = nativeAcceptMultiple(ACCEPT_BATCH_SIZE);
+    if (fds is! List) return null;
+    var sockets = new List<_NativeSocket>(fds.length);
+    for (int i = 0; i < fds.length; i++) {
+      var socket = new _NativeSocket.normal();
+      socket.nativeSetSocketId(fds[i]);
+      sockets[i] = socket;
+    }
+    return sockets;
+  }
+
   int get port {
     if (localPort != null) return localPort;
     return localPort = nativeGetPort();
@@ -402,10 +433,14 @@ class _NativeSocket extends NativeFieldWrapperClass1 {
   nativeRead(int len) native "Socket_Read";
   nativeWrite(List<int> buffer, int offset, int bytes)
       native "Socket_WriteList";
+  nativeSendFile(int fileId, int position, int length)
+      native "Socket_SendFile";
   nativeCreateConnect(String host, int port) native "Socket_CreateConnect";
   nativeCreateBindListen(String address, int port, int backlog)
       native "ServerSocket_CreateBindListen";
   nativeAccept(_NativeSocket socket) native "ServerSocket_Accept";
+  nativeAcceptMultiple(int max) native "ServerSocket_AcceptMultiple";
+  void nativeSetSocketId(int id) native "Socket_SetSocketId";
   int nativeGetPort() native "Socket_GetPort";
   List nativeGetRemotePeer() native "Socket_GetRemotePeer";
   OSError nativeGetError() native "Socket_GetError";
@@ -439,8 +474,17 @@ class _RawServerSocket extends Stream<RawSocket>
     _socket.closeFuture.then((_) => _controller.close());
     _socket.setHandlers(
       read: () {
-        var socket = _socket.accept();
-        if (socket != null) _controller.add(new _RawSocket(socket));
+        var sockets = _socket.acceptMultiple();
+        if (sockets == null) return;
+        for (var socket in sockets) {
+          if (_socket.isClosed) {
+            // The subscription was cancelled while the batch was being
+            // delivered. Close the connections nobody will receive.
+            socket.close();
+          } else {
+            _controller.add(new _RawSocket(socket));
+          }
+        }
       },
       error: (e) {
         _controller.addError(e);
@@ -670,6 +714,10 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
   List<int> buffer;
   bool paused = false;
   Completer streamCompleter;
+  // Set while a file is sent directly from the file to the socket.
+  _RandomAccessFile file;
+  int filePosition;
+  int fileLength;
 
   _SocketStreamConsumer(this.socket);
 
@@ -677,32 +725,111 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
     socket._ensureRawSocketSubscription();
     streamCompleter = new Completer<Socket>();
     if (socket._raw != null) {
-      subscription = stream.listen(
-          (data) {
-            assert(!paused);
-            assert(buffer == null);
-            buffer = data;
-            offset = 0;
-            write();
-          },
-          onError: (error) {
-            socket._consumerDone();
-            done(error);
-          },
-          onDone: () {
-            done();
-          },
-          cancelOnError: true);
+      if (stream is _FileStream &&
+          stream._path != null &&
+          socket._raw is _RawSocket) {
+        // The content of the file is not needed in Dart, so have the
+        // operating system copy it to the socket.
+        sendFile(stream);
+      } else {
+        listen(stream);
+      }
     }
     return streamCompleter.future;
   }
 
+  void listen(Stream<List<int>> stream) {
+    subscription = stream.listen(
+        (data) {
+          assert(!paused);
+          assert(buffer == null);
+          buffer = data;
+          offset = 0;
+          write();
+        },
+        onError: (error) {
+          socket._consumerDone();
+          done(error);
+        },
+        onDone: () {
+          done();
+        },
+        cancelOnError: true);
+  }
+
   Future<Socket> close() {
     socket._consumerDone();
     return new Future.value(socket);
   }
 
+  void sendFile(_FileStream stream) {
+    new File(stream._path).open().then((opened) {
+      return opened.length().then((length) {
+        if (socket._raw == null || streamCompleter == null) {
+          // The socket was destroyed while opening the file.
+          return opened.close();
+        }
+        if (length == 0) {
+          // Pipes and special devices report a length of 0, and sendfile
+          // cannot read from all of them. These are read through the
+          // stream until end of file instead.
+          return opened.close().then((_) {
+            if (socket._raw == null || streamCompleter == null) return;
+            listen(stream);
+          });
+        }
+        file = opened;
+        filePosition = 0;
+        fileLength = length;
+        writeFile();
+      }, onError: (error) {
+        opened.close();
+        throw error;
+      });
+    }).catchError((error) {
+      socket._consumerDone();
+      done(error);
+    });
+  }
+
+  void writeFile() {
+    try {
+      // Send as much as possible.
+      filePosition +=
+          socket._sendFile(file, filePosition, fileLength - filePosition);
+      // Sending can fail and close the socket. The error event completes
+      // the stream, or destroys the socket if the user says so.
+      if (file == null) return;
+      if (streamCompleter == null || socket._nativeSocket.isClosed) {
+        closeFile().catchError((_) {});
+        return;
+      }
+      if (filePosition < fileLength) {
+        socket._enableWriteEvent();
+      } else {
+        closeFile().then((_) => done(), onError: (error) {
+          socket._consumerDone();
+          done(error);
+        });
+      }
+    } catch (e) {
+      stop();
+      socket._consumerDone();
+      done(e);
+    }
+  }
+
+  Future closeFile() {
+    var tmp = file;
+    file = null;
+    return tmp.close();
+  }
+
   void write() {
+    if (file != null) {
+      writeFile();
+      return;
+    }
     try {
       if (subscription == null) return;
       assert(buffer != null);
@@ -746,6 +873,13 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
   }
 
   void stop() {
+    if (file != null) {
+      // The socket is going away, so a failure to close the file has
+      // nowhere to be reported.
+      closeFile().catchError((_) {});
+      socket._disableWriteEvent();
+      return;
+    }
     if (subscription == null) return;
     subscription.cancel();
     subscription = null;
@@ -918,6 +1052,9 @@ class _Socket extends Stream<List<int>> implements Socket {
   int _write(List<int> data, int offset, int length) =>
       _raw.write(data, offset, length);
 
+  int _sendFile(_RandomAccessFile file, int position, int length) =>
+      _nativeSocket.sendFile(file, position, length);
+
   void _enableWriteEvent() {
     _raw.writeEventsEnabled = true;
   }
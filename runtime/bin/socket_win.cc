@@ -10,6 +10,7 @@
 #include "bin/file.h"
 #include "bin/log.h"
 #include "bin/socket.h"
+#include "platform/utils.h"
 
 bool Socket::Initialize() {
   static bool socket_initialized = false;
@@ -44,6 +45,22 @@ intptr_t Socket::Write(intptr_t fd, const void* buffer, intptr_t num_bytes) {
 }
 
 
+int64_t Socket::SendFile(intptr_t fd,
+                         File* file,
+                         int64_t position,
+                         int64_t length) {
+  // There is no zero-copy path here. Read a chunk of the file and hand
+  // it to the socket, which copies it into its own write buffer.
+  const int64_t kChunkSize = 16 * KB;
+  uint8_t buffer[kChunkSize];
+  int64_t bytes_read =
+      file->ReadAt(buffer, dart::Utils::Minimum(length, kChunkSize), position);
+  if (bytes_read < 0) return -1;
+  if (bytes_read == 0 && length > 0) return kEndOfFile;
+  return Write(fd, buffer, bytes_read);
+}
+
+
 intptr_t Socket::GetPort(intptr_t fd) {
   ASSERT(reinterpret_cast<Handle*>(fd)->is_socket());
   SocketHandle* socket_handle = reinterpret_cast<SocketHandle*>(fd);
@@ -802,6 +802,11 @@ DART_EXPORT Dart_Handle Dart_CreateSnapshot(uint8_t** buffer,
  * (skips the script tokenizing and parsing process). A Snapshot of the script
  * can only be created before any dart code has executed.
  *
+ * The snapshot includes the type feedback of the isolate, which is loaded
+ * with the script by Dart_LoadScriptFromSnapshot. Calling
+ * Dart_LoadTypeFeedback with the feedback of an earlier run before creating
+ * the snapshot lets the application start with warm type feedback.
+ *
  * Requires there to be a current isolate which already has loaded script.
  *
  * \param buffer Returns a pointer to a buffer containing
@@ -814,6 +819,82 @@ DART_EXPORT Dart_Handle Dart_CreateSnapshot(uint8_t** buffer,
 DART_EXPORT Dart_Handle Dart_CreateScriptSnapshot(uint8_t** buffer,
                                                   intptr_t* size);
 
+/**
+ * Saves the type feedback collected by the current isolate.
+ *
+ * The type feedback consists of the receiver classes seen at call sites,
+ * the usage counters and the inlining state of the functions that have
+ * run. Loading it into a later run of the same application with
+ * Dart_LoadTypeFeedback lets the hot functions be optimized early.
+ *
+ * \param buffer Returns a pointer to a buffer containing the type
+ *   feedback. This buffer is scope allocated and is only valid until the
+ *   next call to Dart_ExitScope.
+ * \param size Returns the size of the buffer.
+ *
+ * \return A valid handle if no error occurs during the operation.
+ */
+DART_EXPORT Dart_Handle Dart_SaveTypeFeedback(uint8_t** buffer,
+                                              intptr_t* size);
+
+/**
+ * Loads type feedback saved by Dart_SaveTypeFeedback into the current
+ * isolate.
+ *
+ * Requires there to be a current isolate which already has loaded the
+ * script. Feedback for functions whose source has changed is ignored;
+ * feedback that is otherwise out of date only causes the optimized code to
+ * deoptimize.
+ *
+ * \param buffer A buffer containing the type feedback.
+ * \param size The size of the buffer.
+ *
+ * \return A valid handle if no error occurs during the operation.
+ */
+DART_EXPORT Dart_Handle Dart_LoadTypeFeedback(const uint8_t* buffer,
+                                              intptr_t size);
+
+/**
+ * Starts sampling the stack of the current isolate with the CPU profiler.
+ *
+ * The samples are kept in a fixed size buffer (see --profile_buffer_size)
+ * until the isolate shuts down. Passing --profile to the VM records the
+ * names of the generated code for symbolizing the samples.
+ *
+ * \return A valid handle if no error occurs during the operation, an error
+ *   handle if profiling is not supported on this platform.
+ */
+DART_EXPORT Dart_Handle Dart_StartProfiling();
+
+/**
+ * Stops sampling the stack of the current isolate. The samples taken so
+ * far remain available to Dart_GetProfile.
+ *
+ * \return A valid handle if no error occurs during the operation.
+ */
+DART_EXPORT Dart_Handle Dart_StopProfiling();
+
+typedef enum {
+  Dart_kFlatProfile = 0,  // Text, functions by samples in which they ran.
+  Dart_kTreeProfile,      // Text, sampled call paths from the outermost frame.
+  Dart_kPprofProfile,     // Binary CPU profile with symbols, for pprof.
+} Dart_ProfileFormat;
+
+/**
+ * Gets the CPU profile of the current isolate.
+ *
+ * \param format The format of the profile.
+ * \param buffer Returns a pointer to a buffer containing the profile. This
+ *   buffer is scope allocated and is only valid until the next call to
+ *   Dart_ExitScope.
+ * \param size Returns the size of the buffer.
+ *
+ * \return A valid handle if no error occurs during the operation.
+ */
+DART_EXPORT Dart_Handle Dart_GetProfile(Dart_ProfileFormat format,
+                                        uint8_t** buffer,
+                                        intptr_t* size);
+
 
 /**
  * Schedules an interrupt for the specified isolate.
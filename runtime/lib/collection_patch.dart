@@ -2,6 +2,8 @@
 // for details. All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 
+import "dart:typeddata";
+
 patch class HashMap<K, V> {
   final _HashMapTable<K, V> _hashTable = new _HashMapTable<K, V>();
 
@@ -191,115 +193,256 @@ patch class HashSet<E> {
 
 /**
  * A hash-based map that iterates keys and values in key insertion order.
+ *
+ * The keys and values are stored in insertion order in [_data], and the hash
+ * table is a [Uint32List] of positions in [_data]. An entry takes the two
+ * slots of its key and value and a 32-bit index entry, instead of the four
+ * slots of a [_LinkedHashTable] entry, and iterating visits [_data] in order.
  */
 patch class LinkedHashMap<K, V> {
-  final _LinkedHashMapTable _hashTable;
+  static const int _INITIAL_INDEX_SIZE = 8;
 
-  /* patch */ LinkedHashMap() : _hashTable = new _LinkedHashMapTable<K, V>() {
-    _hashTable._container = this;
+  /**
+   * Number of bits of the hash codes that are kept in [_index], so that the
+   * index entries are Smis on all platforms.
+   */
+  static const int _HASH_BITS = 30;
+
+  /** Index entry of a slot that was never used. */
+  static const int _UNUSED_PAIR = 0;
+
+  /** Index entry of a slot whose key has been removed. */
+  static const int _DELETED_PAIR = 1;
+
+  /**
+   * Hash table of the keys in [_data].
+   *
+   * An entry holds the number of a key-value pair of [_data] in its low bits
+   * and bits of the hash code of the key above them, so most probes for
+   * other keys fail without comparing keys. The length is a power of two,
+   * and at most half of the entries are used.
+   */
+  Uint32List _index;
+
+  /** Mask of the bits of a hash code that are kept in an index entry. */
+  int _hashMask;
+
+  /**
+   * Keys and values, as pairs of slots in insertion order. Removed keys are
+   * replaced by [_TOMBSTONE]. Has as many slots as [_index] has entries.
+   */
+  List _data;
+
+  /** Number of slots of [_data] in use, including removed pairs. */
+  int _usedData;
+
+  /** Number of removed pairs in [_data]. */
+  int _deletedKeys;
+
+  /** Counter incremented when the map is modified. */
+  int _modificationCount = 0;
+
+  /* patch */ LinkedHashMap() {
+    _init(_INITIAL_INDEX_SIZE);
   }
 
   /* patch */ bool containsKey(K key) {
-    return _hashTable._get(key) >= 0;
+    int hashCode = key.hashCode;
+    return _findIndex(key, hashCode, _hashPattern(hashCode)) >= 0;
   }
 
   /* patch */ bool containsValue(V value) {
-    int modificationCount = _hashTable._modificationCount;
-    for (int offset = _hashTable._next(_LinkedHashTable._HEAD_OFFSET);
-         offset != _LinkedHashTable._HEAD_OFFSET;
-         offset = _hashTable._next(offset)) {
-      if (_hashTable._value(offset) == value) {
+    int modificationCount = _modificationCount;
+    for (int offset = 0; offset < _usedData; offset += 2) {
+      if (!identical(_data[offset], _TOMBSTONE) &&
+          _data[offset + 1] == value) {
         return true;
       }
-      // The == call may modify the table.
-      _hashTable._checkModification(modificationCount);
+      // The == call may modify the map.
+      _checkModification(modificationCount);
     }
     return false;
   }
 
   /* patch */ void addAll(Map<K, V> other) {
     other.forEach((K key, V value) {
-      int offset = _hashTable._put(key);
-      _hashTable._setValue(offset, value);
-      _hashTable._checkCapacity();
+      this[key] = value;
     });
   }
 
   /* patch */ V operator [](K key) {
-    int offset = _hashTable._get(key);
-    if (offset >= 0) return _hashTable._value(offset);
+    int hashCode = key.hashCode;
+    int pattern = _hashPattern(hashCode);
+    int index = _findIndex(key, hashCode, pattern);
+    if (index >= 0) return _data[_pairOffset(index, pattern) + 1];
     return null;
   }
 
   /* patch */ void operator []=(K key, V value) {
-    int offset = _hashTable._put(key);
-    _hashTable._setValue(offset, value);
-    _hashTable._checkCapacity();
+    int hashCode = key.hashCode;
+    int pattern = _hashPattern(hashCode);
+    int index = _findIndex(key, hashCode, pattern);
+    if (index >= 0) {
+      _data[_pairOffset(index, pattern) + 1] = value;
+    } else {
+      _insert(key, value, hashCode);
+    }
   }
 
   /* patch */ V putIfAbsent(K key, V ifAbsent()) {
-    int offset = _hashTable._probeForAdd(_hashTable._hashCodeOf(key), key);
-    Object entry = _hashTable._table[offset];
-    if (!_hashTable._isFree(entry)) {
-      return _hashTable._value(offset);
-    }
-    int modificationCount = _hashTable._modificationCount;
+    int hashCode = key.hashCode;
+    int pattern = _hashPattern(hashCode);
+    int index = _findIndex(key, hashCode, pattern);
+    if (index >= 0) return _data[_pairOffset(index, pattern) + 1];
+    int modificationCount = _modificationCount;
     V value = ifAbsent();
-    if (modificationCount == _hashTable._modificationCount) {
-      _hashTable._setKey(offset, key);
-      _hashTable._setValue(offset, value);
-      _hashTable._linkLast(offset);
-      if (entry == null) {
-        _hashTable._entryCount++;
-        _hashTable._checkCapacity();
-      } else {
-        assert(identical(entry, _TOMBSTONE));
-        _hashTable._deletedCount--;
-      }
-      _hashTable._recordModification();
+    if (modificationCount == _modificationCount) {
+      _insert(key, value, hashCode);
     } else {
-      // The table might have changed, so we can't trust [offset] any more.
-      // Do another lookup before setting the value.
-      offset = _hashTable._put(key);
-      _hashTable._setValue(offset, value);
-      _hashTable._checkCapacity();
+      // The map has changed, so the key might have been added.
+      this[key] = value;
     }
     return value;
   }
 
   /* patch */ V remove(K key) {
-    int offset = _hashTable._remove(key);
-    if (offset < 0) return null;
-    Object oldValue = _hashTable._value(offset);
-    _hashTable._setValue(offset, null);
-    _hashTable._checkCapacity();
-    return oldValue;
+    int hashCode = key.hashCode;
+    int pattern = _hashPattern(hashCode);
+    int index = _findIndex(key, hashCode, pattern);
+    if (index < 0) return null;
+    int offset = _pairOffset(index, pattern);
+    V value = _data[offset + 1];
+    _index[index] = _DELETED_PAIR;
+    _data[offset] = _TOMBSTONE;
+    _data[offset + 1] = null;
+    _deletedKeys++;
+    _recordModification();
+    return value;
   }
 
   /* patch */ void clear() {
-    _hashTable._clear();
+    if (_usedData == 0) return;
+    _init(_INITIAL_INDEX_SIZE);
+    _recordModification();
   }
 
   /* patch */ void forEach(void action (K key, V value)) {
-    int modificationCount = _hashTable._modificationCount;
-    for (int offset = _hashTable._next(_LinkedHashTable._HEAD_OFFSET);
-         offset != _LinkedHashTable._HEAD_OFFSET;
-         offset = _hashTable._next(offset)) {
-      action(_hashTable._key(offset), _hashTable._value(offset));
-      _hashTable._checkModification(modificationCount);
+    int modificationCount = _modificationCount;
+    for (int offset = 0; offset < _usedData; offset += 2) {
+      Object key = _data[offset];
+      if (!identical(key, _TOMBSTONE)) {
+        action(key, _data[offset + 1]);
+        _checkModification(modificationCount);
+      }
     }
   }
 
-  /* patch */ Iterable<K> get keys =>
-      new _LinkedHashTableKeyIterable<K>(_hashTable);
+  /* patch */ Iterable<K> get keys => new _LinkedHashMapKeyIterable<K>(this);
 
   /* patch */ Iterable<V> get values =>
-      new _LinkedHashTableValueIterable<V>(_hashTable,
-                                           _LinkedHashMapTable._VALUE_INDEX);
+      new _LinkedHashMapValueIterable<V>(this);
 
-  /* patch */ int get length => _hashTable._elementCount;
+  /* patch */ int get length => (_usedData >> 1) - _deletedKeys;
 
-  /* patch */ bool get isEmpty => _hashTable._elementCount == 0;
+  /* patch */ bool get isEmpty => length == 0;
+
+  void _init(int indexSize) {
+    _index = new Uint32List(indexSize);
+    _hashMask = ((1 << _HASH_BITS) - 1) & ~((indexSize >> 1) - 1);
+    _data = new List(indexSize);
+    _usedData = 0;
+    _deletedKeys = 0;
+  }
+
+  /**
+   * Returns the hash bits of the index entries of keys with [hashCode].
+   *
+   * They are the bits above the pair numbers, which are below half of the
+   * index size, and are never zero, so that used entries are not zero.
+   */
+  int _hashPattern(int hashCode) {
+    int pattern = hashCode & _hashMask;
+    return (pattern == 0) ? (_index.length >> 1) : pattern;
+  }
+
+  /** Returns the offset in [_data] of the pair of the used index entry. */
+  int _pairOffset(int index, int pattern) => (_index[index] ^ pattern) << 1;
+
+  /**
+   * Returns the index of the entry of [key] in [_index], or -1.
+   *
+   * The hash bits of the entries of other keys usually differ from
+   * [pattern], which makes their pair number, [:entry ^ pattern:], too large
+   * to be compared. This also skips the deleted entries.
+   */
+  int _findIndex(Object key, int hashCode, int pattern) {
+    int sizeMask = _index.length - 1;
+    int maxPairs = _index.length >> 1;
+    int index = hashCode & sizeMask;
+    int probeCount = 0;
+    int entry = _index[index];
+    while (entry != _UNUSED_PAIR) {
+      int pair = entry ^ pattern;
+      if (pair < maxPairs && _data[pair << 1] == key) {
+        return index;
+      }
+      // The triangular number sequence modulo the size visits every index.
+      index = (index + ++probeCount) & sizeMask;
+      entry = _index[index];
+    }
+    return -1;
+  }
+
+  /** Adds a key that is not in the map. */
+  void _insert(K key, V value, int hashCode) {
+    if (_usedData == _data.length) {
+      _rehash();
+    }
+    int sizeMask = _index.length - 1;
+    int index = hashCode & sizeMask;
+    int probeCount = 0;
+    // Deleted entries are not reused, so at most half of the entries are
+    // not unused.
+    while (_index[index] != _UNUSED_PAIR) {
+      index = (index + ++probeCount) & sizeMask;
+    }
+    _index[index] = _hashPattern(hashCode) | (_usedData >> 1);
+    _data[_usedData++] = key;
+    _data[_usedData++] = value;
+    _recordModification();
+  }
+
+  /**
+   * Moves the pairs that are in use to new tables, which are twice as large
+   * unless at most half of the pairs of [_data] are in use.
+   */
+  void _rehash() {
+    int indexSize = _index.length;
+    int pairs = (_usedData >> 1) - _deletedKeys;
+    if (pairs * 4 > indexSize) {
+      indexSize *= 2;
+    }
+    List oldData = _data;
+    int oldUsedData = _usedData;
+    _init(indexSize);
+    for (int offset = 0; offset < oldUsedData; offset += 2) {
+      Object key = oldData[offset];
+      if (!identical(key, _TOMBSTONE)) {
+        _insert(key, oldData[offset + 1], key.hashCode);
+      }
+    }
+  }
+
+  void _checkModification(int expectedModificationCount) {
+    if (_modificationCount != expectedModificationCount) {
+      throw new ConcurrentModificationError(this);
+    }
+  }
+
+  void _recordModification() {
+    // Value cycles after 2^30 modifications, like in [_HashTable].
+    _modificationCount = (_modificationCount + 1) & (0x3FFFFFFF);
+  }
 }
 
 patch class LinkedHashSet<E> extends _HashSetBase<E> {
@@ -924,40 +1067,12 @@ class _LinkedHashTable<K> extends _HashTable<K> {
   }
 }
 
-class _LinkedHashTableKeyIterable<K> extends IterableBase<K> {
-  final _LinkedHashTable<K> _table;
-  _LinkedHashTableKeyIterable(this._table);
-  Iterator<K> get iterator => new _LinkedHashTableKeyIterator<K>(_table);
-
-  bool contains(Object value) => _table._get(value) >= 0;
-
-  int get length => _table._elementCount;
-}
-
 class _LinkedHashTableKeyIterator<K> extends _LinkedHashTableIterator<K> {
   _LinkedHashTableKeyIterator(_LinkedHashTable<K> hashTable): super(hashTable);
 
   K _getCurrent(int offset) => _hashTable._key(offset);
 }
 
-class _LinkedHashTableValueIterable<V> extends IterableBase<V> {
-  final _LinkedHashTable _hashTable;
-  final int _valueIndex;
-  _LinkedHashTableValueIterable(this._hashTable, this._valueIndex);
-  Iterator<V> get iterator =>
-      new _LinkedHashTableValueIterator<V>(_hashTable, _valueIndex);
-  int get length => _hashTable._elementCount;
-}
-
-class _LinkedHashTableValueIterator<V> extends _LinkedHashTableIterator<V> {
-  final int _valueIndex;
-
-  _LinkedHashTableValueIterator(_LinkedHashTable hashTable, this._valueIndex)
-      : super(hashTable);
-
-  V _getCurrent(int offset) => _hashTable._table[offset + _valueIndex];
-}
-
 abstract class _LinkedHashTableIterator<T> implements Iterator<T> {
   final _LinkedHashTable _hashTable;
   final int _modificationCount;
@@ -985,18 +1100,59 @@ abstract class _LinkedHashTableIterator<T> implements Iterator<T> {
   T get current => _current;
 }
 
-class _LinkedHashMapTable<K, V> extends _LinkedHashTable<K> {
-  static const int _INITIAL_CAPACITY = 8;
-  static const int _VALUE_INDEX = 3;
+abstract class _LinkedHashMapIterable<E> extends IterableBase<E> {
+  final LinkedHashMap _map;
+  _LinkedHashMapIterable(this._map);
 
-  int get _entrySize => 4;
+  int get length => _map.length;
 
-  _LinkedHashMapTable() : super(_INITIAL_CAPACITY);
+  bool get isEmpty => _map.isEmpty;
+}
 
-  V _value(int offset) => _table[offset + _VALUE_INDEX];
-  void _setValue(int offset, V value) { _table[offset + _VALUE_INDEX] = value; }
+class _LinkedHashMapKeyIterable<K> extends _LinkedHashMapIterable<K> {
+  _LinkedHashMapKeyIterable(LinkedHashMap map) : super(map);
 
-  _copyEntry(List oldTable, int fromOffset, int toOffset) {
-    _table[toOffset + _VALUE_INDEX] = oldTable[fromOffset + _VALUE_INDEX];
+  Iterator<K> get iterator => new _LinkedHashMapIterator<K>(_map, 0);
+
+  bool contains(Object key) => _map.containsKey(key);
+}
+
+class _LinkedHashMapValueIterable<V> extends _LinkedHashMapIterable<V> {
+  _LinkedHashMapValueIterable(LinkedHashMap map) : super(map);
+
+  Iterator<V> get iterator => new _LinkedHashMapIterator<V>(_map, 1);
+
+  bool contains(Object value) => _map.containsValue(value);
+}
+
+class _LinkedHashMapIterator<E> implements Iterator<E> {
+  final LinkedHashMap _map;
+  final int _modificationCount;
+  /** Position of the iterated slot in a pair: 0 for keys, 1 for values. */
+  final int _slot;
+  /** Offset of the next pair in the data of the map. */
+  int _offset = 0;
+  E _current;
+
+  _LinkedHashMapIterator(LinkedHashMap map, this._slot)
+      : _map = map,
+        _modificationCount = map._modificationCount;
+
+  bool moveNext() {
+    _map._checkModification(_modificationCount);
+    List data = _map._data;
+    int usedData = _map._usedData;
+    while (_offset < usedData) {
+      int offset = _offset;
+      _offset += 2;
+      if (!identical(data[offset], _TOMBSTONE)) {
+        _current = data[offset + _slot];
+        return true;
+      }
+    }
+    _current = null;
+    return false;
   }
+
+  E get current => _current;
 }
@@ -181,6 +181,43 @@ DEFINE_NATIVE_ENTRY(Integer_equalToInteger, 2) {
 }
 
 
+DEFINE_NATIVE_ENTRY(Integer_modPow, 3) {
+  const Integer& base = Integer::CheckedHandle(arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, exponent, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, modulus, arguments->NativeArgAt(2));
+  ASSERT(CheckInteger(base));
+  ASSERT(CheckInteger(exponent));
+  ASSERT(CheckInteger(modulus));
+  // The arguments are checked in Dart.
+  ASSERT(!exponent.IsNegative());
+  ASSERT(!modulus.IsNegative() && !modulus.IsZero());
+  if (!base.IsBigint() && !exponent.IsBigint() && !modulus.IsBigint() &&
+      (modulus.AsInt64Value() <= kMaxUint32)) {
+    // The products of values below the modulus fit into 64 bits.
+    const uint64_t mod = modulus.AsInt64Value();
+    int64_t power_value = base.AsInt64Value() % static_cast<int64_t>(mod);
+    if (power_value < 0) {
+      power_value += mod;
+    }
+    uint64_t power = power_value;
+    uint64_t result = 1 % mod;
+    for (int64_t e = exponent.AsInt64Value(); e > 0; e >>= 1) {
+      if ((e & 1) != 0) {
+        result = (result * power) % mod;
+      }
+      power = (power * power) % mod;
+    }
+    return Integer::New(result);
+  }
+  const Bigint& big_base = Bigint::Handle(base.AsBigint());
+  const Bigint& big_exponent = Bigint::Handle(exponent.AsBigint());
+  const Bigint& big_modulus = Bigint::Handle(modulus.AsBigint());
+  const Bigint& result = Bigint::Handle(
+      BigintOperations::ModPow(big_base, big_exponent, big_modulus));
+  return result.AsValidInteger();
+}
+
+
 DEFINE_NATIVE_ENTRY(Integer_parse, 1) {
   GET_NON_NULL_NATIVE_ARGUMENT(String, value, arguments->NativeArgAt(0));
   if (value.IsOneByteString()) {
@@ -163,6 +163,17 @@ class _IntegerImplementation {
   int toInt() { return this; }
   double toDouble() { return new _Double.fromInteger(this); }
 
+  int modPow(int exponent, int modulus) {
+    if (exponent is! int) throw new ArgumentError(exponent);
+    if (modulus is! int) throw new ArgumentError(modulus);
+    if (exponent < 0) throw new RangeError("Exponent $exponent is negative");
+    if (modulus <= 0) {
+      throw new RangeError("Modulus $modulus is not positive");
+    }
+    return _modPow(exponent, modulus);
+  }
+  int _modPow(int exponent, int modulus) native "Integer_modPow";
+
   int pow(int exponent) {
     double res = this.toDouble().pow(exponent);
     if (res.isInfinite) {
@@ -0,0 +1,690 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/bootstrap_natives.h"
+
+#include "vm/double_conversion.h"
+#include "vm/exceptions.h"
+#include "vm/native_entry.h"
+#include "vm/object.h"
+#include "vm/symbols.h"
+#include "vm/unicode.h"
+
+namespace dart {
+
+// Slots of the state array of a _JsonDecoder, see json_patch.dart.
+enum JsonDecoderSlot {
+  kResultSlot = 0,  // The top level value.
+  kStackSlot,       // Parser state and container of the enclosing values.
+  kStateSlot,       // Parser state, null before the first chunk.
+  kPendingSlot,     // Characters of an incomplete token, or null.
+  kPositionSlot,    // Input position of the first pending character.
+  kObjectsSlot,     // Holder, index and key/value list of completed objects.
+  kKeysSlot,        // Recently read property names.
+  kNumSlots,
+};
+
+
+// Decodes a chunk of JSON text into lists, numbers, strings and booleans.
+// The states are the ones of the JsonParser of dart:json: the low bits of a
+// state tell whether a string or a value may follow, and or-ing in
+// kValueReadBits moves to the state after a value.
+//
+// Lists are built as growable arrays. Objects are built as growable arrays
+// of their alternating keys and values, and are recorded in the objects list
+// of the state in the order in which they are completed, with the list that
+// holds them and their index in it. json_patch.dart replaces them with maps
+// in that order, so that the key/value list of an object is only read once
+// the objects among its values have been replaced.
+//
+// Numbers, strings and literals that end at the end of a chunk which is not
+// the last one are left unparsed; their characters are kept in the state and
+// parsed together with the next chunk.
+template<typename CharType>
+class JsonDecoder : public ValueObject {
+ public:
+  JsonDecoder(Isolate* isolate,
+              const Array& state,
+              const CharType* chars,
+              intptr_t length,
+              bool is_utf8,
+              bool is_last)
+      : isolate_(isolate),
+        state_array_(state),
+        chars_(chars),
+        length_(length),
+        is_utf8_(is_utf8),
+        is_last_(is_last),
+        position_(Smi::Value(
+            reinterpret_cast<RawSmi*>(state.At(kPositionSlot)))),
+        state_(Smi::Value(reinterpret_cast<RawSmi*>(state.At(kStateSlot)))),
+        stack_(GrowableObjectArray::Handle(isolate)),
+        objects_(GrowableObjectArray::Handle(isolate)),
+        keys_(Array::Handle(isolate)),
+        container_(GrowableObjectArray::Handle(isolate)),
+        value_(Object::Handle(isolate)),
+        string_(String::Handle(isolate)) {
+    stack_ ^= state.At(kStackSlot);
+    objects_ ^= state.At(kObjectsSlot);
+    keys_ ^= state.At(kKeysSlot);
+    if (stack_.Length() > 0) {
+      container_ ^= stack_.At(stack_.Length() - 1);
+    }
+  }
+
+  // Parses the characters and returns the number of characters parsed.
+  intptr_t Decode();
+
+ private:
+  // State building blocks, see the JsonParser of dart:json.
+  static const intptr_t kInsideArray = 1;
+  static const intptr_t kInsideObject = 2;
+  static const intptr_t kAfterColon = 3;
+  static const intptr_t kAllowStringMask = 8;
+  static const intptr_t kAllowValueMask = 4;
+  static const intptr_t kAllowValue = 0;
+  static const intptr_t kStringOnly = 4;
+  static const intptr_t kNoValues = 12;
+  static const intptr_t kEmpty = 0;
+  static const intptr_t kNonEmpty = 16;
+  static const intptr_t kValueReadBits = kNoValues | kNonEmpty;
+
+  static const intptr_t kStateInitial = kEmpty | kAllowValue;
+  static const intptr_t kStateEnd = kNonEmpty | kNoValues;
+  static const intptr_t kStateArrayEmpty = kInsideArray | kEmpty | kAllowValue;
+  static const intptr_t kStateArrayValue =
+      kInsideArray | kNonEmpty | kNoValues;
+  static const intptr_t kStateArrayComma =
+      kInsideArray | kNonEmpty | kAllowValue;
+  static const intptr_t kStateObjectEmpty =
+      kInsideObject | kEmpty | kStringOnly;
+  static const intptr_t kStateObjectKey = kInsideObject | kNonEmpty | kNoValues;
+  static const intptr_t kStateObjectColon =
+      kAfterColon | kNonEmpty | kAllowValue;
+  static const intptr_t kStateObjectValue =
+      kAfterColon | kNonEmpty | kNoValues;
+  static const intptr_t kStateObjectComma =
+      kInsideObject | kNonEmpty | kStringOnly;
+
+  // Integers with at most this many digits fit into an int64_t.
+  static const intptr_t kMaxInt64Digits = 18;
+
+  // Only ASCII property names up to this length are looked up in the keys.
+  static const intptr_t kMaxCachedKeyLength = 32;
+
+  // The parse functions return the position after the token they parsed,
+  // or kIncomplete if the token may continue in the next chunk.
+  static const intptr_t kIncomplete = -1;
+
+  intptr_t ParseLiteral(intptr_t pos, const char* literal, const Object& value);
+  intptr_t ParseNumber(intptr_t pos);
+  intptr_t ParseString(intptr_t pos);
+  intptr_t ParseEscapedString(intptr_t pos, intptr_t end);
+
+  void CreateString(intptr_t start, intptr_t end, bool is_ascii);
+  void AddValue(const Object& value);
+  void BeginContainer(intptr_t state);
+  void EndContainer(bool is_object);
+  void SaveState();
+  void Fail(intptr_t pos);
+
+  bool IsDigit(intptr_t pos) const {
+    return (pos < length_) && ('0' <= chars_[pos]) && (chars_[pos] <= '9');
+  }
+
+  Isolate* isolate_;
+  const Array& state_array_;
+  const CharType* chars_;
+  const intptr_t length_;
+  const bool is_utf8_;
+  const bool is_last_;
+  const intptr_t position_;
+  intptr_t state_;
+  GrowableObjectArray& stack_;
+  GrowableObjectArray& objects_;
+  Array& keys_;
+  GrowableObjectArray& container_;
+  Object& value_;
+  String& string_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonDecoder);
+};
+
+
+template<typename CharType>
+intptr_t JsonDecoder<CharType>::Decode() {
+  intptr_t pos = 0;
+  while (pos < length_) {
+    intptr_t end = pos + 1;
+    switch (chars_[pos]) {
+      case ' ':
+      case '\r':
+      case '\n':
+      case '\t':
+        break;
+      case '"':
+        if ((state_ & kAllowStringMask) != 0) Fail(pos);
+        end = ParseString(pos);
+        break;
+      case '[':
+        if ((state_ & kAllowValueMask) != 0) Fail(pos);
+        BeginContainer(kStateArrayEmpty);
+        break;
+      case '{':
+        if ((state_ & kAllowValueMask) != 0) Fail(pos);
+        BeginContainer(kStateObjectEmpty);
+        break;
+      case 'n':
+        if ((state_ & kAllowValueMask) != 0) Fail(pos);
+        value_ = Object::null();
+        end = ParseLiteral(pos, "null", value_);
+        break;
+      case 'f':
+        if ((state_ & kAllowValueMask) != 0) Fail(pos);
+        end = ParseLiteral(pos, "false", Bool::False());
+        break;
+      case 't':
+        if ((state_ & kAllowValueMask) != 0) Fail(pos);
+        end = ParseLiteral(pos, "true", Bool::True());
+        break;
+      case ':':
+        if (state_ != kStateObjectKey) Fail(pos);
+        state_ = kStateObjectColon;
+        break;
+      case ',':
+        if (state_ == kStateObjectValue) {
+          state_ = kStateObjectComma;
+        } else if (state_ == kStateArrayValue) {
+          state_ = kStateArrayComma;
+        } else {
+          Fail(pos);
+        }
+        break;
+      case ']':
+        if ((state_ != kStateArrayEmpty) && (state_ != kStateArrayValue)) {
+          Fail(pos);
+        }
+        EndContainer(false);
+        break;
+      case '}':
+        if ((state_ != kStateObjectEmpty) && (state_ != kStateObjectValue)) {
+          Fail(pos);
+        }
+        EndContainer(true);
+        break;
+      default:
+        if ((state_ & kAllowValueMask) != 0) Fail(pos);
+        end = ParseNumber(pos);
+        break;
+    }
+    if (end == kIncomplete) {
+      break;
+    }
+    pos = end;
+  }
+  if (is_last_ && (state_ != kStateEnd)) {
+    Fail(pos);
+  }
+  SaveState();
+  return pos;
+}
+
+
+template<typename CharType>
+intptr_t JsonDecoder<CharType>::ParseLiteral(intptr_t pos,
+                                             const char* literal,
+                                             const Object& value) {
+  intptr_t i = 0;
+  for (; literal[i] != '\0'; i++) {
+    if (pos + i == length_) {
+      if (is_last_) Fail(pos);
+      return kIncomplete;
+    }
+    if (chars_[pos + i] != literal[i]) Fail(pos);
+  }
+  AddValue(value);
+  state_ |= kValueReadBits;
+  return pos + i;
+}
+
+
+// Format: '-'?('0'|[1-9][0-9]*)('.'[0-9]+)?([eE][+-]?[0-9]+)?
+template<typename CharType>
+intptr_t JsonDecoder<CharType>::ParseNumber(intptr_t pos) {
+  intptr_t end = pos;
+  bool is_negative = false;
+  bool is_double = false;
+  if (chars_[end] == '-') {
+    is_negative = true;
+    end++;
+  }
+  if (!IsDigit(end)) {
+    if (end == length_ && !is_last_) return kIncomplete;
+    Fail(end);
+  }
+  int64_t value = 0;
+  intptr_t digits_start = end;
+  if (chars_[end] == '0') {
+    end++;
+    if (IsDigit(end)) Fail(end);
+  } else {
+    while (IsDigit(end)) {
+      value = value * 10 + (chars_[end] - '0');
+      end++;
+      if ((end - digits_start) > kMaxInt64Digits) {
+        // Large integers are converted from their digits below.
+        value = 0;
+        while (IsDigit(end)) end++;
+        break;
+      }
+    }
+  }
+  const bool fits_int64 = (end - digits_start) <= kMaxInt64Digits;
+  if ((end < length_) && (chars_[end] == '.')) {
+    is_double = true;
+    end++;
+    if (!IsDigit(end)) {
+      if (end == length_ && !is_last_) return kIncomplete;
+      Fail(end);
+    }
+    while (IsDigit(end)) end++;
+  }
+  if ((end < length_) && ((chars_[end] == 'e') || (chars_[end] == 'E'))) {
+    is_double = true;
+    end++;
+    if ((end < length_) && ((chars_[end] == '+') || (chars_[end] == '-'))) {
+      end++;
+    }
+    if (!IsDigit(end)) {
+      if (end == length_ && !is_last_) return kIncomplete;
+      Fail(end);
+    }
+    while (IsDigit(end)) end++;
+  }
+  if ((end == length_) && !is_last_) {
+    // More digits may follow in the next chunk.
+    return kIncomplete;
+  }
+  if (!is_double && fits_int64) {
+    value_ = Integer::New(is_negative ? -value : value);
+  } else {
+    const intptr_t len = end - pos;
+    char* buffer = isolate_->current_zone()->Alloc<char>(len + 1);
+    for (intptr_t i = 0; i < len; i++) {
+      buffer[i] = static_cast<char>(chars_[pos + i]);
+    }
+    buffer[len] = '\0';
+    if (is_double) {
+      double d = 0.0;
+      if (!CStringToDouble(buffer, len, &d)) Fail(pos);
+      value_ = Double::New(d);
+    } else {
+      string_ = String::New(buffer);
+      value_ = Integer::New(string_);
+    }
+  }
+  AddValue(value_);
+  state_ |= kValueReadBits;
+  return end;
+}
+
+
+// Format: '"'([^\x00-\x1f\\\"]|'\\'[bfnrt/\\"]|'\\u'[0-9a-fA-F]{4})*'"'
+template<typename CharType>
+intptr_t JsonDecoder<CharType>::ParseString(intptr_t pos) {
+  intptr_t end = pos + 1;
+  bool is_ascii = true;
+  while (end < length_) {
+    const CharType c = chars_[end];
+    if (c == '"') {
+      CreateString(pos + 1, end, is_ascii);
+      return end + 1;
+    }
+    if (c == '\\') {
+      // Find the end of the string before decoding its escapes.
+      intptr_t i = end;
+      while (i < length_) {
+        if (chars_[i] == '"') {
+          return ParseEscapedString(pos, i);
+        }
+        i += (chars_[i] == '\\') ? 2 : 1;
+      }
+      break;
+    }
+    if (c < ' ') Fail(end);
+    is_ascii = is_ascii && (c < 0x80);
+    end++;
+  }
+  if (is_last_) Fail(pos);
+  return kIncomplete;
+}
+
+
+template<typename CharType>
+intptr_t JsonDecoder<CharType>::ParseEscapedString(intptr_t pos,
+                                                   intptr_t end) {
+  // Every character, escape sequence or UTF-8 sequence decodes to at most
+  // as many UTF-16 code units as it is long.
+  uint16_t* buffer = isolate_->current_zone()->Alloc<uint16_t>(end - pos);
+  intptr_t len = 0;
+  intptr_t i = pos + 1;
+  while (i < end) {
+    int32_t c = chars_[i];
+    if (c < ' ') Fail(i);
+    if (c == '\\') {
+      i++;
+      switch (chars_[i]) {
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        case '/': c = '/'; break;
+        case '\\': c = '\\'; break;
+        case '"': c = '"'; break;
+        case 'u':
+          if (i + 4 >= end) Fail(i - 1);
+          c = 0;
+          for (intptr_t j = 1; j <= 4; j++) {
+            const int32_t digit = chars_[i + j];
+            if (('0' <= digit) && (digit <= '9')) {
+              c = c * 16 + (digit - '0');
+            } else if (('a' <= (digit | 0x20)) && ((digit | 0x20) <= 'f')) {
+              c = c * 16 + ((digit | 0x20) - 'a' + 10);
+            } else {
+              Fail(i - 1);
+            }
+          }
+          i += 4;
+          break;
+        default:
+          Fail(i);
+      }
+      i++;
+    } else if (is_utf8_ && (c >= 0x80)) {
+      const intptr_t consumed = Utf8::Decode(
+          reinterpret_cast<const uint8_t*>(&chars_[i]), end - i, &c);
+      if (c < 0) Fail(i);
+      i += consumed;
+      if (Utf16::Length(c) == 2) {
+        Utf16::Encode(c, &buffer[len]);
+        len += 2;
+        continue;
+      }
+    } else {
+      i++;
+    }
+    buffer[len++] = c;
+  }
+  string_ = String::FromUTF16(buffer, len);
+  AddValue(string_);
+  state_ |= kValueReadBits;
+  return end + 1;
+}
+
+
+template<typename CharType>
+void JsonDecoder<CharType>::CreateString(intptr_t start,
+                                         intptr_t end,
+                                         bool is_ascii) {
+  const CharType* chars = &chars_[start];
+  const intptr_t len = end - start;
+  // Property names tend to repeat, e.g. in a list of records: look them up
+  // in the names read before instead of allocating a string for each.
+  const bool is_key =
+      ((state_ & kAfterColon) == kInsideObject) && is_ascii &&
+      (len <= kMaxCachedKeyLength);
+  intptr_t key_index = 0;
+  if (is_key) {
+    key_index = String::Hash(chars, len) & (keys_.Length() - 1);
+    string_ ^= keys_.At(key_index);
+    if (!string_.IsNull() && string_.Equals(chars, len)) {
+      AddValue(string_);
+      state_ |= kValueReadBits;
+      return;
+    }
+  }
+  if (sizeof(CharType) == 2) {
+    string_ = String::FromUTF16(reinterpret_cast<const uint16_t*>(chars), len);
+  } else if (!is_utf8_ || is_ascii) {
+    string_ = OneByteString::New(reinterpret_cast<const uint8_t*>(chars),
+                                 len,
+                                 Heap::kNew);
+  } else {
+    const uint8_t* utf8 = reinterpret_cast<const uint8_t*>(chars);
+    if (!Utf8::IsValid(utf8, len)) Fail(start - 1);
+    string_ = String::FromUTF8(utf8, len);
+  }
+  if (is_key) {
+    keys_.SetAt(key_index, string_);
+  }
+  AddValue(string_);
+  state_ |= kValueReadBits;
+}
+
+
+template<typename CharType>
+void JsonDecoder<CharType>::AddValue(const Object& value) {
+  if (container_.IsNull()) {
+    state_array_.SetAt(kResultSlot, value);
+  } else {
+    container_.Add(value);
+  }
+}
+
+
+template<typename CharType>
+void JsonDecoder<CharType>::BeginContainer(intptr_t state) {
+  const GrowableObjectArray& container =
+      GrowableObjectArray::Handle(isolate_, GrowableObjectArray::New());
+  AddValue(container);
+  stack_.Add(Smi::Handle(isolate_, Smi::New(state_)));
+  stack_.Add(container);
+  container_ = container.raw();
+  state_ = state;
+}
+
+
+template<typename CharType>
+void JsonDecoder<CharType>::EndContainer(bool is_object) {
+  const intptr_t depth = stack_.Length();
+  if (is_object) {
+    // The object is the last value of the container holding it.
+    value_ = (depth > 2) ? stack_.At(depth - 3) : Object::null();
+    objects_.Add(value_);
+    if (value_.IsNull()) {
+      value_ = Smi::New(0);
+    } else {
+      value_ = Smi::New(GrowableObjectArray::Cast(value_).Length() - 1);
+    }
+    objects_.Add(value_);
+    objects_.Add(container_);
+  }
+  stack_.RemoveLast();
+  value_ = stack_.RemoveLast();
+  state_ = Smi::Cast(value_).Value() | kValueReadBits;
+  if (depth > 2) {
+    container_ ^= stack_.At(depth - 3);
+  } else {
+    container_ = GrowableObjectArray::null();
+  }
+}
+
+
+template<typename CharType>
+void JsonDecoder<CharType>::SaveState() {
+  state_array_.SetAt(kStateSlot, Smi::Handle(isolate_, Smi::New(state_)));
+}
+
+
+template<typename CharType>
+void JsonDecoder<CharType>::Fail(intptr_t pos) {
+  // Same message as the JsonParser of dart:json.
+  const intptr_t kSliceLength = 20;
+  intptr_t end = pos + kSliceLength;
+  const bool is_cut = end < length_;
+  if (!is_cut) {
+    end = length_;
+  }
+  if (is_utf8_) {
+    // Do not cut a UTF-8 sequence.
+    while ((end > pos) && (end < length_) &&
+           ((chars_[end] & 0xC0) == 0x80)) {
+      end--;
+    }
+    const uint8_t* utf8 = reinterpret_cast<const uint8_t*>(&chars_[pos]);
+    if (Utf8::IsValid(utf8, end - pos)) {
+      string_ = String::FromUTF8(utf8, end - pos);
+    } else {
+      string_ = Symbols::Empty().raw();
+    }
+  } else if (sizeof(CharType) == 2) {
+    string_ = String::FromUTF16(
+        reinterpret_cast<const uint16_t*>(&chars_[pos]), end - pos);
+  } else {
+    string_ = OneByteString::New(reinterpret_cast<const uint8_t*>(&chars_[pos]),
+                                 end - pos,
+                                 Heap::kNew);
+  }
+  const String& message = String::Handle(isolate_, String::NewFormatted(
+      "Unexpected character at %" Pd ": '%s%s'",
+      position_ + pos, string_.ToCString(), is_cut ? "..." : ""));
+  const Array& args = Array::Handle(isolate_, Array::New(1));
+  args.SetAt(0, message);
+  Exceptions::ThrowByType(Exceptions::kFormat, args);
+}
+
+
+static bool IsOneByte(const Object& str) {
+  return str.IsNull() ||
+      String::Cast(str).IsOneByteString() ||
+      String::Cast(str).IsExternalOneByteString();
+}
+
+
+template<typename CharType>
+static void DecodeChunk(Isolate* isolate,
+                        const Array& state,
+                        CharType* chars,
+                        intptr_t length,
+                        bool is_utf8,
+                        bool is_last) {
+  JsonDecoder<CharType> decoder(
+      isolate, state, chars, length, is_utf8, is_last);
+  const intptr_t parsed = decoder.Decode();
+  if (parsed == length) {
+    state.SetAt(kPendingSlot, Object::Handle(isolate));
+  } else if (sizeof(CharType) == 2) {
+    state.SetAt(kPendingSlot, String::Handle(isolate, TwoByteString::New(
+        reinterpret_cast<uint16_t*>(&chars[parsed]),
+        length - parsed,
+        Heap::kNew)));
+  } else {
+    // The pending bytes of UTF-8 input are also kept in a one byte string.
+    state.SetAt(kPendingSlot, String::Handle(isolate, OneByteString::New(
+        reinterpret_cast<uint8_t*>(&chars[parsed]),
+        length - parsed,
+        Heap::kNew)));
+  }
+  const intptr_t position =
+      Smi::Value(reinterpret_cast<RawSmi*>(state.At(kPositionSlot)));
+  state.SetAt(kPositionSlot, Smi::Handle(isolate, Smi::New(position + parsed)));
+}
+
+
+// Arg0: the state array of a _JsonDecoder.
+// Arg1: the chunk, a String, a list of bytes or null.
+// Arg2: whether the chunk is UTF-8 encoded.
+// Arg3: whether this is the last chunk.
+// Returns false if the chunk is UTF-8 encoded but not a typed data list of
+// bytes.
+DEFINE_NATIVE_ENTRY(JsonDecoder_decode, 4) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Array, state, arguments->NativeArgAt(0));
+  GET_NATIVE_ARGUMENT(Instance, chunk, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Bool, is_utf8, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Bool, is_last, arguments->NativeArgAt(3));
+  ASSERT(state.Length() == kNumSlots);
+
+  if (state.At(kStateSlot) == Object::null()) {
+    // 256 keys are enough to hold the property names of typical records.
+    const intptr_t kNumKeys = 256;
+    state.SetAt(kStackSlot,
+                GrowableObjectArray::Handle(GrowableObjectArray::New()));
+    state.SetAt(kStateSlot, Smi::Handle(Smi::New(0)));
+    state.SetAt(kPositionSlot, Smi::Handle(Smi::New(0)));
+    state.SetAt(kObjectsSlot,
+                GrowableObjectArray::Handle(GrowableObjectArray::New()));
+    state.SetAt(kKeysSlot, Array::Handle(Array::New(kNumKeys)));
+  }
+
+  const Object& pending = Object::Handle(state.At(kPendingSlot));
+  const intptr_t pending_length =
+      pending.IsNull() ? 0 : String::Cast(pending).Length();
+  Zone* zone = isolate->current_zone();
+
+  if (is_utf8.value()) {
+    intptr_t chunk_length = 0;
+    if (chunk.IsTypedData()) {
+      if (TypedData::Cast(chunk).ElementSizeInBytes() != 1) {
+        return Bool::False().raw();
+      }
+      chunk_length = TypedData::Cast(chunk).LengthInBytes();
+    } else if (chunk.IsExternalTypedData()) {
+      if (ExternalTypedData::Cast(chunk).ElementSizeInBytes() != 1) {
+        return Bool::False().raw();
+      }
+      chunk_length = ExternalTypedData::Cast(chunk).LengthInBytes();
+    } else if (!chunk.IsNull()) {
+      return Bool::False().raw();
+    }
+    uint8_t* chars = zone->Alloc<uint8_t>(pending_length + chunk_length);
+    if (pending_length > 0) {
+      String::Cast(pending).ToLatin1(chars, pending_length);
+    }
+    if (chunk_length > 0) {
+      NoGCScope no_gc;
+      const void* data = chunk.IsTypedData() ?
+          TypedData::Cast(chunk).DataAddr(0) :
+          ExternalTypedData::Cast(chunk).DataAddr(0);
+      memmove(&chars[pending_length], data, chunk_length);
+    }
+    DecodeChunk(isolate, state, chars, pending_length + chunk_length,
+                true, is_last.value());
+    return Bool::True().raw();
+  }
+
+  String& str = String::Handle();
+  if (!chunk.IsNull()) {
+    if (!chunk.IsString()) {
+      const Array& args = Array::Handle(Array::New(1));
+      args.SetAt(0, chunk);
+      Exceptions::ThrowByType(Exceptions::kArgument, args);
+    }
+    str ^= chunk.raw();
+  }
+  const intptr_t chunk_length = str.IsNull() ? 0 : str.Length();
+  const intptr_t length = pending_length + chunk_length;
+  if (IsOneByte(pending) && IsOneByte(str)) {
+    uint8_t* chars = zone->Alloc<uint8_t>(length);
+    if (pending_length > 0) {
+      String::Cast(pending).ToLatin1(chars, pending_length);
+    }
+    if (chunk_length > 0) {
+      str.ToLatin1(&chars[pending_length], chunk_length);
+    }
+    DecodeChunk(isolate, state, chars, length, false, is_last.value());
+  } else {
+    uint16_t* chars = zone->Alloc<uint16_t>(length);
+    if (pending_length > 0) {
+      String::Cast(pending).ToUTF16(chars, pending_length);
+    }
+    if (chunk_length > 0) {
+      str.ToUTF16(&chars[pending_length], chunk_length);
+    }
+    DecodeChunk(isolate, state, chars, length, false, is_last.value());
+  }
+  return Bool::True().raw();
+}
+
+}  // namespace dart
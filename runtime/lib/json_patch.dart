@@ -2,8 +2,119 @@
 // for details. All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 
+import "dart:typeddata";
+
 // JSON parsing and serialization.
 
 patch parse(String json, [reviver(var key, var value)]) {
-  return _parse(json, reviver);
+  if (json is! String) throw new ArgumentError(json);
+  var decoder = new _JsonDecoder(reviver);
+  _JsonDecoder._decode(decoder._state, json, false, true);
+  return decoder._result();
+}
+
+patch _newChunkedParser(reviver(var key, var value)) {
+  return new _JsonDecoder(reviver);
+}
+
+patch void _addChunk(parser, String chunk) {
+  parser.add(chunk);
+}
+
+patch void _addBytes(parser, List<int> bytes) {
+  parser.addBytes(bytes);
+}
+
+patch _closeChunked(parser) {
+  return parser.close();
+}
+
+
+// Decodes JSON text with the native decoder of json.cc, which builds the
+// lists and the values of the text and leaves the objects as lists of their
+// keys and values, to be replaced with maps here.
+class _JsonDecoder {
+  // Slots of the state of the native decoder, see json.cc.
+  static const int _RESULT = 0;
+  static const int _OBJECTS = 5;
+  static const int _STATE_LENGTH = 7;
+
+  final List _state = new List(_STATE_LENGTH);
+  final _reviver;
+  bool _isUtf8;
+  bool _isClosed = false;
+
+  _JsonDecoder(this._reviver);
+
+  void add(String chunk) {
+    if (chunk is! String) throw new ArgumentError(chunk);
+    _checkInput(false);
+    _decode(_state, chunk, false, false);
+  }
+
+  void addBytes(List<int> bytes) {
+    _checkInput(true);
+    if (!_decode(_state, bytes, true, false)) {
+      _decode(_state, new Uint8List.fromList(bytes), true, false);
+    }
+  }
+
+  close() {
+    _checkInput(_isUtf8 == true);
+    _isClosed = true;
+    _decode(_state, null, _isUtf8, true);
+    return _result();
+  }
+
+  void _checkInput(bool isUtf8) {
+    if (_isClosed) throw new StateError("JSON parser is closed");
+    if (_isUtf8 == null) {
+      _isUtf8 = isUtf8;
+    } else if (_isUtf8 != isUtf8) {
+      throw new StateError("JSON parser cannot mix strings and bytes");
+    }
+  }
+
+  // Replaces the key/value lists of the objects with maps, innermost
+  // objects first, and applies the reviver.
+  _result() {
+    var result = _state[_RESULT];
+    List objects = _state[_OBJECTS];
+    for (int i = 0; i < objects.length; i += 3) {
+      List keyValues = objects[i + 2];
+      var map = {};
+      for (int j = 0; j < keyValues.length; j += 2) {
+        map[keyValues[j]] = keyValues[j + 1];
+      }
+      List holder = objects[i];
+      if (holder == null) {
+        result = map;
+      } else {
+        holder[objects[i + 1]] = map;
+      }
+    }
+    if (_reviver == null) return result;
+    return _reviver("", _revive(result));
+  }
+
+  // Applies the reviver to the elements and properties of [value], in the
+  // order in which the JsonParser of dart:json reports them.
+  _revive(value) {
+    if (value is List) {
+      for (int i = 0; i < value.length; i++) {
+        value[i] = _reviver(i, _revive(value[i]));
+      }
+    } else if (value is Map) {
+      for (var key in value.keys.toList()) {
+        value[key] = _reviver(key, _revive(value[key]));
+      }
+    }
+    return value;
+  }
+
+  // Decodes [chunk] and keeps the characters of its last token if it may
+  // continue in the next chunk. Returns false if [chunk] is a list of bytes
+  // that the native decoder cannot read directly.
+  static bool _decode(List state, chunk, bool isUtf8, bool isLast)
+      native "JsonDecoder_decode";
 }
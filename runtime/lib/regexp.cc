@@ -5,13 +5,18 @@
 #include "platform/assert.h"
 #include "vm/bootstrap_natives.h"
 #include "vm/exceptions.h"
+#include "vm/flags.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
 
+#include "lib/regexp_automaton.h"
 #include "lib/regexp_jsc.h"
 
 namespace dart {
 
+DEFINE_FLAG(bool, use_regexp_automaton, true,
+    "Match regular expressions without backreferences with an automaton.");
+
 DEFINE_NATIVE_ENTRY(JSSyntaxRegExp_factory, 4) {
   ASSERT(AbstractTypeArguments::CheckedHandle(
       arguments->NativeArgAt(0)).IsNull());
@@ -22,6 +27,13 @@ DEFINE_NATIVE_ENTRY(JSSyntaxRegExp_factory, 4) {
       Instance, handle_case_sensitive, arguments->NativeArgAt(3));
   bool ignore_case = handle_case_sensitive.raw() != Bool::True().raw();
   bool multi_line = handle_multi_line.raw() == Bool::True().raw();
+  if (FLAG_use_regexp_automaton) {
+    const JSRegExp& regexp = JSRegExp::Handle(
+        RegExpAutomaton::Compile(pattern, multi_line, ignore_case));
+    if (!regexp.IsNull()) {
+      return regexp.raw();
+    }
+  }
   return Jscre::Compile(pattern, multi_line, ignore_case);
 }
 
@@ -69,6 +81,9 @@ DEFINE_NATIVE_ENTRY(JSSyntaxRegExp_ExecuteMatch, 3) {
   ASSERT(!regexp.IsNull());
   GET_NON_NULL_NATIVE_ARGUMENT(String, str, arguments->NativeArgAt(1));
   GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_index, arguments->NativeArgAt(2));
+  if (regexp.is_automaton()) {
+    return RegExpAutomaton::Execute(regexp, str, start_index.Value());
+  }
   return Jscre::Execute(regexp, str, start_index.Value());
 }
 
@@ -0,0 +1,1280 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "lib/regexp_automaton.h"
+
+#include "platform/assert.h"
+#include "platform/utils.h"
+#include "vm/growable_array.h"
+#include "vm/isolate.h"
+#include "vm/zone.h"
+
+namespace dart {
+
+// Counted repetitions are expanded, so the size of a program is bounded to
+// leave patterns like /(a{1000}){1000}/ to jscre.
+static const intptr_t kMaxInstructions = 4096;
+static const intptr_t kMaxRepetitions = 1000;
+
+// Bound of the number of instructions times the number of capture slots,
+// which is the size of the thread lists used for matching.
+static const intptr_t kMaxThreadListSize = 256 * KB;
+
+static const int32_t kMaxCodeUnit = 0xFFFF;
+static const int32_t kNoChar = -1;
+
+enum Opcode {
+  kChar,  // Matches the code unit 'x'.
+  kClass,  // Matches the code units of the 'y' ranges starting at range 'x'.
+  kSplit,  // Continues at 'x' and, with lower priority, at 'y'.
+  kJump,  // Continues at 'x'.
+  kSave,  // Records the position in capture slot 'x'.
+  kBeginInput,
+  kEndInput,
+  kBeginLine,
+  kEndLine,
+  kWordBoundary,
+  kNotWordBoundary,
+  kMatch,
+};
+
+
+struct Instruction {
+  int32_t opcode;
+  int32_t x;
+  int32_t y;
+};
+
+
+struct CharRange {
+  int32_t from;
+  int32_t to;  // Inclusive.
+};
+
+
+// The compiled program is stored in the data of its JSRegExp object. The
+// header is followed by the instructions and by the ranges of the classes.
+struct ProgramHeader {
+  int32_t num_instructions;
+  int32_t num_ranges;
+  int32_t num_groups;  // Not counting the whole match.
+  int32_t first_char;  // Code unit that starts every match, or kNoChar.
+};
+
+
+static const CharRange kDigitRanges[] = {
+  { '0', '9' },
+};
+
+static const CharRange kWordRanges[] = {
+  { '0', '9' }, { 'A', 'Z' }, { '_', '_' }, { 'a', 'z' },
+};
+
+// Like jscre, \s only matches ASCII white space.
+static const CharRange kSpaceRanges[] = {
+  { 0x09, 0x0D }, { 0x20, 0x20 },
+};
+
+static const CharRange kLineTerminatorRanges[] = {
+  { 0x0A, 0x0A }, { 0x0D, 0x0D }, { 0x2028, 0x2029 },
+};
+
+
+static bool IsLineTerminator(int32_t c) {
+  return (c == 0x0A) || (c == 0x0D) || (c == 0x2028) || (c == 0x2029);
+}
+
+
+static bool IsWordChar(int32_t c) {
+  return ((c >= 'a') && (c <= 'z')) ||
+         ((c >= 'A') && (c <= 'Z')) ||
+         ((c >= '0') && (c <= '9')) ||
+         (c == '_');
+}
+
+
+static bool IsDecimalDigit(int32_t c) {
+  return (c >= '0') && (c <= '9');
+}
+
+
+static int32_t HexDigitValue(int32_t c) {
+  if ((c >= '0') && (c <= '9')) return c - '0';
+  if ((c >= 'a') && (c <= 'f')) return c - 'a' + 10;
+  if ((c >= 'A') && (c <= 'F')) return c - 'A' + 10;
+  return -1;
+}
+
+
+static int CompareRanges(const CharRange* a, const CharRange* b) {
+  return a->from - b->from;
+}
+
+
+// Parses a pattern into a tree of nodes and compiles the tree to the
+// instructions of the automaton. Parsing stops at the first construct that
+// the automaton does not support; jscre then compiles the pattern and
+// reports its syntax errors, so only valid patterns need to be recognized.
+class PatternCompiler : public ValueObject {
+ public:
+  PatternCompiler(const uint16_t* pattern,
+                  intptr_t length,
+                  bool multi_line,
+                  bool ignore_case)
+      : pattern_(pattern),
+        length_(length),
+        position_(0),
+        multi_line_(multi_line),
+        ignore_case_(ignore_case),
+        supported_(true),
+        num_groups_(0),
+        nodes_(),
+        ranges_(),
+        class_ranges_(),
+        instructions_() {}
+
+  // Returns false if the pattern is not supported.
+  bool Compile();
+
+  intptr_t num_groups() const { return num_groups_; }
+
+  intptr_t ProgramSize() const {
+    return sizeof(ProgramHeader) +
+        (instructions_.length() * sizeof(Instruction)) +
+        (ranges_.length() * sizeof(CharRange));
+  }
+
+  void WriteProgram(void* data) const;
+
+ private:
+  static const intptr_t kNoNode = -1;
+
+  struct Node {
+    enum Kind {
+      kEmpty,
+      kCharacters,
+      kAssertion,
+      kGroup,
+      kConcatenation,
+      kAlternation,
+      kRepetition,
+    };
+
+    Kind kind;
+    intptr_t left;  // Body of groups and repetitions.
+    intptr_t right;
+    intptr_t first_range;
+    intptr_t num_ranges;
+    intptr_t opcode;  // Of assertions.
+    intptr_t group;
+    intptr_t min;
+    intptr_t max;  // -1 if unbounded.
+    bool greedy;
+    bool parenthesized;  // Of repetitions, if the body is in parentheses.
+    bool negated_char;  // Of classes, if jscre reads them as [^c], c < 0x80.
+  };
+
+  // The result of parsing an escape.
+  enum EscapeKind {
+    kEscapeChar,
+    kEscapeClass,
+    kEscapeUnsupported,
+  };
+
+  bool AtEnd() const { return position_ >= length_; }
+  int32_t Peek() const { return AtEnd() ? kNoChar : pattern_[position_]; }
+  int32_t PeekAt(intptr_t offset) const {
+    return (position_ + offset < length_) ?
+        pattern_[position_ + offset] : kNoChar;
+  }
+  int32_t Next() { return pattern_[position_++]; }
+
+  intptr_t Unsupported() {
+    supported_ = false;
+    return kNoNode;
+  }
+
+  intptr_t NewNode(Node::Kind kind, intptr_t left, intptr_t right);
+  intptr_t NewCharNode(int32_t c);
+  intptr_t NewClassNode(bool negated);
+
+  intptr_t ParseDisjunction();
+  intptr_t ParseAlternative();
+  intptr_t ParseTerm();
+  intptr_t ParseAtom();
+  intptr_t ParseClass();
+  intptr_t ParseQuantifier(intptr_t atom, bool parenthesized);
+  bool ParseDecimal(intptr_t* value);
+  EscapeKind ParseEscape(bool in_class, int32_t* c);
+  bool ParseHex(intptr_t digits, int32_t* c);
+
+  bool IsNullable(intptr_t node) const;
+  bool HasLazyGroupRepetition(intptr_t node) const;
+
+  // Class ranges are collected in 'class_ranges_' before they are added to
+  // the program.
+  void AddClassRanges(const CharRange* ranges, intptr_t count, bool negated);
+  void AddClassRange(int32_t from, int32_t to);
+  void NormalizeClassRanges();
+  void AddOtherCaseRanges();
+  void NegateClassRanges();
+
+  intptr_t Emit(Opcode opcode, int32_t x, int32_t y);
+  void EmitNode(intptr_t node);
+  void EmitRepetition(const Node& node);
+
+  const uint16_t* pattern_;
+  const intptr_t length_;
+  intptr_t position_;
+  const bool multi_line_;
+  const bool ignore_case_;
+  bool supported_;
+  intptr_t num_groups_;
+  GrowableArray<Node> nodes_;
+  GrowableArray<CharRange> ranges_;
+  GrowableArray<CharRange> class_ranges_;
+  GrowableArray<Instruction> instructions_;
+
+  DISALLOW_COPY_AND_ASSIGN(PatternCompiler);
+};
+
+
+intptr_t PatternCompiler::NewNode(Node::Kind kind,
+                                  intptr_t left,
+                                  intptr_t right) {
+  Node node;
+  node.kind = kind;
+  node.left = left;
+  node.right = right;
+  node.first_range = 0;
+  node.num_ranges = 0;
+  node.opcode = kMatch;
+  node.group = 0;
+  node.min = 0;
+  node.max = 0;
+  node.greedy = true;
+  node.parenthesized = false;
+  node.negated_char = false;
+  nodes_.Add(node);
+  return nodes_.length() - 1;
+}
+
+
+intptr_t PatternCompiler::NewCharNode(int32_t c) {
+  if (ignore_case_ && (c > 0x7F)) {
+    // Only ASCII letters are folded.
+    return Unsupported();
+  }
+  class_ranges_.Clear();
+  AddClassRange(c, c);
+  return NewClassNode(false);
+}
+
+
+// Adds the ranges collected in 'class_ranges_' to the program.
+intptr_t PatternCompiler::NewClassNode(bool negated) {
+  NormalizeClassRanges();
+  if (ignore_case_) {
+    AddOtherCaseRanges();
+  }
+  if (negated) {
+    NegateClassRanges();
+  }
+  const intptr_t node = NewNode(Node::kCharacters, kNoNode, kNoNode);
+  nodes_[node].first_range = ranges_.length();
+  nodes_[node].num_ranges = class_ranges_.length();
+  ranges_.AddArray(class_ranges_);
+  return node;
+}
+
+
+void PatternCompiler::AddClassRanges(const CharRange* ranges,
+                                     intptr_t count,
+                                     bool negated) {
+  // The ranges are sorted and do not overlap.
+  if (!negated) {
+    for (intptr_t i = 0; i < count; i++) {
+      AddClassRange(ranges[i].from, ranges[i].to);
+    }
+    return;
+  }
+  int32_t from = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    if (ranges[i].from > from) {
+      AddClassRange(from, ranges[i].from - 1);
+    }
+    from = ranges[i].to + 1;
+  }
+  if (from <= kMaxCodeUnit) {
+    AddClassRange(from, kMaxCodeUnit);
+  }
+}
+
+
+void PatternCompiler::AddClassRange(int32_t from, int32_t to) {
+  ASSERT((0 <= from) && (from <= to) && (to <= kMaxCodeUnit));
+  CharRange range;
+  range.from = from;
+  range.to = to;
+  class_ranges_.Add(range);
+}
+
+
+// Sorts the class ranges and merges the ranges that overlap or touch.
+void PatternCompiler::NormalizeClassRanges() {
+  class_ranges_.Sort(CompareRanges);
+  intptr_t merged = 0;
+  for (intptr_t i = 0; i < class_ranges_.length(); i++) {
+    const CharRange& range = class_ranges_[i];
+    if ((merged > 0) && (range.from <= class_ranges_[merged - 1].to + 1)) {
+      class_ranges_[merged - 1].to =
+          Utils::Maximum(class_ranges_[merged - 1].to, range.to);
+    } else {
+      class_ranges_[merged++] = range;
+    }
+  }
+  class_ranges_.TruncateTo(merged);
+}
+
+
+// Adds the other case of the ASCII letters of the class ranges.
+void PatternCompiler::AddOtherCaseRanges() {
+  const intptr_t count = class_ranges_.length();
+  for (intptr_t i = 0; i < count; i++) {
+    const CharRange range = class_ranges_[i];
+    const int32_t upper_from = Utils::Maximum<int32_t>(range.from, 'A');
+    const int32_t upper_to = Utils::Minimum<int32_t>(range.to, 'Z');
+    if (upper_from <= upper_to) {
+      AddClassRange(upper_from + ('a' - 'A'), upper_to + ('a' - 'A'));
+    }
+    const int32_t lower_from = Utils::Maximum<int32_t>(range.from, 'a');
+    const int32_t lower_to = Utils::Minimum<int32_t>(range.to, 'z');
+    if (lower_from <= lower_to) {
+      AddClassRange(lower_from - ('a' - 'A'), lower_to - ('a' - 'A'));
+    }
+  }
+  NormalizeClassRanges();
+}
+
+
+void PatternCompiler::NegateClassRanges() {
+  GrowableArray<CharRange> ranges;
+  ranges.AddArray(class_ranges_);
+  class_ranges_.Clear();
+  AddClassRanges(ranges.data(), ranges.length(), true);
+}
+
+
+bool PatternCompiler::Compile() {
+  const intptr_t root = ParseDisjunction();
+  if (!supported_) {
+    return false;
+  }
+  if (!AtEnd()) {
+    // An unbalanced ')'.
+    return false;
+  }
+  Emit(kSave, 0, 0);
+  EmitNode(root);
+  Emit(kSave, 1, 0);
+  Emit(kMatch, 0, 0);
+  const intptr_t num_slots = 2 * (num_groups_ + 1);
+  if (!supported_ ||
+      (instructions_.length() * num_slots > kMaxThreadListSize)) {
+    return false;
+  }
+  return true;
+}
+
+
+void PatternCompiler::WriteProgram(void* data) const {
+  ProgramHeader* header = reinterpret_cast<ProgramHeader*>(data);
+  header->num_instructions = instructions_.length();
+  header->num_ranges = ranges_.length();
+  header->num_groups = num_groups_;
+  // A match that starts with a character can only start where the
+  // character is, so the matcher can skip to its occurrences.
+  intptr_t pc = 0;
+  while (instructions_[pc].opcode == kSave) {
+    pc++;
+  }
+  header->first_char = (instructions_[pc].opcode == kChar) ?
+      instructions_[pc].x : kNoChar;
+  Instruction* instructions = reinterpret_cast<Instruction*>(header + 1);
+  for (intptr_t i = 0; i < instructions_.length(); i++) {
+    instructions[i] = instructions_[i];
+  }
+  CharRange* ranges =
+      reinterpret_cast<CharRange*>(instructions + instructions_.length());
+  for (intptr_t i = 0; i < ranges_.length(); i++) {
+    ranges[i] = ranges_[i];
+  }
+}
+
+
+intptr_t PatternCompiler::ParseDisjunction() {
+  intptr_t node = ParseAlternative();
+  while (supported_ && (Peek() == '|')) {
+    Next();
+    const intptr_t right = ParseAlternative();
+    node = NewNode(Node::kAlternation, node, right);
+  }
+  return supported_ ? node : kNoNode;
+}
+
+
+intptr_t PatternCompiler::ParseAlternative() {
+  intptr_t node = kNoNode;
+  while (supported_ && !AtEnd() && (Peek() != '|') && (Peek() != ')')) {
+    const intptr_t term = ParseTerm();
+    node = (node == kNoNode) ? term :
+        NewNode(Node::kConcatenation, node, term);
+  }
+  if (!supported_) {
+    return kNoNode;
+  }
+  return (node == kNoNode) ? NewNode(Node::kEmpty, kNoNode, kNoNode) : node;
+}
+
+
+intptr_t PatternCompiler::ParseTerm() {
+  intptr_t opcode = kMatch;
+  if (Peek() == '^') {
+    opcode = multi_line_ ? kBeginLine : kBeginInput;
+    Next();
+  } else if (Peek() == '$') {
+    opcode = multi_line_ ? kEndLine : kEndInput;
+    Next();
+  } else if ((Peek() == '\\') && (PeekAt(1) == 'b')) {
+    opcode = kWordBoundary;
+    position_ += 2;
+  } else if ((Peek() == '\\') && (PeekAt(1) == 'B')) {
+    opcode = kNotWordBoundary;
+    position_ += 2;
+  }
+  if (opcode != kMatch) {
+    const int32_t c = Peek();
+    if ((c == '*') || (c == '+') || (c == '?') || (c == '{')) {
+      // Assertions are not quantified.
+      return Unsupported();
+    }
+    const intptr_t node = NewNode(Node::kAssertion, kNoNode, kNoNode);
+    nodes_[node].opcode = opcode;
+    return node;
+  }
+  const bool parenthesized = (Peek() == '(');
+  const intptr_t atom = ParseAtom();
+  if (!supported_) {
+    return kNoNode;
+  }
+  return ParseQuantifier(atom, parenthesized);
+}
+
+
+intptr_t PatternCompiler::ParseAtom() {
+  const int32_t c = Next();
+  switch (c) {
+    case '.':
+      class_ranges_.Clear();
+      AddClassRanges(kLineTerminatorRanges,
+                     ARRAY_SIZE(kLineTerminatorRanges),
+                     true);
+      return NewClassNode(false);
+    case '(': {
+      intptr_t group = 0;
+      if (Peek() == '?') {
+        if (PeekAt(1) != ':') {
+          // Lookaheads.
+          return Unsupported();
+        }
+        position_ += 2;
+      } else {
+        group = ++num_groups_;
+      }
+      const intptr_t body = ParseDisjunction();
+      if (!supported_ || (Peek() != ')')) {
+        return Unsupported();
+      }
+      Next();
+      if (group == 0) {
+        return body;
+      }
+      const intptr_t node = NewNode(Node::kGroup, body, kNoNode);
+      nodes_[node].group = group;
+      return node;
+    }
+    case '[':
+      return ParseClass();
+    case '\\': {
+      int32_t escaped = kNoChar;
+      class_ranges_.Clear();
+      switch (ParseEscape(false, &escaped)) {
+        case kEscapeChar:
+          return NewCharNode(escaped);
+        case kEscapeClass:
+          return NewClassNode(false);
+        case kEscapeUnsupported:
+          return Unsupported();
+      }
+      UNREACHABLE();
+      return kNoNode;
+    }
+    case '*':
+    case '+':
+    case '?':
+    case '{':
+    case '}':
+    case ']':
+      // Syntax errors, or characters that jscre may read as literals.
+      return Unsupported();
+    default:
+      return NewCharNode(c);
+  }
+}
+
+
+intptr_t PatternCompiler::ParseClass() {
+  bool negated = false;
+  if (Peek() == '^') {
+    negated = true;
+    Next();
+  }
+  if (Peek() == ']') {
+    // The empty class, or a class of all characters.
+    return Unsupported();
+  }
+  class_ranges_.Clear();
+  intptr_t num_chars = 0;
+  int32_t last_char = kNoChar;
+  while (Peek() != ']') {
+    if (AtEnd() || (Peek() == '[')) {
+      return Unsupported();
+    }
+    num_chars++;
+    int32_t from = Next();
+    EscapeKind kind = kEscapeChar;
+    if (from == '\\') {
+      kind = ParseEscape(true, &from);
+      if (kind == kEscapeUnsupported) {
+        return Unsupported();
+      }
+    }
+    if ((Peek() == '-') && (PeekAt(1) != ']') && (PeekAt(1) != kNoChar)) {
+      Next();
+      int32_t to = Next();
+      if ((to == '[') || (kind != kEscapeChar)) {
+        return Unsupported();
+      }
+      if ((to == '\\') && (ParseEscape(true, &to) != kEscapeChar)) {
+        return Unsupported();
+      }
+      if ((to < from) || (ignore_case_ && (to > 0x7F))) {
+        return Unsupported();
+      }
+      AddClassRange(from, to);
+      num_chars++;
+    } else if (kind == kEscapeChar) {
+      if (ignore_case_ && (from > 0x7F)) {
+        return Unsupported();
+      }
+      AddClassRange(from, from);
+      last_char = from;
+    } else {
+      num_chars++;
+    }
+  }
+  Next();
+  const intptr_t node = NewClassNode(negated);
+  nodes_[node].negated_char = negated && (num_chars == 1) && (last_char < 0x80);
+  return node;
+}
+
+
+// Parses the escape after a backslash. Adds the ranges of a class escape to
+// 'class_ranges_', and returns the code unit of a character escape in 'c'.
+PatternCompiler::EscapeKind PatternCompiler::ParseEscape(bool in_class,
+                                                         int32_t* c) {
+  if (AtEnd()) {
+    return kEscapeUnsupported;
+  }
+  const int32_t escaped = Next();
+  switch (escaped) {
+    case 'd':
+    case 'D':
+      AddClassRanges(kDigitRanges, ARRAY_SIZE(kDigitRanges), escaped == 'D');
+      return kEscapeClass;
+    case 'w':
+    case 'W':
+      AddClassRanges(kWordRanges, ARRAY_SIZE(kWordRanges), escaped == 'W');
+      return kEscapeClass;
+    case 's':
+    case 'S':
+      AddClassRanges(kSpaceRanges, ARRAY_SIZE(kSpaceRanges), escaped == 'S');
+      return kEscapeClass;
+    case 'b':
+      // A backspace in a class; word boundaries are parsed as assertions.
+      if (!in_class) {
+        return kEscapeUnsupported;
+      }
+      *c = 0x08;
+      return kEscapeChar;
+    case 't':
+      *c = 0x09;
+      return kEscapeChar;
+    case 'n':
+      *c = 0x0A;
+      return kEscapeChar;
+    case 'v':
+      *c = 0x0B;
+      return kEscapeChar;
+    case 'f':
+      *c = 0x0C;
+      return kEscapeChar;
+    case 'r':
+      *c = 0x0D;
+      return kEscapeChar;
+    case '0':
+      if (IsDecimalDigit(Peek())) {
+        // Octal escapes.
+        return kEscapeUnsupported;
+      }
+      *c = 0;
+      return kEscapeChar;
+    case 'x':
+      return ParseHex(2, c) ? kEscapeChar : kEscapeUnsupported;
+    case 'u':
+      return ParseHex(4, c) ? kEscapeChar : kEscapeUnsupported;
+    default:
+      // Backreferences, control escapes and escapes that jscre may reject
+      // are not supported; other characters stand for themselves.
+      if (IsWordChar(escaped)) {
+        return kEscapeUnsupported;
+      }
+      *c = escaped;
+      return kEscapeChar;
+  }
+}
+
+
+bool PatternCompiler::ParseHex(intptr_t digits, int32_t* c) {
+  int32_t value = 0;
+  for (intptr_t i = 0; i < digits; i++) {
+    const int32_t digit = HexDigitValue(PeekAt(i));
+    if (digit < 0) {
+      return false;
+    }
+    value = value * 16 + digit;
+  }
+  position_ += digits;
+  *c = value;
+  return true;
+}
+
+
+bool PatternCompiler::ParseDecimal(intptr_t* value) {
+  if (!IsDecimalDigit(Peek())) {
+    return false;
+  }
+  intptr_t result = 0;
+  while (IsDecimalDigit(Peek())) {
+    result = result * 10 + (Next() - '0');
+    if (result > kMaxRepetitions) {
+      return false;
+    }
+  }
+  *value = result;
+  return true;
+}
+
+
+intptr_t PatternCompiler::ParseQuantifier(intptr_t atom, bool parenthesized) {
+  intptr_t min = 0;
+  intptr_t max = 0;
+  switch (Peek()) {
+    case '*':
+      Next();
+      min = 0;
+      max = -1;
+      break;
+    case '+':
+      Next();
+      min = 1;
+      max = -1;
+      break;
+    case '?':
+      Next();
+      min = 0;
+      max = 1;
+      break;
+    case '{':
+      Next();
+      if (!ParseDecimal(&min)) {
+        return Unsupported();
+      }
+      max = min;
+      if (Peek() == ',') {
+        Next();
+        max = -1;
+        if ((Peek() != '}') && (!ParseDecimal(&max) || (max < min))) {
+          return Unsupported();
+        }
+      }
+      if (Peek() != '}') {
+        return Unsupported();
+      }
+      Next();
+      break;
+    default:
+      return atom;
+  }
+  bool greedy = true;
+  if (Peek() == '?') {
+    greedy = false;
+    Next();
+  }
+  const int32_t c = Peek();
+  if ((c == '*') || (c == '+') || (c == '?') || (c == '{')) {
+    return Unsupported();
+  }
+  if ((max != min) && IsNullable(atom)) {
+    // A backtracking matcher rejects optional repetitions of the body that
+    // match the empty string, which the automaton does not do.
+    return Unsupported();
+  }
+  if (!greedy && (max != min) && nodes_[atom].negated_char) {
+    // jscre does not let a lazy repetition of a negated character match the
+    // last character of the subject.
+    return Unsupported();
+  }
+  if ((max == -1) && HasLazyGroupRepetition(atom)) {
+    // jscre stops an unbounded repetition after its minimum count when the
+    // body holds a lazy optional repetition of a group.
+    return Unsupported();
+  }
+  const intptr_t node = NewNode(Node::kRepetition, atom, kNoNode);
+  nodes_[node].min = min;
+  nodes_[node].max = max;
+  nodes_[node].greedy = greedy;
+  nodes_[node].parenthesized = parenthesized;
+  return node;
+}
+
+
+bool PatternCompiler::IsNullable(intptr_t index) const {
+  const Node& node = nodes_[index];
+  switch (node.kind) {
+    case Node::kEmpty:
+    case Node::kAssertion:
+      return true;
+    case Node::kCharacters:
+      return false;
+    case Node::kGroup:
+      return IsNullable(node.left);
+    case Node::kConcatenation:
+      return IsNullable(node.left) && IsNullable(node.right);
+    case Node::kAlternation:
+      return IsNullable(node.left) || IsNullable(node.right);
+    case Node::kRepetition:
+      return (node.min == 0) || IsNullable(node.left);
+  }
+  UNREACHABLE();
+  return false;
+}
+
+
+bool PatternCompiler::HasLazyGroupRepetition(intptr_t index) const {
+  const Node& node = nodes_[index];
+  switch (node.kind) {
+    case Node::kEmpty:
+    case Node::kAssertion:
+    case Node::kCharacters:
+      return false;
+    case Node::kGroup:
+      return HasLazyGroupRepetition(node.left);
+    case Node::kConcatenation:
+    case Node::kAlternation:
+      return HasLazyGroupRepetition(node.left) ||
+             HasLazyGroupRepetition(node.right);
+    case Node::kRepetition:
+      if (!node.greedy && (node.max != node.min) && node.parenthesized) {
+        return true;
+      }
+      return HasLazyGroupRepetition(node.left);
+  }
+  UNREACHABLE();
+  return false;
+}
+
+
+intptr_t PatternCompiler::Emit(Opcode opcode, int32_t x, int32_t y) {
+  Instruction instruction;
+  instruction.opcode = opcode;
+  instruction.x = x;
+  instruction.y = y;
+  instructions_.Add(instruction);
+  return instructions_.length() - 1;
+}
+
+
+void PatternCompiler::EmitNode(intptr_t index) {
+  if (!supported_) {
+    return;
+  }
+  if (instructions_.length() > kMaxInstructions) {
+    supported_ = false;
+    return;
+  }
+  const Node& node = nodes_[index];
+  switch (node.kind) {
+    case Node::kEmpty:
+      break;
+    case Node::kCharacters: {
+      if ((node.num_ranges == 1) &&
+          (ranges_[node.first_range].from == ranges_[node.first_range].to)) {
+        Emit(kChar, ranges_[node.first_range].from, 0);
+      } else {
+        Emit(kClass, node.first_range, node.num_ranges);
+      }
+      break;
+    }
+    case Node::kAssertion:
+      Emit(static_cast<Opcode>(node.opcode), 0, 0);
+      break;
+    case Node::kGroup:
+      Emit(kSave, 2 * node.group, 0);
+      EmitNode(node.left);
+      Emit(kSave, 2 * node.group + 1, 0);
+      break;
+    case Node::kConcatenation:
+      EmitNode(node.left);
+      EmitNode(node.right);
+      break;
+    case Node::kAlternation: {
+      const intptr_t split = Emit(kSplit, instructions_.length() + 1, 0);
+      EmitNode(node.left);
+      const intptr_t jump = Emit(kJump, 0, 0);
+      instructions_[split].y = instructions_.length();
+      EmitNode(node.right);
+      instructions_[jump].x = instructions_.length();
+      break;
+    }
+    case Node::kRepetition:
+      EmitRepetition(node);
+      break;
+  }
+}
+
+
+void PatternCompiler::EmitRepetition(const Node& node) {
+  for (intptr_t i = 0; i < node.min; i++) {
+    EmitNode(node.left);
+  }
+  if (node.max < 0) {
+    // A loop that repeats the body for as long as the priority allows.
+    const intptr_t split = Emit(kSplit, 0, 0);
+    EmitNode(node.left);
+    Emit(kJump, split, 0);
+    const intptr_t body = split + 1;
+    const intptr_t end = instructions_.length();
+    instructions_[split].x = node.greedy ? body : end;
+    instructions_[split].y = node.greedy ? end : body;
+    return;
+  }
+  // Each optional repetition of the body may be skipped, which skips all the
+  // following ones too.
+  GrowableArray<intptr_t> splits;
+  for (intptr_t i = node.min; (i < node.max) && supported_; i++) {
+    splits.Add(Emit(kSplit, 0, 0));
+    EmitNode(node.left);
+  }
+  const intptr_t end = instructions_.length();
+  for (intptr_t i = 0; i < splits.length(); i++) {
+    const intptr_t split = splits[i];
+    instructions_[split].x = node.greedy ? (split + 1) : end;
+    instructions_[split].y = node.greedy ? end : (split + 1);
+  }
+}
+
+
+// Read access to a program stored in the data of a JSRegExp.
+class AutomatonProgram : public ValueObject {
+ public:
+  explicit AutomatonProgram(const void* data)
+      : header_(reinterpret_cast<const ProgramHeader*>(data)) {}
+
+  intptr_t num_instructions() const { return header_->num_instructions; }
+  intptr_t num_groups() const { return header_->num_groups; }
+  intptr_t num_slots() const { return 2 * (header_->num_groups + 1); }
+  int32_t first_char() const { return header_->first_char; }
+
+  const Instruction* instructions() const {
+    return reinterpret_cast<const Instruction*>(header_ + 1);
+  }
+
+  const CharRange* ranges() const {
+    return reinterpret_cast<const CharRange*>(
+        instructions() + header_->num_instructions);
+  }
+
+ private:
+  const ProgramHeader* header_;
+};
+
+
+// The threads of the automaton at one position, one per instruction, in
+// order of priority. The threads are kept in a sparse set, which is cleared
+// in constant time at each position.
+class ThreadList : public ValueObject {
+ public:
+  ThreadList(intptr_t num_instructions, intptr_t num_slots, Zone* zone)
+      : num_slots_(num_slots),
+        size_(0),
+        dense_(zone->Alloc<intptr_t>(num_instructions)),
+        sparse_(zone->Alloc<intptr_t>(num_instructions)),
+        captures_(zone->Alloc<intptr_t>(num_instructions * num_slots)) {
+    // The sparse array is only read for instructions that have been added,
+    // but initializing it keeps memory checkers quiet.
+    memset(sparse_, 0, num_instructions * sizeof(sparse_[0]));
+  }
+
+  intptr_t size() const { return size_; }
+  bool is_empty() const { return size_ == 0; }
+  intptr_t At(intptr_t i) const { return dense_[i]; }
+
+  bool Contains(intptr_t pc) const {
+    const intptr_t i = sparse_[pc];
+    return (i < size_) && (dense_[i] == pc);
+  }
+
+  void Add(intptr_t pc) {
+    ASSERT(!Contains(pc));
+    sparse_[pc] = size_;
+    dense_[size_++] = pc;
+  }
+
+  void Clear() { size_ = 0; }
+
+  // The capture slots of the thread at instruction 'pc'.
+  intptr_t* Captures(intptr_t pc) const {
+    return &captures_[pc * num_slots_];
+  }
+
+ private:
+  const intptr_t num_slots_;
+  intptr_t size_;
+  intptr_t* dense_;
+  intptr_t* sparse_;
+  intptr_t* captures_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadList);
+};
+
+
+// Simulates the automaton of a program on a string.
+template<typename CharType>
+class AutomatonMatcher : public ValueObject {
+ public:
+  AutomatonMatcher(const AutomatonProgram& program,
+                   const CharType* chars,
+                   intptr_t length,
+                   Zone* zone)
+      : program_(program),
+        instructions_(program.instructions()),
+        ranges_(program.ranges()),
+        chars_(chars),
+        length_(length),
+        num_slots_(program.num_slots()),
+        current_(program.num_instructions(), num_slots_, zone),
+        next_(program.num_instructions(), num_slots_, zone),
+        work_(zone->Alloc<intptr_t>(num_slots_)),
+        initial_(zone->Alloc<intptr_t>(num_slots_)),
+        stack_(zone->Alloc<StackEntry>(program.num_instructions() + 1)) {
+    for (intptr_t i = 0; i < num_slots_; i++) {
+      initial_[i] = -1;
+    }
+  }
+
+  // Finds the first match at or after 'start', and stores the positions of
+  // its groups in 'captures', with -1 for the groups that did not match.
+  bool Match(intptr_t start, intptr_t* captures);
+
+ private:
+  // Entries of the stack of instructions to follow in AddThread. An entry
+  // with a slot restores the slot to the value it had before a kSave.
+  struct StackEntry {
+    intptr_t pc;
+    intptr_t slot;
+    intptr_t value;
+  };
+
+  int32_t CharAt(intptr_t position) const {
+    return ((position >= 0) && (position < length_)) ?
+        chars_[position] : kNoChar;
+  }
+
+  bool IsInClass(const Instruction& instruction, int32_t c) const {
+    const CharRange* ranges = ranges_ + instruction.x;
+    for (intptr_t i = 0; i < instruction.y; i++) {
+      if (c < ranges[i].from) {
+        return false;
+      }
+      if (c <= ranges[i].to) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool IsAssertionTrue(intptr_t opcode, intptr_t position) const;
+  intptr_t SkipToFirstChar(intptr_t position) const;
+
+  // Adds the threads that follow from instruction 'pc' at 'position'
+  // without consuming a character, unless 'list' already has them.
+  void AddThread(ThreadList* list,
+                 intptr_t pc,
+                 intptr_t position,
+                 const intptr_t* captures);
+
+  const AutomatonProgram& program_;
+  const Instruction* instructions_;
+  const CharRange* ranges_;
+  const CharType* chars_;
+  const intptr_t length_;
+  const intptr_t num_slots_;
+  ThreadList current_;
+  ThreadList next_;
+  intptr_t* work_;  // The slots of the thread being added.
+  intptr_t* initial_;  // The slots of a thread that starts a match.
+  StackEntry* stack_;
+
+  DISALLOW_COPY_AND_ASSIGN(AutomatonMatcher);
+};
+
+
+template<typename CharType>
+bool AutomatonMatcher<CharType>::IsAssertionTrue(intptr_t opcode,
+                                                 intptr_t position) const {
+  switch (opcode) {
+    case kBeginInput:
+      return position == 0;
+    case kEndInput:
+      return position == length_;
+    case kBeginLine:
+      return (position == 0) || IsLineTerminator(CharAt(position - 1));
+    case kEndLine:
+      return (position == length_) || IsLineTerminator(CharAt(position));
+    case kWordBoundary:
+      return IsWordChar(CharAt(position - 1)) != IsWordChar(CharAt(position));
+    case kNotWordBoundary:
+      return IsWordChar(CharAt(position - 1)) == IsWordChar(CharAt(position));
+    default:
+      UNREACHABLE();
+      return false;
+  }
+}
+
+
+// Returns the first position at or after 'position' that has the first
+// character of all matches, or -1.
+template<typename CharType>
+intptr_t AutomatonMatcher<CharType>::SkipToFirstChar(intptr_t position) const {
+  const int32_t first_char = program_.first_char();
+  if (position >= length_) {
+    return -1;
+  }
+  if (sizeof(CharType) == 1) {
+    if (first_char > 0xFF) {
+      return -1;
+    }
+    const void* found = memchr(chars_ + position,
+                               first_char,
+                               length_ - position);
+    return (found == NULL) ?
+        -1 : (reinterpret_cast<const CharType*>(found) - chars_);
+  }
+  for (; position < length_; position++) {
+    if (chars_[position] == first_char) {
+      return position;
+    }
+  }
+  return -1;
+}
+
+
+template<typename CharType>
+void AutomatonMatcher<CharType>::AddThread(ThreadList* list,
+                                           intptr_t pc,
+                                           intptr_t position,
+                                           const intptr_t* captures) {
+  memmove(work_, captures, num_slots_ * sizeof(work_[0]));
+  intptr_t stack_size = 0;
+  stack_[stack_size].pc = pc;
+  stack_[stack_size].slot = -1;
+  stack_size++;
+  while (stack_size > 0) {
+    const StackEntry entry = stack_[--stack_size];
+    if (entry.slot >= 0) {
+      work_[entry.slot] = entry.value;
+      continue;
+    }
+    pc = entry.pc;
+    // Follows the instructions that do not consume a character. Each
+    // instruction is visited once, so the stack has room for all entries.
+    while (!list->Contains(pc)) {
+      list->Add(pc);
+      const Instruction& instruction = instructions_[pc];
+      const intptr_t opcode = instruction.opcode;
+      if (opcode == kJump) {
+        pc = instruction.x;
+      } else if (opcode == kSplit) {
+        stack_[stack_size].pc = instruction.y;
+        stack_[stack_size].slot = -1;
+        stack_size++;
+        pc = instruction.x;
+      } else if (opcode == kSave) {
+        stack_[stack_size].slot = instruction.x;
+        stack_[stack_size].value = work_[instruction.x];
+        stack_size++;
+        work_[instruction.x] = position;
+        pc++;
+      } else if ((opcode == kChar) || (opcode == kClass) ||
+                 (opcode == kMatch)) {
+        memmove(list->Captures(pc), work_, num_slots_ * sizeof(work_[0]));
+        break;
+      } else if (IsAssertionTrue(opcode, position)) {
+        pc++;
+      } else {
+        break;
+      }
+    }
+  }
+}
+
+
+template<typename CharType>
+bool AutomatonMatcher<CharType>::Match(intptr_t start, intptr_t* captures) {
+  ThreadList* current = &current_;
+  ThreadList* next = &next_;
+  current->Clear();
+  bool matched = false;
+  for (intptr_t position = start; position <= length_; position++) {
+    if (!matched) {
+      // A match may start at every position, with the lowest priority.
+      if (current->is_empty() && (program_.first_char() != kNoChar)) {
+        position = SkipToFirstChar(position);
+        if (position < 0) {
+          break;
+        }
+      }
+      AddThread(current, 0, position, initial_);
+    }
+    if (current->is_empty()) {
+      break;
+    }
+    next->Clear();
+    const int32_t c = CharAt(position);
+    for (intptr_t i = 0; i < current->size(); i++) {
+      const intptr_t pc = current->At(i);
+      const Instruction& instruction = instructions_[pc];
+      if (instruction.opcode == kMatch) {
+        // The threads of lower priority are cut off.
+        memmove(captures,
+                current->Captures(pc),
+                num_slots_ * sizeof(captures[0]));
+        matched = true;
+        break;
+      }
+      if (((instruction.opcode == kChar) && (c == instruction.x)) ||
+          ((instruction.opcode == kClass) && (c != kNoChar) &&
+           IsInClass(instruction, c))) {
+        AddThread(next, pc + 1, position + 1, current->Captures(pc));
+      }
+    }
+    ThreadList* swap = current;
+    current = next;
+    next = swap;
+  }
+  return matched;
+}
+
+
+RawJSRegExp* RegExpAutomaton::Compile(const String& pattern,
+                                      bool multi_line,
+                                      bool ignore_case) {
+  // The pattern is only read once, so it is copied to UTF-16 for the
+  // parser.
+  Zone* zone = Isolate::Current()->current_zone();
+  const intptr_t length = pattern.Length();
+  uint16_t* chars = zone->Alloc<uint16_t>(length);
+  for (intptr_t i = 0; i < length; i++) {
+    chars[i] = pattern.CharAt(i);
+  }
+  PatternCompiler compiler(chars, length, multi_line, ignore_case);
+  if (!compiler.Compile()) {
+    return JSRegExp::null();
+  }
+  const JSRegExp& regexp =
+      JSRegExp::Handle(JSRegExp::New(compiler.ProgramSize()));
+  {
+    NoGCScope no_gc;
+    compiler.WriteProgram(regexp.GetDataStartAddress());
+  }
+  regexp.set_pattern(pattern);
+  if (multi_line) {
+    regexp.set_is_multi_line();
+  }
+  if (ignore_case) {
+    regexp.set_is_ignore_case();
+  }
+  // A Dart regexp is always global.
+  regexp.set_is_global();
+  regexp.set_is_automaton();
+  regexp.set_num_bracket_expressions(compiler.num_groups());
+  return regexp.raw();
+}
+
+
+RawArray* RegExpAutomaton::Execute(const JSRegExp& regex,
+                                   const String& str,
+                                   intptr_t start_index) {
+  ASSERT(regex.is_automaton());
+  const intptr_t length = str.Length();
+  if ((start_index < 0) || (start_index > length)) {
+    return Array::null();
+  }
+  Zone* zone = Isolate::Current()->current_zone();
+  intptr_t num_slots = 0;
+  intptr_t* captures = NULL;
+  bool matched = false;
+  {
+    // The matcher allocates its thread lists in the zone, which does not
+    // cause a GC.
+    NoGCScope no_gc;
+    const AutomatonProgram program(regex.GetDataStartAddress());
+    num_slots = program.num_slots();
+    captures = zone->Alloc<intptr_t>(num_slots);
+    if ((length > 0) && (str.CharSize() != String::kOneByteChar)) {
+      AutomatonMatcher<uint16_t> matcher(
+          program, String::UTF16Chars(str), length, zone);
+      matched = matcher.Match(start_index, captures);
+    } else {
+      const uint8_t* chars = (length > 0) ? String::Latin1Chars(str) : NULL;
+      AutomatonMatcher<uint8_t> matcher(program, chars, length, zone);
+      matched = matcher.Match(start_index, captures);
+    }
+  }
+  if (!matched) {
+    return Array::null();
+  }
+  // The matches come in (start, end) pairs for each group, as from jscre.
+  const Array& array = Array::Handle(Array::New(num_slots));
+  Smi& position = Smi::Handle();
+  for (intptr_t i = 0; i < num_slots; i++) {
+    position = Smi::New(captures[i]);
+    array.SetAt(i, position);
+  }
+  return array.raw();
+}
+
+}  // namespace dart
@@ -0,0 +1,39 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef LIB_REGEXP_AUTOMATON_H_
+#define LIB_REGEXP_AUTOMATON_H_
+
+#include "vm/object.h"
+
+
+namespace dart {
+
+// Matches regular expressions without backreferences and lookaheads by
+// simulating their automaton in all its states at once, so matching takes
+// time linear in the length of the string and never backtracks. The
+// characters of one byte and two byte strings are read in place.
+//
+// The groups are reported as the backtracking jscre library reports them:
+// the leftmost match is found, alternatives and quantifiers are tried in
+// order of priority, and a group in a repetition holds its last match.
+class RegExpAutomaton : public AllStatic {
+ public:
+  // Returns the compiled regexp, or null if the pattern uses a feature that
+  // the automaton does not support. Such patterns are compiled by Jscre,
+  // which also reports the syntax errors.
+  static RawJSRegExp* Compile(const String& pattern,
+                              bool multi_line,
+                              bool ignore_case);
+
+  // Returns the (start, end) pairs of the groups of the first match at or
+  // after 'index', as Jscre::Execute does, or null if there is no match.
+  static RawArray* Execute(const JSRegExp& regex,
+                           const String& str,
+                           intptr_t index);
+};
+
+}  // namespace dart
+
+#endif  // LIB_REGEXP_AUTOMATON_H_
@@ -102,26 +102,35 @@ DEFINE_NATIVE_ENTRY(OneByteString_splitWithCharCode, 2) {
       GrowableObjectArray::New(16, Heap::kNew));
   String& str = String::Handle(isolate);
   intptr_t start = 0;
-  intptr_t i = 0;
-  for (; i < len; i++) {
-    if (split_code == OneByteString::CharAt(receiver, i)) {
-      str = OneByteString::SubStringUnchecked(receiver,
-                                              start,
-                                              (i - start),
-                                              Heap::kNew);
-      result.Add(str);
-      start = i + 1;
-    }
+  intptr_t i = String::IndexOfCodeUnit(receiver, split_code, start);
+  while (i >= 0) {
+    str = OneByteString::SubStringUnchecked(receiver,
+                                            start,
+                                            (i - start),
+                                            Heap::kNew);
+    result.Add(str);
+    start = i + 1;
+    i = String::IndexOfCodeUnit(receiver, split_code, start);
   }
   str = OneByteString::SubStringUnchecked(receiver,
                                           start,
-                                          (i - start),
+                                          (len - start),
                                           Heap::kNew);
   result.Add(str);
   return result.raw();
 }
 
 
+DEFINE_NATIVE_ENTRY(String_indexOf, 3) {
+  const String& receiver = String::CheckedHandle(isolate,
+                                                 arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(String, pattern, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start, arguments->NativeArgAt(2));
+  ASSERT((start.Value() >= 0) && (start.Value() <= receiver.Length()));
+  return Smi::New(String::IndexOf(receiver, pattern, start.Value()));
+}
+
+
 DEFINE_NATIVE_ENTRY(String_getHashCode, 1) {
   const String& receiver = String::CheckedHandle(arguments->NativeArgAt(0));
   intptr_t hash_val = receiver.Hash();
@@ -214,6 +223,46 @@ DEFINE_NATIVE_ENTRY(Strings_concatAll, 1) {
 }
 
 
+DEFINE_NATIVE_ENTRY(StringBase_concatRange, 3) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, list, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end, arguments->NativeArgAt(2));
+  if (!list.IsGrowableObjectArray() && !list.IsArray()) {
+    const Array& args = Array::Handle(Array::New(1));
+    args.SetAt(0, list);
+    Exceptions::ThrowByType(Exceptions::kArgument, args);
+  }
+  Array& strings = Array::Handle(isolate);
+  intptr_t length;
+  if (list.IsGrowableObjectArray()) {
+    const GrowableObjectArray& growableArray = GrowableObjectArray::Cast(list);
+    strings ^= growableArray.data();
+    length = growableArray.Length();
+  } else {
+    strings ^= Array::Cast(list).raw();
+    length = strings.Length();
+  }
+  const intptr_t start_value = start.Value();
+  const intptr_t end_value = end.Value();
+  if ((start_value < 0) || (start_value > end_value) || (end_value > length)) {
+    const Array& args = Array::Handle(Array::New(1));
+    args.SetAt(0, (start_value < 0) ? start : end);
+    Exceptions::ThrowByType(Exceptions::kRange, args);
+  }
+  // Check that the range contains strings.
+  Instance& elem = Instance::Handle(isolate);
+  for (intptr_t i = start_value; i < end_value; i++) {
+    elem ^= strings.At(i);
+    if (!elem.IsString()) {
+      const Array& args = Array::Handle(Array::New(1));
+      args.SetAt(0, elem);
+      Exceptions::ThrowByType(Exceptions::kArgument, args);
+    }
+  }
+  return String::ConcatAllRange(strings, start_value, end_value);
+}
+
+
 DEFINE_NATIVE_ENTRY(StringBuffer_createStringFromUint16Array, 3) {
   GET_NON_NULL_NATIVE_ARGUMENT(TypedData, codeUnits, arguments->NativeArgAt(0));
   GET_NON_NULL_NATIVE_ARGUMENT(Smi, length, arguments->NativeArgAt(1));
@@ -3,26 +3,60 @@
 // BSD-style license that can be found in the LICENSE file.
 
 patch class StringBuffer {
-  /** Backing store for collected UTF-16 code units. */
+  /** Size of the buffer that collects the code units of [writeCharCode]. */
+  static const int _BUFFER_SIZE = 64;
+
+  /**
+   * Number of parts after which the small parts that were added since the
+   * last compaction are concatenated into one part.
+   */
+  static const int _PARTS_TO_COMPACT = 128;
+
+  /**
+   * Upper bound of the code units of the parts to compact. Larger parts are
+   * left for [toString] to copy only once.
+   */
+  static const int _PARTS_TO_COMPACT_SIZE_LIMIT = _PARTS_TO_COMPACT * 8;
+
+  /**
+   * The strings added to the buffer, in order.
+   *
+   * They are concatenated only when the contents are needed, which makes
+   * building a string from many parts linear in its length.
+   */
+  List<String> _parts;
+
+  /** Number of code units in [_parts]. */
+  int _partsCodeUnits = 0;
+
+  /** Index of the first part added since the last compaction. */
+  int _partsCompactionIndex = 0;
+
+  /** Number of code units in the parts added since the last compaction. */
+  int _partsCodeUnitsSinceCompaction = 0;
+
+  /** Collects the UTF-16 code units added by [writeCharCode]. */
   Uint16List _buffer;
-  /** Number of code units collected. */
-  int _length = 0;
+
+  /** Number of code units in [_buffer]. */
+  int _bufferPosition = 0;
+
   /**
-   * Collects the approximate maximal magnitude of the added code units.
+   * Collects the approximate maximal magnitude of the code units in
+   * [_buffer].
    *
    * The value of each added code unit is or'ed with this variable, so the
    * most significant bit set in any code unit is also set in this value.
    * If below 256, the string is a Latin-1 string.
    */
-  int _codeUnitMagnitude = 0;
+  int _bufferCodeUnitMagnitude = 0;
 
   /// Creates the string buffer with an initial content.
-  /* patch */ StringBuffer([Object content = ""])
-      : _buffer = new Uint16List(16) {
+  /* patch */ StringBuffer([Object content = ""]) {
     write(content);
   }
 
-  /* patch */ int get length => _length;
+  /* patch */ int get length => _partsCodeUnits + _bufferPosition;
 
   /// Adds [obj] to the buffer.
   /* patch */ void write(Object obj) {
@@ -38,13 +72,8 @@ patch class StringBuffer {
       }
     }
     if (str.isEmpty) return;
-    _ensureCapacity(str.length);
-    for (int i = 0; i < str.length; i++) {
-      int unit = str.codeUnitAt(i);
-      _buffer[_length + i] = unit;
-      _codeUnitMagnitude |= unit;
-    }
-    _length += str.length;
+    _consumeBuffer();
+    _addPart(str);
   }
 
   /* patch */ writeCharCode(int charCode) {
@@ -53,50 +82,95 @@ patch class StringBuffer {
         throw new RangeError.range(charCode, 0, 0x10FFFF);
       }
       _ensureCapacity(1);
-      _buffer[_length++] = charCode;
-      _codeUnitMagnitude |= charCode;
+      _buffer[_bufferPosition++] = charCode;
+      _bufferCodeUnitMagnitude |= charCode;
     } else {
       if (charCode > 0x10FFFF) {
         throw new RangeError.range(charCode, 0, 0x10FFFF);
       }
       _ensureCapacity(2);
       int bits = charCode - 0x10000;
-      _buffer[_length++] = 0xD800 | (bits >> 10);
-      _buffer[_length++] = 0xDC00 | (bits & 0x3FF);
-      _codeUnitMagnitude |= 0xFFFF;
+      _buffer[_bufferPosition++] = 0xD800 | (bits >> 10);
+      _buffer[_bufferPosition++] = 0xDC00 | (bits & 0x3FF);
+      _bufferCodeUnitMagnitude |= 0xFFFF;
     }
   }
 
   /** Makes the buffer empty. */
   /* patch */ void clear() {
-    _length = 0;
-    _codeUnitMagnitude = 0;
+    _parts = null;
+    _partsCodeUnits = 0;
+    _partsCompactionIndex = 0;
+    _partsCodeUnitsSinceCompaction = 0;
+    _bufferPosition = 0;
+    _bufferCodeUnitMagnitude = 0;
   }
 
-  /** Returns the contents of buffer as a string. */
+  /**
+   * Returns the contents of buffer as a string.
+   *
+   * The parts are replaced with the result, so that the contents are
+   * concatenated only once if nothing is added in between.
+   */
   /* patch */ String toString() {
-    if (_length == 0) return "";
-    bool isLatin1 = _codeUnitMagnitude <= 0xFF;
-    return _create(_buffer, _length, isLatin1);
+    _consumeBuffer();
+    if (_partsCodeUnits == 0) return "";
+    if (_parts.length > 1) {
+      String result = _StringBase._concatRange(_parts, 0, _parts.length);
+      _parts.length = 0;
+      _parts.add(result);
+      _partsCompactionIndex = 1;
+      _partsCodeUnitsSinceCompaction = 0;
+    }
+    return _parts[0];
   }
 
   /** Ensures that the buffer has enough capacity to add n code units. */
   void _ensureCapacity(int n) {
-    int requiredCapacity = _length + n;
-    if (requiredCapacity > _buffer.length) {
-      _grow(requiredCapacity);
+    if (_buffer == null) {
+      _buffer = new Uint16List(_BUFFER_SIZE);
+    } else if (_bufferPosition + n > _buffer.length) {
+      _consumeBuffer();
     }
   }
 
-  /** Grows the buffer until it can contain [requiredCapacity] entries. */
-  void _grow(int requiredCapacity) {
-    int newCapacity = _buffer.length;
-    do {
-      newCapacity *= 2;
-    } while (newCapacity < requiredCapacity);
-    List<int> newBuffer = new Uint16List(newCapacity);
-    newBuffer.setRange(0, _length, _buffer);
-    _buffer = newBuffer;
+  /** Moves the code units of the buffer to a new part. */
+  void _consumeBuffer() {
+    if (_bufferPosition == 0) return;
+    bool isLatin1 = _bufferCodeUnitMagnitude <= 0xFF;
+    String str = _create(_buffer, _bufferPosition, isLatin1);
+    _bufferPosition = 0;
+    _bufferCodeUnitMagnitude = 0;
+    _addPart(str);
+  }
+
+  void _addPart(String str) {
+    int length = str.length;
+    _partsCodeUnits += length;
+    _partsCodeUnitsSinceCompaction += length;
+    if (_parts == null) {
+      _parts = <String>[str];
+    } else {
+      _parts.add(str);
+      if (_parts.length - _partsCompactionIndex == _PARTS_TO_COMPACT) {
+        _compact();
+      }
+    }
+  }
+
+  /**
+   * Concatenates the parts added since the last compaction if they are
+   * small, which bounds the number of parts that hold few code units.
+   */
+  void _compact() {
+    if (_partsCodeUnitsSinceCompaction < _PARTS_TO_COMPACT_SIZE_LIMIT) {
+      String compacted = _StringBase._concatRange(
+          _parts, _partsCompactionIndex, _parts.length);
+      _parts.length = _partsCompactionIndex;
+      _parts.add(compacted);
+    }
+    _partsCompactionIndex = _parts.length;
+    _partsCodeUnitsSinceCompaction = 0;
   }
 
   /**
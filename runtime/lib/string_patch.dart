@@ -117,15 +117,11 @@ class _StringBase {
     if ((start < 0) || (start >= this.length)) {
       return -1;
     }
-    int len = this.length - other.length + 1;
-    for (int index = start; index < len; index++) {
-      if (_substringMatches(index, other)) {
-        return index;
-      }
-    }
-    return -1;
+    return _indexOf(other, start);
   }
 
+  int _indexOf(String other, int start) native "String_indexOf";
+
   int lastIndexOf(String other, [int start = null]) {
     if (start == null) start = length - 1;
     if (other.isEmpty) {
@@ -406,7 +402,7 @@ class _StringBase {
       }
       stringsList.add(string);
     }
-    return concatAll(stringsList);
+    return _concatRange(stringsList, 0, stringsList.length);
   }
 
   static String concatAll(Iterable<String> strings) {
@@ -430,6 +426,11 @@ class _StringBase {
 
   static String _concatAll(List<String> strings)
       native "Strings_concatAll";
+
+  // Concatenates the strings at the indices [start, end) of [strings],
+  // which may be a fixed length or a growable list.
+  static String _concatRange(List<String> strings, int start, int end)
+      native "StringBase_concatRange";
 }
 
 
@@ -9,7 +9,9 @@
 #include "vm/bigint_operations.h"
 #include "vm/exceptions.h"
 #include "vm/native_entry.h"
+#include "vm/number_text.h"
 #include "vm/object.h"
+#include "vm/typed_data_operations.h"
 
 namespace dart {
 
@@ -128,6 +130,322 @@ DEFINE_NATIVE_ENTRY(TypedData_setRange, 5) {
 }
 
 
+// Checks that the range ['start_in_bytes', 'end_in_bytes') is in the data of
+// the typed data or external typed data 'instance'.
+static void BytesRangeCheck(const Instance& instance,
+                            intptr_t start_in_bytes,
+                            intptr_t end_in_bytes) {
+  intptr_t length_in_bytes;
+  intptr_t element_size_in_bytes;
+  if (instance.IsTypedData()) {
+    const TypedData& array = TypedData::Cast(instance);
+    length_in_bytes = array.LengthInBytes();
+    element_size_in_bytes = array.ElementSizeInBytes();
+  } else {
+    ASSERT(instance.IsExternalTypedData());
+    const ExternalTypedData& array = ExternalTypedData::Cast(instance);
+    length_in_bytes = array.LengthInBytes();
+    element_size_in_bytes = array.ElementSizeInBytes();
+  }
+  SetRangeCheck(start_in_bytes,
+                end_in_bytes - start_in_bytes,
+                length_in_bytes,
+                element_size_in_bytes);
+}
+
+
+// Returns the address of the byte at 'offset_in_bytes' of the typed data or
+// external typed data 'instance'. The data of typed data objects is moved by
+// the GC, so the caller must not allow a GC while it uses the address.
+static uint8_t* BytesAddr(const Instance& instance, intptr_t offset_in_bytes) {
+  if (instance.IsTypedData()) {
+    return reinterpret_cast<uint8_t*>(
+        TypedData::Cast(instance).DataAddr(offset_in_bytes));
+  }
+  return reinterpret_cast<uint8_t*>(
+      ExternalTypedData::Cast(instance).DataAddr(offset_in_bytes));
+}
+
+
+// Returns the class id of the typed data class that has the same elements as
+// the typed data, external typed data or typed data view class 'cid'.
+static intptr_t ElementClassId(intptr_t cid) {
+  if (RawObject::IsExternalTypedDataClassId(cid)) {
+    return cid - kExternalTypedDataInt8ArrayCid + kTypedDataInt8ArrayCid;
+  }
+  if (RawObject::IsTypedDataViewClassId(cid)) {
+    ASSERT(cid != kByteDataViewCid);
+    return cid - kTypedDataInt8ArrayViewCid + kTypedDataInt8ArrayCid;
+  }
+  ASSERT(RawObject::IsTypedDataClassId(cid));
+  return cid;
+}
+
+
+// Returns true if an element of the integer typed data class 'cid' can be
+// equal to 'value'.
+static bool IsElementValue(intptr_t cid, int64_t value) {
+  switch (cid) {
+    case kTypedDataInt8ArrayCid:
+      return (value >= -0x80) && (value <= 0x7F);
+    case kTypedDataUint8ArrayCid:
+    case kTypedDataUint8ClampedArrayCid:
+      return (value >= 0) && (value <= 0xFF);
+    case kTypedDataInt16ArrayCid:
+      return (value >= -0x8000) && (value <= 0x7FFF);
+    case kTypedDataUint16ArrayCid:
+      return (value >= 0) && (value <= 0xFFFF);
+    case kTypedDataInt32ArrayCid:
+      return (value >= kMinInt32) && (value <= kMaxInt32);
+    case kTypedDataUint32ArrayCid:
+      return (value >= 0) && (value <= kMaxUint32);
+    case kTypedDataInt64ArrayCid:
+      return true;
+    case kTypedDataUint64ArrayCid:
+      return value >= 0;
+    default:
+      UNREACHABLE();
+      return false;
+  }
+}
+
+
+DEFINE_NATIVE_ENTRY(TypedData_fillRange, 4) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_in_bytes, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end_in_bytes, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, element_size, arguments->NativeArgAt(3));
+  ASSERT(instance.IsTypedData() || instance.IsExternalTypedData());
+  const intptr_t len = end_in_bytes.Value() - start_in_bytes.Value();
+  BytesRangeCheck(instance, start_in_bytes.Value(), end_in_bytes.Value());
+  if (len > 0) {
+    NoGCScope no_gc;
+    TypedDataOperations::FillFromFirst(
+        BytesAddr(instance, start_in_bytes.Value()), len, element_size.Value());
+  }
+  return Object::null();
+}
+
+
+// Searches the elements of 'list' from 'start_in_bytes' to 'end_in_bytes' of
+// the typed data receiver, which is the buffer of 'list', for 'element'.
+// Returns the index of the first or last equal element relative to the start
+// of the range, or -1. Returns null if 'list' or 'element' is not an integer,
+// in which case the caller compares the elements.
+static RawObject* SearchElement(Isolate* isolate,
+                                NativeArguments* arguments,
+                                bool forward) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, list, arguments->NativeArgAt(1));
+  const Instance& element =
+      Instance::CheckedHandle(isolate, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_in_bytes, arguments->NativeArgAt(3));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end_in_bytes, arguments->NativeArgAt(4));
+  ASSERT(instance.IsTypedData() || instance.IsExternalTypedData());
+  const intptr_t cid = ElementClassId(Class::Handle(list.clazz()).id());
+  if (!element.IsInteger() ||
+      (cid == kTypedDataFloat32ArrayCid) ||
+      (cid == kTypedDataFloat64ArrayCid) ||
+      (cid == kTypedDataFloat32x4ArrayCid)) {
+    return Object::null();
+  }
+  BytesRangeCheck(instance, start_in_bytes.Value(), end_in_bytes.Value());
+  uint64_t value;
+  if (element.IsBigint()) {
+    // Only Uint64 elements can be equal to an integer outside of the int64
+    // range.
+    const Bigint& bigint = Bigint::Cast(element);
+    if ((cid != kTypedDataUint64ArrayCid) ||
+        !BigintOperations::FitsIntoUint64(bigint)) {
+      return Smi::New(-1);
+    }
+    value = BigintOperations::AbsToUint64(bigint);
+  } else {
+    const int64_t int64_value = Integer::Cast(element).AsInt64Value();
+    if (!IsElementValue(cid, int64_value)) {
+      return Smi::New(-1);
+    }
+    value = static_cast<uint64_t>(int64_value);
+  }
+  const intptr_t element_size = TypedData::ElementSizeInBytes(cid);
+  const intptr_t length =
+      (end_in_bytes.Value() - start_in_bytes.Value()) / element_size;
+  if (length <= 0) {
+    return Smi::New(-1);
+  }
+  intptr_t index;
+  {
+    NoGCScope no_gc;
+    const uint8_t* data = BytesAddr(instance, start_in_bytes.Value());
+    index = forward ?
+        TypedDataOperations::IndexOf(data, length, element_size, value) :
+        TypedDataOperations::LastIndexOf(data, length, element_size, value);
+  }
+  return Smi::New(index);
+}
+
+
+DEFINE_NATIVE_ENTRY(TypedData_indexOf, 5) {
+  return SearchElement(isolate, arguments, true);
+}
+
+
+DEFINE_NATIVE_ENTRY(TypedData_lastIndexOf, 5) {
+  return SearchElement(isolate, arguments, false);
+}
+
+
+// Parses the numbers separated by 'separator' from 'start_in_bytes' to
+// 'end_in_bytes' of the typed data receiver into the 8-byte elements of
+// 'result' from 'result_start_in_bytes' to 'result_end_in_bytes', and
+// returns their number. The numbers are doubles or 64-bit integers.
+static RawObject* ParseNumbers(Isolate* isolate,
+                               NativeArguments* arguments,
+                               bool doubles) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_in_bytes, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end_in_bytes, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, separator, arguments->NativeArgAt(3));
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, result, arguments->NativeArgAt(4));
+  GET_NON_NULL_NATIVE_ARGUMENT(
+      Smi, result_start_in_bytes, arguments->NativeArgAt(5));
+  GET_NON_NULL_NATIVE_ARGUMENT(
+      Smi, result_end_in_bytes, arguments->NativeArgAt(6));
+  ASSERT(instance.IsTypedData() || instance.IsExternalTypedData());
+  ASSERT(result.IsTypedData() || result.IsExternalTypedData());
+  ASSERT((0 <= separator.Value()) && (separator.Value() <= 0xFF));
+  BytesRangeCheck(instance, start_in_bytes.Value(), end_in_bytes.Value());
+  BytesRangeCheck(
+      result, result_start_in_bytes.Value(), result_end_in_bytes.Value());
+  const intptr_t length = end_in_bytes.Value() - start_in_bytes.Value();
+  const intptr_t capacity =
+      (result_end_in_bytes.Value() - result_start_in_bytes.Value()) / 8;
+  if (length <= 0) {
+    return Smi::New(0);
+  }
+  intptr_t count;
+  intptr_t error_offset = 0;
+  intptr_t error_length = 0;
+  uint8_t* error_field = NULL;
+  {
+    NoGCScope no_gc;
+    const uint8_t* data = BytesAddr(instance, start_in_bytes.Value());
+    uint8_t* values = BytesAddr(result, result_start_in_bytes.Value());
+    if (doubles) {
+      count = NumberText::ParseDoubles(data, length, separator.Value(),
+                                       values, capacity,
+                                       &error_offset, &error_length);
+    } else {
+      count = NumberText::ParseInt64s(data, length, separator.Value(),
+                                      values, capacity,
+                                      &error_offset, &error_length);
+    }
+    if (count == NumberText::kInvalidField) {
+      // The field is copied out of the data, which moves when the string
+      // reporting it is allocated.
+      error_field = isolate->current_zone()->Alloc<uint8_t>(error_length);
+      memmove(error_field, data + error_offset, error_length);
+    }
+  }
+  if (count == NumberText::kInvalidField) {
+    const Array& args = Array::Handle(Array::New(1));
+    args.SetAt(0, String::Handle(
+        String::FromLatin1(error_field, error_length)));
+    Exceptions::ThrowByType(Exceptions::kFormat, args);
+  }
+  if (count == NumberText::kTooManyFields) {
+    const String& error = String::Handle(String::NewFormatted(
+        "result has room for only %"Pd" values", capacity));
+    const Array& args = Array::Handle(Array::New(1));
+    args.SetAt(0, error);
+    Exceptions::ThrowByType(Exceptions::kRange, args);
+  }
+  return Smi::New(count);
+}
+
+
+DEFINE_NATIVE_ENTRY(TypedData_parseDoubles, 7) {
+  return ParseNumbers(isolate, arguments, true);
+}
+
+
+DEFINE_NATIVE_ENTRY(TypedData_parseInts, 7) {
+  return ParseNumbers(isolate, arguments, false);
+}
+
+
+// Writes the 8-byte elements from 'start_in_bytes' to 'end_in_bytes' of the
+// typed data receiver, separated by 'separator', to the bytes of 'output'
+// from 'output_start_in_bytes' to 'output_end_in_bytes', and returns the
+// number of bytes written. The elements are doubles, written with the given
+// number of fraction digits if it is not null, or 64-bit integers.
+static RawObject* FormatNumbers(Isolate* isolate,
+                                NativeArguments* arguments,
+                                bool doubles) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_in_bytes, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end_in_bytes, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, separator, arguments->NativeArgAt(3));
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, output, arguments->NativeArgAt(4));
+  GET_NON_NULL_NATIVE_ARGUMENT(
+      Smi, output_start_in_bytes, arguments->NativeArgAt(5));
+  GET_NON_NULL_NATIVE_ARGUMENT(
+      Smi, output_end_in_bytes, arguments->NativeArgAt(6));
+  intptr_t fraction_digits = -1;
+  if (doubles) {
+    GET_NATIVE_ARGUMENT(Smi, digits, arguments->NativeArgAt(7));
+    if (!digits.IsNull()) {
+      fraction_digits = digits.Value();
+      ASSERT((0 <= fraction_digits) && (fraction_digits <= 20));
+    }
+  }
+  ASSERT(instance.IsTypedData() || instance.IsExternalTypedData());
+  ASSERT(output.IsTypedData() || output.IsExternalTypedData());
+  ASSERT((0 <= separator.Value()) && (separator.Value() <= 0xFF));
+  BytesRangeCheck(instance, start_in_bytes.Value(), end_in_bytes.Value());
+  BytesRangeCheck(
+      output, output_start_in_bytes.Value(), output_end_in_bytes.Value());
+  const intptr_t count = (end_in_bytes.Value() - start_in_bytes.Value()) / 8;
+  const intptr_t capacity =
+      output_end_in_bytes.Value() - output_start_in_bytes.Value();
+  if (count <= 0) {
+    return Smi::New(0);
+  }
+  intptr_t length;
+  {
+    NoGCScope no_gc;
+    const uint8_t* values = BytesAddr(instance, start_in_bytes.Value());
+    uint8_t* text = BytesAddr(output, output_start_in_bytes.Value());
+    if (doubles) {
+      length = NumberText::FormatDoubles(values, count, fraction_digits,
+                                         separator.Value(), text, capacity);
+    } else {
+      length = NumberText::FormatInt64s(values, count,
+                                        separator.Value(), text, capacity);
+    }
+  }
+  if (length < 0) {
+    const String& error = String::Handle(String::NewFormatted(
+        "output of %"Pd" bytes is too short for %"Pd" values",
+        capacity, count));
+    const Array& args = Array::Handle(Array::New(1));
+    args.SetAt(0, error);
+    Exceptions::ThrowByType(Exceptions::kRange, args);
+  }
+  return Smi::New(length);
+}
+
+
+DEFINE_NATIVE_ENTRY(TypedData_formatDoubles, 8) {
+  return FormatNumbers(isolate, arguments, true);
+}
+
+
+DEFINE_NATIVE_ENTRY(TypedData_formatInts, 7) {
+  return FormatNumbers(isolate, arguments, false);
+}
+
+
 // We check the length parameter against a possible maximum length for the
 // array based on available physical addressable memory on the system. The
 // maximum possible length is a scaled value of kSmiMax which is set up based
@@ -272,12 +272,130 @@ patch class ByteData {
 }
 
 
+patch class NumberText {
+  /* patch */ static int parseDoubles(Uint8List bytes,
+                                      int start,
+                                      int end,
+                                      int separator,
+                                      Float64List result,
+                                      [int resultStart = 0]) {
+    _checkList(bytes);
+    _checkList(result);
+    _checkRange(bytes, start, end);
+    _checkSeparator(separator);
+    _checkRange(result, resultStart, result.length);
+    return bytes.buffer._parseDoubles(
+        bytes.offsetInBytes + start,
+        bytes.offsetInBytes + end,
+        separator,
+        result.buffer,
+        result.offsetInBytes + resultStart * Float64List.BYTES_PER_ELEMENT,
+        result.offsetInBytes + result.lengthInBytes);
+  }
+
+  /* patch */ static int parseInts(Uint8List bytes,
+                                   int start,
+                                   int end,
+                                   int separator,
+                                   Int64List result,
+                                   [int resultStart = 0]) {
+    _checkList(bytes);
+    _checkList(result);
+    _checkRange(bytes, start, end);
+    _checkSeparator(separator);
+    _checkRange(result, resultStart, result.length);
+    return bytes.buffer._parseInts(
+        bytes.offsetInBytes + start,
+        bytes.offsetInBytes + end,
+        separator,
+        result.buffer,
+        result.offsetInBytes + resultStart * Int64List.BYTES_PER_ELEMENT,
+        result.offsetInBytes + result.lengthInBytes);
+  }
+
+  /* patch */ static int formatDoubles(Float64List values,
+                                       int start,
+                                       int end,
+                                       int separator,
+                                       Uint8List output,
+                                       [int outputStart = 0,
+                                        int fractionDigits]) {
+    _checkList(values);
+    _checkList(output);
+    _checkRange(values, start, end);
+    _checkSeparator(separator);
+    _checkRange(output, outputStart, output.length);
+    if (fractionDigits != null) {
+      if (fractionDigits is! int) {
+        throw new ArgumentError(fractionDigits);
+      }
+      if (fractionDigits < 0 || fractionDigits > 20) {
+        throw new RangeError(fractionDigits);
+      }
+    }
+    int elementSize = Float64List.BYTES_PER_ELEMENT;
+    return outputStart + values.buffer._formatDoubles(
+        values.offsetInBytes + start * elementSize,
+        values.offsetInBytes + end * elementSize,
+        separator,
+        output.buffer,
+        output.offsetInBytes + outputStart,
+        output.offsetInBytes + output.length,
+        fractionDigits);
+  }
+
+  /* patch */ static int formatInts(Int64List values,
+                                    int start,
+                                    int end,
+                                    int separator,
+                                    Uint8List output,
+                                    [int outputStart = 0]) {
+    _checkList(values);
+    _checkList(output);
+    _checkRange(values, start, end);
+    _checkSeparator(separator);
+    _checkRange(output, outputStart, output.length);
+    int elementSize = Int64List.BYTES_PER_ELEMENT;
+    return outputStart + values.buffer._formatInts(
+        values.offsetInBytes + start * elementSize,
+        values.offsetInBytes + end * elementSize,
+        separator,
+        output.buffer,
+        output.offsetInBytes + outputStart,
+        output.offsetInBytes + output.length);
+  }
+
+  // The bytes of the lists are read and written by natives of their
+  // buffers, so the lists must be implemented by the VM.
+  static void _checkList(list) {
+    if (list is! _TypedListBase) {
+      throw new ArgumentError(list);
+    }
+  }
+
+  static void _checkRange(List list, int start, int end) {
+    if (start is! int || start < 0 || start > list.length) {
+      throw new RangeError.range(start, 0, list.length);
+    }
+    if (end is! int || end < start || end > list.length) {
+      throw new RangeError.range(end, start, list.length);
+    }
+  }
+
+  static void _checkSeparator(int separator) {
+    if (separator is! int || separator < 0 || separator > 0xFF) {
+      throw new ArgumentError(separator);
+    }
+  }
+}
+
+
 // Based class for _TypedList that provides common methods for implementing
 // the collection and list interfaces.
 
 abstract class _TypedListBase {
   // Method(s) implementing the Collection interface.
-  bool contains(element) => IterableMixinWorkaround.contains(this, element);
+  bool contains(element) => indexOf(element) != -1;
 
   void forEach(void f(element)) {
     var len = this.length;
@@ -378,11 +496,31 @@ abstract class _TypedListBase {
   }
 
   int indexOf(element, [int start = 0]) {
-    return IterableMixinWorkaround.indexOfList(this, element, start);
+    if (start >= length) return -1;
+    if (start < 0) start = 0;
+    int elementSize = elementSizeInBytes;
+    int index = buffer._indexOf(this,
+                                element,
+                                offsetInBytes + start * elementSize,
+                                offsetInBytes + length * elementSize);
+    if (index == null) {
+      return IterableMixinWorkaround.indexOfList(this, element, start);
+    }
+    return (index < 0) ? index : start + index;
   }
 
   int lastIndexOf(element, [int start = null]) {
-    return IterableMixinWorkaround.lastIndexOfList(this, element, start);
+    if (start == null || start >= length) start = length - 1;
+    if (start < 0) return -1;
+    int elementSize = elementSizeInBytes;
+    int index = buffer._lastIndexOf(this,
+                                    element,
+                                    offsetInBytes,
+                                    offsetInBytes + (start + 1) * elementSize);
+    if (index == null) {
+      return IterableMixinWorkaround.lastIndexOfList(this, element, start);
+    }
+    return index;
   }
 
   void clear() {
@@ -479,7 +617,20 @@ abstract class _TypedListBase {
   }
 
   void fillRange(int start, int end, [fillValue]) {
-    IterableMixinWorkaround.fillRangeList(this, start, end, fillValue);
+    if (start < 0 || start > length) {
+      throw new RangeError.range(start, 0, length);
+    }
+    if (end < start || end > length) {
+      throw new RangeError.range(end, start, length);
+    }
+    if (start == end) return;
+    // The element setter checks and converts the value, and the bytes it
+    // stores are copied to the rest of the range.
+    this[start] = fillValue;
+    int elementSize = elementSizeInBytes;
+    buffer._fillRange(offsetInBytes + start * elementSize,
+                      offsetInBytes + end * elementSize,
+                      elementSize);
   }
 
 
@@ -519,6 +670,38 @@ abstract class _TypedList extends _TypedListBase implements ByteBuffer {
 
   // Internal utility methods.
 
+  // The bulk operations of [_TypedListBase] work on the bytes of the buffer
+  // of a list, from [startInBytes] to [endInBytes]. [list] is this list or
+  // a view on it.
+
+  void _fillRange(int startInBytes, int endInBytes, int elementSizeInBytes)
+      native "TypedData_fillRange";
+
+  // Return the index relative to [startInBytes], or -1. Return null if the
+  // elements of [list] or [element] are not integers.
+  int _indexOf(list, element, int startInBytes, int endInBytes)
+      native "TypedData_indexOf";
+  int _lastIndexOf(list, element, int startInBytes, int endInBytes)
+      native "TypedData_lastIndexOf";
+
+  // Return the number of numbers parsed into the 8-byte elements of [result]
+  // from [resultStartInBytes] to [resultEndInBytes].
+  int _parseDoubles(int startInBytes, int endInBytes, int separator,
+                    result, int resultStartInBytes, int resultEndInBytes)
+      native "TypedData_parseDoubles";
+  int _parseInts(int startInBytes, int endInBytes, int separator,
+                 result, int resultStartInBytes, int resultEndInBytes)
+      native "TypedData_parseInts";
+
+  // Return the number of bytes written to [output] from [outputStartInBytes].
+  int _formatDoubles(int startInBytes, int endInBytes, int separator,
+                     output, int outputStartInBytes, int outputEndInBytes,
+                     int fractionDigits)
+      native "TypedData_formatDoubles";
+  int _formatInts(int startInBytes, int endInBytes, int separator,
+                  output, int outputStartInBytes, int outputEndInBytes)
+      native "TypedData_formatInts";
+
   int _getInt8(int offsetInBytes) native "TypedData_GetInt8";
   void _setInt8(int offsetInBytes, int value) native "TypedData_SetInt8";
 
@@ -424,6 +424,16 @@ class Assembler : public ValueObject {
   void set1ps(XmmRegister dst, Register tmp, const Immediate& imm);
   void shufps(XmmRegister dst, XmmRegister src, const Immediate& mask);
 
+  void addpd(XmmRegister dst, XmmRegister src);
+  void subpd(XmmRegister dst, XmmRegister src);
+  void mulpd(XmmRegister dst, XmmRegister src);
+  void divpd(XmmRegister dst, XmmRegister src);
+  void unpcklpd(XmmRegister dst, XmmRegister src);
+  void unpckhpd(XmmRegister dst, XmmRegister src);
+
+  void cvtps2pd(XmmRegister dst, XmmRegister src);
+  void cvtpd2ps(XmmRegister dst, XmmRegister src);
+
   void cvtsi2ss(XmmRegister dst, Register src);
   void cvtsi2sd(XmmRegister dst, Register src);
 
@@ -707,6 +717,18 @@ class Assembler : public ValueObject {
   //   .....
   void EnterDartFrame(intptr_t frame_size);
 
+  // Take over the frame of unoptimized code at an OSR entry: the saved PC
+  // is replaced with one identifying the optimized code and the frame is
+  // resized to frame_size bytes of spill slots.  The locals of the
+  // unoptimized frame stay in place.
+  // This code sets this up with the sequence:
+  //   call L
+  //   L: popl eax
+  //   <code to adjust eax to the saved pc of a frame entered at entrypoint>
+  //   movl [ebp - kWordSize], eax
+  //   leal esp, [ebp - kWordSize - frame_size]
+  void EnterOsrFrame(intptr_t frame_size);
+
   // Set up a stub frame so that the stack traversal code can easily identify
   // a stub frame.
   // The stub frame layout is as follows:
@@ -892,6 +892,70 @@ ASSEMBLER_TEST_RUN(PackedFPOperations2, test) {
 }
 
 
+ASSEMBLER_TEST_GENERATE(PackedDoubleOperations, assembler) {
+  int64_t l = bit_cast<int64_t, double>(12.3);
+  __ movl(EAX, Immediate(Utils::High32Bits(l)));
+  __ pushl(EAX);
+  __ movl(EAX, Immediate(Utils::Low32Bits(l)));
+  __ pushl(EAX);
+  __ movsd(XMM0, Address(ESP, 0));
+  __ unpcklpd(XMM0, XMM0);  // 12.3, 12.3
+  __ popl(EAX);
+  __ popl(EAX);
+  l = bit_cast<int64_t, double>(3.4);
+  __ movl(EAX, Immediate(Utils::High32Bits(l)));
+  __ pushl(EAX);
+  __ movl(EAX, Immediate(Utils::Low32Bits(l)));
+  __ pushl(EAX);
+  __ movsd(XMM1, Address(ESP, 0));
+  __ unpcklpd(XMM1, XMM1);  // 3.4, 3.4
+  __ addpd(XMM0, XMM1);  // 15.7
+  __ mulpd(XMM0, XMM1);  // 53.38
+  __ subpd(XMM0, XMM1);  // 49.98
+  __ divpd(XMM0, XMM1);  // 14.7
+  __ unpckhpd(XMM0, XMM0);  // Copy the high lane into the low lane.
+  __ movsd(Address(ESP, 0), XMM0);
+  __ fldl(Address(ESP, 0));
+  __ popl(EAX);
+  __ popl(EAX);
+  __ ret();
+}
+
+
+ASSEMBLER_TEST_RUN(PackedDoubleOperations, test) {
+  typedef double (*PackedDoubleOperationsCode)();
+  double res = reinterpret_cast<PackedDoubleOperationsCode>(test->entry())();
+  EXPECT_FLOAT_EQ(14.7, res, 0.001);
+}
+
+
+ASSEMBLER_TEST_GENERATE(PackedSingleToDoubleConversion, assembler) {
+  __ movl(EAX, Immediate(bit_cast<int32_t, float>(2.5f)));
+  __ pushl(EAX);
+  __ movl(EAX, Immediate(bit_cast<int32_t, float>(1.0f)));
+  __ pushl(EAX);
+  __ movsd(XMM1, Address(ESP, 0));  // 1.0f, 2.5f
+  __ cvtps2pd(XMM1, XMM1);
+  __ addpd(XMM1, XMM1);  // 2.0, 5.0
+  __ cvtpd2ps(XMM1, XMM1);
+  __ cvtps2pd(XMM1, XMM1);
+  __ unpckhpd(XMM1, XMM1);
+  __ movsd(Address(ESP, 0), XMM1);
+  __ fldl(Address(ESP, 0));
+  __ popl(EAX);
+  __ popl(EAX);
+  __ ret();
+}
+
+
+ASSEMBLER_TEST_RUN(PackedSingleToDoubleConversion, test) {
+  typedef double (*PackedSingleToDoubleConversionCode)();
+  double res =
+      reinterpret_cast<PackedSingleToDoubleConversionCode>(test->entry())();
+  EXPECT_FLOAT_EQ(5.0, res, 0.001);
+}
+
+
 ASSEMBLER_TEST_GENERATE(PackedCompareEQ, assembler) {
   __ set1ps(XMM0, EAX, Immediate(bit_cast<int32_t, float>(2.0f)));
   __ set1ps(XMM1, EAX, Immediate(bit_cast<int32_t, float>(4.0f)));
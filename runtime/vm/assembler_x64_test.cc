@@ -1471,6 +1471,58 @@ ASSEMBLER_TEST_RUN(PackedFPOperations2, test) {
 }
 
 
+ASSEMBLER_TEST_GENERATE(PackedDoubleOperations, assembler) {
+  __ movq(RAX, Immediate(bit_cast<int64_t, double>(12.3)));
+  __ pushq(RAX);
+  __ movsd(XMM10, Address(RSP, 0));
+  __ unpcklpd(XMM10, XMM10);  // 12.3, 12.3
+  __ movq(RAX, Immediate(bit_cast<int64_t, double>(3.4)));
+  __ movq(Address(RSP, 0), RAX);
+  __ movsd(XMM11, Address(RSP, 0));
+  __ unpcklpd(XMM11, XMM11);  // 3.4, 3.4
+  __ addpd(XMM10, XMM11);  // 15.7
+  __ mulpd(XMM10, XMM11);  // 53.38
+  __ subpd(XMM10, XMM11);  // 49.98
+  __ divpd(XMM10, XMM11);  // 14.7
+  __ unpckhpd(XMM10, XMM10);  // Copy the high lane into the low lane.
+  __ movaps(XMM0, XMM10);
+  __ popq(RAX);
+  __ ret();
+}
+
+
+ASSEMBLER_TEST_RUN(PackedDoubleOperations, test) {
+  typedef double (*PackedDoubleOperationsCode)();
+  double res = reinterpret_cast<PackedDoubleOperationsCode>(test->entry())();
+  EXPECT_FLOAT_EQ(14.7, res, 0.001);
+}
+
+
+ASSEMBLER_TEST_GENERATE(PackedSingleToDoubleConversion, assembler) {
+  __ movq(RAX, Immediate(bit_cast<int32_t, float>(2.5f)));
+  __ shlq(RAX, Immediate(32));
+  __ orq(RAX, Immediate(bit_cast<int32_t, float>(1.0f)));
+  __ pushq(RAX);
+  __ movsd(XMM9, Address(RSP, 0));  // 1.0f, 2.5f
+  __ cvtps2pd(XMM9, XMM9);
+  __ addpd(XMM9, XMM9);  // 2.0, 5.0
+  __ cvtpd2ps(XMM9, XMM9);
+  __ cvtps2pd(XMM9, XMM9);
+  __ unpckhpd(XMM9, XMM9);
+  __ movaps(XMM0, XMM9);
+  __ popq(RAX);
+  __ ret();
+}
+
+
+ASSEMBLER_TEST_RUN(PackedSingleToDoubleConversion, test) {
+  typedef double (*PackedSingleToDoubleConversionCode)();
+  double res =
+      reinterpret_cast<PackedSingleToDoubleConversionCode>(test->entry())();
+  EXPECT_FLOAT_EQ(5.0, res, 0.001);
+}
+
+
 ASSEMBLER_TEST_GENERATE(PackedCompareEQ, assembler) {
   __ set1ps(XMM0, RAX, Immediate(bit_cast<int32_t, float>(2.0f)));
   __ set1ps(XMM1, RAX, Immediate(bit_cast<int32_t, float>(4.0f)));
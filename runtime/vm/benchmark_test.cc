@@ -5,6 +5,7 @@
 #include "vm/benchmark_test.h"
 
 #include "bin/file.h"
+#include "bin/filter.h"
 
 #include "platform/assert.h"
 
@@ -14,6 +15,11 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, use_osr);
+DECLARE_FLAG(bool, vectorize_loops);
+DECLARE_FLAG(bool, use_dispatch_table);
+DECLARE_FLAG(bool, hoist_bounds_checks);
+
 Benchmark* Benchmark::first_ = NULL;
 Benchmark* Benchmark::tail_ = NULL;
 const char* Benchmark::executable_ = NULL;
@@ -391,6 +397,263 @@ BENCHMARK(FrameLookup) {
 }
 
 
+//
+// Measure a single invocation of a function that spends its time in one
+// long running loop, which only runs optimized through on-stack replacement.
+//
+BENCHMARK(OSRLongLoop) {
+  const int kNumIterations = 100000000;
+  const char* kScriptChars =
+      "int sumOfSquares(int count) {\n"
+      "  int sum = 0;\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    sum = (sum + i * i) & 0x3FFFFFFF;\n"
+      "  }\n"
+      "  return sum;\n"
+      "}\n";
+  const bool saved_use_osr = FLAG_use_osr;
+  FLAG_use_osr = true;
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kNumIterations);
+  Timer timer(true, "OSRLongLoop benchmark");
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString("sumOfSquares"), 1, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  FLAG_use_osr = saved_use_osr;
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
+
+//
+// Measure loops over typed data arrays that the optimizing compiler
+// vectorizes.  The kernel is warmed up so that the timed invocation runs
+// optimized code.
+//
+static const char* kVectorizedLoopsScript =
+    "import 'dart:typed_data';\n"
+    "saxpy(double a, Float32List x, Float32List y) {\n"
+    "  for (int i = 0; i < x.length; i++) {\n"
+    "    y[i] = a * x[i] + y[i];\n"
+    "  }\n"
+    "}\n"
+    "double dot(Float64List x, Float64List y) {\n"
+    "  double sum = 0.0;\n"
+    "  for (int i = 0; i < x.length; i++) {\n"
+    "    sum += x[i] * y[i];\n"
+    "  }\n"
+    "  return sum;\n"
+    "}\n"
+    "scale(Float64List x, Float64List result) {\n"
+    "  for (int i = 0; i < x.length; i++) {\n"
+    "    result[i] = x[i] * 0.5 - 1.0;\n"
+    "  }\n"
+    "}\n"
+    "run(String kernel, int iterations) {\n"
+    "  var x32 = new Float32List(1000);\n"
+    "  var y32 = new Float32List(1000);\n"
+    "  var x64 = new Float64List(1000);\n"
+    "  var y64 = new Float64List(1000);\n"
+    "  for (int i = 0; i < 1000; i++) {\n"
+    "    x32[i] = x64[i] = i / 1000;\n"
+    "    y32[i] = y64[i] = 1.0 - i / 1000;\n"
+    "  }\n"
+    "  for (int i = 0; i < iterations; i++) {\n"
+    "    if (kernel == 'saxpy') saxpy(1e-6, x32, y32);\n"
+    "    if (kernel == 'dot') dot(x64, y64);\n"
+    "    if (kernel == 'scale') scale(x64, y64);\n"
+    "  }\n"
+    "}\n";
+
+
+static void RunVectorizedLoop(Benchmark* benchmark, const char* kernel) {
+  const int kWarmupIterations = 10000;
+  const int kNumIterations = 100000;
+  const bool saved_vectorize_loops = FLAG_vectorize_loops;
+  FLAG_vectorize_loops = true;
+  Dart_Handle lib = TestCase::LoadTestScript(kVectorizedLoopsScript, NULL);
+  Dart_Handle args[2];
+  args[0] = NewString(kernel);
+  args[1] = Dart_NewInteger(kWarmupIterations);
+  EXPECT_VALID(Dart_Invoke(lib, NewString("run"), 2, args));
+  args[1] = Dart_NewInteger(kNumIterations);
+  Timer timer(true, "Vectorized loop benchmark");
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString("run"), 2, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  FLAG_vectorize_loops = saved_vectorize_loops;
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
+
+BENCHMARK(VectorizedSaxpy) {
+  RunVectorizedLoop(benchmark, "saxpy");
+}
+
+
+BENCHMARK(VectorizedDotProduct) {
+  RunVectorizedLoop(benchmark, "dot");
+}
+
+
+BENCHMARK(VectorizedMap) {
+  RunVectorizedLoop(benchmark, "scale");
+}
+
+
+//
+// Measure a call site that sees receivers of 20 classes, so that optimized
+// code calls through the megamorphic cache or the dispatch table.
+//
+static const char* kMegamorphicCallScript =
+    "class C0 { int f() => 0; }\n"
+    "class C1 { int f() => 1; }\n"
+    "class C2 { int f() => 2; }\n"
+    "class C3 { int f() => 3; }\n"
+    "class C4 { int f() => 4; }\n"
+    "class C5 { int f() => 5; }\n"
+    "class C6 { int f() => 6; }\n"
+    "class C7 { int f() => 7; }\n"
+    "class C8 { int f() => 8; }\n"
+    "class C9 { int f() => 9; }\n"
+    "class C10 { int f() => 10; }\n"
+    "class C11 { int f() => 11; }\n"
+    "class C12 { int f() => 12; }\n"
+    "class C13 { int f() => 13; }\n"
+    "class C14 { int f() => 14; }\n"
+    "class C15 { int f() => 15; }\n"
+    "class C16 { int f() => 16; }\n"
+    "class C17 { int f() => 17; }\n"
+    "class C18 { int f() => 18; }\n"
+    "class C19 { int f() => 19; }\n"
+    "int callF(o) => o.f();\n"
+    "int run(List receivers, int iterations) {\n"
+    "  int sum = 0;\n"
+    "  for (int i = 0; i < iterations; i++) {\n"
+    "    for (int j = 0; j < receivers.length; j++) {\n"
+    "      sum += callF(receivers[j]);\n"
+    "    }\n"
+    "  }\n"
+    "  return sum;\n"
+    "}\n"
+    "int main(int iterations) {\n"
+    "  var receivers = [new C0(), new C1(), new C2(), new C3(), new C4(),\n"
+    "                   new C5(), new C6(), new C7(), new C8(), new C9(),\n"
+    "                   new C10(), new C11(), new C12(), new C13(),\n"
+    "                   new C14(), new C15(), new C16(), new C17(),\n"
+    "                   new C18(), new C19()];\n"
+    "  return run(receivers, iterations);\n"
+    "}\n";
+
+
+static void RunMegamorphicCall(Benchmark* benchmark, bool use_dispatch_table) {
+  const int kWarmupIterations = 1000;
+  const int kNumIterations = 1000000;
+  const bool saved_use_dispatch_table = FLAG_use_dispatch_table;
+  FLAG_use_dispatch_table = use_dispatch_table;
+  Dart_Handle lib = TestCase::LoadTestScript(kMegamorphicCallScript, NULL);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kWarmupIterations);
+  EXPECT_VALID(Dart_Invoke(lib, NewString("main"), 1, args));
+  args[0] = Dart_NewInteger(kNumIterations);
+  Timer timer(true, "Megamorphic call benchmark");
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 1, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  int64_t sum = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &sum));
+  EXPECT_EQ(190 * kNumIterations, sum);
+  FLAG_use_dispatch_table = saved_use_dispatch_table;
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
+
+BENCHMARK(MegamorphicCacheCall) {
+  RunMegamorphicCall(benchmark, false);
+}
+
+
+BENCHMARK(DispatchTableCall) {
+  RunMegamorphicCall(benchmark, true);
+}
+
+
+//
+// Measure loops that index a second array with the induction variable of a
+// loop bounded by the length of the first, so that the bounds checks can
+// only be removed by hoisting them out of the loop.
+//
+static const char* kBoundsCheckLoopsScript =
+    "import 'dart:typed_data';\n"
+    "copy(src, dst) {\n"
+    "  for (int i = 0; i < src.length; i++) {\n"
+    "    dst[i] = src[i] + dst[i];\n"
+    "  }\n"
+    "}\n"
+    "run(String kind, int iterations) {\n"
+    "  var src, dst;\n"
+    "  if (kind == 'typed_data') {\n"
+    "    src = new Float64List(1000);\n"
+    "    dst = new Float64List(1000);\n"
+    "  } else {\n"
+    "    src = new List(1000);\n"
+    "    dst = new List(1000);\n"
+    "  }\n"
+    "  for (int i = 0; i < 1000; i++) {\n"
+    "    src[i] = i / 1000;\n"
+    "    dst[i] = 0.0;\n"
+    "  }\n"
+    "  for (int i = 0; i < iterations; i++) {\n"
+    "    copy(src, dst);\n"
+    "  }\n"
+    "}\n";
+
+
+static void RunBoundsCheckLoop(Benchmark* benchmark,
+                               const char* kind,
+                               bool hoist_bounds_checks) {
+  const int kWarmupIterations = 1000;
+  const int kNumIterations = 50000;
+  const bool saved_hoist_bounds_checks = FLAG_hoist_bounds_checks;
+  FLAG_hoist_bounds_checks = hoist_bounds_checks;
+  Dart_Handle lib = TestCase::LoadTestScript(kBoundsCheckLoopsScript, NULL);
+  Dart_Handle args[2];
+  args[0] = NewString(kind);
+  args[1] = Dart_NewInteger(kWarmupIterations);
+  EXPECT_VALID(Dart_Invoke(lib, NewString("run"), 2, args));
+  args[1] = Dart_NewInteger(kNumIterations);
+  Timer timer(true, "Bounds check loop benchmark");
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString("run"), 2, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  FLAG_hoist_bounds_checks = saved_hoist_bounds_checks;
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
+
+BENCHMARK(TypedDataCheckedLoop) {
+  RunBoundsCheckLoop(benchmark, "typed_data", false);
+}
+
+
+BENCHMARK(TypedDataHoistedChecksLoop) {
+  RunBoundsCheckLoop(benchmark, "typed_data", true);
+}
+
+
+BENCHMARK(ListCheckedLoop) {
+  RunBoundsCheckLoop(benchmark, "list", false);
+}
+
+
+BENCHMARK(ListHoistedChecksLoop) {
+  RunBoundsCheckLoop(benchmark, "list", true);
+}
+
 static uint8_t* malloc_allocator(
     uint8_t* ptr, intptr_t old_size, intptr_t new_size) {
   return reinterpret_cast<uint8_t*>(realloc(ptr, new_size));
@@ -454,4 +717,690 @@ BENCHMARK(StandaloneSnapshotSize) {
   benchmark->set_score(snapshot->length());
 }
 
+
+//
+// Measure reading a large file fully into memory, both by copying it
+// into a buffer (as File_Read does) and by mapping it (as File_Map
+// does). The file read is the test executable itself.
+//
+static const int kFileReadIterations = 50;
+
+
+static intptr_t SumBytes(const uint8_t* data, intptr_t length) {
+  intptr_t sum = 0;
+  for (intptr_t i = 0; i < length; i++) {
+    sum += data[i];
+  }
+  return sum;
+}
+
+
+BENCHMARK(FileReadLarge) {
+  File* file = File::Open(Benchmark::Executable(), File::kRead);
+  EXPECT(file != NULL);
+  intptr_t length = file->Length();
+  Timer timer(true, "FileReadLarge benchmark");
+  timer.Start();
+  intptr_t sum = 0;
+  for (int i = 0; i < kFileReadIterations; i++) {
+    uint8_t* buffer = new uint8_t[length];
+    EXPECT(file->SetPosition(0));
+    EXPECT(file->ReadFully(buffer, length));
+    sum += SumBytes(buffer, length);
+    delete[] buffer;
+  }
+  timer.Stop();
+  EXPECT(sum >= 0);
+  delete file;
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
+
+BENCHMARK(FileMapLarge) {
+  File* file = File::Open(Benchmark::Executable(), File::kRead);
+  EXPECT(file != NULL);
+  intptr_t length = file->Length();
+  Timer timer(true, "FileMapLarge benchmark");
+  timer.Start();
+  intptr_t sum = 0;
+  for (int i = 0; i < kFileReadIterations; i++) {
+    MappedMemory* mapping = file->Map(length);
+    EXPECT(mapping != NULL);
+    sum += SumBytes(reinterpret_cast<uint8_t*>(mapping->address()), length);
+    delete mapping;
+  }
+  timer.Stop();
+  EXPECT(sum >= 0);
+  delete file;
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
+
+//
+// Measure gzip compression of a large HTTP body, fed to the filter in
+// chunks the size of the buffered HTTP output.
+//
+static const intptr_t kGZipBodySize = 16 * MB;
+static const intptr_t kGZipChunkSize = 8 * KB;
+
+
+BENCHMARK(GZipLargeBody) {
+  uint8_t* body = new uint8_t[kGZipBodySize];
+  intptr_t length = 0;
+  for (intptr_t row = 0; length < kGZipBodySize; row++) {
+    char line[128];
+    intptr_t line_length = OS::SNPrint(
+        line, sizeof(line),
+        "<tr><td class=\"id\">%" Pd "</td><td>item %" Pd "</td></tr>\n",
+        row, row % 1000);
+    line_length = Utils::Minimum(line_length, kGZipBodySize - length);
+    memmove(body + length, line, line_length);
+    length += line_length;
+  }
+  ZLibDeflateFilter filter(true, 6);
+  EXPECT(filter.Init());
+  Timer timer(true, "GZipLargeBody benchmark");
+  timer.Start();
+  intptr_t compressed = 0;
+  intptr_t read;
+  for (intptr_t offset = 0; offset < length; offset += kGZipChunkSize) {
+    filter.Process(body + offset, kGZipChunkSize);
+    while ((read = filter.Processed(filter.output_chunk(),
+                                    filter.output_chunk_size(),
+                                    false)) > 0) {
+      compressed += read;
+    }
+  }
+  filter.Process(NULL, 0);
+  while ((read = filter.Processed(filter.output_chunk(),
+                                  filter.output_chunk_size(),
+                                  true)) > 0) {
+    compressed += read;
+  }
+  timer.Stop();
+  EXPECT(compressed > 0);
+  EXPECT(compressed < length);
+  delete[] body;
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
+
+//
+// Measure decoding a corpus of JSON payloads shaped like the responses of
+// web APIs: a list of user records with repeated property names, a GeoJSON
+// feature collection dominated by numbers, and documents with long strings
+// that contain escapes and non-ASCII characters. The payloads are decoded
+// from strings and, in chunks, from UTF-8 encoded bytes.
+//
+static const char* kJsonCorpusScript =
+    "import 'dart:json' as json;\n"
+    "import 'dart:utf';\n"
+    "users() {\n"
+    "  var users = [];\n"
+    "  for (int i = 0; i < 500; i++) {\n"
+    "    users.add({'id': i, 'login': 'user$i', 'name': 'User Number $i',\n"
+    "               'email': 'user$i@example.com', 'admin': i % 10 == 0,\n"
+    "               'score': i * 1.5,\n"
+    "               'manager': i > 0 ? {'id': i - 1} : null,\n"
+    "               'tags': ['tag${i % 7}', 'tag${i % 11}'],\n"
+    "               'created': '2013-05-${10 + i % 20}T10:00:00Z'});\n"
+    "  }\n"
+    "  return json.stringify({'users': users, 'total': 500});\n"
+    "}\n"
+    "features() {\n"
+    "  var features = [];\n"
+    "  for (int i = 0; i < 200; i++) {\n"
+    "    var ring = [];\n"
+    "    for (int j = 0; j < 20; j++) {\n"
+    "      ring.add([-122.4 + i / 1000 + j / 7, 37.7 + j / 1000 - i / 9]);\n"
+    "    }\n"
+    "    features.add({'type': 'Feature', 'id': i,\n"
+    "                  'geometry': {'type': 'Polygon',\n"
+    "                               'coordinates': [ring]},\n"
+    "                  'properties': {'population': i * 1234567}});\n"
+    "  }\n"
+    "  return json.stringify({'type': 'FeatureCollection',\n"
+    "                         'features': features});\n"
+    "}\n"
+    "documents() {\n"
+    "  var documents = [];\n"
+    "  var text = 'Gr\\u00fc\\u00dfe \"quoted\"\\tand \\u20ac\\n' * 20;\n"
+    "  for (int i = 0; i < 100; i++) {\n"
+    "    documents.add({'title': 'Document $i', 'body': text,\n"
+    "                   'path': 'C:\\\\docs\\\\$i.txt'});\n"
+    "  }\n"
+    "  return json.stringify(documents);\n"
+    "}\n"
+    "final corpus = [users(), features(), documents()];\n"
+    "decodeStrings(int iterations) {\n"
+    "  var result;\n"
+    "  for (int i = 0; i < iterations; i++) {\n"
+    "    for (var payload in corpus) result = json.parse(payload);\n"
+    "  }\n"
+    "  return result.length;\n"
+    "}\n"
+    "final bytes = corpus.map(encodeUtf8).toList();\n"
+    "decodeBytes(int iterations) {\n"
+    "  var result;\n"
+    "  for (int i = 0; i < iterations; i++) {\n"
+    "    for (var payload in bytes) {\n"
+    "      var parser = new json.ChunkedJsonParser();\n"
+    "      for (int j = 0; j < payload.length; j += 4096) {\n"
+    "        var end = j + 4096 < payload.length ? j + 4096 : payload.length;\n"
+    "        parser.addBytes(payload.sublist(j, end));\n"
+    "      }\n"
+    "      result = parser.close();\n"
+    "    }\n"
+    "  }\n"
+    "  return result.length;\n"
+    "}\n";
+
+
+static void RunJsonDecode(Benchmark* benchmark, const char* function) {
+  const int kWarmupIterations = 5;
+  const int kNumIterations = 50;
+  Dart_Handle lib = TestCase::LoadTestScript(kJsonCorpusScript, NULL);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kWarmupIterations);
+  EXPECT_VALID(Dart_Invoke(lib, NewString(function), 1, args));
+  args[0] = Dart_NewInteger(kNumIterations);
+  Timer timer(true, "JSON decode benchmark");
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString(function), 1, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  int64_t length = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &length));
+  EXPECT_EQ(100, length);
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+
+BENCHMARK(JsonDecodeStrings) {
+  RunJsonDecode(benchmark, "decodeStrings");
+}
+
+
+BENCHMARK(JsonDecodeChunkedBytes) {
+  RunJsonDecode(benchmark, "decodeBytes");
+}
+
+
+static const char* kLogScanScript =
+    "makeLines(String separator) {\n"
+    "  var levels = ['INFO', 'DEBUG', 'WARN', 'ERROR'];\n"
+    "  var lines = [];\n"
+    "  for (int i = 0; i < 2000; i++) {\n"
+    "    lines.add('2013-05-${10 + i % 20} 10:${i % 60}:00 ${levels[i % 4]} '\n"
+    "              '[worker-${i % 8}] GET /api/v1/users/$i?Format=JSON '\n"
+    "              'status=${200 + i % 3} user=user$i${separator}'\n"
+    "              'latency=${i % 97}ms');\n"
+    "  }\n"
+    "  return lines;\n"
+    "}\n"
+    "final oneByteLines = makeLines(' ');\n"
+    "final twoByteLines = makeLines(' \\u2192 ');\n"
+    "scanLines(List lines, int iterations) {\n"
+    "  int count = 0;\n"
+    "  for (int i = 0; i < iterations; i++) {\n"
+    "    for (var line in lines) {\n"
+    "      if (line.contains('ERROR')) count++;\n"
+    "      var fields = line.split(' ');\n"
+    "      if (fields[2] == 'WARN') count++;\n"
+    "      if ((line.indexOf('user=') > 0) &&\n"
+    "          line.toLowerCase().contains('format=json')) {\n"
+    "        count++;\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "  return count ~/ iterations;\n"
+    "}\n"
+    "scanOneByte(int iterations) => scanLines(oneByteLines, iterations);\n"
+    "scanTwoByte(int iterations) => scanLines(twoByteLines, iterations);\n";
+
+
+static void RunLogScan(Benchmark* benchmark, const char* function) {
+  const int kWarmupIterations = 5;
+  const int kNumIterations = 100;
+  Dart_Handle lib = TestCase::LoadTestScript(kLogScanScript, NULL);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kWarmupIterations);
+  EXPECT_VALID(Dart_Invoke(lib, NewString(function), 1, args));
+  args[0] = Dart_NewInteger(kNumIterations);
+  Timer timer(true, "Log scan benchmark");
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString(function), 1, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  int64_t count = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &count));
+  EXPECT_EQ(3000, count);
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+
+BENCHMARK(StringScanOneByteLogLines) {
+  RunLogScan(benchmark, "scanOneByte");
+}
+
+
+BENCHMARK(StringScanTwoByteLogLines) {
+  RunLogScan(benchmark, "scanTwoByte");
+}
+
+
+static const char* kStringBuildingScript =
+    "renderTemplate(int iterations) {\n"
+    "  var length = 0;\n"
+    "  for (int i = 0; i < iterations; i++) {\n"
+    "    var out = new StringBuffer('<table>\\n');\n"
+    "    for (int id = 0; id < 1000; id++) {\n"
+    "      out.write('  <tr class=\"');\n"
+    "      out.write(id % 2 == 0 ? 'even' : 'odd');\n"
+    "      out.write('\"><td>');\n"
+    "      out.write(id);\n"
+    "      out.write('</td><td>Item ');\n"
+    "      out.write(id);\n"
+    "      out.write('</td><td>');\n"
+    "      out.write(id * 37);\n"
+    "      out.write('</td></tr>\\n');\n"
+    "    }\n"
+    "    out.write('</table>\\n');\n"
+    "    length = out.toString().length;\n"
+    "  }\n"
+    "  return length;\n"
+    "}\n"
+    "formatLog(int iterations) {\n"
+    "  var levels = ['INFO', 'DEBUG', 'WARN', 'ERROR'];\n"
+    "  var length = 0;\n"
+    "  for (int i = 0; i < iterations; i++) {\n"
+    "    var out = new StringBuffer();\n"
+    "    for (int line = 0; line < 2000; line++) {\n"
+    "      var level = levels[line % 4];\n"
+    "      out.writeCharCode(0x5B);\n"
+    "      out.write(level);\n"
+    "      out.writeCharCode(0x5D);\n"
+    "      for (int j = level.length; j < 6; j++) out.writeCharCode(0x20);\n"
+    "      out.write('worker-${line % 8}: request $line took ');\n"
+    "      out.write(line % 97);\n"
+    "      out.write('ms');\n"
+    "      out.writeCharCode(0x0A);\n"
+    "    }\n"
+    "    length = out.toString().length;\n"
+    "  }\n"
+    "  return length;\n"
+    "}\n";
+
+
+static void RunStringBuilding(Benchmark* benchmark,
+                              const char* function,
+                              int64_t expected_length) {
+  const int kWarmupIterations = 5;
+  const int kNumIterations = 100;
+  Dart_Handle lib = TestCase::LoadTestScript(kStringBuildingScript, NULL);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kWarmupIterations);
+  EXPECT_VALID(Dart_Invoke(lib, NewString(function), 1, args));
+  args[0] = Dart_NewInteger(kNumIterations);
+  Timer timer(true, "String building benchmark");
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString(function), 1, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  int64_t length = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &length));
+  EXPECT_EQ(expected_length, length);
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+
+BENCHMARK(StringBufferTemplateRendering) {
+  RunStringBuilding(benchmark, "renderTemplate", 66994);
+}
+
+
+BENCHMARK(StringBufferLogFormatting) {
+  RunStringBuilding(benchmark, "formatLog", 80680);
+}
+
+
+static const char* kStringHashScript =
+    "lookupKeys(String prefix, int iterations) {\n"
+    "  var map = {};\n"
+    "  for (int i = 0; i < 1000; i++) {\n"
+    "    map['$prefix$i'] = i;\n"
+    "  }\n"
+    "  int sum = 0;\n"
+    "  for (int n = 0; n < iterations; n++) {\n"
+    "    for (int i = 0; i < 1000; i++) {\n"
+    "      // A fresh key has no cached hash.\n"
+    "      sum += map['$prefix$i'];\n"
+    "    }\n"
+    "  }\n"
+    "  return sum ~/ iterations;\n"
+    "}\n"
+    "lookupOneByte(int iterations) =>\n"
+    "    lookupKeys('/api/v1/accounts/settings/notifications/' * 4,\n"
+    "               iterations);\n"
+    "final twoBytePrefix =\n"
+    "    '/api/v1/\\u043a\\u043b\\u044e\\u0447/notifications/' * 4;\n"
+    "lookupTwoByte(int iterations) => lookupKeys(twoBytePrefix, iterations);\n";
+
+
+static void RunStringHash(Benchmark* benchmark, const char* function) {
+  const int kWarmupIterations = 5;
+  const int kNumIterations = 200;
+  Dart_Handle lib = TestCase::LoadTestScript(kStringHashScript, NULL);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kWarmupIterations);
+  EXPECT_VALID(Dart_Invoke(lib, NewString(function), 1, args));
+  args[0] = Dart_NewInteger(kNumIterations);
+  Timer timer(true, "String hash benchmark");
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString(function), 1, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  int64_t sum = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &sum));
+  EXPECT_EQ(499500, sum);
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+
+BENCHMARK(StringHashOneByteKeys) {
+  RunStringHash(benchmark, "lookupOneByte");
+}
+
+
+BENCHMARK(StringHashTwoByteKeys) {
+  RunStringHash(benchmark, "lookupTwoByte");
+}
+
+
+static const char* kLinkedHashMapScript =
+    "import 'dart:collection';\n"
+    "lookupKeys(List keys, int iterations) {\n"
+    "  var map = new LinkedHashMap();\n"
+    "  for (int i = 0; i < keys.length; i++) {\n"
+    "    map[keys[i]] = i;\n"
+    "  }\n"
+    "  int sum = 0;\n"
+    "  for (int n = 0; n < iterations; n++) {\n"
+    "    for (int i = 0; i < keys.length; i++) {\n"
+    "      sum += map[keys[i]];\n"
+    "    }\n"
+    "  }\n"
+    "  return sum ~/ iterations;\n"
+    "}\n"
+    "lookupSmiKeys(int iterations) =>\n"
+    "    lookupKeys(new List.generate(1000, (i) => i * 7919), iterations);\n"
+    "final stringKeys = new List.generate(1000, (i) => 'session-$i');\n"
+    "lookupStringKeys(int iterations) => lookupKeys(stringKeys, iterations);\n"
+    "var retainedMap;\n"
+    "retainMap(int length) {\n"
+    "  retainedMap = new LinkedHashMap();\n"
+    "  for (int i = 0; i < length; i++) {\n"
+    "    retainedMap[i] = i;\n"
+    "  }\n"
+    "}\n";
+
+
+static void RunLinkedHashMapLookup(Benchmark* benchmark,
+                                   const char* function) {
+  const int kWarmupIterations = 5;
+  const int kNumIterations = 1000;
+  Dart_Handle lib = TestCase::LoadTestScript(kLinkedHashMapScript, NULL);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kWarmupIterations);
+  EXPECT_VALID(Dart_Invoke(lib, NewString(function), 1, args));
+  args[0] = Dart_NewInteger(kNumIterations);
+  Timer timer(true, "LinkedHashMap lookup benchmark");
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString(function), 1, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  int64_t sum = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &sum));
+  EXPECT_EQ(499500, sum);
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+
+BENCHMARK(LinkedHashMapLookupSmiKeys) {
+  RunLinkedHashMapLookup(benchmark, "lookupSmiKeys");
+}
+
+
+BENCHMARK(LinkedHashMapLookupStringKeys) {
+  RunLinkedHashMapLookup(benchmark, "lookupStringKeys");
+}
+
+
+// The score is the number of heap bytes per entry of a map with Smi keys
+// and values, which take no space of their own.
+BENCHMARK(LinkedHashMapMemoryPerEntry) {
+  const int kLength = 100000;
+  Dart_Handle lib = TestCase::LoadTestScript(kLinkedHashMapScript, NULL);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(0);
+  EXPECT_VALID(Dart_Invoke(lib, NewString("retainMap"), 1, args));
+  Heap* heap = Isolate::Current()->heap();
+  heap->CollectAllGarbage();
+  const intptr_t used_before = heap->Used(Heap::kNew) + heap->Used(Heap::kOld);
+  args[0] = Dart_NewInteger(kLength);
+  EXPECT_VALID(Dart_Invoke(lib, NewString("retainMap"), 1, args));
+  heap->CollectAllGarbage();
+  const intptr_t used_after = heap->Used(Heap::kNew) + heap->Used(Heap::kOld);
+  benchmark->set_score((used_after - used_before) / kLength);
+}
+
+
+static const char* kRegExpScript =
+    "const levels = const ['INFO', 'WARN', 'ERROR', 'DEBUG'];\n"
+    "final logLines = new List.generate(200, (i) =>\n"
+    "    '2013-05-${i % 28 + 1} 12:00:${i % 60} [${levels[i % 4]}] '\n"
+    "    'request $i served by host-${i % 7}');\n"
+    "final twoByteLogLines =\n"
+    "    logLines.map((line) => '$line \\u2192 ok').toList();\n"
+    "final routes = [\n"
+    "    new RegExp(r'\\[(WARN|ERROR)\\] request (\\d+)'),\n"
+    "    new RegExp(r'host-[0-3]\\b'),\n"
+    "    new RegExp(r'served by HOST-', caseSensitive: false),\n"
+    "    new RegExp(r'^(\\S+) (\\S+) \\[DEBUG\\]')];\n"
+    "countRoutes(List lines, int iterations) {\n"
+    "  int count = 0;\n"
+    "  for (int n = 0; n < iterations; n++) {\n"
+    "    for (int i = 0; i < lines.length; i++) {\n"
+    "      for (int j = 0; j < routes.length; j++) {\n"
+    "        if (routes[j].hasMatch(lines[i])) count++;\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "  return count ~/ iterations;\n"
+    "}\n"
+    "routeLogLines(int iterations) => countRoutes(logLines, iterations);\n"
+    "routeTwoByteLogLines(int iterations) =>\n"
+    "    countRoutes(twoByteLogLines, iterations);\n"
+    "final nested = new RegExp(r'(a+)+b');\n"
+    "final manyAs = 'a' * 24;\n"
+    "matchNestedQuantifiers(int iterations) {\n"
+    "  int count = 0;\n"
+    "  for (int n = 0; n < iterations; n++) {\n"
+    "    if (nested.hasMatch(manyAs)) count++;\n"
+    "    if (nested.hasMatch('${manyAs}b')) count++;\n"
+    "  }\n"
+    "  return count ~/ iterations;\n"
+    "}\n"
+    "final backreference =\n"
+    "    new RegExp(r'request (\\d+) served by host-\\1\\b');\n"
+    "matchBackreferences(int iterations) {\n"
+    "  int count = 0;\n"
+    "  for (int n = 0; n < iterations; n++) {\n"
+    "    for (int i = 0; i < logLines.length; i++) {\n"
+    "      if (backreference.hasMatch(logLines[i])) count++;\n"
+    "    }\n"
+    "  }\n"
+    "  return count ~/ iterations;\n"
+    "}\n";
+
+
+// Runs 'function' of kRegExpScript, which returns the number of matches
+// per iteration.
+static void RunRegExp(Benchmark* benchmark,
+                      const char* function,
+                      int64_t expected_matches) {
+  const int kWarmupIterations = 5;
+  const int kNumIterations = 100;
+  Dart_Handle lib = TestCase::LoadTestScript(kRegExpScript, NULL);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kWarmupIterations);
+  EXPECT_VALID(Dart_Invoke(lib, NewString(function), 1, args));
+  args[0] = Dart_NewInteger(kNumIterations);
+  Timer timer(true, "RegExp benchmark");
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString(function), 1, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  int64_t matches = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &matches));
+  EXPECT_EQ(expected_matches, matches);
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+
+BENCHMARK(RegExpRouteLogLines) {
+  RunRegExp(benchmark, "routeLogLines", 466);
+}
+
+
+BENCHMARK(RegExpRouteTwoByteLogLines) {
+  RunRegExp(benchmark, "routeTwoByteLogLines", 466);
+}
+
+
+// A pattern that takes a backtracking matcher exponential time to reject.
+BENCHMARK(RegExpNestedQuantifiers) {
+  RunRegExp(benchmark, "matchNestedQuantifiers", 1);
+}
+
+
+// Backreferences are matched by jscre.
+BENCHMARK(RegExpBackreferences) {
+  RunRegExp(benchmark, "matchBackreferences", 7);
+}
+
+
+// A CSV table of 2000 rows of 8 doubles, parsed and formatted by splitting
+// strings and by NumberText.
+static const char* kNumberTextScript =
+    "import 'dart:typeddata';\n"
+    "const int kRows = 2000;\n"
+    "const int kColumns = 8;\n"
+    "final values = new Float64List.fromList(\n"
+    "    new List.generate(kRows * kColumns,\n"
+    "        (i) => double.parse((i * 0.37).toStringAsFixed(2))));\n"
+    "final bytes = new Uint8List.fromList(formatRows().codeUnits);\n"
+    "final output = new Uint8List(bytes.length);\n"
+    "String formatRows() {\n"
+    "  var buffer = new StringBuffer();\n"
+    "  for (int i = 0; i < values.length; i++) {\n"
+    "    buffer.write(values[i].toStringAsFixed(2));\n"
+    "    buffer.write(((i + 1) % kColumns == 0) ? '\\n' : ',');\n"
+    "  }\n"
+    "  return buffer.toString();\n"
+    "}\n"
+    "parseWithStrings(int iterations) {\n"
+    "  int count = 0;\n"
+    "  for (int n = 0; n < iterations; n++) {\n"
+    "    int index = 0;\n"
+    "    var text = new String.fromCharCodes(bytes);\n"
+    "    for (var line in text.split('\\n')) {\n"
+    "      if (line.isEmpty) continue;\n"
+    "      for (var field in line.split(',')) {\n"
+    "        values[index++] = double.parse(field);\n"
+    "      }\n"
+    "    }\n"
+    "    count += index;\n"
+    "  }\n"
+    "  return count ~/ iterations;\n"
+    "}\n"
+    "parseWithNumberText(int iterations) {\n"
+    "  int count = 0;\n"
+    "  for (int n = 0; n < iterations; n++) {\n"
+    "    int index = 0;\n"
+    "    int start = 0;\n"
+    "    while (start < bytes.length) {\n"
+    "      int end = bytes.indexOf(10, start);\n"
+    "      if (end < 0) end = bytes.length;\n"
+    "      index += NumberText.parseDoubles(\n"
+    "          bytes, start, end, 44, values, index);\n"
+    "      start = end + 1;\n"
+    "    }\n"
+    "    count += index;\n"
+    "  }\n"
+    "  return count ~/ iterations;\n"
+    "}\n"
+    "formatWithStrings(int iterations) {\n"
+    "  int count = 0;\n"
+    "  for (int n = 0; n < iterations; n++) {\n"
+    "    var text = values.map((v) => v.toStringAsFixed(2)).join(',');\n"
+    "    output.setRange(0, text.length, text.codeUnits);\n"
+    "    count += text.length;\n"
+    "  }\n"
+    "  return count ~/ iterations;\n"
+    "}\n"
+    "formatWithNumberText(int iterations) {\n"
+    "  int count = 0;\n"
+    "  for (int n = 0; n < iterations; n++) {\n"
+    "    count += NumberText.formatDoubles(\n"
+    "        values, 0, values.length, 44, output, 0, 2);\n"
+    "  }\n"
+    "  return count ~/ iterations;\n"
+    "}\n";
+
+
+// Runs 'function' of kNumberTextScript, which returns the number of values
+// parsed or of bytes formatted per iteration.
+static void RunNumberText(Benchmark* benchmark,
+                          const char* function,
+                          int64_t expected_result) {
+  const int kWarmupIterations = 5;
+  const int kNumIterations = 50;
+  Dart_Handle lib = TestCase::LoadTestScript(kNumberTextScript, NULL);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kWarmupIterations);
+  EXPECT_VALID(Dart_Invoke(lib, NewString(function), 1, args));
+  args[0] = Dart_NewInteger(kNumIterations);
+  Timer timer(true, "NumberText benchmark");
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString(function), 1, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  int64_t value = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+  EXPECT_EQ(expected_result, value);
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+
+BENCHMARK(NumberTextParseCsvWithStrings) {
+  RunNumberText(benchmark, "parseWithStrings", 16000);
+}
+
+
+BENCHMARK(NumberTextParseCsv) {
+  RunNumberText(benchmark, "parseWithNumberText", 16000);
+}
+
+
+// The text of the table with commas instead of line feeds.
+BENCHMARK(NumberTextFormatCsvWithStrings) {
+  RunNumberText(benchmark, "formatWithStrings", 124997);
+}
+
+
+BENCHMARK(NumberTextFormatCsv) {
+  RunNumberText(benchmark, "formatWithNumberText", 124997);
+}
+
 }  // namespace dart
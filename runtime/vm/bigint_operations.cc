@@ -350,59 +350,119 @@ const char* BigintOperations::ToDecimalCString(
     required_size++;
   }
   ASSERT(required_size == static_cast<intptr_t>(required_size));
-  // We will fill the result in the inverse order and then exchange at the end.
   char* result =
       reinterpret_cast<char*>(allocator(static_cast<intptr_t>(required_size)));
   ASSERT(result != NULL);
-  int result_pos = 0;
-
-  // We divide the input into pieces of ~27 bits which can be efficiently
-  // handled.
-  const intptr_t kChunkDivisor = 100000000;
-  const int kChunkDigits = 8;
-  ASSERT(pow(10.0, kChunkDigits) == kChunkDivisor);
-  ASSERT(static_cast<Chunk>(kChunkDivisor) < kDigitMaxValue);
-  ASSERT(Smi::IsValid(kChunkDivisor));
-  const Bigint& divisor = Bigint::Handle(NewFromInt64(kChunkDivisor));
-
-  // Rest contains the remaining bigint that needs to be printed.
-  Bigint& rest = Bigint::Handle(bigint.raw());
+  intptr_t result_pos = 0;
+  if (bigint.IsNegative()) {
+    result[result_pos++] = '-';
+  }
+
+  if (length < kRadixConversionThreshold) {
+    result_pos = WriteDecimalSchoolbook(bigint, 0, result, result_pos);
+  } else {
+    // Divide and conquer: split the bigint at a power of ten with about half
+    // of its digits, and convert the quotient and the remainder separately.
+    // With the subquadratic multiplication and division this is much faster
+    // than repeatedly dividing the whole bigint by a small power of ten.
+    const Bigint* powers[kBitsPerWord];
+    intptr_t levels = 0;
+    powers[levels++] = &Bigint::Handle(NewFromInt64(kDecimalDivisor));
+    while (2 * powers[levels - 1]->Length() <= length) {
+      ASSERT(levels < kBitsPerWord);
+      const Bigint& power = *powers[levels - 1];
+      powers[levels++] = &Bigint::Handle(Multiply(power, power));
+    }
+    result_pos =
+        WriteDecimal(bigint, powers, levels - 1, 0, result, result_pos);
+  }
+  ASSERT(result_pos < required_size);
+  result[result_pos] = '\0';
+  return result;
+}
+
+
+intptr_t BigintOperations::WriteDecimal(const Bigint& bigint,
+                                        const Bigint** powers,
+                                        intptr_t level,
+                                        intptr_t width,
+                                        char* buffer,
+                                        intptr_t position) {
+  if ((level < 0) || (bigint.Length() < kRadixConversionThreshold)) {
+    return WriteDecimalSchoolbook(bigint, width, buffer, position);
+  }
+  const Bigint& power = *powers[level];
+  if ((width == 0) && (UnsignedCompare(bigint, power) < 0)) {
+    return WriteDecimal(bigint, powers, level - 1, 0, buffer, position);
+  }
+  // The remainder has exactly power_width digits once it is padded. The
+  // quotient is only padded if the bigint itself is.
+  const intptr_t power_width = kDecimalDivisorDigits << level;
   Bigint& quotient = Bigint::Handle();
   Bigint& remainder = Bigint::Handle();
-  while (!rest.IsZero()) {
-    DivideRemainder(rest, divisor, &quotient, &remainder);
-    ASSERT(remainder.Length() <= 1);
-    intptr_t part = (remainder.Length() == 1)
-        ? static_cast<intptr_t>(remainder.GetChunkAt(0))
-        : 0;
-    for (int i = 0; i < kChunkDigits; i++) {
-      result[result_pos++] = '0' + (part % 10);
+  DivideRemainder(bigint, power, &quotient, &remainder);
+  if (width == 0) {
+    // The quotient may still be larger than the power.
+    position = WriteDecimal(quotient, powers, level, 0, buffer, position);
+  } else {
+    ASSERT(width > power_width);
+    position = WriteDecimal(quotient, powers, level - 1, width - power_width,
+                            buffer, position);
+  }
+  return WriteDecimal(remainder, powers, level - 1, power_width,
+                      buffer, position);
+}
+
+
+intptr_t BigintOperations::WriteDecimalSchoolbook(const Bigint& bigint,
+                                                  intptr_t width,
+                                                  char* buffer,
+                                                  intptr_t position) {
+  // Repeatedly divide a copy of the digits by 10^9, which yields the decimal
+  // digits nine at a time, least significant first.
+  Zone* zone = Isolate::Current()->current_zone();
+  intptr_t length = bigint.Length();
+  Chunk* digits = zone->Alloc<Chunk>(length);
+  for (intptr_t i = 0; i < length; i++) {
+    digits[i] = bigint.GetChunkAt(i);
+  }
+  // Each digit has fewer than kDecimalDivisorDigits decimal digits.
+  char* decimals =
+      zone->Alloc<char>((length + 1) * kDecimalDivisorDigits);
+  intptr_t decimals_length = 0;
+  while (length > 0) {
+    DoubleChunk rest = 0;
+    for (intptr_t i = length - 1; i >= 0; i--) {
+      DoubleChunk current = (rest << kDigitBitSize) | digits[i];
+      digits[i] = static_cast<Chunk>(current / kDecimalDivisor);
+      rest = current % kDecimalDivisor;
+    }
+    while ((length > 0) && (digits[length - 1] == 0)) {
+      length--;
+    }
+    Chunk part = static_cast<Chunk>(rest);
+    for (intptr_t i = 0; i < kDecimalDivisorDigits; i++) {
+      decimals[decimals_length++] = '0' + (part % 10);
       part /= 10;
     }
     ASSERT(part == 0);
-    rest = quotient.raw();
   }
-  // Move the resulting position back until we don't have any zeroes anymore.
-  // This is done so that we can remove all leading zeroes.
-  while (result_pos > 1 && result[result_pos - 1] == '0') {
-    result_pos--;
+  // Remove the leading zeroes.
+  while ((decimals_length > 0) && (decimals[decimals_length - 1] == '0')) {
+    decimals_length--;
   }
-  if (bigint.IsNegative()) {
-    result[result_pos++] = '-';
+  if ((decimals_length == 0) && (width == 0)) {
+    buffer[position++] = '0';
+    return position;
   }
-  // Reverse the string.
-  int i = 0;
-  int j = result_pos - 1;
-  while (i < j) {
-    char tmp = result[i];
-    result[i] = result[j];
-    result[j] = tmp;
-    i++;
-    j--;
-  }
-  ASSERT(result_pos >= 0);
-  result[result_pos] = '\0';
-  return result;
+  ASSERT((width == 0) || (decimals_length <= width));
+  for (intptr_t i = decimals_length; i < width; i++) {
+    buffer[position++] = '0';
+  }
+  for (intptr_t i = decimals_length - 1; i >= 0; i--) {
+    buffer[position++] = decimals[i];
+  }
+  return position;
 }
 
 
@@ -707,6 +767,20 @@ RawBigint* BigintOperations::Multiply(const Bigint& a, const Bigint& b) {
     result.ToggleSign();
   }
 
+  if (Utils::Minimum(a_length, b_length) >= kKaratsubaThreshold) {
+    // The scratch space must be allocated before the addresses of the digits
+    // are taken.
+    Zone* zone = Isolate::Current()->current_zone();
+    Chunk* scratch =
+        zone->Alloc<Chunk>(KaratsubaScratchLength(a_length, b_length));
+    NoGCScope no_gc;
+    MultiplyDigits(a.ChunkAddr(0), a_length,
+                   b.ChunkAddr(0), b_length,
+                   result.ChunkAddr(0), scratch);
+    Clamp(result);
+    return result.raw();
+  }
+
   // Comba multiplication: compute each column separately.
   // Example: r = a2a1a0 * b2b1b0.
   //    r =  1    * a0b0 +
@@ -730,15 +804,8 @@ RawBigint* BigintOperations::Multiply(const Bigint& a, const Bigint& b) {
   const DoubleChunk kDoubleChunkMaxValue = static_cast<DoubleChunk>(-1);
   const DoubleChunk left_over_carry = kDoubleChunkMaxValue >> kDigitBitSize;
   const intptr_t kMaxDigits = (kDoubleChunkMaxValue - left_over_carry) / square;
-  if (Utils::Minimum(a_length, b_length) > kMaxDigits) {
-    // Use the preallocated out of memory exception to avoid calling
-    // into dart code or allocating any code.
-    Isolate* isolate = Isolate::Current();
-    const Instance& exception =
-        Instance::Handle(isolate->object_store()->out_of_memory());
-    Exceptions::Throw(exception);
-    UNREACHABLE();
-  }
+  // Larger factors use the Karatsuba multiplication above.
+  ASSERT(Utils::Minimum(a_length, b_length) <= kMaxDigits);
 
   DoubleChunk accumulator = 0;  // Accumulates the result of one column.
   for (intptr_t i = 0; i < result_length; i++) {
@@ -772,6 +839,150 @@ RawBigint* BigintOperations::Multiply(const Bigint& a, const Bigint& b) {
 }
 
 
+BigintOperations::Chunk BigintOperations::AddDigits(Chunk* a,
+                                                    intptr_t a_length,
+                                                    const Chunk* b,
+                                                    intptr_t b_length) {
+  ASSERT(b_length <= a_length);
+  Chunk carry = 0;
+  intptr_t i = 0;
+  for (; i < b_length; i++) {
+    Chunk sum = a[i] + b[i] + carry;
+    a[i] = sum & kDigitMask;
+    carry = sum >> kDigitBitSize;
+  }
+  for (; (carry != 0) && (i < a_length); i++) {
+    Chunk sum = a[i] + carry;
+    a[i] = sum & kDigitMask;
+    carry = sum >> kDigitBitSize;
+  }
+  return carry;
+}
+
+
+void BigintOperations::SubtractDigits(Chunk* a,
+                                      intptr_t a_length,
+                                      const Chunk* b,
+                                      intptr_t b_length) {
+  ASSERT(b_length <= a_length);
+  const int kSignBitPos = kChunkBitSize - 1;
+  Chunk borrow = 0;
+  intptr_t i = 0;
+  for (; i < b_length; i++) {
+    Chunk difference = a[i] - b[i] - borrow;
+    a[i] = difference & kDigitMask;
+    borrow = difference >> kSignBitPos;
+  }
+  for (; (borrow != 0) && (i < a_length); i++) {
+    Chunk difference = a[i] - borrow;
+    a[i] = difference & kDigitMask;
+    borrow = difference >> kSignBitPos;
+  }
+  ASSERT(borrow == 0);
+}
+
+
+void BigintOperations::SchoolbookMultiplyDigits(const Chunk* a,
+                                                intptr_t a_length,
+                                                const Chunk* b,
+                                                intptr_t b_length,
+                                                Chunk* result) {
+  for (intptr_t i = 0; i < a_length + b_length; i++) {
+    result[i] = 0;
+  }
+  // Each step computes digit * digit + digit + carry, which is at most
+  // (2^kDigitBitSize)^2 - 1, so the carry always fits into a digit.
+  for (intptr_t i = 0; i < a_length; i++) {
+    const DoubleChunk digit = a[i];
+    if (digit == 0) continue;
+    DoubleChunk carry = 0;
+    for (intptr_t j = 0; j < b_length; j++) {
+      DoubleChunk product = digit * b[j] + result[i + j] + carry;
+      result[i + j] = static_cast<Chunk>(product & kDigitMask);
+      carry = product >> kDigitBitSize;
+    }
+    result[i + b_length] = static_cast<Chunk>(carry);
+  }
+}
+
+
+void BigintOperations::MultiplyDigits(const Chunk* a,
+                                      intptr_t a_length,
+                                      const Chunk* b,
+                                      intptr_t b_length,
+                                      Chunk* result,
+                                      Chunk* scratch) {
+  if (a_length < b_length) {
+    MultiplyDigits(b, b_length, a, a_length, result, scratch);
+    return;
+  }
+  if (b_length < kKaratsubaThreshold) {
+    SchoolbookMultiplyDigits(a, a_length, b, b_length, result);
+    return;
+  }
+  const intptr_t result_length = a_length + b_length;
+  if (a_length >= 2 * b_length) {
+    // Multiply b with slices of a that have the length of b, and add up the
+    // partial products.
+    for (intptr_t i = 0; i < result_length; i++) {
+      result[i] = 0;
+    }
+    Chunk* product = scratch;
+    scratch += 2 * b_length;
+    for (intptr_t offset = 0; offset < a_length; offset += b_length) {
+      intptr_t slice_length = Utils::Minimum(b_length, a_length - offset);
+      MultiplyDigits(a + offset, slice_length, b, b_length, product, scratch);
+      Chunk carry = AddDigits(result + offset, result_length - offset,
+                              product, slice_length + b_length);
+      ASSERT(carry == 0);
+    }
+    return;
+  }
+
+  // Karatsuba multiplication. With a = a1 * B^h + a0 and b = b1 * B^h + b0:
+  //   a * b = a1b1 * B^2h + ((a0 + a1)(b0 + b1) - a0b0 - a1b1) * B^h + a0b0.
+  // This needs three multiplications of half the size instead of four.
+  const intptr_t half = (a_length + 1) / 2;
+  ASSERT(half <= b_length);
+  const intptr_t a1_length = a_length - half;
+  const intptr_t b1_length = b_length - half;
+  const intptr_t low_length = 2 * half;
+  const intptr_t high_length = a1_length + b1_length;
+  // a0b0 and a1b1 go directly into their place in the result.
+  MultiplyDigits(a, half, b, half, result, scratch);
+  MultiplyDigits(a + half, a1_length, b + half, b1_length,
+                 result + low_length, scratch);
+
+  const intptr_t sum_length = half + 1;
+  const intptr_t middle_length = 2 * sum_length;
+  Chunk* a_sum = scratch;
+  Chunk* b_sum = a_sum + sum_length;
+  Chunk* middle = b_sum + sum_length;
+  scratch = middle + middle_length;
+  for (intptr_t i = 0; i < half; i++) {
+    a_sum[i] = a[i];
+    b_sum[i] = b[i];
+  }
+  a_sum[half] = 0;
+  b_sum[half] = 0;
+  AddDigits(a_sum, sum_length, a + half, a1_length);
+  AddDigits(b_sum, sum_length, b + half, b1_length);
+  MultiplyDigits(a_sum, sum_length, b_sum, sum_length, middle, scratch);
+  SubtractDigits(middle, middle_length, result, low_length);
+  SubtractDigits(middle, middle_length, result + low_length, high_length);
+
+  // The middle term a0b1 + a1b0 fits into the result at h.
+  intptr_t used_middle_length = middle_length;
+  while ((used_middle_length > 0) && (middle[used_middle_length - 1] == 0)) {
+    used_middle_length--;
+  }
+  ASSERT(used_middle_length <= result_length - half);
+  Chunk carry = AddDigits(result + half, result_length - half,
+                          middle, used_middle_length);
+  ASSERT(carry == 0);
+}
+
+
 RawBigint* BigintOperations::Divide(const Bigint& a, const Bigint& b) {
   Bigint& quotient = Bigint::Handle();
   Bigint& remainder = Bigint::Handle();
@@ -804,6 +1015,202 @@ RawBigint* BigintOperations::Remainder(const Bigint& a, const Bigint& b) {
 }
 
 
+RawBigint* BigintOperations::ModPow(const Bigint& base,
+                                    const Bigint& exponent,
+                                    const Bigint& modulus) {
+  ASSERT(IsClamped(base));
+  ASSERT(IsClamped(exponent));
+  ASSERT(IsClamped(modulus));
+  ASSERT(!exponent.IsNegative());
+  ASSERT(!modulus.IsZero() && !modulus.IsNegative());
+  if ((modulus.Length() == 1) && (modulus.GetChunkAt(0) == 1)) {
+    return Zero();
+  }
+  if (exponent.IsZero()) {
+    return One();
+  }
+  const Bigint& reduced_base = Bigint::Handle(Modulo(base, modulus));
+  if ((modulus.GetChunkAt(0) & 1) != 0) {
+    return MontgomeryModPow(reduced_base, exponent, modulus);
+  }
+
+  // Montgomery reduction requires an odd modulus, which cryptographic moduli
+  // are. Even moduli use right-to-left square-and-multiply with divisions.
+  Bigint& result = Bigint::Handle(One());
+  Bigint& power = Bigint::Handle(reduced_base.raw());
+  Bigint& product = Bigint::Handle();
+  intptr_t exponent_bits = (exponent.Length() - 1) * kDigitBitSize +
+      CountBits(exponent.GetChunkAt(exponent.Length() - 1));
+  for (intptr_t i = 0; i < exponent_bits; i++) {
+    if (IsBitSet(exponent, i)) {
+      product = Multiply(result, power);
+      result = Modulo(product, modulus);
+    }
+    if (i + 1 < exponent_bits) {
+      product = Multiply(power, power);
+      power = Modulo(product, modulus);
+    }
+  }
+  return result.raw();
+}
+
+
+RawBigint* BigintOperations::MontgomeryModPow(const Bigint& base,
+                                              const Bigint& exponent,
+                                              const Bigint& modulus) {
+  // The powers are computed in Montgomery form, x * R mod modulus, in which
+  // a product is reduced without a division. All intermediate values live
+  // in preallocated digit arrays, so the loop does not allocate.
+  const intptr_t n = modulus.Length();
+  const Bigint& one = Bigint::Handle(One());
+  const Bigint& r_mod = Bigint::Handle(
+      Modulo(Bigint::Handle(DigitsShiftLeft(one, n)), modulus));
+  const Bigint& base_mod = Bigint::Handle(
+      Modulo(Bigint::Handle(DigitsShiftLeft(base, n)), modulus));
+
+  // Left-to-right sliding windows: the exponent is consumed in windows of
+  // up to window_bits bits that start and end with a one bit, using a table
+  // of the odd powers base^1, base^3, ..., base^(2^window_bits - 1).
+  const intptr_t exponent_bits = (exponent.Length() - 1) * kDigitBitSize +
+      CountBits(exponent.GetChunkAt(exponent.Length() - 1));
+  intptr_t window_bits = 1;
+  const intptr_t kWindowThresholds[] = { 7, 25, 81, 241, 673, 1793 };
+  const intptr_t kMaxWindowBits = ARRAY_SIZE(kWindowThresholds);
+  while ((window_bits <= kMaxWindowBits) &&
+         (exponent_bits > kWindowThresholds[window_bits - 1])) {
+    window_bits++;
+  }
+  const intptr_t table_length = 1 << (window_bits - 1);
+
+  Zone* zone = Isolate::Current()->current_zone();
+  Chunk* modulus_digits = zone->Alloc<Chunk>(n);
+  Chunk* table = zone->Alloc<Chunk>(table_length * n);
+  Chunk* result = zone->Alloc<Chunk>(n);
+  Chunk* square = zone->Alloc<Chunk>(n);
+  Chunk* scratch = zone->Alloc<Chunk>(n + 2);
+  for (intptr_t i = 0; i < n; i++) {
+    modulus_digits[i] = modulus.GetChunkAt(i);
+    table[i] = (i < base_mod.Length()) ? base_mod.GetChunkAt(i) : 0;
+    result[i] = (i < r_mod.Length()) ? r_mod.GetChunkAt(i) : 0;
+  }
+
+  // Newton's iteration for the inverse of the odd lowest digit modulo 2^32.
+  // Each step doubles the number of correct bits, starting with three.
+  const Chunk lowest_digit = modulus_digits[0];
+  Chunk inverse = lowest_digit;
+  for (intptr_t i = 0; i < 4; i++) {
+    inverse *= 2 - lowest_digit * inverse;
+  }
+  ASSERT(((lowest_digit * inverse) & kDigitMask) == 1);
+  inverse = (0 - inverse) & kDigitMask;
+
+  MontgomeryMultiply(table, table, modulus_digits, n, inverse,
+                     square, scratch);
+  for (intptr_t i = 1; i < table_length; i++) {
+    MontgomeryMultiply(table + (i - 1) * n, square, modulus_digits, n,
+                       inverse, table + i * n, scratch);
+  }
+
+  intptr_t bit = exponent_bits - 1;
+  while (bit >= 0) {
+    if (!IsBitSet(exponent, bit)) {
+      MontgomeryMultiply(result, result, modulus_digits, n, inverse,
+                         result, scratch);
+      bit--;
+      continue;
+    }
+    intptr_t window_end = Utils::Maximum(bit - window_bits + 1,
+                                         static_cast<intptr_t>(0));
+    while (!IsBitSet(exponent, window_end)) {
+      window_end++;
+    }
+    intptr_t window = 0;
+    for (intptr_t i = bit; i >= window_end; i--) {
+      MontgomeryMultiply(result, result, modulus_digits, n, inverse,
+                         result, scratch);
+      window = (window << 1) | (IsBitSet(exponent, i) ? 1 : 0);
+    }
+    MontgomeryMultiply(result, table + (window >> 1) * n, modulus_digits, n,
+                       inverse, result, scratch);
+    bit = window_end - 1;
+  }
+
+  // Leave the Montgomery form by multiplying with 1.
+  square[0] = 1;
+  for (intptr_t i = 1; i < n; i++) {
+    square[i] = 0;
+  }
+  MontgomeryMultiply(result, square, modulus_digits, n, inverse,
+                     result, scratch);
+  const Bigint& value = Bigint::Handle(Bigint::Allocate(n));
+  for (intptr_t i = 0; i < n; i++) {
+    value.SetChunkAt(i, result[i]);
+  }
+  Clamp(value);
+  return value.raw();
+}
+
+
+void BigintOperations::MontgomeryMultiply(const Chunk* a,
+                                          const Chunk* b,
+                                          const Chunk* modulus,
+                                          intptr_t n,
+                                          Chunk inverse,
+                                          Chunk* result,
+                                          Chunk* scratch) {
+  // Coarsely integrated operand scanning: after a[i] * b is added to the
+  // accumulator, the multiple of the modulus that clears its lowest digit
+  // is added, and the accumulator is shifted down by one digit.
+  Chunk* accumulator = scratch;
+  for (intptr_t i = 0; i < n + 2; i++) {
+    accumulator[i] = 0;
+  }
+  for (intptr_t i = 0; i < n; i++) {
+    const DoubleChunk digit = a[i];
+    DoubleChunk carry = 0;
+    for (intptr_t j = 0; j < n; j++) {
+      DoubleChunk sum = accumulator[j] + digit * b[j] + carry;
+      accumulator[j] = static_cast<Chunk>(sum & kDigitMask);
+      carry = sum >> kDigitBitSize;
+    }
+    DoubleChunk sum = accumulator[n] + carry;
+    accumulator[n] = static_cast<Chunk>(sum & kDigitMask);
+    accumulator[n + 1] = static_cast<Chunk>(sum >> kDigitBitSize);
+
+    const DoubleChunk factor =
+        (static_cast<DoubleChunk>(accumulator[0]) * inverse) & kDigitMask;
+    sum = accumulator[0] + factor * modulus[0];
+    ASSERT((sum & kDigitMask) == 0);
+    carry = sum >> kDigitBitSize;
+    for (intptr_t j = 1; j < n; j++) {
+      sum = accumulator[j] + factor * modulus[j] + carry;
+      accumulator[j - 1] = static_cast<Chunk>(sum & kDigitMask);
+      carry = sum >> kDigitBitSize;
+    }
+    sum = accumulator[n] + carry;
+    accumulator[n - 1] = static_cast<Chunk>(sum & kDigitMask);
+    accumulator[n] =
+        accumulator[n + 1] + static_cast<Chunk>(sum >> kDigitBitSize);
+  }
+
+  // The accumulator is smaller than twice the modulus.
+  bool needs_subtraction = (accumulator[n] != 0);
+  if (!needs_subtraction) {
+    intptr_t i = n - 1;
+    while ((i > 0) && (accumulator[i] == modulus[i])) {
+      i--;
+    }
+    needs_subtraction = (accumulator[i] >= modulus[i]);
+  }
+  if (needs_subtraction) {
+    SubtractDigits(accumulator, n + 1, modulus, n);
+  }
+  for (intptr_t i = 0; i < n; i++) {
+    result[i] = accumulator[i];
+  }
+}
+
+
 RawBigint* BigintOperations::ShiftLeft(const Bigint& bigint, intptr_t amount) {
   ASSERT(IsClamped(bigint));
   ASSERT(amount >= 0);
@@ -1471,9 +1878,6 @@ RawBigint* BigintOperations::MultiplyWithDigit(
 
 void BigintOperations::DivideRemainder(
     const Bigint& a, const Bigint& b, Bigint* quotient, Bigint* remainder) {
-  // TODO(floitsch): This function is very memory-intensive since all
-  // intermediate bigint results are allocated in new memory. It would be
-  // much more efficient to reuse the space of temporary intermediate variables.
   ASSERT(IsClamped(a));
   ASSERT(IsClamped(b));
   ASSERT(!b.IsZero());
@@ -1490,151 +1894,257 @@ void BigintOperations::DivideRemainder(
     return;
   }
 
-  // High level description:
-  // The algorithm is basically the algorithm that is taught in school:
-  // Let a the dividend and b the divisor. We are looking for
-  // the quotient q = truncate(a / b), and
-  // the remainder r = a - q * b.
-  // School algorithm:
-  // q = 0
-  // n = number_of_digits(a) - number_of_digits(b)
-  // for (i = n; i >= 0; i--) {
-  //   Maximize k such that k*y*10^i is less than or equal to a and
-  //                  (k + 1)*y*10^i is greater.
-  //   q = q + k * 10^i   // Add new digit to result.
-  //   a = a - k * b * 10^i
-  // }
-  // r = a
-  //
-  // Instead of working in base 10 we work in base kDigitBitSize.
-
+  // The schoolbook division is quadratic in the length of the quotient and
+  // of the divisor. If both are long, the recursive division is faster.
   intptr_t b_length = b.Length();
+  if ((b_length >= kBurnikelZieglerThreshold) &&
+      (a.Length() - b_length >= kBurnikelZieglerThreshold)) {
+    RecursiveDivideRemainder(a, b, quotient, remainder);
+  } else {
+    UnsignedDivideRemainder(a, b, quotient, remainder);
+  }
+  quotient->SetSign(a.IsNegative() != b.IsNegative());
+  remainder->SetSign(a.IsNegative());
+}
+
+
+void BigintOperations::UnsignedDivideRemainder(
+    const Bigint& a, const Bigint& b, Bigint* quotient, Bigint* remainder) {
+  ASSERT(IsClamped(a));
+  ASSERT(IsClamped(b));
+  ASSERT(!b.IsZero());
+  if (UnsignedCompare(a, b) < 0) {
+    (*quotient) = Zero();
+    (*remainder) = Copy(a);
+    remainder->SetSign(false);
+    return;
+  }
+
+  // Normalize the divisor such that its most significant bit is set. This
+  // makes the estimates of the quotient digits in DivideDigits precise.
+  intptr_t divisor_length = b.Length();
   int normalization_shift =
-      kDigitBitSize - CountBits(b.GetChunkAt(b_length - 1));
-  Bigint& dividend = Bigint::Handle(ShiftLeft(a, normalization_shift));
+      kDigitBitSize - CountBits(b.GetChunkAt(divisor_length - 1));
   const Bigint& divisor = Bigint::Handle(ShiftLeft(b, normalization_shift));
-  dividend.SetSign(false);
-  divisor.SetSign(false);
+  const Bigint& shifted_a = Bigint::Handle(ShiftLeft(a, normalization_shift));
+  ASSERT(divisor.Length() == divisor_length);
+
+  // The dividend gets an additional leading zero digit, which is smaller
+  // than the leading digit of the divisor.
+  intptr_t shifted_a_length = shifted_a.Length();
+  intptr_t dividend_length = shifted_a_length + 1;
+  const Bigint& dividend = Bigint::Handle(Bigint::Allocate(dividend_length));
+  intptr_t quotient_length = dividend_length - divisor_length;
+  *quotient = Bigint::Allocate(quotient_length);
+  {
+    NoGCScope no_gc;
+    Chunk* dividend_digits = dividend.ChunkAddr(0);
+    for (intptr_t i = 0; i < shifted_a_length; i++) {
+      dividend_digits[i] = shifted_a.GetChunkAt(i);
+    }
+    dividend_digits[shifted_a_length] = 0;
+    DivideDigits(dividend_digits, dividend_length,
+                 divisor.ChunkAddr(0), divisor_length,
+                 quotient->ChunkAddr(0));
+  }
+  Clamp(*quotient);
+  dividend.SetLength(divisor_length);
+  Clamp(dividend);
+  *remainder = ShiftRight(dividend, normalization_shift);
+}
 
-  intptr_t dividend_length = dividend.Length();
-  intptr_t divisor_length = b_length;
-  ASSERT(divisor_length == divisor.Length());
 
-  intptr_t quotient_length = dividend_length - divisor_length + 1;
-  *quotient = Bigint::Allocate(quotient_length);
-  quotient->SetSign(a.IsNegative() != b.IsNegative());
+void BigintOperations::DivideDigits(Chunk* dividend,
+                                    intptr_t dividend_length,
+                                    const Chunk* divisor,
+                                    intptr_t divisor_length,
+                                    Chunk* quotient) {
+  // This is algorithm D of Knuth, TAOCP Vol. 2, 4.3.1: every quotient digit
+  // is estimated from the leading digits, which is at most one too large,
+  // and the divisor times the estimate is then subtracted from the
+  // dividend.
+  const intptr_t n = divisor_length;
+  ASSERT(n >= 1);
+  ASSERT((divisor[n - 1] >> (kDigitBitSize - 1)) == 1);
+  ASSERT(dividend[dividend_length - 1] < divisor[n - 1]);
+  const int kSignBitPos = kChunkBitSize - 1;
+  const DoubleChunk first_divisor_digit = divisor[n - 1];
+  const DoubleChunk second_divisor_digit = (n > 1) ? divisor[n - 2] : 0;
+  for (intptr_t j = dividend_length - n - 1; j >= 0; j--) {
+    // The digits [j, j + n] of the dividend are smaller than the divisor
+    // times the digit base.
+    Chunk* window = dividend + j;
+    DoubleChunk two_digits = window[n];
+    two_digits = (two_digits << kDigitBitSize) | window[n - 1];
+    DoubleChunk estimate = two_digits / first_divisor_digit;
+    DoubleChunk rest = two_digits % first_divisor_digit;
+    DoubleChunk third_digit = (n > 1) ? window[n - 2] : 0;
+    while ((estimate > kDigitMaxValue) ||
+           (estimate * second_divisor_digit >
+            ((rest << kDigitBitSize) | third_digit))) {
+      estimate--;
+      rest += first_divisor_digit;
+      if (rest > kDigitMaxValue) break;
+    }
 
-  intptr_t quotient_pos = dividend_length - divisor_length;
-  // Find the first quotient-digit.
-  // The first digit must be computed separately from the other digits because
-  // the preconditions for the loop are not yet satisfied.
-  // For simplicity use a shifted divisor, so that the comparison and
-  // subtraction are easier.
-  int divisor_shift_amount = dividend_length - divisor_length;
-  Bigint& shifted_divisor =
-      Bigint::Handle(DigitsShiftLeft(divisor, divisor_shift_amount));
-  Chunk first_quotient_digit = 0;
-  while (UnsignedCompare(dividend, shifted_divisor) >= 0) {
-    first_quotient_digit++;
-    dividend = Subtract(dividend, shifted_divisor);
-  }
-  quotient->SetChunkAt(quotient_pos--, first_quotient_digit);
-
-  // Find the remainder of the digits.
-
-  Chunk first_divisor_digit = divisor.GetChunkAt(divisor_length - 1);
-  // The short divisor only represents the first two digits of the divisor.
-  // If the divisor has only one digit, then the second part is zeroed out.
-  Bigint& short_divisor = Bigint::Handle(Bigint::Allocate(2));
-  if (divisor_length > 1) {
-    short_divisor.SetChunkAt(0, divisor.GetChunkAt(divisor_length - 2));
-  } else {
-    short_divisor.SetChunkAt(0, 0);
-  }
-  short_divisor.SetChunkAt(1, first_divisor_digit);
-  // The following bigint will be used inside the loop. It is allocated outside
-  // the loop to avoid repeated allocations.
-  Bigint& target = Bigint::Handle(Bigint::Allocate(3));
-  // The dividend_length here must be from the initial dividend.
-  for (intptr_t i = dividend_length - 1; i >= divisor_length; i--) {
-    // Invariant: let t = i - divisor_length
-    //   then dividend / (divisor << (t * kDigitBitSize)) <= kDigitMaxValue.
-    // Ex: dividend: 53451232, and divisor: 535  (with t == 5) is ok.
-    //     dividend: 56822123, and divisor: 563  (with t == 5) is bad.
-    //     dividend:  6822123, and divisor: 563  (with t == 5) is ok.
-
-    // The dividend has changed. So recompute its length.
-    dividend_length = dividend.Length();
-    Chunk dividend_digit;
-    if (i > dividend_length) {
-      quotient->SetChunkAt(quotient_pos--, 0);
-      continue;
-    } else if (i == dividend_length) {
-      dividend_digit = 0;
-    } else {
-      ASSERT(i + 1 == dividend_length);
-      dividend_digit = dividend.GetChunkAt(i);
+    DoubleChunk carry = 0;
+    Chunk borrow = 0;
+    for (intptr_t i = 0; i < n; i++) {
+      DoubleChunk product = estimate * divisor[i] + carry;
+      carry = product >> kDigitBitSize;
+      Chunk difference =
+          window[i] - static_cast<Chunk>(product & kDigitMask) - borrow;
+      window[i] = difference & kDigitMask;
+      borrow = difference >> kSignBitPos;
     }
-    Chunk quotient_digit;
-    // Compute an estimate of the quotient_digit. The estimate will never
-    // be too small.
-    if (dividend_digit == first_divisor_digit) {
-      // Small shortcut: the else-branch would compute a value > kDigitMaxValue.
-      // However, by hypothesis, we know that the quotient_digit must fit into
-      // a digit. Avoid going through repeated iterations of the adjustment
-      // loop by directly assigning kDigitMaxValue to the quotient_digit.
-      // Ex:  51235 / 523.
-      //    51 / 5 would yield 10 (if computed in the else branch).
-      // However we know that 9 is the maximal value.
-      quotient_digit = kDigitMaxValue;
-    } else {
-      // Compute the estimate by using two digits of the dividend and one of
-      // the divisor.
-      // Ex: 32421 / 535
-      //    32 / 5 -> 6
-      // The estimate would hence be 6.
-      DoubleChunk two_dividend_digits = dividend_digit;
-      two_dividend_digits <<= kDigitBitSize;
-      two_dividend_digits += dividend.GetChunkAt(i - 1);
-      DoubleChunk q = two_dividend_digits / first_divisor_digit;
-      if (q > kDigitMaxValue) q = kDigitMaxValue;
-      quotient_digit = static_cast<Chunk>(q);
+    Chunk difference = window[n] - static_cast<Chunk>(carry) - borrow;
+    window[n] = difference & kDigitMask;
+    if ((difference >> kSignBitPos) != 0) {
+      // The estimate was one too large. Add the divisor back.
+      estimate--;
+      Chunk add_carry = 0;
+      for (intptr_t i = 0; i < n; i++) {
+        Chunk sum = window[i] + divisor[i] + add_carry;
+        window[i] = sum & kDigitMask;
+        add_carry = sum >> kDigitBitSize;
+      }
+      window[n] = (window[n] + add_carry) & kDigitMask;
     }
+    ASSERT(estimate <= kDigitMaxValue);
+    quotient[j] = static_cast<Chunk>(estimate);
+  }
+}
 
-    // Refine estimation.
-    quotient_digit++;  // The following loop will start by decrementing.
-    Bigint& estimation_product = Bigint::Handle();
-    target.SetChunkAt(0, ((i - 2) < 0) ? 0 : dividend.GetChunkAt(i - 2));
-    target.SetChunkAt(1, ((i - 1) < 0) ? 0 : dividend.GetChunkAt(i - 1));
-    target.SetChunkAt(2, dividend_digit);
-    do {
-      quotient_digit = (quotient_digit - 1) & kDigitMask;
-      estimation_product = MultiplyWithDigit(short_divisor, quotient_digit);
-    } while (UnsignedCompareNonClamped(estimation_product, target) > 0);
-    // At this point the quotient_digit is fairly accurate.
-    // At the worst it is off by one.
-    // Remove a multiple of the divisor. If the estimate is incorrect we will
-    // subtract the divisor another time.
-    // Let t = i - divisor_length.
-    // dividend -= (quotient_digit * divisor) << (t * kDigitBitSize);
-    shifted_divisor = MultiplyWithDigit(divisor, quotient_digit);
-    shifted_divisor = DigitsShiftLeft(shifted_divisor, i - divisor_length);
-    dividend = Subtract(dividend, shifted_divisor);
-    if (dividend.IsNegative()) {
-      // The estimation was still too big.
-      quotient_digit--;
-      // TODO(floitsch): allocate space for the shifted_divisor once and reuse
-      // it at every iteration.
-      shifted_divisor = DigitsShiftLeft(divisor, i - divisor_length);
-      // TODO(floitsch): reuse the space of the previous dividend.
-      dividend = Add(dividend, shifted_divisor);
+
+RawBigint* BigintOperations::DigitsSlice(const Bigint& bigint,
+                                         intptr_t from,
+                                         intptr_t count) {
+  intptr_t bigint_length = bigint.Length();
+  if (from >= bigint_length) {
+    return Zero();
+  }
+  intptr_t slice_length = Utils::Minimum(count, bigint_length - from);
+  const Bigint& result = Bigint::Handle(Bigint::Allocate(slice_length));
+  for (intptr_t i = 0; i < slice_length; i++) {
+    result.SetChunkAt(i, bigint.GetChunkAt(from + i));
+  }
+  Clamp(result);
+  return result.raw();
+}
+
+
+void BigintOperations::RecursiveDivideRemainder(
+    const Bigint& a, const Bigint& b, Bigint* quotient, Bigint* remainder) {
+  // Burnikel and Ziegler, "Fast Recursive Division", 1998. The dividend is
+  // divided in the base B^n, where n is the length of the divisor. Each
+  // quotient block of n digits is computed by Divide2n1n, which recursively
+  // splits the division into two divisions of half the size, and whose cost
+  // is dominated by the Karatsuba multiplications.
+  intptr_t n = b.Length();
+  int normalization_shift = kDigitBitSize - CountBits(b.GetChunkAt(n - 1));
+  const Bigint& divisor = Bigint::Handle(ShiftLeft(b, normalization_shift));
+  const Bigint& dividend = Bigint::Handle(ShiftLeft(a, normalization_shift));
+  divisor.SetSign(false);
+  dividend.SetSign(false);
+  ASSERT(divisor.Length() == n);
+
+  intptr_t blocks = (dividend.Length() + n - 1) / n;
+  const Bigint& result = Bigint::Handle(Bigint::Allocate(blocks * n));
+  Bigint& rest = Bigint::Handle(Zero());
+  Bigint& block = Bigint::Handle();
+  Bigint& block_quotient = Bigint::Handle();
+  for (intptr_t i = blocks - 1; i >= 0; i--) {
+    // The rest is smaller than the divisor, so the block is smaller than
+    // the divisor times B^n.
+    block = DigitsSlice(dividend, i * n, n);
+    block = Add(Bigint::Handle(DigitsShiftLeft(rest, n)), block);
+    Divide2n1n(block, divisor, n, &block_quotient, &rest);
+    intptr_t block_quotient_length = block_quotient.Length();
+    ASSERT(block_quotient_length <= n);
+    for (intptr_t j = 0; j < n; j++) {
+      Chunk digit =
+          (j < block_quotient_length) ? block_quotient.GetChunkAt(j) : 0;
+      result.SetChunkAt(i * n + j, digit);
     }
-    quotient->SetChunkAt(quotient_pos--, quotient_digit);
   }
-  ASSERT(quotient_pos == -1);
-  Clamp(*quotient);
-  *remainder = ShiftRight(dividend, normalization_shift);
-  remainder->SetSign(a.IsNegative());
+  Clamp(result);
+  *quotient = result.raw();
+  *remainder = ShiftRight(rest, normalization_shift);
+}
+
+
+void BigintOperations::Divide2n1n(const Bigint& a,
+                                  const Bigint& b,
+                                  intptr_t n,
+                                  Bigint* quotient,
+                                  Bigint* remainder) {
+  ASSERT(b.Length() == n);
+  if (n < kBurnikelZieglerThreshold) {
+    UnsignedDivideRemainder(a, b, quotient, remainder);
+    return;
+  }
+  if ((n & 1) != 0) {
+    // Multiply both operands by B, so that the divisor splits evenly.
+    const Bigint& padded_a = Bigint::Handle(DigitsShiftLeft(a, 1));
+    const Bigint& padded_b = Bigint::Handle(DigitsShiftLeft(b, 1));
+    Divide2n1n(padded_a, padded_b, n + 1, quotient, remainder);
+    *remainder = ShiftRight(*remainder, kDigitBitSize);
+    return;
+  }
+  intptr_t half = n / 2;
+  const Bigint& b1 = Bigint::Handle(DigitsSlice(b, half, half));
+  const Bigint& b2 = Bigint::Handle(DigitsSlice(b, 0, half));
+  // With a = [a1 a2 a3 a4] in digits of B^half, first divide [a1 a2 a3] and
+  // then the remainder followed by a4.
+  const Bigint& a12 = Bigint::Handle(DigitsSlice(a, n, n));
+  const Bigint& a3 = Bigint::Handle(DigitsSlice(a, half, half));
+  const Bigint& a4 = Bigint::Handle(DigitsSlice(a, 0, half));
+  Bigint& high_quotient = Bigint::Handle();
+  Bigint& rest = Bigint::Handle();
+  Divide3n2n(a12, a3, b, b1, b2, half, &high_quotient, &rest);
+  Bigint& low_quotient = Bigint::Handle();
+  Divide3n2n(rest, a4, b, b1, b2, half, &low_quotient, remainder);
+  *quotient = Add(Bigint::Handle(DigitsShiftLeft(high_quotient, half)),
+                  low_quotient);
+}
+
+
+void BigintOperations::Divide3n2n(const Bigint& a12,
+                                  const Bigint& a3,
+                                  const Bigint& b,
+                                  const Bigint& b1,
+                                  const Bigint& b2,
+                                  intptr_t n,
+                                  Bigint* quotient,
+                                  Bigint* remainder) {
+  // Estimate the quotient by dividing a12 by b1. The estimate is at most
+  // two too large, since b1 is normalized.
+  Bigint& rest = Bigint::Handle();
+  const Bigint& a1 = Bigint::Handle(DigitsSlice(a12, n, n));
+  if (UnsignedCompare(a1, b1) == 0) {
+    // The quotient of a12 by b1 would not fit into n digits. Use the
+    // largest n-digit value instead, B^n - 1.
+    *quotient = Bigint::Allocate(n);
+    for (intptr_t i = 0; i < n; i++) {
+      quotient->SetChunkAt(i, kDigitMaxValue);
+    }
+    rest = Subtract(a12, Bigint::Handle(DigitsShiftLeft(b1, n)));
+    rest = Add(rest, b1);
+  } else {
+    Divide2n1n(a12, b1, n, quotient, &rest);
+  }
+  // The remainder is rest * B^n + a3 - quotient * b2. It is negative if the
+  // estimate is too large.
+  rest = Add(Bigint::Handle(DigitsShiftLeft(rest, n)), a3);
+  rest = Subtract(rest, Bigint::Handle(Multiply(*quotient, b2)));
+  if (rest.IsNegative()) {
+    const Bigint& one = Bigint::Handle(One());
+    do {
+      *quotient = Subtract(*quotient, one);
+      rest = Add(rest, b);
+    } while (rest.IsNegative());
+  }
+  *remainder = rest.raw();
 }
 
 
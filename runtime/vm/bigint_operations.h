@@ -85,6 +85,11 @@ class BigintOperations : public AllStatic {
   static RawBigint* Divide(const Bigint& a, const Bigint& b);
   static RawBigint* Modulo(const Bigint& a, const Bigint& b);
   static RawBigint* Remainder(const Bigint& a, const Bigint& b);
+  // Returns base^exponent mod modulus, which is in the range [0, modulus).
+  // The exponent must not be negative and the modulus must be positive.
+  static RawBigint* ModPow(const Bigint& base,
+                           const Bigint& exponent,
+                           const Bigint& modulus);
 
   static RawBigint* ShiftLeft(const Bigint& bigint, intptr_t amount);
   static RawBigint* ShiftRight(const Bigint& bigint, intptr_t amount);
@@ -111,6 +116,19 @@ class BigintOperations : public AllStatic {
   static const int kChunkBitSize = kChunkSize * kBitsPerByte;
   static const int kHexCharsPerDigit = kDigitBitSize / 4;
 
+  // Multiplications where both factors have at least this many digits use
+  // the Karatsuba algorithm.
+  static const intptr_t kKaratsubaThreshold = 40;
+  // Divisions where the divisor and the quotient have at least this many
+  // digits use the recursive algorithm of Burnikel and Ziegler.
+  static const intptr_t kBurnikelZieglerThreshold = 40;
+  // Bigints with at least this many digits are converted to decimal by
+  // recursively splitting them at powers of ten.
+  static const intptr_t kRadixConversionThreshold = 64;
+  // The largest power of ten that fits into a chunk, and its exponent.
+  static const Chunk kDecimalDivisor = 1000000000;
+  static const intptr_t kDecimalDivisorDigits = 9;
+
   static RawBigint* Zero() { return Bigint::Allocate(0); }
   static RawBigint* One() {
     Bigint& result = Bigint::Handle(Bigint::Allocate(1));
@@ -134,11 +152,99 @@ class BigintOperations : public AllStatic {
   static RawBigint* UnsignedSubtract(const Bigint& a, const Bigint& b);
 
   static RawBigint* MultiplyWithDigit(const Bigint& bigint, Chunk digit);
+
+  // Operations on arrays of digits. They do not allocate, so they may be
+  // used on the digits of bigints inside a NoGCScope.
+
+  // Adds 'b' to 'a' and returns the carry out of the most significant digit.
+  static Chunk AddDigits(Chunk* a, intptr_t a_length,
+                         const Chunk* b, intptr_t b_length);
+  // Subtracts 'b' from 'a', which must not be smaller than 'b'.
+  static void SubtractDigits(Chunk* a, intptr_t a_length,
+                             const Chunk* b, intptr_t b_length);
+  // Stores the a_length + b_length digits of a * b in 'result'.
+  static void SchoolbookMultiplyDigits(const Chunk* a, intptr_t a_length,
+                                       const Chunk* b, intptr_t b_length,
+                                       Chunk* result);
+  // Same as SchoolbookMultiplyDigits, but uses the Karatsuba algorithm for
+  // large factors. 'scratch' must have KaratsubaScratchLength digits.
+  static void MultiplyDigits(const Chunk* a, intptr_t a_length,
+                             const Chunk* b, intptr_t b_length,
+                             Chunk* result, Chunk* scratch);
+  static intptr_t KaratsubaScratchLength(intptr_t a_length,
+                                         intptr_t b_length) {
+    return 4 * (a_length + b_length) + 16 * kBitsPerWord;
+  }
+  // Divides 'dividend' by the normalized 'divisor', whose most significant
+  // bit is set. The most significant digit of the dividend must be smaller
+  // than the one of the divisor. Stores the dividend_length - divisor_length
+  // quotient digits in 'quotient' and leaves the remainder in the low
+  // digits of the dividend.
+  static void DivideDigits(Chunk* dividend, intptr_t dividend_length,
+                           const Chunk* divisor, intptr_t divisor_length,
+                           Chunk* quotient);
+
+  // Montgomery arithmetic modulo the odd n-digit 'modulus', with R = B^n
+  // for the digit base B. 'inverse' is -modulus^-1 mod B. Stores
+  // a * b * R^-1 mod modulus in 'result', which may be 'a' or 'b', where
+  // a and b must be smaller than the modulus. 'scratch' must have n + 2
+  // digits.
+  static void MontgomeryMultiply(const Chunk* a,
+                                 const Chunk* b,
+                                 const Chunk* modulus,
+                                 intptr_t n,
+                                 Chunk inverse,
+                                 Chunk* result,
+                                 Chunk* scratch);
+  // Same as ModPow for a reduced base and an odd modulus.
+  static RawBigint* MontgomeryModPow(const Bigint& base,
+                                     const Bigint& exponent,
+                                     const Bigint& modulus);
+  static bool IsBitSet(const Bigint& bigint, intptr_t bit) {
+    Chunk digit = bigint.GetChunkAt(bit / kDigitBitSize);
+    return ((digit >> (bit % kDigitBitSize)) & 1) != 0;
+  }
+
+  // Returns the digits [from, from + count) of the absolute value of
+  // 'bigint'.
+  static RawBigint* DigitsSlice(const Bigint& bigint,
+                                intptr_t from,
+                                intptr_t count);
   static RawBigint* DigitsShiftLeft(const Bigint& bigint, intptr_t amount) {
     return ShiftLeft(bigint, amount * kDigitBitSize);
   }
   static void DivideRemainder(const Bigint& a, const Bigint& b,
                               Bigint* quotient, Bigint* remainder);
+  // The following division helpers ignore the signs of their arguments and
+  // return non-negative results.
+  static void UnsignedDivideRemainder(const Bigint& a, const Bigint& b,
+                                      Bigint* quotient, Bigint* remainder);
+  static void RecursiveDivideRemainder(const Bigint& a, const Bigint& b,
+                                       Bigint* quotient, Bigint* remainder);
+  // Divides 'a' by the normalized n-digit divisor 'b', where a < b * B^n
+  // for the digit base B.
+  static void Divide2n1n(const Bigint& a, const Bigint& b, intptr_t n,
+                         Bigint* quotient, Bigint* remainder);
+  // Divides a12 * B^n + a3 by b = b1 * B^n + b2, where b1 is normalized and
+  // has n digits, and where a12 < b * B^n.
+  static void Divide3n2n(const Bigint& a12, const Bigint& a3,
+                         const Bigint& b, const Bigint& b1, const Bigint& b2,
+                         intptr_t n, Bigint* quotient, Bigint* remainder);
+
+  // Writes the decimal digits of the absolute value of 'bigint' to 'buffer'
+  // at 'position', and returns the position after them. If 'width' is not
+  // zero, the digits are padded with leading zeroes to 'width' characters.
+  // 'powers' holds 10^(9 * 2^k) for k in [0, level].
+  static intptr_t WriteDecimal(const Bigint& bigint,
+                               const Bigint** powers,
+                               intptr_t level,
+                               intptr_t width,
+                               char* buffer,
+                               intptr_t position);
+  static intptr_t WriteDecimalSchoolbook(const Bigint& bigint,
+                                         intptr_t width,
+                                         char* buffer,
+                                         intptr_t position);
 
   // Removes leading zero-chunks by adjusting the bigint's length.
   static void Clamp(const Bigint& bigint);
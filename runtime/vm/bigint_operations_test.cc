@@ -3,9 +3,11 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "platform/assert.h"
+#include "vm/benchmark_test.h"
 #include "vm/bigint_operations.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
+#include "vm/timer.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -2231,4 +2233,248 @@ TEST_CASE(BigintDivideRemainder) {
       "01234567890ABCDEE");
 }
 
+
+// Returns a string of the given digits, which starts with 'prefix' and
+// continues with 'count' digits that are chosen pseudo-randomly with 'seed'.
+// The first digit is not zero.
+static const char* RandomDigits(const char* prefix,
+                                const char* digits,
+                                intptr_t count,
+                                uint32_t* seed) {
+  intptr_t prefix_length = strlen(prefix);
+  intptr_t base = strlen(digits);
+  char* result = reinterpret_cast<char*>(
+      ZoneAllocator(prefix_length + count + 1));
+  memmove(result, prefix, prefix_length);
+  for (intptr_t i = 0; i < count; i++) {
+    *seed = *seed * 1103515245 + 12345;
+    intptr_t digit = (*seed >> 16) % base;
+    if ((i == 0) && (digit == 0)) digit = 1;
+    result[prefix_length + i] = digits[digit];
+  }
+  result[prefix_length + count] = '\0';
+  return result;
+}
+
+
+// Returns "0x" followed by 'leading' Fs, 'middle', 'trailing' Fs, 'zeroes'
+// zeroes and 'last'.
+static const char* HexCString(intptr_t leading,
+                              const char* middle,
+                              intptr_t trailing,
+                              intptr_t zeroes,
+                              const char* last) {
+  intptr_t length =
+      2 + leading + strlen(middle) + trailing + zeroes + strlen(last);
+  char* result = reinterpret_cast<char*>(ZoneAllocator(length + 1));
+  char* pos = result;
+  *pos++ = '0';
+  *pos++ = 'x';
+  for (intptr_t i = 0; i < leading; i++) *pos++ = 'F';
+  for (const char* c = middle; *c != '\0'; c++) *pos++ = *c;
+  for (intptr_t i = 0; i < trailing; i++) *pos++ = 'F';
+  for (intptr_t i = 0; i < zeroes; i++) *pos++ = '0';
+  for (const char* c = last; *c != '\0'; c++) *pos++ = *c;
+  *pos = '\0';
+  return result;
+}
+
+
+TEST_CASE(BigintKaratsuba) {
+  // (16^k - 1) * (16^m - 1) = 16^(k+m) - 16^k - 16^m + 1, which is written
+  // as m - 1 Fs, an E, k - m Fs, m - 1 zeroes and a 1. The factors have
+  // equal digits, which exercises the carries of the middle terms.
+  const intptr_t kLengths[] = { 1000, 700, 333, 300, 41, 7 };
+  for (unsigned i = 0; i < ARRAY_SIZE(kLengths); i++) {
+    for (unsigned j = i; j < ARRAY_SIZE(kLengths); j++) {
+      intptr_t k = kLengths[i];
+      intptr_t m = kLengths[j];
+      const Bigint& a = Bigint::Handle(BigintOperations::NewFromCString(
+          HexCString(k, "", 0, 0, "")));
+      const Bigint& b = Bigint::Handle(BigintOperations::NewFromCString(
+          HexCString(m, "", 0, 0, "")));
+      const Bigint& product =
+          Bigint::Handle(BigintOperations::Multiply(a, b));
+      EXPECT_STREQ(HexCString(m - 1, "E", k - m, m - 1, "1"),
+                   BigintOperations::ToHexCString(product, &ZoneAllocator));
+    }
+  }
+}
+
+
+TEST_CASE(BigintLargeDivideRemainder) {
+  // Divisions of a * b + c by b, where c < b, must yield a and c. The sizes
+  // cover the schoolbook and the recursive division.
+  const char* kHexDigits = "0123456789ABCDEF";
+  const intptr_t kSizes[][2] = {
+    { 30, 20 }, { 400, 350 }, { 800, 400 }, { 2000, 1001 }, { 3000, 500 },
+  };
+  uint32_t seed = 42;
+  for (unsigned i = 0; i < ARRAY_SIZE(kSizes); i++) {
+    const char* str_a = RandomDigits("0x", kHexDigits, kSizes[i][0], &seed);
+    const char* str_b = RandomDigits("0x", kHexDigits, kSizes[i][1], &seed);
+    const char* str_c =
+        RandomDigits("0x", kHexDigits, kSizes[i][1] - 1, &seed);
+    const Bigint& a = Bigint::Handle(BigintOperations::NewFromCString(str_a));
+    const Bigint& b = Bigint::Handle(BigintOperations::NewFromCString(str_b));
+    const Bigint& c = Bigint::Handle(BigintOperations::NewFromCString(str_c));
+    Bigint& dividend = Bigint::Handle(BigintOperations::Multiply(a, b));
+    dividend = BigintOperations::Add(dividend, c);
+    const Bigint& quotient =
+        Bigint::Handle(BigintOperations::Divide(dividend, b));
+    const Bigint& remainder =
+        Bigint::Handle(BigintOperations::Remainder(dividend, b));
+    EXPECT_STREQ(str_a,
+                 BigintOperations::ToHexCString(quotient, &ZoneAllocator));
+    EXPECT_STREQ(str_c,
+                 BigintOperations::ToHexCString(remainder, &ZoneAllocator));
+  }
+}
+
+
+TEST_CASE(BigintLargeDecimalStrings) {
+  const intptr_t kLengths[] = { 300, 600, 1000, 3000, 10000 };
+  uint32_t seed = 7;
+  for (unsigned i = 0; i < ARRAY_SIZE(kLengths); i++) {
+    const char* str = RandomDigits("-", "0123456789", kLengths[i], &seed);
+    const Bigint& bigint =
+        Bigint::Handle(BigintOperations::NewFromCString(str));
+    EXPECT_STREQ(str,
+                 BigintOperations::ToDecimalCString(bigint, &ZoneAllocator));
+  }
+  // Numbers with long runs of zeroes and nines must keep them when they are
+  // split at powers of ten.
+  const char* nines = "99999999999999999999999999999999999999999999999999";
+  Bigint& bigint = Bigint::Handle(BigintOperations::NewFromCString(nines));
+  const Bigint& shift = Bigint::Handle(BigintOperations::NewFromCString(
+      "1000000000000000000000000000000000000000000000000000"));
+  for (intptr_t i = 0; i < 40; i++) {
+    bigint = BigintOperations::Multiply(bigint, shift);
+  }
+  const char* str = BigintOperations::ToDecimalCString(bigint, &ZoneAllocator);
+  EXPECT_EQ(50 + 40 * 51, static_cast<intptr_t>(strlen(str)));
+  EXPECT(strncmp(str, nines, 50) == 0);
+  for (intptr_t i = 50; i < 50 + 40 * 51; i++) {
+    EXPECT_EQ('0', str[i]);
+  }
+}
+
+
+static void TestBigintModPow(const char* base,
+                             const char* exponent,
+                             const char* modulus,
+                             const char* result) {
+  const Bigint& bigint_base =
+      Bigint::Handle(BigintOperations::NewFromCString(base));
+  const Bigint& bigint_exponent =
+      Bigint::Handle(BigintOperations::NewFromCString(exponent));
+  const Bigint& bigint_modulus =
+      Bigint::Handle(BigintOperations::NewFromCString(modulus));
+  const Bigint& computed_result = Bigint::Handle(BigintOperations::ModPow(
+      bigint_base, bigint_exponent, bigint_modulus));
+  EXPECT_STREQ(result, BigintOperations::ToHexCString(computed_result,
+                                                      &ZoneAllocator));
+}
+
+
+TEST_CASE(BigintModPow) {
+  TestBigintModPow("0x4", "0xD", "0x1F1", "0x1BD");
+  TestBigintModPow("-0x3", "0x3", "0x7", "0x1");
+  TestBigintModPow("0x2", "0x0", "0x7", "0x1");
+  TestBigintModPow("0x2", "0x5", "0x1", "0x0");
+  TestBigintModPow("0x0", "0x5", "0x7", "0x0");
+  // An even modulus.
+  TestBigintModPow("0x3", "0x3E8", HexCString(0, "1", 0, 25, ""),
+                   "0x6F7867DBE5616937BD3B85B21");
+  // Fermat's little theorem for the Mersenne prime 2^521 - 1.
+  const char* prime = HexCString(0, "1", 130, 0, "");
+  TestBigintModPow("0x3", HexCString(0, "1", 129, 0, "E"), prime, "0x1");
+  TestBigintModPow("-0x1", prime, prime, HexCString(0, "1", 129, 0, "E"));
+  // RSA with the primes 2^127 - 1 and 2^521 - 1.
+  const char* n = HexCString(31, "D", 98, 0,
+                             "80000000000000000000000000000001");
+  const char* message = "0x1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF"
+      "1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF1234567890ABCDEF"
+      "1234567890ABCDEF";
+  const char* cipher =
+      "0xA6C9EE859FB47250A55102DADEC57D87147FA4431D8CCF04694C2027E17B5E42"
+      "A41E695E5BE291032ED6AE2F82852E65F2F295717533B8605715A5B83DE84B6C74"
+      "8956375BB2954841109723D4C85CC59B";
+  const char* d =
+      "0x2A7FD5802A7FD5802A7FD5802A7FD57F80807F7F80807F7F80807F7F80807F7F"
+      "80807F7F80807F7F80807F7F80807F7F80807F7F80807F7F80807F7F80807F7F80"
+      "55FFAA0055FFAA0055FFAA0055FFAA01";
+  TestBigintModPow(message, "0x10001", n, cipher);
+  TestBigintModPow(cipher, d, n, message);
+}
+
+
+// Computes a 2048-bit modular exponentiation, as used for RSA signatures
+// and Diffie-Hellman key exchange.
+BENCHMARK(BigintModPow2048) {
+  const intptr_t kNumIterations = 20;
+  uint32_t seed = 1;
+  const char* kHexDigits = "0123456789ABCDEF";
+  const Bigint& base = Bigint::Handle(BigintOperations::NewFromCString(
+      RandomDigits("0x", kHexDigits, 500, &seed)));
+  const Bigint& exponent = Bigint::Handle(BigintOperations::NewFromCString(
+      RandomDigits("0x", kHexDigits, 512, &seed)));
+  // The modulus is odd, like the cryptographic moduli.
+  const Bigint& modulus = Bigint::Handle(BigintOperations::NewFromCString(
+      RandomDigits("0x", "13579BDF", 512, &seed)));
+  Bigint& result = Bigint::Handle();
+  Timer timer(true, "BigintModPow2048 benchmark");
+  timer.Start();
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    HANDLESCOPE(benchmark->isolate());
+    result = BigintOperations::ModPow(base, exponent, modulus);
+  }
+  timer.Stop();
+  EXPECT(BigintOperations::Compare(result, modulus) < 0);
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+
+// Multiplies and divides 4096-bit numbers, as used by cryptographic code.
+BENCHMARK(BigintMultiplyDivide4096) {
+  const intptr_t kNumIterations = 200;
+  uint32_t seed = 1;
+  const Bigint& a = Bigint::Handle(BigintOperations::NewFromCString(
+      RandomDigits("0x", "0123456789ABCDEF", 1024, &seed)));
+  const Bigint& b = Bigint::Handle(BigintOperations::NewFromCString(
+      RandomDigits("0x", "0123456789ABCDEF", 1024, &seed)));
+  Bigint& product = Bigint::Handle();
+  Bigint& quotient = Bigint::Handle();
+  Timer timer(true, "BigintMultiplyDivide4096 benchmark");
+  timer.Start();
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    HANDLESCOPE(benchmark->isolate());
+    product = BigintOperations::Multiply(a, b);
+    quotient = BigintOperations::Divide(product, b);
+  }
+  timer.Stop();
+  EXPECT(BigintOperations::Compare(a, quotient) == 0);
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+
+// Prints a number with 20000 decimal digits.
+BENCHMARK(BigintToDecimalString) {
+  const intptr_t kNumIterations = 10;
+  const intptr_t kDigits = 20000;
+  uint32_t seed = 1;
+  const char* str = RandomDigits("", "0123456789", kDigits, &seed);
+  const Bigint& bigint =
+      Bigint::Handle(BigintOperations::NewFromCString(str));
+  Timer timer(true, "BigintToDecimalString benchmark");
+  timer.Start();
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    HANDLESCOPE(benchmark->isolate());
+    EXPECT_EQ(kDigits, static_cast<intptr_t>(
+        strlen(BigintOperations::ToDecimalCString(bigint, &ZoneAllocator))));
+  }
+  timer.Stop();
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
 }  // namespace dart
@@ -32,6 +32,7 @@ namespace dart {
   V(Integer_moduloFromInteger, 2)                                              \
   V(Integer_greaterThanFromInteger, 2)                                         \
   V(Integer_equalToInteger, 2)                                                 \
+  V(Integer_modPow, 3)                                                         \
   V(Integer_parse, 1)                                                          \
   V(ReceivePortImpl_factory, 1)                                                \
   V(ReceivePortImpl_closeInternal, 1)                                          \
@@ -79,6 +80,7 @@ namespace dart {
   V(ObjectArray_copyFromObjectArray, 5)                                        \
   V(StringBase_createFromCodePoints, 1)                                        \
   V(StringBase_substringUnchecked, 3)                                          \
+  V(StringBase_concatRange, 3)                                                 \
   V(StringBuffer_createStringFromUint16Array, 3)                               \
   V(OneByteString_substringUnchecked, 3)                                       \
   V(OneByteString_splitWithCharCode, 2)                                        \
@@ -86,6 +88,7 @@ namespace dart {
   V(String_getLength, 1)                                                       \
   V(String_charAt, 2)                                                          \
   V(String_codeUnitAt, 2)                                                      \
+  V(String_indexOf, 3)                                                         \
   V(String_concat, 2)                                                          \
   V(String_toLowerCase, 1)                                                     \
   V(String_toUpperCase, 1)                                                     \
@@ -100,6 +103,7 @@ namespace dart {
   V(Math_atan2, 2)                                                             \
   V(Math_exp, 1)                                                               \
   V(Math_log, 1)                                                               \
+  V(JsonDecoder_decode, 4)                                                     \
   V(DateNatives_currentTimeMillis, 0)                                          \
   V(DateNatives_timeZoneName, 1)                                               \
   V(DateNatives_timeZoneOffsetInSeconds, 1)                                    \
@@ -139,6 +143,13 @@ namespace dart {
   V(ExternalTypedData_Float32x4Array_new, 1)                                   \
   V(TypedData_length, 1)                                                       \
   V(TypedData_setRange, 5)                                                     \
+  V(TypedData_fillRange, 4)                                                    \
+  V(TypedData_indexOf, 5)                                                      \
+  V(TypedData_lastIndexOf, 5)                                                  \
+  V(TypedData_parseDoubles, 7)                                                 \
+  V(TypedData_parseInts, 7)                                                    \
+  V(TypedData_formatDoubles, 8)                                                \
+  V(TypedData_formatInts, 7)                                                   \
   V(TypedData_GetInt8, 2)                                                      \
   V(TypedData_SetInt8, 3)                                                      \
   V(TypedData_GetUint8, 2)                                                     \
@@ -44,6 +44,8 @@ DECLARE_FLAG(bool, enable_type_checks);
 DECLARE_FLAG(bool, trace_type_checks);
 DECLARE_FLAG(bool, report_usage_count);
 DECLARE_FLAG(int, deoptimization_counter_threshold);
+DECLARE_FLAG(bool, optimize_on_idle);
+DECLARE_FLAG(bool, use_osr);
 DEFINE_FLAG(charp, optimization_filter, NULL, "Optimize only named function");
 DEFINE_FLAG(bool, trace_failed_optimization_attempts, false,
     "Traces all failed optimization attempts");
@@ -1053,6 +1055,7 @@ DEFINE_RUNTIME_ENTRY(MegamorphicCacheMissHandler, 3) {
   const Smi& class_id = Smi::Handle(Smi::New(
       is_null ? static_cast<intptr_t>(kNullCid) : cls.id()));
   cache.Insert(class_id, target);
+  isolate->dispatch_table()->Update(name, descriptor, class_id.Value(), target);
   return;
 }
 
@@ -1218,6 +1221,63 @@ DEFINE_RUNTIME_ENTRY(InstanceFunctionLookup, 4) {
 }
 
 
+// Usage count of functions that should not be optimized again soon.
+static const intptr_t kLowInvocationCount = -100000000;
+
+
+// Called from a stack check of unoptimized code. If it is a loop check of a
+// hot function, compiles optimized code entered at that check and makes the
+// runtime call return into it, so that the loop continues in optimized code.
+static void ReplaceFrameWithOptimizedCode(Isolate* isolate) {
+  DartFrameIterator iterator;
+  StackFrame* frame = iterator.NextFrame();
+  ASSERT(frame != NULL);
+  const Code& code = Code::Handle(frame->LookupDartCode());
+  ASSERT(!code.IsNull());
+  // Only loop checks compiled for OSR have an OSR entry.
+  const intptr_t osr_id = code.GetDeoptIdForOsr(frame->pc());
+  if (osr_id == Isolate::kNoDeoptId) {
+    return;
+  }
+  const Function& function = Function::Handle(code.function());
+  ASSERT(!function.IsNull());
+  if (code.is_optimized() ||
+      (code.raw() != function.unoptimized_code()) ||
+      (function.usage_counter() < FLAG_optimization_counter_threshold)) {
+    return;
+  }
+  if (!function.is_optimizable() ||
+      isolate->debugger()->HasBreakpoint(function) ||
+      (function.deoptimization_counter() >=
+       FLAG_deoptimization_counter_threshold) ||
+      ((FLAG_optimization_filter != NULL) &&
+       (strstr(function.ToFullyQualifiedCString(),
+               FLAG_optimization_filter) == NULL))) {
+    // Stop counting the iterations of the loop.
+    function.set_usage_counter(kLowInvocationCount);
+    return;
+  }
+  const Code& original_code = Code::Handle(function.CurrentCode());
+  const Error& error = Error::Handle(
+      Compiler::CompileOptimizedFunction(function, osr_id));
+  if (!error.IsNull()) {
+    Exceptions::PropagateError(error);
+  }
+  const Code& osr_code = Code::Handle(function.CurrentCode());
+  // The current code is unchanged if the optimizer bailed out.
+  if (osr_code.raw() != original_code.raw()) {
+    // The OSR code cannot be called, the function keeps its code.
+    function.SetCode(original_code);
+    if (original_code.is_optimized()) {
+      // Set usage counter for reoptimization.
+      function.set_usage_counter(
+          function.usage_counter() - FLAG_reoptimization_counter_threshold);
+    }
+    frame->set_pc(osr_code.EntryPoint());
+  }
+}
+
+
 DEFINE_RUNTIME_ENTRY(StackOverflow, 0) {
   ASSERT(arguments.ArgCount() ==
          kStackOverflowRuntimeEntry.argument_count());
@@ -1264,6 +1324,10 @@ DEFINE_RUNTIME_ENTRY(StackOverflow, 0) {
       (*callback)();
     }
   }
+
+  if (FLAG_use_osr) {
+    ReplaceFrameWithOptimizedCode(isolate);
+  }
 }
 
 
@@ -1291,7 +1355,6 @@ DEFINE_RUNTIME_ENTRY(TraceICCall, 2) {
 DEFINE_RUNTIME_ENTRY(OptimizeInvokedFunction, 1) {
   ASSERT(arguments.ArgCount() ==
          kOptimizeInvokedFunctionRuntimeEntry.argument_count());
-  const intptr_t kLowInvocationCount = -100000000;
   const Function& function = Function::CheckedHandle(arguments.ArgAt(0));
   ASSERT(!function.IsNull());
   if (isolate->debugger()->HasBreakpoint(function)) {
@@ -1320,6 +1383,13 @@ DEFINE_RUNTIME_ENTRY(OptimizeInvokedFunction, 1) {
     return;
   }
   if (function.is_optimizable()) {
+    if (FLAG_optimize_on_idle && Compiler::QueueOptimization(function)) {
+      // Keep running the current code until the isolate is idle. If the
+      // function gets hot again before that, it is optimized right away.
+      function.set_usage_counter(0);
+      arguments.SetReturn(Code::Handle(function.CurrentCode()));
+      return;
+    }
     const Error& error =
         Error::Handle(Compiler::CompileOptimizedFunction(function));
     if (!error.IsNull()) {
@@ -1506,6 +1576,20 @@ static void CopyFrame(const Code& optimized_code, const StackFrame& frame) {
 }
 
 
+// Returns the number of deoptimization instructions describing the
+// unoptimized frames.  They are followed by the descriptions of the objects
+// whose allocation was sunk, if any.
+static intptr_t DeoptFrameLength(
+    const GrowableArray<DeoptInstr*>& deopt_instructions) {
+  for (intptr_t i = 0; i < deopt_instructions.length(); i++) {
+    if (deopt_instructions[i]->kind() == DeoptInstr::kMaterializeObject) {
+      return i;
+    }
+  }
+  return deopt_instructions.length();
+}
+
+
 // Copies saved registers and caller's frame into temporary buffers.
 // Returns the stack size of unoptimized frame.
 DEFINE_LEAF_RUNTIME_ENTRY(intptr_t, DeoptimizeCopyFrame,
@@ -1551,8 +1635,11 @@ DEFINE_LEAF_RUNTIME_ENTRY(intptr_t, DeoptimizeCopyFrame,
   const Function& function = Function::Handle(optimized_code.function());
   const intptr_t num_args =
       function.HasOptionalParameters() ? 0 : function.num_fixed_parameters();
+  GrowableArray<DeoptInstr*> deopt_instructions;
+  deopt_info.ToInstructions(Array::Handle(optimized_code.deopt_info_array()),
+                            &deopt_instructions);
   intptr_t unoptimized_stack_size =
-      + deopt_info.TranslationLength() - num_args
+      + DeoptFrameLength(deopt_instructions) - num_args
       - 2;  // Subtract caller FP and PC.
   return unoptimized_stack_size * kWordSize;
 }
@@ -1584,11 +1671,16 @@ static intptr_t DeoptimizeWithDeoptInfo(const Code& code,
                                       Array::Handle(code.object_table()),
                                       num_args,
                                       static_cast<DeoptReasonId>(deopt_reason));
+  const intptr_t frame_len = DeoptFrameLength(deopt_instructions);
+  if (frame_len < len) {
+    deopt_context.PrepareForDeferredMaterialization(frame_len,
+                                                    len - frame_len);
+  }
   for (intptr_t to_index = len - 1; to_index >= 0; to_index--) {
     deopt_instructions[to_index]->Execute(&deopt_context, to_index);
   }
   if (FLAG_trace_deoptimization_verbose) {
-    for (intptr_t i = 0; i < len; i++) {
+    for (intptr_t i = 0; i < frame_len; i++) {
       OS::PrintErr("*%"Pd". [%p] %#014"Px" [%s]\n",
           i,
           &start[i],
@@ -1643,6 +1735,60 @@ DEFINE_LEAF_RUNTIME_ENTRY(intptr_t, DeoptimizeFillFrame, uword last_fp) {
 END_LEAF_RUNTIME_ENTRY
 
 
+// Allocates the objects whose allocation was sunk by the optimizing compiler
+// and stores them into the slots of the unoptimized frames referring to them.
+// The materialization area holding their descriptions is visited by the GC
+// until all of them are allocated and initialized.
+static void MaterializeSunkObjects(Isolate* isolate) {
+  intptr_t* area = isolate->deopt_materialization_area();
+  if (area == NULL) return;
+  const intptr_t area_size = isolate->deopt_materialization_area_size();
+
+  GrowableArray<const Instance*> objects;
+  Class& cls = Class::Handle();
+  intptr_t index = 0;
+  while (index < area_size) {
+    const intptr_t field_count =
+        Smi::Value(reinterpret_cast<RawSmi*>(area[index]));
+    cls ^= reinterpret_cast<RawObject*>(area[index + 1]);
+    objects.Add(&Instance::ZoneHandle(Instance::New(cls)));
+    index += 2 + 2 * field_count;
+  }
+  ASSERT(index == area_size);
+
+  // No allocation can occur from here on.
+  Field& field = Field::Handle();
+  Object& value = Object::Handle();
+  index = 0;
+  for (intptr_t i = 0; i < objects.length(); i++) {
+    const intptr_t field_count =
+        Smi::Value(reinterpret_cast<RawSmi*>(area[index]));
+    index += 2;
+    for (intptr_t j = 0; j < field_count; j++) {
+      field ^= reinterpret_cast<RawObject*>(area[index]);
+      value = reinterpret_cast<RawObject*>(area[index + 1]);
+      objects[i]->SetField(field, value);
+      index += 2;
+    }
+    if (FLAG_trace_deoptimization_verbose) {
+      OS::PrintErr("materializing object %"Pd": %s\n",
+                   i, objects[i]->ToCString());
+    }
+  }
+
+  DeferredObjectRef* ref = isolate->DetachDeferredObjectRefs();
+  while (ref != NULL) {
+    DeferredObjectRef* current = ref;
+    ref = ref->next();
+    *current->slot() = objects[current->index()]->raw();
+    delete current;
+  }
+
+  isolate->SetDeoptMaterializationArea(NULL, 0);
+  delete[] area;
+}
+
+
 // This is the last step in the deoptimization, GC can occur.
 DEFINE_RUNTIME_ENTRY(DeoptimizeMaterializeDoubles, 0) {
   DeferredObject* deferred_object = Isolate::Current()->DetachDeferredObjects();
@@ -1656,6 +1802,10 @@ DEFINE_RUNTIME_ENTRY(DeoptimizeMaterializeDoubles, 0) {
     delete current;
   }
 
+  // Boxes may be stored into fields of sunk objects, materialize those
+  // objects last.
+  MaterializeSunkObjects(isolate);
+
   // Since this is the only step where GC can occur during deoptimization,
   // use it to report the source line where deoptimization occured.
   if (FLAG_trace_deoptimization) {
@@ -49,11 +49,25 @@ DEFINE_FLAG(int, deoptimization_counter_threshold, 16,
     "How many times we allow deoptimization before we disallow optimization.");
 DEFINE_FLAG(bool, use_inlining, true, "Enable call-site inlining");
 DEFINE_FLAG(bool, range_analysis, true, "Enable range analysis");
+DEFINE_FLAG(bool, allocation_sinking, false,
+    "Remove allocations of objects that do not escape, materializing them "
+    "on deoptimization.");
+DEFINE_FLAG(bool, hoist_bounds_checks, false,
+    "Replace bounds checks in counted loops with a single check before the "
+    "loop.");
+DEFINE_FLAG(bool, vectorize_loops, false,
+    "Process two elements per iteration of simple loops over Float32 and "
+    "Float64 typed data arrays.");
+DEFINE_FLAG(bool, optimize_on_idle, false,
+    "Defer optimizing hot functions until their isolate has no messages "
+    "to handle.");
 DEFINE_FLAG(bool, verify_compiler, false,
     "Enable compiler verification assertions");
 DECLARE_FLAG(bool, print_flow_graph);
 DECLARE_FLAG(bool, print_flow_graph_optimized);
 DECLARE_FLAG(bool, trace_failed_optimization_attempts);
+DECLARE_FLAG(int, optimization_counter_threshold);
+DECLARE_FLAG(int, reoptimization_counter_threshold);
 
 // Compile a function. Should call only if the function has not been compiled.
 //   Arg0: function object.
@@ -114,7 +128,8 @@ static void InstallUnoptimizedCode(const Function& function) {
 
 // Return false if bailed out.
 static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
-                                        bool optimized) {
+                                        bool optimized,
+                                        intptr_t osr_id) {
   TimerScope timer(FLAG_compiler_stats, &CompilerStats::codegen_timer);
   bool is_compiled = false;
   Isolate* isolate = Isolate::Current();
@@ -149,7 +164,9 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
       }
 
       // Build the flow graph.
-      FlowGraphBuilder builder(parsed_function, NULL);  // NULL = not inlining.
+      FlowGraphBuilder builder(parsed_function,
+                               NULL,  // NULL = not inlining.
+                               osr_id);
       flow_graph = builder.BuildGraph();
     }
 
@@ -271,6 +288,16 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
         DEBUG_ASSERT(flow_graph->VerifyUseLists());
       }
 
+      if (FLAG_hoist_bounds_checks &&
+          FLAG_range_analysis &&
+          (parsed_function.function().deoptimization_counter() <
+           (FLAG_deoptimization_counter_threshold - 1))) {
+        // Uses the ranges of induction variables.
+        BoundsCheckHoisting hoisting(flow_graph);
+        hoisting.Optimize();
+        DEBUG_ASSERT(flow_graph->VerifyUseLists());
+      }
+
       if (FLAG_constant_propagation) {
         // Constant propagation can use information from range analysis to
         // find unreachable branch targets.
@@ -289,6 +316,20 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
       optimizer.Canonicalize();
       DEBUG_ASSERT(flow_graph->VerifyUseLists());
 
+      if (FLAG_vectorize_loops && BinaryFloat64x2OpInstr::IsSupported()) {
+        LoopVectorizer vectorizer(flow_graph);
+        vectorizer.Optimize();
+        DEBUG_ASSERT(flow_graph->VerifyUseLists());
+      }
+
+      // Must be the last pass before register allocation: the inputs of
+      // materializations are not recorded in use lists.
+      if (FLAG_allocation_sinking) {
+        AllocationSinking sinking(flow_graph);
+        sinking.Optimize();
+        DEBUG_ASSERT(flow_graph->VerifyUseLists());
+      }
+
       // Perform register allocation on the SSA graph.
       FlowGraphAllocator allocator(*flow_graph);
       allocator.AllocateRegisters();
@@ -325,12 +366,14 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
       graph_compiler.FinalizeStaticCallTargetsTable(code);
 
       if (optimized) {
-        CodePatcher::PatchEntry(Code::Handle(function.CurrentCode()));
-        function.SetCode(code);
-        if (FLAG_trace_compiler) {
-          OS::Print("--> patching entry %#"Px"\n",
-                    Code::Handle(function.unoptimized_code()).EntryPoint());
+        if (osr_id == Isolate::kNoDeoptId) {
+          CodePatcher::PatchEntry(Code::Handle(function.CurrentCode()));
+          if (FLAG_trace_compiler) {
+            OS::Print("--> patching entry %#"Px"\n",
+                      Code::Handle(function.unoptimized_code()).EntryPoint());
+          }
         }
+        function.SetCode(code);
 
         for (intptr_t i = 0; i < guarded_fields.length(); i++) {
           const Field& field = *guarded_fields[i];
@@ -491,7 +534,8 @@ static void DisassembleCode(const Function& function, bool optimized) {
 
 
 static RawError* CompileFunctionHelper(const Function& function,
-                                       bool optimized) {
+                                       bool optimized,
+                                       intptr_t osr_id) {
   Isolate* isolate = Isolate::Current();
   StackZone zone(isolate);
   LongJump* base = isolate->long_jump_base();
@@ -510,7 +554,8 @@ static RawError* CompileFunctionHelper(const Function& function,
     ParsedFunction* parsed_function = new ParsedFunction(
         Function::ZoneHandle(function.raw()));
     if (FLAG_trace_compiler) {
-      OS::Print("Compiling %sfunction: '%s' @ token %"Pd", size %"Pd"\n",
+      OS::Print("Compiling %s%sfunction: '%s' @ token %"Pd", size %"Pd"\n",
+                (osr_id != Isolate::kNoDeoptId ? "OSR " : ""),
                 (optimized ? "optimized " : ""),
                 function.ToFullyQualifiedCString(),
                 function.token_pos(),
@@ -523,7 +568,7 @@ static RawError* CompileFunctionHelper(const Function& function,
     }
 
     const bool success =
-        CompileParsedFunctionHelper(*parsed_function, optimized);
+        CompileParsedFunctionHelper(*parsed_function, optimized, osr_id);
     if (optimized && !success) {
       // Optimizer bailed out. Disable optimizations and to never try again.
       if (FLAG_trace_compiler) {
@@ -575,12 +620,81 @@ static RawError* CompileFunctionHelper(const Function& function,
 
 
 RawError* Compiler::CompileFunction(const Function& function) {
-  return CompileFunctionHelper(function, false);  // Non-optimized.
+  return CompileFunctionHelper(function,
+                               false,  // Non-optimized.
+                               Isolate::kNoDeoptId);
+}
+
+
+RawError* Compiler::CompileOptimizedFunction(const Function& function,
+                                             intptr_t osr_id) {
+  return CompileFunctionHelper(function, true, osr_id);  // Optimized.
 }
 
 
-RawError* Compiler::CompileOptimizedFunction(const Function& function) {
-  return CompileFunctionHelper(function, true);  // Optimized.
+// The optimization queue holds pairs of a function and its code at the
+// time it was queued.
+static const intptr_t kOptimizationQueueFunctionEntry = 0;
+static const intptr_t kOptimizationQueueCodeEntry = 1;
+static const intptr_t kOptimizationQueueEntryLength = 2;
+
+
+bool Compiler::QueueOptimization(const Function& function) {
+  ObjectStore* object_store = Isolate::Current()->object_store();
+  GrowableObjectArray& queue =
+      GrowableObjectArray::Handle(object_store->optimization_queue());
+  if (queue.IsNull()) {
+    queue = GrowableObjectArray::New();
+    object_store->set_optimization_queue(queue);
+  }
+  const Code& code = Code::Handle(function.CurrentCode());
+  for (intptr_t i = 0; i < queue.Length();
+       i += kOptimizationQueueEntryLength) {
+    if ((queue.At(i + kOptimizationQueueFunctionEntry) == function.raw()) &&
+        (queue.At(i + kOptimizationQueueCodeEntry) == code.raw())) {
+      return false;
+    }
+  }
+  queue.Add(function);
+  queue.Add(code);
+  return true;
+}
+
+
+bool Compiler::OptimizeQueuedFunction() {
+  Isolate* isolate = Isolate::Current();
+  const GrowableObjectArray& queue = GrowableObjectArray::Handle(
+      isolate->object_store()->optimization_queue());
+  if (queue.IsNull() || (queue.Length() == 0)) {
+    return false;
+  }
+  ASSERT(kOptimizationQueueCodeEntry == kOptimizationQueueEntryLength - 1);
+  const Object& code = Object::Handle(queue.RemoveLast());
+  Function& function = Function::Handle();
+  function ^= queue.RemoveLast();
+  // Skip functions that were optimized, deoptimized or disabled for
+  // optimization since they were queued.
+  if ((function.CurrentCode() != code.raw()) ||
+      !function.is_optimizable() ||
+      isolate->debugger()->HasBreakpoint(function)) {
+    return true;
+  }
+  const Error& error = Error::Handle(CompileOptimizedFunction(function));
+  if (!error.IsNull()) {
+    // There is no Dart code running to report the error to. The function
+    // keeps running its current code.
+    if (FLAG_trace_failed_optimization_attempts) {
+      OS::PrintErr("Failed to optimize %s: %s\n",
+                   function.ToFullyQualifiedCString(),
+                   error.ToErrorCString());
+    }
+    return true;
+  }
+  // Set usage counter for reoptimization, as if the function had been
+  // optimized when it got hot.
+  function.set_usage_counter(FLAG_optimization_counter_threshold -
+                             FLAG_reoptimization_counter_threshold);
+  return true;
 }
 
 
@@ -592,7 +706,7 @@ RawError* Compiler::CompileParsedFunction(
   isolate->set_long_jump_base(&jump);
   if (setjmp(*jump.Set()) == 0) {
     // Non-optimized code generator.
-    CompileParsedFunctionHelper(parsed_function, false);
+    CompileParsedFunctionHelper(parsed_function, false, Isolate::kNoDeoptId);
     if (FLAG_disassemble) {
       DisassembleCode(parsed_function.function(), false);
     }
@@ -683,7 +797,7 @@ RawObject* Compiler::ExecuteOnce(SequenceNode* fragment) {
     parsed_function->AllocateVariables();
 
     // Non-optimized code generator.
-    CompileParsedFunctionHelper(*parsed_function, false);
+    CompileParsedFunctionHelper(*parsed_function, false, Isolate::kNoDeoptId);
 
     const Object& result = Object::Handle(
         DartEntry::InvokeFunction(func, Object::empty_array()));
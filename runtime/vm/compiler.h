@@ -7,6 +7,7 @@
 
 #include "vm/allocation.h"
 #include "vm/growable_array.h"
+#include "vm/isolate.h"
 #include "vm/runtime_entry.h"
 
 namespace dart {
@@ -37,8 +38,24 @@ class Compiler : public AllStatic {
 
   // Generates optimized code for function.
   //
+  // If an OSR id is given, the code is entered at the stack overflow check
+  // with that deopt id from a frame of the unoptimized code. It is set as
+  // the function's current code without patching the unoptimized code, the
+  // caller must restore the unoptimized code.
+  //
   // Returns Error::null() if there is no compilation error.
-  static RawError* CompileOptimizedFunction(const Function& function);
+  static RawError* CompileOptimizedFunction(
+      const Function& function,
+      intptr_t osr_id = Isolate::kNoDeoptId);
+
+  // Queues function for optimization once the isolate has no messages to
+  // handle, see OptimizeQueuedFunction. Returns false if function is
+  // already queued with its current code.
+  static bool QueueOptimization(const Function& function);
+
+  // Optimizes the most recently queued function, unless its code has
+  // changed since it was queued. Returns false if the queue is empty.
+  static bool OptimizeQueuedFunction();
 
   // Generates code for given parsed function (without parsing it again) and
   // sets its code field.
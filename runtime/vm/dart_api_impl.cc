@@ -5,6 +5,7 @@
 #include "include/dart_api.h"
 
 #include "platform/assert.h"
+#include "platform/json.h"
 #include "vm/bigint_operations.h"
 #include "vm/class_finalizer.h"
 #include "vm/compiler.h"
@@ -23,10 +24,13 @@
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/port.h"
+#include "vm/profiler.h"
 #include "vm/resolver.h"
+#include "vm/scan_queue.h"
 #include "vm/stack_frame.h"
 #include "vm/symbols.h"
 #include "vm/timer.h"
+#include "vm/type_feedback.h"
 #include "vm/unicode.h"
 #include "vm/verifier.h"
 #include "vm/version.h"
@@ -922,13 +926,105 @@ DART_EXPORT Dart_Handle Dart_CreateScriptSnapshot(uint8_t** buffer,
         Api::NewError("%s expects the isolate to have a script loaded in it.",
                       CURRENT_FUNC);
   }
+  // Include the type feedback of the isolate, e.g. feedback loaded from an
+  // earlier run with Dart_LoadTypeFeedback, so that it is available as soon
+  // as the script is loaded from the snapshot.
+  uint8_t* type_feedback = NULL;
+  const intptr_t type_feedback_length =
+      TypeFeedback::Save(&type_feedback, ApiReallocate);
   ScriptSnapshotWriter writer(buffer, ApiReallocate);
-  writer.WriteScriptSnapshot(library);
+  writer.WriteScriptSnapshot(library, type_feedback, type_feedback_length);
   *size = writer.BytesWritten();
   return Api::Success(isolate);
 }
 
 
+DART_EXPORT Dart_Handle Dart_SaveTypeFeedback(uint8_t** buffer,
+                                              intptr_t* size) {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  if (buffer == NULL) {
+    RETURN_NULL_ERROR(buffer);
+  }
+  if (size == NULL) {
+    RETURN_NULL_ERROR(size);
+  }
+  *size = TypeFeedback::Save(buffer, ApiReallocate);
+  return Api::Success(isolate);
+}
+
+
+DART_EXPORT Dart_Handle Dart_LoadTypeFeedback(const uint8_t* buffer,
+                                              intptr_t size) {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  if (buffer == NULL) {
+    RETURN_NULL_ERROR(buffer);
+  }
+  CHECK_CALLBACK_STATE(isolate);
+  Dart_Handle state = Api::CheckIsolateState(isolate);
+  if (::Dart_IsError(state)) {
+    return state;
+  }
+  if (!TypeFeedback::Load(buffer, size)) {
+    return Api::NewError("%s expects parameter 'buffer' to contain type "
+                         "feedback saved by Dart_SaveTypeFeedback.",
+                         CURRENT_FUNC);
+  }
+  return Api::Success(isolate);
+}
+
+
+DART_EXPORT Dart_Handle Dart_StartProfiling() {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  if (!Profiler::StartIsolate(isolate)) {
+    return Api::NewError("%s: CPU profiling is not supported on this "
+                         "platform.", CURRENT_FUNC);
+  }
+  return Api::Success(isolate);
+}
+
+
+DART_EXPORT Dart_Handle Dart_StopProfiling() {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  Profiler::StopIsolate(isolate);
+  return Api::Success(isolate);
+}
+
+
+DART_EXPORT Dart_Handle Dart_GetProfile(Dart_ProfileFormat format,
+                                        uint8_t** buffer,
+                                        intptr_t* size) {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  if (buffer == NULL) {
+    RETURN_NULL_ERROR(buffer);
+  }
+  if (size == NULL) {
+    RETURN_NULL_ERROR(size);
+  }
+  if (format == Dart_kPprofProfile) {
+    *size = Profiler::WritePprof(buffer, ApiReallocate);
+    return Api::Success(isolate);
+  }
+  TextBuffer text(1024);
+  if (format == Dart_kFlatProfile) {
+    Profiler::PrintFlat(&text);
+  } else if (format == Dart_kTreeProfile) {
+    Profiler::PrintTree(&text);
+  } else {
+    return Api::NewError("%s: invalid profile format %d.",
+                         CURRENT_FUNC, format);
+  }
+  *buffer = ApiReallocate(NULL, 0, text.length());
+  memmove(*buffer, text.buf(), text.length());
+  *size = text.length();
+  return Api::Success(isolate);
+}
+
+
 DART_EXPORT void Dart_InterruptIsolate(Dart_Isolate isolate) {
   if (isolate == NULL) {
     FATAL1("%s expects argument 'isolate' to be non-null.",  CURRENT_FUNC);
@@ -4484,6 +4580,13 @@ DART_EXPORT Dart_Handle Dart_LoadScriptFromSnapshot(const uint8_t* buffer,
   library ^= tmp.raw();
   library.set_debuggable(true);
   isolate->object_store()->set_root_library(library);
+  const intptr_t type_feedback_length = reader.ReadIntptrValue();
+  if ((type_feedback_length != reader.PendingBytes()) ||
+      !TypeFeedback::Load(reader.CurrentBufferAddress(),
+                          type_feedback_length)) {
+    return Api::NewError("%s: Unable to deserialize snapshot correctly.",
+                         CURRENT_FUNC);
+  }
   return Api::NewHandle(isolate, library.raw());
 }
 
@@ -4737,6 +4840,12 @@ DART_EXPORT Dart_Handle Dart_LoadSource(Dart_Handle library,
 
   const Script& script = Script::Handle(
       isolate, Script::New(url_str, source_str, RawScript::kSourceTag));
+  // Parts loaded while the library definition is parsed are compiled by
+  // the parser once all of them are loaded.
+  ScanQueue* queue = isolate->scan_queue();
+  if ((queue != NULL) && queue->Add(lib, script)) {
+    return Api::NewHandle(isolate, lib.raw());
+  }
   Dart_Handle result;
   CompileSource(isolate, lib, script, &result);
   return result;
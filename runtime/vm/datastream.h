@@ -83,6 +83,8 @@ class ReadStream : public ValueObject {
 
   intptr_t Position() const { return current_ - buffer_; }
 
+  intptr_t PendingBytes() const { return end_ - current_; }
+
   void SetPosition(intptr_t value) {
     ASSERT((end_ - buffer_) > value);
     current_ = buffer_ + value;
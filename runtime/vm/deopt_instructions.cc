@@ -28,6 +28,9 @@ DeoptimizationContext::DeoptimizationContext(intptr_t* to_frame_start,
       from_frame_size_(0),
       registers_copy_(NULL),
       fpu_registers_copy_(NULL),
+      materialization_area_(NULL),
+      materialization_start_(to_frame_size),
+      materialization_size_(0),
       num_args_(num_args),
       deopt_reason_(deopt_reason),
       isolate_(Isolate::Current()) {
@@ -39,6 +42,20 @@ DeoptimizationContext::DeoptimizationContext(intptr_t* to_frame_start,
 }
 
 
+void DeoptimizationContext::PrepareForDeferredMaterialization(
+    intptr_t frame_length,
+    intptr_t size) {
+  ASSERT(materialization_area_ == NULL);
+  ASSERT(size > 0);
+  // The area is visited by the GC until the objects are materialized, so it
+  // must only contain valid object pointers.
+  materialization_area_ = new intptr_t[size]();
+  materialization_start_ = frame_length;
+  materialization_size_ = size;
+  isolate_->SetDeoptMaterializationArea(materialization_area_, size);
+}
+
+
 intptr_t DeoptimizationContext::GetFromFp() const {
   return from_frame_[from_frame_size_ - 1 - num_args_ - 1];
 }
@@ -598,6 +615,76 @@ class DeoptCallerPcInstr : public DeoptInstr {
 };
 
 
+// Deoptimization instruction that starts the description of an object whose
+// allocation was sunk by the optimizing compiler.  It is followed by the
+// class of the object and by a field and value pair for each initialized
+// field.  The descriptions follow the instructions for the unoptimized
+// frames and are written into the materialization area of the context.
+class DeoptMaterializeObjectInstr : public DeoptInstr {
+ public:
+  explicit DeoptMaterializeObjectInstr(intptr_t field_count)
+      : field_count_(field_count) {
+    ASSERT(field_count >= 0);
+  }
+
+  virtual intptr_t from_index() const { return field_count_; }
+  virtual DeoptInstr::Kind kind() const { return kMaterializeObject; }
+
+  virtual const char* ToCString() const {
+    const char* format = "mat%"Pd"";
+    intptr_t len = OS::SNPrint(NULL, 0, format, field_count_);
+    char* chars = Isolate::Current()->current_zone()->Alloc<char>(len + 1);
+    OS::SNPrint(chars, len + 1, format, field_count_);
+    return chars;
+  }
+
+  void Execute(DeoptimizationContext* deopt_context, intptr_t to_index) {
+    ASSERT(deopt_context->IsMaterializationIndex(to_index));
+    intptr_t* to_addr = deopt_context->GetToFrameAddressAt(to_index);
+    *reinterpret_cast<RawSmi**>(to_addr) = Smi::New(field_count_);
+  }
+
+ private:
+  const intptr_t field_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(DeoptMaterializeObjectInstr);
+};
+
+
+// Deoptimization instruction storing a reference to an object whose
+// allocation was sunk.  The object is identified by the position of its
+// description among the descriptions following the frames.
+class DeoptMaterializedObjectRefInstr : public DeoptInstr {
+ public:
+  explicit DeoptMaterializedObjectRefInstr(intptr_t index) : index_(index) {
+    ASSERT(index >= 0);
+  }
+
+  virtual intptr_t from_index() const { return index_; }
+  virtual DeoptInstr::Kind kind() const { return kMaterializedObjectRef; }
+
+  virtual const char* ToCString() const {
+    const char* format = "obj%"Pd"";
+    intptr_t len = OS::SNPrint(NULL, 0, format, index_);
+    char* chars = Isolate::Current()->current_zone()->Alloc<char>(len + 1);
+    OS::SNPrint(chars, len + 1, format, index_);
+    return chars;
+  }
+
+  void Execute(DeoptimizationContext* deopt_context, intptr_t to_index) {
+    intptr_t* to_addr = deopt_context->GetToFrameAddressAt(to_index);
+    *reinterpret_cast<RawSmi**>(to_addr) = Smi::New(0);
+    Isolate::Current()->DeferMaterializedObjectRef(
+        index_, reinterpret_cast<RawInstance**>(to_addr));
+  }
+
+ private:
+  const intptr_t index_;
+
+  DISALLOW_COPY_AND_ASSIGN(DeoptMaterializedObjectRefInstr);
+};
+
+
 // Deoptimization instruction that indicates the rest of this DeoptInfo is a
 // suffix of another one.  The suffix contains the info number (0 based
 // index in the deopt table of the DeoptInfo to share) and the length of the
@@ -698,6 +785,10 @@ DeoptInstr* DeoptInstr::Create(intptr_t kind_as_int, intptr_t from_index) {
     case kPcMarker: return new DeoptPcMarkerInstr(from_index);
     case kCallerFp: return new DeoptCallerFpInstr();
     case kCallerPc: return new DeoptCallerPcInstr();
+    case kMaterializeObject:
+        return new DeoptMaterializeObjectInstr(from_index);
+    case kMaterializedObjectRef:
+        return new DeoptMaterializedObjectRefInstr(from_index);
     case kSuffix: return new DeoptSuffixInstr(from_index);
   }
   UNREACHABLE();
@@ -739,6 +830,7 @@ class DeoptInfoBuilder::TrieNode : public ZoneAllocated {
 
 DeoptInfoBuilder::DeoptInfoBuilder(const intptr_t num_args)
     : instructions_(),
+      materializations_(),
       object_table_(GrowableObjectArray::Handle(GrowableObjectArray::New())),
       num_args_(num_args),
       trie_root_(new TrieNode()),
@@ -795,7 +887,11 @@ void DeoptInfoBuilder::AddCopy(Value* value,
                                const Location& from_loc,
                                const intptr_t to_index) {
   DeoptInstr* deopt_instr = NULL;
-  if (from_loc.IsConstant()) {
+  MaterializeObjectInstr* mat = value->definition()->AsMaterializeObject();
+  if (mat != NULL) {
+    const intptr_t index = FindOrAddMaterialization(mat);
+    deopt_instr = new DeoptMaterializedObjectRefInstr(index);
+  } else if (from_loc.IsConstant()) {
     intptr_t object_table_index = FindOrAddObjectInTable(from_loc.constant());
     deopt_instr = new DeoptConstantInstr(object_table_index);
   } else if (from_loc.IsRegister()) {
@@ -853,7 +949,39 @@ void DeoptInfoBuilder::AddCallerPc(intptr_t to_index) {
 }
 
 
+intptr_t DeoptInfoBuilder::FindOrAddMaterialization(
+    MaterializeObjectInstr* mat) {
+  for (intptr_t i = 0; i < materializations_.length(); i++) {
+    if (materializations_[i] == mat) {
+      return i;
+    }
+  }
+  materializations_.Add(mat);
+  return materializations_.length() - 1;
+}
+
+
+void DeoptInfoBuilder::AddMaterializations() {
+  for (intptr_t i = 0; i < materializations_.length(); i++) {
+    MaterializeObjectInstr* mat = materializations_[i];
+    instructions_.Add(new DeoptMaterializeObjectInstr(mat->InputCount()));
+    instructions_.Add(
+        new DeoptConstantInstr(FindOrAddObjectInTable(mat->cls())));
+    for (intptr_t j = 0; j < mat->InputCount(); j++) {
+      instructions_.Add(
+          new DeoptConstantInstr(FindOrAddObjectInTable(mat->FieldAt(j))));
+      // Materializations are not nested, the inputs are plain values.
+      ASSERT(!mat->InputAt(j)->definition()->IsMaterializeObject());
+      AddCopy(mat->InputAt(j), mat->LocationAt(j), instructions_.length());
+    }
+  }
+  materializations_.Clear();
+}
+
+
 RawDeoptInfo* DeoptInfoBuilder::CreateDeoptInfo() {
+  // Describe the objects whose allocation was sunk after the frames.
+  AddMaterializations();
   intptr_t length = instructions_.length();
 
   // Count the number of instructions that are a shared suffix of some deopt
@@ -14,6 +14,7 @@
 namespace dart {
 
 class Location;
+class MaterializeObjectInstr;
 class Value;
 
 // Holds all data relevant for execution of deoptimization instructions.
@@ -34,10 +35,25 @@ class DeoptimizationContext : public ValueObject {
   }
 
   intptr_t* GetToFrameAddressAt(intptr_t index) const {
+    if (IsMaterializationIndex(index)) {
+      ASSERT((index - materialization_start_) < materialization_size_);
+      return &materialization_area_[index - materialization_start_];
+    }
     ASSERT((0 <= index) && (index < to_frame_size_));
     return &to_frame_[index];
   }
 
+  // The instructions following the first 'frame_length' instructions
+  // describe objects whose allocation was sunk.  They are written into a
+  // materialization area of 'size' words that is handed to the isolate.
+  void PrepareForDeferredMaterialization(intptr_t frame_length,
+                                         intptr_t size);
+
+  bool IsMaterializationIndex(intptr_t index) const {
+    return (materialization_area_ != NULL) &&
+        (index >= materialization_start_);
+  }
+
   intptr_t GetFromFp() const;
   intptr_t GetFromPc() const;
 
@@ -79,6 +95,9 @@ class DeoptimizationContext : public ValueObject {
   intptr_t from_frame_size_;
   intptr_t* registers_copy_;
   fpu_register_t* fpu_registers_copy_;
+  intptr_t* materialization_area_;
+  intptr_t materialization_start_;
+  intptr_t materialization_size_;
   const intptr_t num_args_;
   const DeoptReasonId deopt_reason_;
   intptr_t caller_fp_;
@@ -110,6 +129,8 @@ class DeoptInstr : public ZoneAllocated {
     kPcMarker,
     kCallerFp,
     kCallerPc,
+    kMaterializeObject,
+    kMaterializedObjectRef,
     kSuffix,
   };
 
@@ -167,7 +188,8 @@ class DeoptInfoBuilder : public ValueObject {
                         intptr_t deopt_id,
                         intptr_t to_index);
 
-  // Copy from optimized frame to unoptimized.
+  // Copy from optimized frame to unoptimized.  A materialization is copied
+  // as a reference to an object described after the frames.
   void AddCopy(Value* value, const Location& from_loc, intptr_t to_index);
   void AddPcMarker(const Function& function, intptr_t to_index);
   void AddCallerFp(intptr_t to_index);
@@ -179,9 +201,15 @@ class DeoptInfoBuilder : public ValueObject {
   class TrieNode;
 
   intptr_t FindOrAddObjectInTable(const Object& obj) const;
+  intptr_t FindOrAddMaterialization(MaterializeObjectInstr* mat);
   intptr_t CalculateStackIndex(const Location& from_loc) const;
 
+  // Append the descriptions of the materializations referred to by the
+  // current deopt info.
+  void AddMaterializations();
+
   GrowableArray<DeoptInstr*> instructions_;
+  GrowableArray<MaterializeObjectInstr*> materializations_;
   const GrowableObjectArray& object_table_;
   const intptr_t num_args_;
 
@@ -246,6 +246,7 @@ static const char* F0Mnem(uint8_t f0byte) {
     case 0x57: return "xorps";
     case 0x58: return "addps";
     case 0x59: return "mulps";
+    case 0x5A: return "cvtps2pd";
     case 0x5C: return "subps";
     case 0x5D: return "minps";
     case 0x5E: return "divps";
@@ -1387,8 +1388,8 @@ int X86Decoder::InstructionDecode(uword pc) {
             data += PrintRightOperand(data);
           } else if (f0byte == 0x51 || f0byte == 0x52 || f0byte == 0x53 ||
                      f0byte == 0x54 || f0byte == 0x56 || f0byte == 0x58 ||
-                     f0byte == 0x59 || f0byte == 0x5C || f0byte == 0x5D ||
-                     f0byte == 0x5E || f0byte == 0x5F) {
+                     f0byte == 0x59 || f0byte == 0x5A || f0byte == 0x5C ||
+                     f0byte == 0x5D || f0byte == 0x5E || f0byte == 0x5F) {
             int mod, regop, rm;
             GetModRm(*data, &mod, &regop, &rm);
             Print(f0mnem);
@@ -1547,6 +1548,27 @@ int X86Decoder::InstructionDecode(uword pc) {
             PrintXmmRegister(regop);
           } else if (*data == 0x57 || *data == 0x56 || *data == 0x54) {
             data += BitwisePDInstruction(data);
+          } else if (*data == 0x58 || *data == 0x59 || *data == 0x5A ||
+                     *data == 0x5C || *data == 0x5E || *data == 0x14 ||
+                     *data == 0x15) {
+            const char* mnem = "?";
+            switch (*data) {
+              case 0x58: mnem = "addpd"; break;
+              case 0x59: mnem = "mulpd"; break;
+              case 0x5A: mnem = "cvtpd2ps"; break;
+              case 0x5C: mnem = "subpd"; break;
+              case 0x5E: mnem = "divpd"; break;
+              case 0x14: mnem = "unpcklpd"; break;
+              case 0x15: mnem = "unpckhpd"; break;
+            }
+            data++;
+            int mod, regop, rm;
+            GetModRm(*data, &mod, &regop, &rm);
+            Print(mnem);
+            Print(" ");
+            PrintXmmRegister(regop);
+            Print(",");
+            data += PrintRightXmmOperand(data);
           } else if (*data == 0x1F &&
                      *(data+1) == 0x44 &&
                      *(data+2) == 0x00 &&
@@ -1274,6 +1274,20 @@ int DisassemblerX64::TwoByteOpcodeInstruction(uint8_t* data) {
           mnemonic = "orpd";
         } else  if (opcode == 0x57) {
           mnemonic = "xorpd";
+        } else if (opcode == 0x58) {
+          mnemonic = "addpd";
+        } else if (opcode == 0x59) {
+          mnemonic = "mulpd";
+        } else if (opcode == 0x5A) {
+          mnemonic = "cvtpd2ps";
+        } else if (opcode == 0x5C) {
+          mnemonic = "subpd";
+        } else if (opcode == 0x5E) {
+          mnemonic = "divpd";
+        } else if (opcode == 0x14) {
+          mnemonic = "unpcklpd";
+        } else if (opcode == 0x15) {
+          mnemonic = "unpckhpd";
         } else if (opcode == 0x2E) {
           mnemonic = "ucomisd";
         } else if (opcode == 0x2F) {
@@ -1427,8 +1441,9 @@ int DisassemblerX64::TwoByteOpcodeInstruction(uint8_t* data) {
 
   } else if (opcode == 0x51 || opcode == 0x52 || opcode == 0x53 ||
              opcode == 0x54 || opcode == 0x56 || opcode == 0x57 ||
-             opcode == 0x58 || opcode == 0x59 || opcode == 0x5C ||
-             opcode == 0x5D || opcode == 0x5E || opcode == 0x5F) {
+             opcode == 0x58 || opcode == 0x59 || opcode == 0x5A ||
+             opcode == 0x5C || opcode == 0x5D || opcode == 0x5E ||
+             opcode == 0x5F) {
     const char* mnemonic = NULL;
     switch (opcode) {
       case 0x51: mnemonic = "sqrtps"; break;
@@ -1439,6 +1454,7 @@ int DisassemblerX64::TwoByteOpcodeInstruction(uint8_t* data) {
       case 0x57: mnemonic = "xorps"; break;
       case 0x58: mnemonic = "addps"; break;
       case 0x59: mnemonic = "mulps"; break;
+      case 0x5A: mnemonic = "cvtps2pd"; break;
       case 0x5C: mnemonic = "subps"; break;
       case 0x5D: mnemonic = "minps"; break;
       case 0x5E: mnemonic = "divps"; break;
@@ -0,0 +1,219 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/dispatch_table.h"
+
+#include <stdlib.h>
+#include "vm/class_table.h"
+#include "vm/dart_entry.h"
+#include "vm/flags.h"
+#include "vm/growable_array.h"
+#include "vm/object.h"
+#include "vm/object_store.h"
+#include "vm/resolver.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool, use_dispatch_table, false,
+    "Dispatch megamorphic instance calls through the global dispatch table.");
+DEFINE_FLAG(bool, trace_dispatch_table, false,
+    "Trace the assignment of dispatch table offsets.");
+
+DispatchTable::DispatchTable()
+    : entries_(NULL),
+      capacity_(0),
+      length_(0),
+      selectors_(NULL) {
+}
+
+
+DispatchTable::~DispatchTable() {
+  free(selectors_);
+}
+
+
+intptr_t DispatchTable::FindSelector(const String& name,
+                                     const Array& descriptor) const {
+  for (intptr_t i = 0; i < length_; ++i) {
+    if ((selectors_[i].name == name.raw()) &&
+        (selectors_[i].descriptor == descriptor.raw())) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+bool DispatchTable::IsUsedOffset(intptr_t offset) const {
+  for (intptr_t i = 0; i < length_; ++i) {
+    if (selectors_[i].offset == offset) return true;
+  }
+  return false;
+}
+
+
+void DispatchTable::EnsureEntries(intptr_t num_entries) {
+  if (num_entries < kInitialEntries) {
+    num_entries = kInitialEntries;
+  }
+  if (entries_ == NULL) {
+    entries_ = Array::New(kEntryLength * num_entries, Heap::kOld);
+    return;
+  }
+  const Array& entries = Array::Handle(entries_);
+  const intptr_t old_entries = entries.Length() / kEntryLength;
+  if (num_entries <= old_entries) return;
+  if (num_entries < 2 * old_entries) {
+    num_entries = 2 * old_entries;
+  }
+  entries_ = Array::Grow(entries, kEntryLength * num_entries, Heap::kOld);
+}
+
+
+// Returns the class used to resolve calls on receivers of class 'cid', or
+// null if no instances of the class are dispatched through the table.
+static RawClass* ReceiverClassAt(intptr_t cid) {
+  Isolate* isolate = Isolate::Current();
+  if (cid == kNullCid) {
+    // For lookups treat null as an instance of class Object.
+    return isolate->object_store()->object_class();
+  }
+  ClassTable* class_table = isolate->class_table();
+  if (!class_table->HasValidClassAt(cid)) {
+    return Class::null();
+  }
+  const Class& cls = Class::Handle(class_table->At(cid));
+  if (!cls.is_finalized() || cls.is_abstract()) {
+    return Class::null();
+  }
+  return cls.raw();
+}
+
+
+intptr_t DispatchTable::SelectorOffset(const String& name,
+                                       const Array& descriptor) {
+  const intptr_t index = FindSelector(name, descriptor);
+  if (index >= 0) {
+    return selectors_[index].offset;
+  }
+
+  // Resolve the selector for all finalized classes.
+  const ArgumentsDescriptor args_desc(descriptor);
+  const intptr_t num_cids = Isolate::Current()->class_table()->NumCids();
+  GrowableArray<intptr_t> cids;
+  GrowableArray<const Function*> targets;
+  Class& cls = Class::Handle();
+  for (intptr_t cid = kIllegalCid + 1; cid < num_cids; ++cid) {
+    cls = ReceiverClassAt(cid);
+    if (cls.IsNull()) continue;
+    const Function& target = Function::ZoneHandle(
+        Resolver::ResolveDynamicForReceiverClass(cls,
+                                                 name,
+                                                 args_desc.Count(),
+                                                 args_desc.NamedCount()));
+    if (target.IsNull()) continue;
+    cids.Add(cid);
+    targets.Add(&target);
+  }
+
+  // Find the first unused offset at which the entries of all these classes
+  // are free.
+  EnsureEntries(num_cids);
+  Array& entries = Array::Handle(entries_);
+  intptr_t offset = 0;
+  while (true) {
+    if (!IsUsedOffset(offset)) {
+      const intptr_t num_entries = entries.Length() / kEntryLength;
+      bool fits = true;
+      for (intptr_t i = 0; i < cids.length(); ++i) {
+        const intptr_t entry = offset + cids[i];
+        if ((entry < num_entries) &&
+            (entries.At(kEntryLength * entry + kSelectorOffsetIndex) !=
+             Object::null())) {
+          fits = false;
+          break;
+        }
+      }
+      if (fits) break;
+    }
+    ++offset;
+  }
+  EnsureEntries(offset + num_cids);
+  entries = entries_;
+
+  // Fill in the entries. Targets that have no code yet are compiled by the
+  // miss handler when they are first called.
+  const Smi& offset_smi = Smi::Handle(Smi::New(offset));
+  const Function& miss_handler = Function::Handle(
+      Isolate::Current()->megamorphic_cache_table()->miss_handler());
+  for (intptr_t i = 0; i < cids.length(); ++i) {
+    const intptr_t entry = kEntryLength * (offset + cids[i]);
+    entries.SetAt(entry + kSelectorOffsetIndex, offset_smi);
+    entries.SetAt(entry + kTargetFunctionIndex,
+                  targets[i]->HasCode() ? *targets[i] : miss_handler);
+  }
+
+  if (length_ == capacity_) {
+    capacity_ += kCapacityIncrement;
+    selectors_ = reinterpret_cast<Selector*>(
+        realloc(selectors_, capacity_ * sizeof(*selectors_)));
+  }
+  ASSERT(length_ < capacity_);
+  Selector selector = { name.raw(), descriptor.raw(), offset };
+  selectors_[length_++] = selector;
+
+  if (FLAG_trace_dispatch_table) {
+    OS::Print("Dispatch table offset %"Pd" for '%s' (%"Pd" classes)\n",
+              offset, name.ToCString(), static_cast<intptr_t>(cids.length()));
+  }
+  return offset;
+}
+
+
+void DispatchTable::Update(const String& name,
+                           const Array& descriptor,
+                           intptr_t cid,
+                           const Function& target) {
+  const intptr_t index = FindSelector(name, descriptor);
+  if (index < 0) return;
+  const intptr_t offset = selectors_[index].offset;
+  EnsureEntries(offset + cid + 1);
+  const Array& entries = Array::Handle(entries_);
+  const intptr_t entry = kEntryLength * (offset + cid);
+  const Object& current =
+      Object::Handle(entries.At(entry + kSelectorOffsetIndex));
+  if (current.IsNull() || (Smi::Cast(current).Value() == offset)) {
+    entries.SetAt(entry + kSelectorOffsetIndex,
+                  Smi::Handle(Smi::New(offset)));
+    entries.SetAt(entry + kTargetFunctionIndex, target);
+  }
+}
+
+
+void DispatchTable::VisitObjectPointers(ObjectPointerVisitor* v) {
+  ASSERT(v != NULL);
+  v->VisitPointer(reinterpret_cast<RawObject**>(&entries_));
+  for (intptr_t i = 0; i < length_; ++i) {
+    v->VisitPointer(reinterpret_cast<RawObject**>(&selectors_[i].name));
+    v->VisitPointer(reinterpret_cast<RawObject**>(&selectors_[i].descriptor));
+  }
+}
+
+
+void DispatchTable::PrintSizes() {
+  if (entries_ == NULL) return;
+  StackZone zone(Isolate::Current());
+  const Array& entries = Array::Handle(entries_);
+  const intptr_t num_entries = entries.Length() / kEntryLength;
+  intptr_t used = 0;
+  for (intptr_t i = 0; i < num_entries; ++i) {
+    if (entries.At(kEntryLength * i) != Object::null()) ++used;
+  }
+  OS::Print("%"Pd" dispatch table selectors using %"Pd" of %"Pd" entries "
+            "(%"Pd"KB).\n",
+            length_, used, num_entries,
+            Array::InstanceSize(entries.Length()) / 1024);
+}
+
+}  // namespace dart
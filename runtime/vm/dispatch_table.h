@@ -0,0 +1,89 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef VM_DISPATCH_TABLE_H_
+#define VM_DISPATCH_TABLE_H_
+
+#include "vm/allocation.h"
+
+namespace dart {
+
+class Array;
+class Function;
+class ObjectPointerVisitor;
+class RawArray;
+class RawString;
+class String;
+
+// A row displacement dispatch table shared by all megamorphic call sites of
+// an isolate.
+//
+// Every selector (name and arguments descriptor) dispatched through the
+// table is assigned an offset, such that the entries at 'offset + cid' for
+// the classes implementing the selector do not collide with the entries of
+// any other selector. An entry holds the offset of its selector and the
+// target function, so a call site checks the offset at 'offset + cid' of the
+// receiver and calls the target if it matches. Otherwise the call site falls
+// back to the megamorphic cache of the selector.
+//
+// Selectors are assigned their offsets when the first call site using them
+// is compiled, based on the classes finalized at that point. Entries for
+// classes finalized later are added on a megamorphic cache miss if their
+// slot is still free.
+class DispatchTable {
+ public:
+  DispatchTable();
+  ~DispatchTable();
+
+  // Returns the offset of the selector, assigning one if needed.
+  intptr_t SelectorOffset(const String& name, const Array& descriptor);
+
+  // Records 'target' as the target of the selector for receivers of class
+  // 'cid' if the selector has an offset and the entry is free.
+  void Update(const String& name,
+              const Array& descriptor,
+              intptr_t cid,
+              const Function& target);
+
+  // Address of the entries array, which is reallocated when it grows.
+  uword entries_address() const {
+    return reinterpret_cast<uword>(&entries_);
+  }
+
+  void VisitObjectPointers(ObjectPointerVisitor* visitor);
+
+  // Printed at isolate shutdown with --trace_dispatch_table.
+  void PrintSizes();
+
+  enum {
+    kSelectorOffsetIndex,
+    kTargetFunctionIndex,
+    kEntryLength,
+  };
+
+ private:
+  struct Selector {
+    RawString* name;
+    RawArray* descriptor;
+    intptr_t offset;
+  };
+
+  static const int kCapacityIncrement = 128;
+  static const int kInitialEntries = 256;
+
+  intptr_t FindSelector(const String& name, const Array& descriptor) const;
+  bool IsUsedOffset(intptr_t offset) const;
+  void EnsureEntries(intptr_t num_entries);
+
+  RawArray* entries_;
+  intptr_t capacity_;
+  intptr_t length_;
+  Selector* selectors_;
+
+  DISALLOW_COPY_AND_ASSIGN(DispatchTable);
+};
+
+}  // namespace dart
+
+#endif  // VM_DISPATCH_TABLE_H_
@@ -52,7 +52,10 @@ void DoubleToCString(double d, char* buffer, int buffer_size) {
   ASSERT(result == buffer);
 }
 
-RawString* DoubleToStringAsFixed(double d, int fraction_digits) {
+void DoubleToCStringAsFixed(double d,
+                            int fraction_digits,
+                            char* buffer,
+                            int buffer_size) {
   static const int kMinFractionDigits = 0;
   static const int kMaxFractionDigits = 20;
   static const int kMaxDigitsBeforePoint = 20;
@@ -62,7 +65,6 @@ RawString* DoubleToStringAsFixed(double d, int fraction_digits) {
   // TODO(floitsch): remove the UNIQUE_ZERO flag when the test is updated.
   static const int kConversionFlags =
       double_conversion::DoubleToStringConverter::NO_FLAGS;
-  const int kBufferSize = 128;
 
   USE(kMaxDigitsBeforePoint);
   USE(kMaxFractionDigits);
@@ -72,7 +74,8 @@ RawString* DoubleToStringAsFixed(double d, int fraction_digits) {
   USE(kMaxFractionDigits);
   // The output contains the sign, at most kMaxDigitsBeforePoint digits,
   // the decimal point followed by at most fraction_digits digits plus the \0.
-  ASSERT(kBufferSize >= 1 + kMaxDigitsBeforePoint + 1 + kMaxFractionDigits + 1);
+  ASSERT(buffer_size >=
+         1 + kMaxDigitsBeforePoint + 1 + fraction_digits + 1);
 
   ASSERT(kLowerBoundary < d && d < kUpperBoundary);
 
@@ -86,12 +89,20 @@ RawString* DoubleToStringAsFixed(double d, int fraction_digits) {
       kDoubleToStringCommonExponentChar,
       0, 0, 0, 0);  // Last four values are ignored in fixed mode.
 
-  char* buffer = Isolate::Current()->current_zone()->Alloc<char>(kBufferSize);
-  buffer[kBufferSize - 1] = '\0';
-  double_conversion::StringBuilder builder(buffer, kBufferSize);
+  double_conversion::StringBuilder builder(buffer, buffer_size);
   bool status = converter.ToFixed(d, fraction_digits, &builder);
   ASSERT(status);
-  return String::New(builder.Finalize());
+  char* result = builder.Finalize();
+  ASSERT(result == buffer);
+}
+
+
+RawString* DoubleToStringAsFixed(double d, int fraction_digits) {
+  const int kBufferSize = 128;
+  char* buffer = Isolate::Current()->current_zone()->Alloc<char>(kBufferSize);
+  buffer[kBufferSize - 1] = '\0';
+  DoubleToCStringAsFixed(d, fraction_digits, buffer, kBufferSize);
+  return String::New(buffer);
 }
 
 
@@ -11,6 +11,10 @@
 namespace dart {
 
 void DoubleToCString(double d, char* buffer, int buffer_size);
+void DoubleToCStringAsFixed(double d,
+                            int fraction_digits,
+                            char* buffer,
+                            int buffer_size);
 RawString* DoubleToStringAsFixed(double d, int fraction_digits);
 RawString* DoubleToStringAsExponential(double d, int fraction_digits);
 RawString* DoubleToStringAsPrecision(double d, int precision);
@@ -636,8 +636,11 @@ void FlowGraph::Rename(GrowableArray<PhiInstr*>* live_phis,
       env.Add(defn);
     }
   } else {
-    // Create new parameters.
-    for (intptr_t i = 0; i < parameter_count(); ++i) {
+    // Create new parameters.  When compiling for OSR the locals are also
+    // parameters, their values are in the frame of the unoptimized code.
+    const intptr_t count =
+        IsCompiledForOsr() ? variable_count() : parameter_count();
+    for (intptr_t i = 0; i < count; ++i) {
       ParameterInstr* param = new ParameterInstr(i, graph_entry_);
       param->set_ssa_temp_index(alloc_ssa_temp_index());  // New SSA temp.
       AddToInitialDefinitions(param);
@@ -646,7 +649,7 @@ void FlowGraph::Rename(GrowableArray<PhiInstr*>* live_phis,
   }
 
   // Initialize all locals with #null in the renaming environment.
-  for (intptr_t i = parameter_count(); i < variable_count(); ++i) {
+  for (intptr_t i = env.length(); i < variable_count(); ++i) {
     env.Add(constant_null());
   }
 
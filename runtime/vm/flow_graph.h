@@ -102,6 +102,8 @@ class FlowGraph : public ZoneAllocated {
     return graph_entry_;
   }
 
+  bool IsCompiledForOsr() const { return graph_entry()->IsCompiledForOsr(); }
+
   ConstantInstr* constant_null() const {
     return constant_null_;
   }
@@ -144,6 +146,7 @@ class FlowGraph : public ZoneAllocated {
   friend class IfConverter;
   friend class BranchSimplifier;
   friend class ConstantPropagator;
+  friend class LoopVectorizer;
 
   // SSA transformation methods and fields.
   void ComputeDominators(GrowableArray<BitVector*>* dominance_frontier);
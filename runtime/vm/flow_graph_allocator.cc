@@ -153,8 +153,18 @@ void SSALivenessAnalysis::ComputeInitialSets() {
              !env_it.Done();
              env_it.Advance()) {
           Value* value = env_it.CurrentValue();
-          if (!value->definition()->IsPushArgument() &&
-              !value->BindsToConstant()) {
+          MaterializeObjectInstr* mat =
+              value->definition()->AsMaterializeObject();
+          if (mat != NULL) {
+            // The inputs of a materialization are live where the
+            // materialization is used.
+            for (intptr_t k = 0; k < mat->InputCount(); k++) {
+              if (!mat->InputAt(k)->BindsToConstant()) {
+                live_in->Add(mat->InputAt(k)->definition()->ssa_temp_index());
+              }
+            }
+          } else if (!value->definition()->IsPushArgument() &&
+                     !value->BindsToConstant()) {
             live_in->Add(value->definition()->ssa_temp_index());
           }
         }
@@ -517,7 +527,9 @@ void FlowGraphAllocator::BuildLiveRanges() {
 
       range->set_assigned_location(Location::StackSlot(slot_index));
       range->set_spill_slot(Location::StackSlot(slot_index));
-      if (flow_graph_.num_copied_params() > 0) {
+      // Copied parameters and, when compiling for OSR, locals live in the
+      // spill slots of the frame.
+      if (slot_index >= 0) {
         ASSERT(spill_slots_.length() == slot_index);
         spill_slots_.Add(range->End());
         quad_spill_slots_.Add(false);
@@ -540,7 +552,9 @@ void FlowGraphAllocator::BuildLiveRanges() {
     }
     ConvertAllUses(range);
 
-    if (defn->IsParameter() && flow_graph_.num_copied_params() > 0) {
+    if (defn->IsParameter() &&
+        (defn->AsParameter()->index() >=
+         flow_graph_.num_non_copied_params())) {
       MarkAsObjectAtSafepoints(range);
     }
   }
@@ -560,7 +574,8 @@ static Location::Kind RegisterKindForResult(Instruction* instr) {
   if ((instr->representation() == kUnboxedDouble) ||
       (instr->representation() == kUnboxedMint) ||
       (instr->representation() == kUnboxedFloat32x4) ||
-      (instr->representation() == kUnboxedUint32x4)) {
+      (instr->representation() == kUnboxedUint32x4) ||
+      (instr->representation() == kUnboxedFloat64x2)) {
     return Location::kFpuRegister;
   } else {
     return Location::kRegister;
@@ -736,6 +751,15 @@ void FlowGraphAllocator::ProcessEnvironmentUses(BlockEntryInstr* block,
         continue;
       }
 
+      MaterializeObjectInstr* mat = def->AsMaterializeObject();
+      if (mat != NULL) {
+        // The materialization itself has no location, it is described by
+        // the locations of its inputs.
+        locations[i] = Location::NoLocation();
+        ProcessMaterializationUses(block_start_pos, use_pos, mat);
+        continue;
+      }
+
       ConstantInstr* constant = def->AsConstant();
       if (constant != NULL) {
         locations[i] = Location::Constant(constant->value());
@@ -754,6 +778,35 @@ void FlowGraphAllocator::ProcessEnvironmentUses(BlockEntryInstr* block,
 }
 
 
+void FlowGraphAllocator::ProcessMaterializationUses(
+    intptr_t block_start_pos,
+    intptr_t use_pos,
+    MaterializeObjectInstr* mat) {
+  // A materialization is only used by the environment of a single
+  // instruction but it can occur several times in it.
+  if (mat->locations() != NULL) return;
+
+  Location* locations =
+      Isolate::Current()->current_zone()->Alloc<Location>(mat->InputCount());
+  mat->set_locations(locations);
+
+  for (intptr_t i = 0; i < mat->InputCount(); ++i) {
+    Definition* def = mat->InputAt(i)->definition();
+    locations[i] = Location::Any();
+
+    ConstantInstr* constant = def->AsConstant();
+    if (constant != NULL) {
+      locations[i] = Location::Constant(constant->value());
+      continue;
+    }
+
+    LiveRange* range = GetLiveRange(def->ssa_temp_index());
+    range->AddUseInterval(block_start_pos, use_pos);
+    range->AddUse(use_pos, &locations[i]);
+  }
+}
+
+
 // Create and update live ranges corresponding to instruction's inputs,
 // temporaries and output.
 void FlowGraphAllocator::ProcessOneInstruction(BlockEntryInstr* block,
@@ -1512,7 +1565,8 @@ void FlowGraphAllocator::AllocateSpillSlotFor(LiveRange* range) {
   // parallel move resolution.
   const bool need_quad = (register_kind_ == Location::kFpuRegister) &&
       ((range->representation() == kUnboxedFloat32x4) ||
-       (range->representation() == kUnboxedUint32x4));
+       (range->representation() == kUnboxedUint32x4) ||
+       (range->representation() == kUnboxedFloat64x2));
 
   // Search for a free spill slot among allocated: the value in it should be
   // dead and its type should match (e.g. it should not be a part of the quad if
@@ -1558,7 +1612,8 @@ void FlowGraphAllocator::AllocateSpillSlotFor(LiveRange* range) {
 
     Location location;
     if ((range->representation() == kUnboxedFloat32x4) ||
-        (range->representation() == kUnboxedUint32x4)) {
+        (range->representation() == kUnboxedUint32x4) ||
+        (range->representation() == kUnboxedFloat64x2)) {
       ASSERT(need_quad);
       location = Location::QuadStackSlot(slot_idx);
     } else {
@@ -107,6 +107,9 @@ class FlowGraphAllocator : public ValueObject {
   Instruction* ConnectOutgoingPhiMoves(BlockEntryInstr* block,
                                        BitVector* interference_set);
   void ProcessEnvironmentUses(BlockEntryInstr* block, Instruction* current);
+  void ProcessMaterializationUses(intptr_t block_start_pos,
+                                  intptr_t use_pos,
+                                  MaterializeObjectInstr* mat);
   void ProcessOneInstruction(BlockEntryInstr* block,
                              Instruction* instr,
                              BitVector* interference_set);
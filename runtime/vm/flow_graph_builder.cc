@@ -6,6 +6,7 @@
 
 #include "lib/invocation_mirror.h"
 #include "vm/ast_printer.h"
+#include "vm/bit_vector.h"
 #include "vm/code_descriptors.h"
 #include "vm/dart_entry.h"
 #include "vm/flags.h"
@@ -41,7 +42,8 @@ static const String& PrivateCoreLibName(const String& str) {
 
 
 FlowGraphBuilder::FlowGraphBuilder(const ParsedFunction& parsed_function,
-                                   InlineExitCollector* exit_collector)
+                                   InlineExitCollector* exit_collector,
+                                   intptr_t osr_id)
   : parsed_function_(parsed_function),
     num_copied_params_(parsed_function.num_copied_params()),
     // All parameters are copied if any parameter is.
@@ -50,6 +52,7 @@ FlowGraphBuilder::FlowGraphBuilder(const ParsedFunction& parsed_function,
         : 0),
     num_stack_locals_(parsed_function.num_stack_locals()),
     exit_collector_(exit_collector),
+    osr_id_(osr_id),
     last_used_block_id_(0),  // 0 is used for the graph entry.
     context_level_(0),
     last_used_try_index_(CatchClauseNode::kInvalidTryIndex),
@@ -1530,7 +1533,7 @@ void EffectGraphVisitor::VisitWhileNode(WhileNode* node) {
 
   EffectGraphVisitor for_body(owner(), temp_index());
   for_body.AddInstruction(
-      new CheckStackOverflowInstr(node->token_pos()));
+      new CheckStackOverflowInstr(node->token_pos(), true));  // In loop.
   node->body()->Visit(&for_body);
 
   // Labels are set after body traversal.
@@ -1562,7 +1565,7 @@ void EffectGraphVisitor::VisitDoWhileNode(DoWhileNode* node) {
   // Traverse body first in order to generate continue and break labels.
   EffectGraphVisitor for_body(owner(), temp_index());
   for_body.AddInstruction(
-      new CheckStackOverflowInstr(node->token_pos()));
+      new CheckStackOverflowInstr(node->token_pos(), true));  // In loop.
   node->body()->Visit(&for_body);
 
   TestGraphVisitor for_test(owner(),
@@ -1622,7 +1625,7 @@ void EffectGraphVisitor::VisitForNode(ForNode* node) {
   // Compose body to set any jump labels.
   EffectGraphVisitor for_body(owner(), temp_index());
   for_body.AddInstruction(
-      new CheckStackOverflowInstr(node->token_pos()));
+      new CheckStackOverflowInstr(node->token_pos(), true));  // In loop.
   node->body()->Visit(&for_body);
 
   // Join loop body, increment and compute their end instruction.
@@ -2074,20 +2077,20 @@ void EffectGraphVisitor::BuildConstructorCall(
 // TODO(srdjan): Store the values in the snapshot instead.
 // TODO(srdjan): Add Float32x4List.
 #define RECOGNIZED_LIST_FACTORY_LIST(V)                                        \
-  V(ObjectArrayFactory, kArrayCid, 97987288)                                   \
-  V(GrowableObjectArrayWithData, kGrowableObjectArrayCid, 816132033)           \
-  V(GrowableObjectArrayFactory, kGrowableObjectArrayCid, 552407276)            \
-  V(Int8ListFactory, kTypedDataInt8ArrayCid, 2066002614)                       \
-  V(Uint8ListFactory, kTypedDataUint8ArrayCid, 1883551322)                     \
-  V(Uint8ClampedListFactory, kTypedDataUint8ClampedArrayCid, 244333676)        \
-  V(Int16ListFactory, kTypedDataInt16ArrayCid, 335889889)                      \
-  V(Uint16ListFactory, kTypedDataUint16ArrayCid, 1552801708)                   \
-  V(Int32ListFactory, kTypedDataInt32ArrayCid, 1615677219)                     \
-  V(Uint32ListFactory, kTypedDataUint32ArrayCid, 1239540305)                   \
-  V(Int64ListFactory, kTypedDataInt64ArrayCid, 993438946)                      \
-  V(Uint64ListFactory, kTypedDataUint64ArrayCid, 1830907325)                   \
-  V(Float64ListFactory, kTypedDataFloat64ArrayCid, 1236037424)                 \
-  V(Float32ListFactory, kTypedDataFloat32ArrayCid, 570814412)                  \
+  V(ObjectArrayFactory, kArrayCid, 514235087)                                  \
+  V(GrowableObjectArrayWithData, kGrowableObjectArrayCid, 862476975)           \
+  V(GrowableObjectArrayFactory, kGrowableObjectArrayCid, 889245417)            \
+  V(Int8ListFactory, kTypedDataInt8ArrayCid, 810369271)                        \
+  V(Uint8ListFactory, kTypedDataUint8ArrayCid, 675454903)                      \
+  V(Uint8ClampedListFactory, kTypedDataUint8ClampedArrayCid, 896258118)        \
+  V(Int16ListFactory, kTypedDataInt16ArrayCid, 1787047219)                     \
+  V(Uint16ListFactory, kTypedDataUint16ArrayCid, 1349007923)                   \
+  V(Int32ListFactory, kTypedDataInt32ArrayCid, 1629155383)                     \
+  V(Uint32ListFactory, kTypedDataUint32ArrayCid, 1409531493)                   \
+  V(Int64ListFactory, kTypedDataInt64ArrayCid, 1182836045)                     \
+  V(Uint64ListFactory, kTypedDataUint64ArrayCid, 1165719244)                   \
+  V(Float64ListFactory, kTypedDataFloat64ArrayCid, 1823542222)                 \
+  V(Float32ListFactory, kTypedDataFloat32ArrayCid, 1069808340)                 \
 
 
 // Class that recognizes factories and returns corresponding result cid.
@@ -3381,11 +3384,13 @@ FlowGraph* FlowGraphBuilder::BuildGraph() {
   TargetEntryInstr* normal_entry =
       new TargetEntryInstr(AllocateBlockId(),
                            CatchClauseNode::kInvalidTryIndex);
-  graph_entry_ = new GraphEntryInstr(parsed_function(), normal_entry);
+  graph_entry_ =
+      new GraphEntryInstr(parsed_function(), normal_entry, osr_id_);
   EffectGraphVisitor for_effect(this, 0);
   // TODO(kmillikin): We can eliminate stack checks in some cases (e.g., the
   // stack check on entry for leaf routines).
-  Instruction* check = new CheckStackOverflowInstr(function.token_pos());
+  Instruction* check =
+      new CheckStackOverflowInstr(function.token_pos(), false);  // Not loop.
   // If we are inlining don't actually attach the stack check. We must still
   // create the stack check in order to allocate a deopt id.
   if (!IsInlining()) for_effect.AddInstruction(check);
@@ -3393,11 +3398,51 @@ FlowGraph* FlowGraphBuilder::BuildGraph() {
   AppendFragment(normal_entry, for_effect);
   // Check that the graph is properly terminated.
   ASSERT(!for_effect.is_open());
+  if (IsCompiledForOsr()) PruneUnreachable();
   FlowGraph* graph = new FlowGraph(*this, graph_entry_, last_used_block_id_);
   return graph;
 }
 
 
+// Makes the stack overflow check with the OSR id the entry of the graph.
+// The check is split off into a new join block that is the target of both
+// the code before the check and the normal entry, whose original code
+// becomes unreachable unless the loop reaches it again.  The values of all
+// variables at the join are taken from the frame of the unoptimized code.
+void FlowGraphBuilder::PruneUnreachable() {
+  ASSERT(IsCompiledForOsr());
+  // Blocks have not been discovered yet, search the graph depth first.
+  GrowableArray<BlockEntryInstr*> worklist;
+  BitVector* visited = new BitVector(last_used_block_id_ + 1);
+  worklist.Add(graph_entry_->normal_entry());
+  while (!worklist.is_empty()) {
+    BlockEntryInstr* block = worklist.RemoveLast();
+    if (visited->Contains(block->block_id())) continue;
+    visited->Add(block->block_id());
+
+    Instruction* last = block;
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Instruction* current = it.Current();
+      if (current->IsCheckStackOverflow() &&
+          (current->deopt_id() == osr_id_)) {
+        JoinEntryInstr* osr_join =
+            new JoinEntryInstr(AllocateBlockId(), block->try_index());
+        Instruction* previous = current->previous();
+        previous->LinkTo(new GotoInstr(osr_join));
+        osr_join->LinkTo(current);
+        graph_entry_->normal_entry()->LinkTo(new GotoInstr(osr_join));
+        return;
+      }
+      last = current;
+    }
+    for (intptr_t i = 0; i < last->SuccessorCount(); ++i) {
+      worklist.Add(last->SuccessorAt(i));
+    }
+  }
+  Bailout("OSR entry not found");
+}
+
+
 void FlowGraphBuilder::Bailout(const char* reason) {
   const char* kFormat = "FlowGraphBuilder Bailout: %s %s";
   const char* function_name = parsed_function_.function().ToCString();
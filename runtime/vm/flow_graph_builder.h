@@ -77,9 +77,12 @@ class InlineExitCollector: public ZoneAllocated {
 // Build a flow graph from a parsed function's AST.
 class FlowGraphBuilder: public ValueObject {
  public:
-  // The inlining context is NULL if not inlining.
+  // The inlining context is NULL if not inlining.  The OSR id is the deopt
+  // id of the stack overflow check at which the graph is entered when
+  // compiling for on-stack replacement, or Isolate::kNoDeoptId.
   FlowGraphBuilder(const ParsedFunction& parsed_function,
-                   InlineExitCollector* exit_collector);
+                   InlineExitCollector* exit_collector,
+                   intptr_t osr_id);
 
   FlowGraph* BuildGraph();
 
@@ -115,7 +118,11 @@ class FlowGraphBuilder: public ValueObject {
   bool IsInlining() const { return (exit_collector_ != NULL); }
   InlineExitCollector* exit_collector() const { return exit_collector_; }
 
+  bool IsCompiledForOsr() const { return osr_id_ != Isolate::kNoDeoptId; }
+
  private:
+  void PruneUnreachable();
+
   intptr_t parameter_count() const {
     return num_copied_params_ + num_non_copied_params_;
   }
@@ -129,6 +136,7 @@ class FlowGraphBuilder: public ValueObject {
   const intptr_t num_non_copied_params_;
   const intptr_t num_stack_locals_;  // Does not include any parameters.
   InlineExitCollector* const exit_collector_;
+  const intptr_t osr_id_;
 
   intptr_t last_used_block_id_;
   intptr_t context_level_;
@@ -23,6 +23,8 @@
 namespace dart {
 
 DEFINE_FLAG(bool, print_scopes, false, "Print scopes of local variables.");
+DEFINE_FLAG(bool, use_osr, false,
+    "Replace unoptimized code running hot loops with optimized code.");
 DECLARE_FLAG(bool, code_comments);
 DECLARE_FLAG(bool, enable_type_checks);
 DECLARE_FLAG(bool, intrinsify);
@@ -42,6 +44,8 @@ void CompilerDeoptInfo::AllocateIncomingParametersRecursive(
   AllocateIncomingParametersRecursive(env->outer(), stack_height);
   for (Environment::ShallowIterator it(env); !it.Done(); it.Advance()) {
     if (it.CurrentLocation().IsInvalid()) {
+      // Materializations are described by the locations of their inputs.
+      if (it.CurrentValue()->definition()->IsMaterializeObject()) continue;
       ASSERT(it.CurrentValue()->definition()->IsPushArgument());
       it.SetCurrentLocation(Location::StackSlot((*stack_height)++));
     }
@@ -202,6 +206,24 @@ bool FlowGraphCompiler::CanOptimizeFunction() const {
 }
 
 
+bool FlowGraphCompiler::CanOSRFunction() const {
+#if defined(TARGET_ARCH_IA32) || defined(TARGET_ARCH_X64)
+  return FLAG_use_osr &&
+         !is_optimizing() &&
+         CanOptimizeFunction() &&
+         parsed_function().function().is_optimizable();
+#else
+  // Only the ia32 and x64 compilers can enter the frame of unoptimized code.
+  return false;
+#endif
+}
+
+
+bool FlowGraphCompiler::IsCompiledForOsr() const {
+  return block_order_[0]->AsGraphEntry()->IsCompiledForOsr();
+}
+
+
 static bool IsEmptyBlock(BlockEntryInstr* block) {
   return !block->HasParallelMove() &&
          block->next()->IsGoto() &&
@@ -532,6 +554,8 @@ void FlowGraphCompiler::FinalizeStaticCallTargetsTable(const Code& code) {
 // no fall-through to regular code is needed.
 bool FlowGraphCompiler::TryIntrinsify() {
   if (!CanOptimizeFunction()) return false;
+  // Code compiled for OSR is only entered in the middle of the function.
+  if (IsCompiledForOsr()) return false;
   // Intrinsification skips arguments checks, therefore disable if in checked
   // mode.
   if (FLAG_intrinsify && !FLAG_enable_type_checks) {
@@ -250,6 +250,10 @@ class FlowGraphCompiler : public ValueObject {
   }
   static bool CanOptimize();
   bool CanOptimizeFunction() const;
+  // Whether loop stack checks in unoptimized code count iterations to
+  // trigger on-stack replacement.
+  bool CanOSRFunction() const;
+  bool IsCompiledForOsr() const;
   bool is_optimizing() const { return is_optimizing_; }
 
   const GrowableArray<BlockInfo*>& block_info() const { return block_info_; }
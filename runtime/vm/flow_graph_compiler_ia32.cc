@@ -26,6 +26,7 @@ DECLARE_FLAG(bool, print_ast);
 DECLARE_FLAG(bool, print_scopes);
 DECLARE_FLAG(bool, enable_type_checks);
 DECLARE_FLAG(bool, eliminate_type_checks);
+DECLARE_FLAG(bool, use_dispatch_table);
 
 
 FlowGraphCompiler::~FlowGraphCompiler() {
@@ -907,6 +908,12 @@ void FlowGraphCompiler::GenerateInlinedSetter(intptr_t offset) {
 
 
 void FlowGraphCompiler::EmitFrameEntry() {
+  if (IsCompiledForOsr()) {
+    // Continue in the frame of the unoptimized code, see EnterOsrFrame.
+    __ Comment("Enter OSR frame");
+    __ EnterOsrFrame(StackSize() * kWordSize);
+    return;
+  }
   const Function& function = parsed_function().function();
   if (CanOptimizeFunction() && function.is_optimizable()) {
     const bool can_optimize = !is_optimizing() || may_reoptimize();
@@ -964,7 +971,10 @@ void FlowGraphCompiler::CompileGraph() {
   // unless we are in debug mode or unless we are compiling a closure.
   LocalVariable* saved_args_desc_var =
       parsed_function().GetSavedArgumentsDescriptorVar();
-  if (num_copied_params == 0) {
+  if (IsCompiledForOsr()) {
+    // The unoptimized code has already checked and copied the parameters.
+    ASSERT(is_optimizing());
+  } else if (num_copied_params == 0) {
 #ifdef DEBUG
     ASSERT(!parsed_function().function().HasOptionalParameters());
     const bool check_arguments = true;
@@ -1202,6 +1212,28 @@ void FlowGraphCompiler::EmitMegamorphicInstanceCall(
 
   // EAX: class ID of the receiver (smi).
   __ Bind(&load_cache);
+  Label call_function;
+  if (FLAG_use_dispatch_table) {
+    // Look up the entry of the class at the selector's offset in the
+    // dispatch table and use the cache if it belongs to another selector.
+    DispatchTable* dispatch_table = Isolate::Current()->dispatch_table();
+    const intptr_t offset =
+        dispatch_table->SelectorOffset(name, arguments_descriptor);
+    Label not_found;
+    __ movl(EDI, Address::Absolute(dispatch_table->entries_address()));
+    __ leal(ECX, Address(EAX, EAX, TIMES_1, Smi::RawValue(2 * offset)));
+    // ECX: index of the entry in the entries array (smi).
+    __ cmpl(ECX, FieldAddress(EDI, Array::length_offset()));
+    __ j(ABOVE_EQUAL, &not_found, Assembler::kNearJump);
+    // ECX is a smi tagged word index, so TIMES_2.
+    __ cmpl(FieldAddress(EDI, ECX, TIMES_2, Array::data_offset()),
+            Immediate(Smi::RawValue(offset)));
+    __ j(NOT_EQUAL, &not_found, Assembler::kNearJump);
+    __ movl(EAX, FieldAddress(EDI, ECX, TIMES_2,
+                              Array::data_offset() + kWordSize));
+    __ jmp(&call_function);
+    __ Bind(&not_found);
+  }
   __ LoadObject(EBX, cache);
   __ movl(EDI, FieldAddress(EBX, MegamorphicCache::buckets_offset()));
   __ movl(EBX, FieldAddress(EBX, MegamorphicCache::mask_offset()));
@@ -1232,6 +1264,8 @@ void FlowGraphCompiler::EmitMegamorphicInstanceCall(
   // illegal class id was found, the target is a cache miss handler that can
   // be invoked as a normal Dart function.
   __ movl(EAX, FieldAddress(EDI, ECX, TIMES_4, base + kWordSize));
+  __ Bind(&call_function);
+  // EAX: target function.
   __ movl(EAX, FieldAddress(EAX, Function::code_offset()));
   __ movl(EAX, FieldAddress(EAX, Code::instructions_offset()));
   __ LoadObject(ECX, ic_data);
@@ -25,6 +25,7 @@ DECLARE_FLAG(bool, print_ast);
 DECLARE_FLAG(bool, print_scopes);
 DECLARE_FLAG(bool, enable_type_checks);
 DECLARE_FLAG(bool, eliminate_type_checks);
+DECLARE_FLAG(bool, use_dispatch_table);
 
 
 FlowGraphCompiler::~FlowGraphCompiler() {
@@ -905,6 +906,12 @@ void FlowGraphCompiler::GenerateInlinedSetter(intptr_t offset) {
 
 
 void FlowGraphCompiler::EmitFrameEntry() {
+  if (IsCompiledForOsr()) {
+    // Continue in the frame of the unoptimized code, see EnterOsrFrame.
+    __ Comment("Enter OSR frame");
+    __ EnterOsrFrame(StackSize() * kWordSize);
+    return;
+  }
   const Function& function = parsed_function().function();
   if (CanOptimizeFunction() && function.is_optimizable()) {
     const bool can_optimize = !is_optimizing() || may_reoptimize();
@@ -963,7 +970,10 @@ void FlowGraphCompiler::CompileGraph() {
   // unless we are in debug mode or unless we are compiling a closure.
   LocalVariable* saved_args_desc_var =
       parsed_function().GetSavedArgumentsDescriptorVar();
-  if (num_copied_params == 0) {
+  if (IsCompiledForOsr()) {
+    // The unoptimized code has already checked and copied the parameters.
+    ASSERT(is_optimizing());
+  } else if (num_copied_params == 0) {
 #ifdef DEBUG
     ASSERT(!parsed_function().function().HasOptionalParameters());
     const bool check_arguments = true;
@@ -1202,6 +1212,30 @@ void FlowGraphCompiler::EmitMegamorphicInstanceCall(
 
   // RAX: class ID of the receiver (smi).
   __ Bind(&load_cache);
+  Label call_function;
+  if (FLAG_use_dispatch_table) {
+    // Look up the entry of the class at the selector's offset in the
+    // dispatch table and use the cache if it belongs to another selector.
+    DispatchTable* dispatch_table = Isolate::Current()->dispatch_table();
+    const intptr_t offset =
+        dispatch_table->SelectorOffset(name, arguments_descriptor);
+    ASSERT(Utils::IsInt(32, Smi::RawValue(offset)));
+    Label not_found;
+    __ movq(RDI, Immediate(dispatch_table->entries_address()));
+    __ movq(RDI, Address(RDI, 0));
+    __ leaq(RCX, Address(RAX, RAX, TIMES_1, Smi::RawValue(2 * offset)));
+    // RCX: index of the entry in the entries array (smi).
+    __ cmpq(RCX, FieldAddress(RDI, Array::length_offset()));
+    __ j(ABOVE_EQUAL, &not_found, Assembler::kNearJump);
+    // RCX is a smi tagged word index, so TIMES_4.
+    __ cmpq(FieldAddress(RDI, RCX, TIMES_4, Array::data_offset()),
+            Immediate(Smi::RawValue(offset)));
+    __ j(NOT_EQUAL, &not_found, Assembler::kNearJump);
+    __ movq(RAX, FieldAddress(RDI, RCX, TIMES_4,
+                              Array::data_offset() + kWordSize));
+    __ jmp(&call_function);
+    __ Bind(&not_found);
+  }
   __ LoadObject(RBX, cache);
   __ movq(RDI, FieldAddress(RBX, MegamorphicCache::buckets_offset()));
   __ movq(RBX, FieldAddress(RBX, MegamorphicCache::mask_offset()));
@@ -1232,6 +1266,8 @@ void FlowGraphCompiler::EmitMegamorphicInstanceCall(
   // illegal class id was found, the target is a cache miss handler that can
   // be invoked as a normal Dart function.
   __ movq(RAX, FieldAddress(RDI, RCX, TIMES_8, base + kWordSize));
+  __ Bind(&call_function);
+  // RAX: target function.
   __ movq(RAX, FieldAddress(RAX, Function::code_offset()));
   __ movq(RAX, FieldAddress(RAX, Code::instructions_offset()));
   __ LoadObject(RBX, ic_data);
@@ -691,7 +691,7 @@ intptr_t FlowGraphOptimizer::PrepareIndexedOp(InstanceCallInstr* call,
                  new CheckArrayBoundInstr(new Value(length),
                                           new Value(*index),
                                           class_id,
-                                          call),
+                                          call->deopt_id()),
                  call->env(),
                  Definition::kEffect);
   }
@@ -1067,7 +1067,7 @@ bool FlowGraphOptimizer::TryReplaceWithBinaryOp(InstanceCallInstr* call,
 
     BinaryDoubleOpInstr* double_bin_op =
         new BinaryDoubleOpInstr(op_kind, new Value(left), new Value(right),
-                                call);
+                                call->deopt_id());
     ReplaceCall(call, double_bin_op);
   } else if (operands_type == kMintCid) {
     if (!FlowGraphCompiler::SupportsUnboxedMints()) return false;
@@ -1170,7 +1170,7 @@ bool FlowGraphOptimizer::TryReplaceWithUnaryOp(InstanceCallInstr* call,
     unary_op = new BinaryDoubleOpInstr(Token::kMUL,
                                        new Value(input),
                                        new Value(minus_one),
-                                       call);
+                                       call->deopt_id());
   }
   if (unary_op == NULL) return false;
 
@@ -1486,7 +1486,7 @@ LoadIndexedInstr* FlowGraphOptimizer::BuildStringCodeUnitAt(
                  new CheckArrayBoundInstr(new Value(length),
                                           new Value(index),
                                           cid,
-                                          call),
+                                          call->deopt_id()),
                  call->env(),
                  Definition::kEffect);
   }
@@ -1844,7 +1844,7 @@ void FlowGraphOptimizer::PrepareByteArrayViewOp(
                new CheckArrayBoundInstr(new Value(len_in_bytes),
                                         new Value(byte_index),
                                         receiver_cid,
-                                        call),
+                                        call->deopt_id()),
                call->env(),
                Definition::kEffect);
 
@@ -2999,6 +2999,919 @@ void LICM::Optimize() {
 }
 
 
+BoundsCheckHoisting::BoundsCheckHoisting(FlowGraph* flow_graph)
+    : flow_graph_(flow_graph) {
+}
+
+
+void BoundsCheckHoisting::HoistChecks(BlockEntryInstr* header,
+                                      BlockEntryInstr* pre_header) {
+  BranchInstr* branch = header->last_instruction()->AsBranch();
+  if (branch == NULL) return;
+  RelationalOpInstr* compare = branch->comparison()->AsRelationalOp();
+  if ((compare == NULL) || (compare->operands_class_id() != kSmiCid)) return;
+  PhiInstr* induction = NULL;
+  Definition* limit = NULL;
+  if (compare->kind() == Token::kLT) {
+    induction = compare->left()->definition()->AsPhi();
+    limit = compare->right()->definition();
+  } else if (compare->kind() == Token::kGT) {
+    induction = compare->right()->definition()->AsPhi();
+    limit = compare->left()->definition();
+  }
+  if ((induction == NULL) ||
+      (induction->block() != header) ||
+      (induction->representation() != kTagged) ||
+      (Range::ConstantMin(induction->range()).value() < 0) ||
+      !limit->GetBlock()->Dominates(pre_header)) {
+    return;
+  }
+  TargetEntryInstr* body = branch->true_successor();
+  if (!header->loop_info()->Contains(body->preorder_number())) return;
+
+  // The guard computes length + 1 with the instance call of the increment.
+  BinarySmiOpInstr* increment = NULL;
+  for (intptr_t i = 0; i < induction->InputCount(); i++) {
+    BinarySmiOpInstr* op = induction->InputAt(i)->definition()->AsBinarySmiOp();
+    if ((op != NULL) &&
+        (op->op_kind() == Token::kADD) &&
+        (op->left()->definition() == induction)) {
+      increment = op;
+    }
+  }
+  if (increment == NULL) return;
+
+  // Within the blocks dominated by the body the induction variable is in
+  // [0, n - 1].
+  GrowableArray<CheckArrayBoundInstr*> checks;
+  for (BitVector::Iterator loop_it(header->loop_info());
+       !loop_it.Done();
+       loop_it.Advance()) {
+    BlockEntryInstr* block = flow_graph()->preorder()[loop_it.Current()];
+    if (!body->Dominates(block)) continue;
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      CheckArrayBoundInstr* check = it.Current()->AsCheckArrayBound();
+      if ((check != NULL) &&
+          (check->index()->definition() == induction) &&
+          CheckArrayBoundInstr::IsFixedLengthArrayType(check->array_type()) &&
+          check->length()->definition()->GetBlock()->Dominates(pre_header)) {
+        checks.Add(check);
+      }
+    }
+  }
+  if (checks.is_empty()) return;
+
+  GotoInstr* last = pre_header->last_instruction()->AsGoto();
+  ConstantInstr* one = flow_graph()->AddConstantToInitialDefinitions(
+      Smi::ZoneHandle(Smi::New(1)));
+  GrowableArray<Definition*> guarded_lengths;
+  for (intptr_t i = 0; i < checks.length(); i++) {
+    CheckArrayBoundInstr* check = checks[i];
+    Definition* length = check->length()->definition();
+    bool is_guarded = false;
+    for (intptr_t j = 0; j < guarded_lengths.length(); j++) {
+      if (guarded_lengths[j] == length) is_guarded = true;
+    }
+    if (!is_guarded) {
+      if (FLAG_trace_optimization) {
+        OS::Print("Hoisting bounds check of v%"Pd" out of loop B%"Pd"\n",
+                  length->ssa_temp_index(),
+                  header->block_id());
+      }
+      guarded_lengths.Add(length);
+      // Array lengths are far from the maximal smi: no overflow.
+      BinarySmiOpInstr* length_plus_one =
+          new BinarySmiOpInstr(Token::kADD,
+                               increment->instance_call(),
+                               new Value(length),
+                               new Value(one));
+      length_plus_one->set_overflow(false);
+      flow_graph()->InsertBefore(last, length_plus_one, NULL,
+                                 Definition::kValue);
+      // Deoptimizes to the loop entry unless 0 <= n <= length.
+      CheckArrayBoundInstr* guard =
+          new CheckArrayBoundInstr(new Value(length_plus_one),
+                                   new Value(limit),
+                                   check->array_type(),
+                                   last->GetDeoptId());
+      flow_graph()->InsertBefore(last, guard, last->env(),
+                                 Definition::kEffect);
+    }
+    check->RemoveFromGraph();
+  }
+}
+
+
+void BoundsCheckHoisting::Optimize() {
+  GrowableArray<BlockEntryInstr*> loop_headers;
+  flow_graph()->ComputeLoops(&loop_headers);
+
+  for (intptr_t i = 0; i < loop_headers.length(); ++i) {
+    BlockEntryInstr* header = loop_headers[i];
+    BlockEntryInstr* pre_header = FindPreHeader(header);
+    if ((pre_header == NULL) ||
+        (pre_header->last_instruction()->AsGoto() == NULL)) {
+      continue;
+    }
+    HoistChecks(header, pre_header);
+  }
+}
+
+
+AllocationSinking::AllocationSinking(FlowGraph* flow_graph)
+    : flow_graph_(flow_graph) {
+}
+
+
+// Returns true if 'offset_in_bytes' is the offset of an instance field of
+// 'cls' or one of its superclasses.
+static bool IsInstanceFieldOffset(const Class& cls, intptr_t offset_in_bytes) {
+  Class& current = Class::Handle(cls.raw());
+  Array& fields = Array::Handle();
+  Field& field = Field::Handle();
+  while (!current.IsNull()) {
+    fields = current.fields();
+    for (intptr_t i = 0; i < fields.Length(); i++) {
+      field ^= fields.At(i);
+      if (!field.is_static() && (field.Offset() == offset_in_bytes)) {
+        return true;
+      }
+    }
+    current = current.SuperClass();
+  }
+  return false;
+}
+
+
+// An allocation can be sunk if all its uses are loads from and stores into
+// its fields, and environment uses.  The stores must be in the block of the
+// allocation, so that the value of each field is known at every use.
+bool AllocationSinking::IsSinkable(AllocateObjectInstr* alloc) {
+  if (alloc->ArgumentCount() != 0) return false;
+  const Class& cls =
+      Class::Handle(Isolate::Current()->class_table()->At(alloc->cid()));
+  if (cls.HasTypeArguments()) return false;
+
+  BlockEntryInstr* block = alloc->GetBlock();
+  for (Value* use = alloc->input_use_list();
+       use != NULL;
+       use = use->next_use()) {
+    Instruction* instr = use->instruction();
+    StoreInstanceFieldInstr* store = instr->AsStoreInstanceField();
+    if (store != NULL) {
+      if ((use->use_index() != 0) ||
+          (store->value()->definition() == alloc) ||
+          (store->GetBlock() != block)) {
+        return false;
+      }
+      continue;
+    }
+    LoadFieldInstr* load = instr->AsLoadField();
+    if ((load == NULL) ||
+        !IsInstanceFieldOffset(cls, load->offset_in_bytes())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+// Returns the value of the field at the given offset of the allocation being
+// sunk: the last value stored or null if it was not initialized yet.
+Definition* AllocationSinking::LoadedValue(intptr_t offset_in_bytes) const {
+  for (intptr_t i = 0; i < fields_.length(); i++) {
+    if (fields_[i]->Offset() == offset_in_bytes) {
+      return values_[i];
+    }
+  }
+  return flow_graph()->constant_null();
+}
+
+
+void AllocationSinking::ReplaceLoad(LoadFieldInstr* load) {
+  load->ReplaceUsesWith(LoadedValue(load->offset_in_bytes()));
+  load->RemoveFromGraph();
+}
+
+
+// Deoptimization boxes unboxed values in the environment, so a box does not
+// need to be kept alive for a materialization.
+static Definition* UnwrapBox(Definition* def) {
+  if (def->IsBoxDouble()) {
+    return def->AsBoxDouble()->value()->definition();
+  } else if (def->IsBoxFloat32x4()) {
+    return def->AsBoxFloat32x4()->value()->definition();
+  } else if (def->IsBoxInteger()) {
+    return def->AsBoxInteger()->value()->definition();
+  }
+  return def;
+}
+
+
+// Replace the uses of the allocation in the environment of 'exit' with a
+// materialization of the object as it is before 'exit' executes.
+void AllocationSinking::CreateMaterializationAt(Instruction* exit,
+                                                AllocateObjectInstr* alloc) {
+  if (!exit->CanDeoptimize()) {
+    // The register allocator drops the environment anyway.
+    exit->RemoveEnvironment();
+    return;
+  }
+
+  ZoneGrowableArray<const Field*>* fields =
+      new ZoneGrowableArray<const Field*>(fields_.length());
+  ZoneGrowableArray<Value*>* values =
+      new ZoneGrowableArray<Value*>(values_.length());
+  for (intptr_t i = 0; i < fields_.length(); i++) {
+    fields->Add(fields_[i]);
+    values->Add(new Value(UnwrapBox(values_[i])));
+  }
+  MaterializeObjectInstr* mat = new MaterializeObjectInstr(
+      Class::ZoneHandle(Isolate::Current()->class_table()->At(alloc->cid())),
+      *fields,
+      values);
+
+  for (Environment::DeepIterator it(exit->env()); !it.Done(); it.Advance()) {
+    Value* use = it.CurrentValue();
+    if (use->definition() == alloc) {
+      use->RemoveFromUseList();
+      use->set_definition(mat);
+      mat->AddEnvUse(use);
+    }
+  }
+}
+
+
+void AllocationSinking::Sink(AllocateObjectInstr* alloc) {
+  if (FLAG_trace_optimization) {
+    OS::Print("Sinking allocation v%"Pd" of %s\n",
+              alloc->ssa_temp_index(),
+              Class::Handle(alloc->constructor().Owner()).ToCString());
+  }
+  fields_.Clear();
+  values_.Clear();
+
+  // All stores are in the block of the allocation.  Follow them to know the
+  // values of the fields at each use in the block.
+  Instruction* next = NULL;
+  for (Instruction* current = alloc->next();
+       current != NULL;
+       current = next) {
+    next = current->next();
+    if (current->env() != NULL) {
+      for (Environment::DeepIterator it(current->env());
+           !it.Done();
+           it.Advance()) {
+        if (it.CurrentValue()->definition() == alloc) {
+          CreateMaterializationAt(current, alloc);
+          break;
+        }
+      }
+    }
+
+    StoreInstanceFieldInstr* store = current->AsStoreInstanceField();
+    if ((store != NULL) && (store->instance()->definition() == alloc)) {
+      const Field& field = store->field();
+      Definition* value = store->value()->definition();
+      intptr_t i = 0;
+      while ((i < fields_.length()) &&
+             (fields_[i]->Offset() != field.Offset())) {
+        i++;
+      }
+      if (i == fields_.length()) {
+        fields_.Add(&field);
+        values_.Add(value);
+      } else {
+        values_[i] = value;
+      }
+      if (UnwrapBox(value) != value) boxes_.Add(value);
+      store->RemoveFromGraph();
+      continue;
+    }
+
+    LoadFieldInstr* load = current->AsLoadField();
+    if ((load != NULL) && (load->value()->definition() == alloc)) {
+      ReplaceLoad(load);
+    }
+  }
+
+  // The remaining uses are in blocks dominated by the block of the
+  // allocation, after all the stores.
+  for (Value::Iterator it(alloc->input_use_list()); !it.Done(); it.Advance()) {
+    ReplaceLoad(it.Current()->instruction()->AsLoadField());
+  }
+  GrowableArray<Instruction*> exits;
+  for (Value* use = alloc->env_use_list(); use != NULL; use = use->next_use()) {
+    Instruction* exit = use->instruction();
+    bool found = false;
+    for (intptr_t i = 0; i < exits.length(); i++) {
+      if (exits[i] == exit) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) exits.Add(exit);
+  }
+  for (intptr_t i = 0; i < exits.length(); i++) {
+    CreateMaterializationAt(exits[i], alloc);
+  }
+
+  ASSERT(alloc->input_use_list() == NULL);
+  ASSERT(alloc->env_use_list() == NULL);
+  alloc->RemoveFromGraph();
+}
+
+
+// Remove boxes that were only kept alive by stores into sunk allocations.
+// Their environment uses can refer to the unboxed value instead.
+void AllocationSinking::RemoveUnusedBoxes() {
+  for (intptr_t i = 0; i < boxes_.length(); i++) {
+    Definition* box = boxes_[i];
+    if ((box->previous() == NULL) || (box->input_use_list() != NULL)) {
+      continue;
+    }
+    box->ReplaceUsesWith(UnwrapBox(box));
+    box->RemoveFromGraph();
+  }
+  boxes_.Clear();
+}
+
+
+void AllocationSinking::Optimize() {
+  GrowableArray<AllocateObjectInstr*> candidates;
+  for (BlockIterator block_it = flow_graph()->reverse_postorder_iterator();
+       !block_it.Done();
+       block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current());
+         !it.Done();
+         it.Advance()) {
+      AllocateObjectInstr* alloc = it.Current()->AsAllocateObject();
+      if ((alloc != NULL) && IsSinkable(alloc)) {
+        candidates.Add(alloc);
+      }
+    }
+  }
+
+  for (intptr_t i = 0; i < candidates.length(); i++) {
+    Sink(candidates[i]);
+  }
+  RemoveUnusedBoxes();
+}
+
+
+LoopVectorizer::LoopVectorizer(FlowGraph* flow_graph)
+    : flow_graph_(flow_graph),
+      header_(NULL),
+      pre_header_(NULL),
+      body_(NULL),
+      branch_(NULL),
+      stack_check_(NULL),
+      induction_(NULL),
+      increment_(NULL),
+      limit_(NULL) {
+}
+
+
+static bool IsVectorizableArrayCid(intptr_t cid) {
+  return (cid == kTypedDataFloat32ArrayCid) ||
+         (cid == kTypedDataFloat64ArrayCid);
+}
+
+
+static bool IsVectorizableOpKind(Token::Kind op_kind) {
+  return (op_kind == Token::kADD) ||
+         (op_kind == Token::kSUB) ||
+         (op_kind == Token::kMUL) ||
+         (op_kind == Token::kDIV);
+}
+
+
+bool LoopVectorizer::IsInLoop(Definition* defn) const {
+  BlockEntryInstr* block = defn->GetBlock();
+  return (block == header_) || (block == body_);
+}
+
+
+intptr_t LoopVectorizer::ScalarIndex(Definition* defn) const {
+  for (intptr_t i = 0; i < scalars_.length(); i++) {
+    if (scalars_[i] == defn) return i;
+  }
+  return -1;
+}
+
+
+intptr_t LoopVectorizer::ReductionIndex(Definition* defn) const {
+  for (intptr_t i = 0; i < reduction_adds_.length(); i++) {
+    if (reduction_adds_[i] == defn) return i;
+  }
+  return -1;
+}
+
+
+Definition* LoopVectorizer::VectorFor(Definition* scalar) const {
+  const intptr_t index = ScalarIndex(scalar);
+  return (index == -1) ? NULL : vectors_[index];
+}
+
+
+bool LoopVectorizer::IsVectorDefinition(Definition* defn) const {
+  return ScalarIndex(defn) != -1;
+}
+
+
+// Operands of vectorized operations are either computed by the loop body
+// for each element or are loop invariant doubles that are splatted in the
+// pre-header.
+bool LoopVectorizer::IsVectorizableOperand(Definition* defn) const {
+  return IsVectorDefinition(defn) ||
+      (!IsInLoop(defn) && (defn->representation() == kUnboxedDouble));
+}
+
+
+bool LoopVectorizer::IsVectorizableAccess(Value* array,
+                                          Value* index,
+                                          intptr_t index_scale,
+                                          intptr_t class_id) const {
+  return IsVectorizableArrayCid(class_id) &&
+      (index_scale == FlowGraphCompiler::ElementSizeFor(class_id)) &&
+      (index->definition() == induction_) &&
+      (array->definition()->representation() == kTagged) &&
+      !IsInLoop(array->definition());
+}
+
+
+// The header consists of the phis of the induction variable and of double
+// sums, an optional stack overflow check and the branch 'i < n' on a loop
+// invariant smi n.
+bool LoopVectorizer::MatchHeader() {
+  branch_ = header_->last_instruction()->AsBranch();
+  if ((branch_ == NULL) || (branch_->true_successor() != body_)) return false;
+  RelationalOpInstr* compare = branch_->comparison()->AsRelationalOp();
+  if ((compare == NULL) ||
+      (compare->kind() != Token::kLT) ||
+      (compare->operands_class_id() != kSmiCid)) {
+    return false;
+  }
+  induction_ = compare->left()->definition()->AsPhi();
+  if ((induction_ == NULL) ||
+      (induction_->block() != header_) ||
+      (induction_->representation() != kTagged)) {
+    return false;
+  }
+  limit_ = compare->right()->definition();
+  if (IsInLoop(limit_)) return false;
+
+  for (ForwardInstructionIterator it(header_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current == branch_) continue;
+    if (current->IsCheckStackOverflow() && (stack_check_ == NULL)) {
+      stack_check_ = current->AsCheckStackOverflow();
+      continue;
+    }
+    return false;
+  }
+
+  const intptr_t back_index = header_->IndexOfPredecessor(body_);
+  BinarySmiOpInstr* increment =
+      induction_->InputAt(back_index)->definition()->AsBinarySmiOp();
+  if ((increment == NULL) ||
+      (increment->op_kind() != Token::kADD) ||
+      (increment->GetBlock() != body_) ||
+      (increment->left()->definition() != induction_) ||
+      !increment->right()->BindsToConstant() ||
+      (increment->right()->BoundConstant().raw() != Smi::New(1))) {
+    return false;
+  }
+  increment_ = increment;
+
+  for (intptr_t i = 0; i < header_->phis()->length(); i++) {
+    PhiInstr* phi = (*header_->phis())[i];
+    if ((phi == NULL) || (phi == induction_)) continue;
+    if (phi->representation() != kUnboxedDouble) return false;
+    BinaryDoubleOpInstr* add =
+        phi->InputAt(back_index)->definition()->AsBinaryDoubleOp();
+    if ((add == NULL) ||
+        (add->op_kind() != Token::kADD) ||
+        (add->GetBlock() != body_) ||
+        ((add->left()->definition() == phi) ==
+         (add->right()->definition() == phi))) {
+      return false;
+    }
+    reductions_.Add(phi);
+    reduction_adds_.Add(add);
+  }
+  return true;
+}
+
+
+// The body may only contain bounds checks, loads and stores of elements at
+// the induction variable, lane-wise arithmetic on them, the increment of
+// the induction variable and additions to sums.
+bool LoopVectorizer::MatchBody() {
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current->IsGoto() || (current == increment_)) continue;
+
+    if (current->IsCheckArrayBound()) {
+      CheckArrayBoundInstr* check = current->AsCheckArrayBound();
+      if ((check->index()->definition() != induction_) ||
+          IsInLoop(check->length()->definition())) {
+        return false;
+      }
+    } else if (current->IsLoadIndexed()) {
+      LoadIndexedInstr* load = current->AsLoadIndexed();
+      if (!IsVectorizableAccess(load->array(),
+                                load->index(),
+                                load->index_scale(),
+                                load->class_id())) {
+        return false;
+      }
+      scalars_.Add(load);
+      vectors_.Add(NULL);
+    } else if (current->IsStoreIndexed()) {
+      StoreIndexedInstr* store = current->AsStoreIndexed();
+      if (!IsVectorizableAccess(store->array(),
+                                store->index(),
+                                store->index_scale(),
+                                store->class_id()) ||
+          !IsVectorDefinition(store->value()->definition()) ||
+          (store->input_use_list() != NULL)) {
+        return false;
+      }
+    } else if (current->IsBinaryDoubleOp()) {
+      BinaryDoubleOpInstr* op = current->AsBinaryDoubleOp();
+      const intptr_t reduction = ReductionIndex(op);
+      if (reduction != -1) {
+        Definition* operand =
+            (op->left()->definition() == reductions_[reduction]) ?
+                op->right()->definition() : op->left()->definition();
+        if (!IsVectorDefinition(operand)) return false;
+        continue;
+      }
+      if (!IsVectorizableOpKind(op->op_kind()) ||
+          !IsVectorizableOperand(op->left()->definition()) ||
+          !IsVectorizableOperand(op->right()->definition()) ||
+          (!IsVectorDefinition(op->left()->definition()) &&
+           !IsVectorDefinition(op->right()->definition()))) {
+        return false;
+      }
+      scalars_.Add(op);
+      vectors_.Add(NULL);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+// Values computed per element must not escape the loop body except into
+// sums, and the induction variable is only used as an index.  Environment
+// uses do not matter: the vectorized loop deoptimizes to the loop entry.
+bool LoopVectorizer::MatchUses() {
+  for (Value::Iterator it(induction_->input_use_list());
+       !it.Done();
+       it.Advance()) {
+    Instruction* instr = it.Current()->instruction();
+    if (instr == branch_) continue;
+    if (instr->GetBlock() == header_) return false;
+  }
+
+  for (Value::Iterator it(increment_->input_use_list());
+       !it.Done();
+       it.Advance()) {
+    if (it.Current()->instruction() != induction_) return false;
+  }
+
+  for (intptr_t i = 0; i < scalars_.length(); i++) {
+    for (Value::Iterator it(scalars_[i]->input_use_list());
+         !it.Done();
+         it.Advance()) {
+      Instruction* instr = it.Current()->instruction();
+      if (instr->IsPhi() || (instr->GetBlock() != body_)) return false;
+    }
+  }
+
+  for (intptr_t i = 0; i < reductions_.length(); i++) {
+    for (Value::Iterator it(reduction_adds_[i]->input_use_list());
+         !it.Done();
+         it.Advance()) {
+      if (it.Current()->instruction() != reductions_[i]) return false;
+    }
+    for (Value::Iterator it(reductions_[i]->input_use_list());
+         !it.Done();
+         it.Advance()) {
+      Instruction* instr = it.Current()->instruction();
+      BlockEntryInstr* block = instr->GetBlock();
+      if ((instr != reduction_adds_[i]) &&
+          ((block == header_) || (block == body_))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+
+// Instructions of the vectorized loop deoptimize to the entry of the
+// original loop: the environment of the pre-header with the header phis
+// replaced by their counterparts in the vectorized loop.  All elements
+// before the current pair are processed when they deoptimize.
+void LoopVectorizer::AttachDeoptEnvironment(Instruction* instr) {
+  instr->InheritDeoptTarget(pre_header_->last_instruction());
+  Environment* header_env = header_->env();
+  for (intptr_t i = 0; i < header_env->Length(); i++) {
+    Definition* defn = header_env->ValueAt(i)->definition();
+    if (!defn->IsPhi() || (defn->AsPhi()->block() != header_)) continue;
+    Definition* vector = VectorFor(defn);
+    Value* value = instr->env()->ValueAt(i);
+    value->RemoveFromUseList();
+    value->set_definition(vector);
+    vector->AddEnvUse(value);
+  }
+}
+
+
+Definition* LoopVectorizer::Emit(BlockEntryInstr* block, Definition* defn) {
+  flow_graph()->InsertBefore(block->last_instruction(),
+                             defn,
+                             NULL,
+                             Definition::kValue);
+  if (defn->CanDeoptimize()) AttachDeoptEnvironment(defn);
+  return defn;
+}
+
+
+void LoopVectorizer::EmitEffect(BlockEntryInstr* block, Instruction* instr) {
+  flow_graph()->InsertBefore(block->last_instruction(),
+                             instr,
+                             NULL,
+                             Definition::kEffect);
+  if (instr->CanDeoptimize()) AttachDeoptEnvironment(instr);
+}
+
+
+Definition* LoopVectorizer::VectorOperand(Definition* defn) {
+  Definition* vector = VectorFor(defn);
+  if (vector == NULL) {
+    // Loop invariant operand.
+    vector = new Float64x2SplatInstr(new Value(defn));
+    flow_graph()->InsertBefore(pre_header_->last_instruction(),
+                               vector,
+                               NULL,
+                               Definition::kValue);
+    scalars_.Add(defn);
+    vectors_.Add(vector);
+  }
+  return vector;
+}
+
+
+static PhiInstr* AddPhi(FlowGraph* flow_graph,
+                        JoinEntryInstr* join,
+                        Representation representation,
+                        Definition* initial_value) {
+  PhiInstr* phi = new PhiInstr(join, 2);
+  phi->set_ssa_temp_index(flow_graph->alloc_ssa_temp_index());
+  phi->set_representation(representation);
+  phi->mark_alive();
+  join->InsertPhi(phi);
+  Value* input = new Value(initial_value);
+  phi->SetInputAt(0, input);
+  initial_value->AddInputUse(input);
+  return phi;
+}
+
+
+static void SetPhiInput(PhiInstr* phi, intptr_t index, Definition* defn) {
+  Value* input = new Value(defn);
+  phi->SetInputAt(index, input);
+  defn->AddInputUse(input);
+}
+
+
+// Inserts the vectorized loop between the pre-header and the header:
+//
+//   pre-header -> VH: vi = phi(i0, vnext); vs = phi(s0, vs'')
+//                     vnext = vi + 2
+//                     if (vnext <= n) VB else VE
+//                 VB: checks for vi and vi + 1
+//                     packed loads, operations and stores
+//                     vs' = vs + t[0]; vs'' = vs' + t[1]
+//                     goto VH
+//                 VE: goto header
+//
+// The original loop runs the remaining iteration starting from vi.  Sums
+// are accumulated in scalar order to get the same result.
+void LoopVectorizer::Vectorize() {
+  if (FLAG_trace_optimization) {
+    OS::Print("Vectorizing loop B%"Pd"\n", header_->block_id());
+  }
+  const intptr_t entry_index = header_->IndexOfPredecessor(pre_header_);
+  const intptr_t back_index = header_->IndexOfPredecessor(body_);
+  const intptr_t try_index = header_->try_index();
+  intptr_t block_id = flow_graph()->max_block_id();
+  JoinEntryInstr* vector_header = new JoinEntryInstr(++block_id, try_index);
+  TargetEntryInstr* vector_body = new TargetEntryInstr(++block_id, try_index);
+  TargetEntryInstr* vector_exit = new TargetEntryInstr(++block_id, try_index);
+  flow_graph()->set_max_block_id(block_id);
+
+  PhiInstr* vector_index =
+      AddPhi(flow_graph(), vector_header, kTagged,
+             induction_->InputAt(entry_index)->definition());
+  scalars_.Add(induction_);
+  vectors_.Add(vector_index);
+  for (intptr_t i = 0; i < reductions_.length(); i++) {
+    PhiInstr* sum =
+        AddPhi(flow_graph(), vector_header, kUnboxedDouble,
+               reductions_[i]->InputAt(entry_index)->definition());
+    scalars_.Add(reductions_[i]);
+    vectors_.Add(sum);
+  }
+
+  // Vectorized loop header.
+  RelationalOpInstr* compare = branch_->comparison()->AsRelationalOp();
+  ConstantInstr* two = flow_graph()->AddConstantToInitialDefinitions(
+      Smi::ZoneHandle(Smi::New(2)));
+  BinarySmiOpInstr* next_index =
+      new BinarySmiOpInstr(Token::kADD,
+                           increment_->instance_call(),
+                           new Value(vector_index),
+                           new Value(two));
+  RelationalOpInstr* vector_compare =
+      new RelationalOpInstr(compare->token_pos(),
+                            Token::kLTE,
+                            new Value(next_index),
+                            new Value(limit_));
+  vector_compare->set_ic_data(compare->ic_data());
+  vector_compare->set_operands_class_id(kSmiCid);
+  BranchInstr* vector_branch = new BranchInstr(vector_compare);
+  for (intptr_t i = vector_branch->InputCount() - 1; i >= 0; --i) {
+    Value* input = vector_branch->InputAt(i);
+    input->definition()->AddInputUse(input);
+  }
+  *vector_branch->true_successor_address() = vector_body;
+  *vector_branch->false_successor_address() = vector_exit;
+  vector_header->LinkTo(vector_branch);
+  vector_header->set_last_instruction(vector_branch);
+  if (stack_check_ != NULL) {
+    EmitEffect(vector_header,
+               new CheckStackOverflowInstr(stack_check_->token_pos(),
+                                           stack_check_->in_loop()));
+  }
+  Emit(vector_header, next_index);
+
+  // Vectorized loop body.  All checks precede the stores.
+  GotoInstr* back_edge = new GotoInstr(vector_header);
+  vector_body->LinkTo(back_edge);
+  vector_body->set_last_instruction(back_edge);
+  ConstantInstr* one = increment_->right()->definition()->AsConstant();
+  Definition* next_element =
+      Emit(vector_body, new BinarySmiOpInstr(Token::kADD,
+                                             increment_->instance_call(),
+                                             new Value(vector_index),
+                                             new Value(one)));
+  GrowableArray<Definition*> checked_lengths;
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    CheckArrayBoundInstr* check = it.Current()->AsCheckArrayBound();
+    if (check == NULL) continue;
+    Definition* length = check->length()->definition();
+    bool is_checked = false;
+    for (intptr_t i = 0; i < checked_lengths.length(); i++) {
+      if (checked_lengths[i] == length) is_checked = true;
+    }
+    if (is_checked) continue;
+    checked_lengths.Add(length);
+    EmitEffect(vector_body, new CheckArrayBoundInstr(new Value(length),
+                                                     new Value(vector_index),
+                                                     check->array_type(),
+                                                     check->deopt_id()));
+    EmitEffect(vector_body, new CheckArrayBoundInstr(new Value(length),
+                                                     new Value(next_element),
+                                                     check->array_type(),
+                                                     check->deopt_id()));
+  }
+
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current->IsLoadIndexed()) {
+      LoadIndexedInstr* load = current->AsLoadIndexed();
+      Definition* vector =
+          Emit(vector_body,
+               new LoadIndexedFloat64x2Instr(
+                   new Value(load->array()->definition()),
+                   new Value(vector_index),
+                   load->class_id()));
+      vectors_[ScalarIndex(load)] = vector;
+    } else if (current->IsStoreIndexed()) {
+      StoreIndexedInstr* store = current->AsStoreIndexed();
+      EmitEffect(vector_body,
+                 new StoreIndexedFloat64x2Instr(
+                     new Value(store->array()->definition()),
+                     new Value(vector_index),
+                     new Value(VectorFor(store->value()->definition())),
+                     store->class_id()));
+    } else if (current->IsBinaryDoubleOp()) {
+      BinaryDoubleOpInstr* op = current->AsBinaryDoubleOp();
+      const intptr_t reduction = ReductionIndex(op);
+      if (reduction == -1) {
+        Definition* left = VectorOperand(op->left()->definition());
+        Definition* right = VectorOperand(op->right()->definition());
+        Definition* vector =
+            Emit(vector_body, new BinaryFloat64x2OpInstr(op->op_kind(),
+                                                         new Value(left),
+                                                         new Value(right)));
+        vectors_[ScalarIndex(op)] = vector;
+        continue;
+      }
+      PhiInstr* phi = reductions_[reduction];
+      const bool sum_is_left = (op->left()->definition() == phi);
+      Definition* elements = VectorFor(sum_is_left ?
+          op->right()->definition() : op->left()->definition());
+      Definition* sum = VectorFor(phi);
+      for (intptr_t lane = 0; lane < 2; lane++) {
+        Definition* element =
+            Emit(vector_body,
+                 new Float64x2LaneInstr(new Value(elements), lane));
+        sum = Emit(vector_body, new BinaryDoubleOpInstr(
+            Token::kADD,
+            new Value(sum_is_left ? sum : element),
+            new Value(sum_is_left ? element : sum),
+            op->DeoptimizationTarget()));
+      }
+      SetPhiInput(VectorFor(phi)->AsPhi(), 1, sum);
+    }
+  }
+  SetPhiInput(vector_index, 1, next_index);
+
+  // Vectorized loop exit.
+  GotoInstr* exit = new GotoInstr(header_);
+  vector_exit->LinkTo(exit);
+  vector_exit->set_last_instruction(exit);
+
+  // Enter the vectorized loop from the pre-header, and the original loop
+  // from the exit of the vectorized loop.  Predecessors of joins are sorted
+  // by block id, so the exit becomes the second predecessor of the header.
+  pre_header_->last_instruction()->AsGoto()->set_successor(vector_header);
+  for (intptr_t i = 0; i < header_->phis()->length(); i++) {
+    PhiInstr* phi = (*header_->phis())[i];
+    if (phi == NULL) continue;
+    Value* entry = phi->InputAt(entry_index);
+    Value* back = phi->InputAt(back_index);
+    entry->RemoveFromUseList();
+    phi->SetInputAt(0, back);
+    SetPhiInput(phi, 1, VectorFor(phi));
+  }
+}
+
+
+void LoopVectorizer::Optimize() {
+  GrowableArray<BlockEntryInstr*> loop_headers;
+  flow_graph()->ComputeLoops(&loop_headers);
+
+  bool changed = false;
+  for (intptr_t i = 0; i < loop_headers.length(); i++) {
+    header_ = loop_headers[i]->AsJoinEntry();
+    pre_header_ = FindPreHeader(header_);
+    if ((pre_header_ == NULL) ||
+        (header_->PredecessorCount() != 2) ||
+        (header_->env() == NULL)) {
+      continue;
+    }
+    GotoInstr* entry = pre_header_->last_instruction()->AsGoto();
+    if ((entry == NULL) ||
+        (entry->env() == NULL) ||
+        (entry->env()->Length() != header_->env()->Length())) {
+      continue;
+    }
+    BlockEntryInstr* back_edge_block =
+        header_->PredecessorAt(1 - header_->IndexOfPredecessor(pre_header_));
+    body_ = back_edge_block->AsTargetEntry();
+    if ((body_ == NULL) || (body_->PredecessorAt(0) != header_)) continue;
+
+    branch_ = NULL;
+    stack_check_ = NULL;
+    induction_ = NULL;
+    increment_ = NULL;
+    limit_ = NULL;
+    reductions_.Clear();
+    reduction_adds_.Clear();
+    scalars_.Clear();
+    vectors_.Clear();
+    if (MatchHeader() && MatchBody() && MatchUses() && !scalars_.is_empty()) {
+      Vectorize();
+      changed = true;
+    }
+  }
+
+  if (changed) {
+    flow_graph()->DiscoverBlocks();
+    GrowableArray<BitVector*> dominance_frontier;
+    flow_graph()->ComputeDominators(&dominance_frontier);
+  }
+}
+
+
 static bool IsLoadEliminationCandidate(Definition* def) {
   // Immutable loads (not affected by side effects) are handled
   // in the DominatorBasedCSE pass.
@@ -4411,6 +5324,41 @@ void ConstantPropagator::VisitConstant(ConstantInstr* instr) {
 }
 
 
+void ConstantPropagator::VisitMaterializeObject(MaterializeObjectInstr* instr) {
+  // Materializations are not part of the flow graph, they are created by
+  // allocation sinking after constant propagation.
+  UNREACHABLE();
+}
+
+
+void ConstantPropagator::VisitLoadIndexedFloat64x2(
+    LoadIndexedFloat64x2Instr* instr) {
+  SetValue(instr, non_constant_);
+}
+
+
+void ConstantPropagator::VisitStoreIndexedFloat64x2(
+    StoreIndexedFloat64x2Instr* instr) {
+  SetValue(instr, instr->value()->definition()->constant_value());
+}
+
+
+void ConstantPropagator::VisitBinaryFloat64x2Op(
+    BinaryFloat64x2OpInstr* instr) {
+  SetValue(instr, non_constant_);
+}
+
+
+void ConstantPropagator::VisitFloat64x2Splat(Float64x2SplatInstr* instr) {
+  SetValue(instr, non_constant_);
+}
+
+
+void ConstantPropagator::VisitFloat64x2Lane(Float64x2LaneInstr* instr) {
+  SetValue(instr, non_constant_);
+}
+
+
 void ConstantPropagator::VisitConstraint(ConstraintInstr* instr) {
   // Should not be used outside of range analysis.
   UNREACHABLE();
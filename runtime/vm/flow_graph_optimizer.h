@@ -194,6 +194,122 @@ class LICM : public ValueObject {
 };
 
 
+// Removes the bounds checks of fixed length arrays indexed by the induction
+// variable of a loop 'for (i = start; i < n; ...)' when the start is known
+// to be non-negative and n and the array length are loop invariant.  They
+// are replaced with a single check n <= length in the loop pre-header that
+// deoptimizes if the loop could access an element outside of the array.
+class BoundsCheckHoisting : public ValueObject {
+ public:
+  explicit BoundsCheckHoisting(FlowGraph* flow_graph);
+
+  void Optimize();
+
+ private:
+  FlowGraph* flow_graph() const { return flow_graph_; }
+
+  void HoistChecks(BlockEntryInstr* header, BlockEntryInstr* pre_header);
+
+  FlowGraph* const flow_graph_;
+};
+
+
+// Removes allocations of objects that do not escape: the object is only
+// used as the instance of field loads and stores and by deoptimization
+// environments.  Loads are replaced with the stored values and the
+// environments describe how to materialize the object on deoptimization.
+class AllocationSinking : public ValueObject {
+ public:
+  explicit AllocationSinking(FlowGraph* flow_graph);
+
+  void Optimize();
+
+ private:
+  FlowGraph* flow_graph() const { return flow_graph_; }
+
+  bool IsSinkable(AllocateObjectInstr* alloc);
+
+  void Sink(AllocateObjectInstr* alloc);
+
+  Definition* LoadedValue(intptr_t offset_in_bytes) const;
+
+  void ReplaceLoad(LoadFieldInstr* load);
+
+  void CreateMaterializationAt(Instruction* exit, AllocateObjectInstr* alloc);
+
+  void RemoveUnusedBoxes();
+
+  FlowGraph* const flow_graph_;
+
+  // Fields of the allocation being sunk that were stored to so far, and
+  // their values.
+  GrowableArray<const Field*> fields_;
+  GrowableArray<Definition*> values_;
+
+  // Boxes whose value was stored into sunk allocations.
+  GrowableArray<Definition*> boxes_;
+};
+
+
+// Vectorizes counted loops of the form
+//
+//   for (var i = start; i < n; i++) { y[i] = x[i] * a + y[i]; s += x[i]; }
+//
+// over Float32 and Float64 typed data arrays.  A loop that handles two
+// elements per iteration with packed double operations is inserted in
+// front of the original loop, which then runs the remaining iteration.
+class LoopVectorizer : public ValueObject {
+ public:
+  explicit LoopVectorizer(FlowGraph* flow_graph);
+
+  void Optimize();
+
+ private:
+  FlowGraph* flow_graph() const { return flow_graph_; }
+
+  bool IsInLoop(Definition* defn) const;
+  intptr_t ScalarIndex(Definition* defn) const;
+  intptr_t ReductionIndex(Definition* defn) const;
+  Definition* VectorFor(Definition* scalar) const;
+  bool IsVectorDefinition(Definition* defn) const;
+  bool IsVectorizableOperand(Definition* defn) const;
+  bool IsVectorizableAccess(Value* array,
+                            Value* index,
+                            intptr_t index_scale,
+                            intptr_t class_id) const;
+
+  bool MatchHeader();
+  bool MatchBody();
+  bool MatchUses();
+
+  void AttachDeoptEnvironment(Instruction* instr);
+  Definition* Emit(BlockEntryInstr* block, Definition* defn);
+  void EmitEffect(BlockEntryInstr* block, Instruction* instr);
+  Definition* VectorOperand(Definition* defn);
+
+  void Vectorize();
+
+  FlowGraph* const flow_graph_;
+
+  // The loop being vectorized.
+  JoinEntryInstr* header_;
+  BlockEntryInstr* pre_header_;
+  TargetEntryInstr* body_;
+  BranchInstr* branch_;
+  CheckStackOverflowInstr* stack_check_;
+  PhiInstr* induction_;
+  BinarySmiOpInstr* increment_;
+  Definition* limit_;
+  GrowableArray<PhiInstr*> reductions_;
+  GrowableArray<BinaryDoubleOpInstr*> reduction_adds_;
+
+  // Scalar definitions of the loop body and their vector counterparts in
+  // the vectorized loop (phis of the vectorized loop for header phis).
+  GrowableArray<Definition*> scalars_;
+  GrowableArray<Definition*> vectors_;
+};
+
+
 // A simple common subexpression elimination based
 // on the dominator tree.
 class DominatorBasedCSE : public AllStatic {
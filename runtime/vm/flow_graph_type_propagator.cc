@@ -659,6 +659,11 @@ CompileType ParameterInstr::ComputeType() const {
   // However there are parameters that are known to match their declared type:
   // for example receiver and construction phase.
   const Function& function = block_->parsed_function().function();
+  // Locals entering a graph compiled for OSR can have any value.
+  if (index() >= function.NumParameters()) {
+    ASSERT(block_->IsCompiledForOsr());
+    return CompileType::Dynamic();
+  }
   LocalScope* scope = block_->parsed_function().node_sequence()->scope();
   const AbstractType& type = scope->VariableAt(index())->type();
 
@@ -967,6 +972,27 @@ CompileType BinaryFloat32x4OpInstr::ComputeType() const {
 }
 
 
+CompileType LoadIndexedFloat64x2Instr::ComputeType() const {
+  // Pairs of doubles only exist unboxed.
+  return CompileType::Dynamic();
+}
+
+
+CompileType BinaryFloat64x2OpInstr::ComputeType() const {
+  return CompileType::Dynamic();
+}
+
+
+CompileType Float64x2SplatInstr::ComputeType() const {
+  return CompileType::Dynamic();
+}
+
+
+CompileType Float64x2LaneInstr::ComputeType() const {
+  return CompileType::FromCid(kDoubleCid);
+}
+
+
 CompileType MathSqrtInstr::ComputeType() const {
   return CompileType::FromCid(kDoubleCid);
 }
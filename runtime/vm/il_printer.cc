@@ -484,6 +484,16 @@ void AllocateObjectInstr::PrintOperandsTo(BufferFormatter* f) const {
 }
 
 
+void MaterializeObjectInstr::PrintOperandsTo(BufferFormatter* f) const {
+  f->Print("%s", String::Handle(cls_.Name()).ToCString());
+  for (intptr_t i = 0; i < InputCount(); i++) {
+    f->Print(", ");
+    f->Print("%s: ", String::Handle(fields_[i]->name()).ToCString());
+    InputAt(i)->PrintTo(f);
+  }
+}
+
+
 void AllocateObjectWithBoundsCheckInstr::PrintOperandsTo(
     BufferFormatter* f) const {
   f->Print("%s", Class::Handle(constructor().Owner()).ToCString());
@@ -603,6 +613,20 @@ void BinaryFloat32x4OpInstr::PrintOperandsTo(BufferFormatter* f) const {
 }
 
 
+void BinaryFloat64x2OpInstr::PrintOperandsTo(BufferFormatter* f) const {
+  f->Print("%s, ", Token::Str(op_kind()));
+  left()->PrintTo(f);
+  f->Print(", ");
+  right()->PrintTo(f);
+}
+
+
+void Float64x2LaneInstr::PrintOperandsTo(BufferFormatter* f) const {
+  value()->PrintTo(f);
+  f->Print(", %"Pd"", lane());
+}
+
+
 void BinaryMintOpInstr::PrintOperandsTo(BufferFormatter* f) const {
   f->Print("%s, ", Token::Str(op_kind()));
   left()->PrintTo(f);
@@ -777,6 +801,8 @@ void Environment::PrintTo(BufferFormatter* f) const {
     if (i > 0) f->Print(", ");
     if (values_[i]->definition()->IsPushArgument()) {
       f->Print("a%d", arg_count++);
+    } else if (values_[i]->definition()->IsMaterializeObject()) {
+      values_[i]->definition()->PrintTo(f);
     } else {
       values_[i]->PrintTo(f);
     }
@@ -35,42 +35,42 @@ class Range;
 // (class-name, function-name, recognized enum, fingerprint).
 // See intrinsifier for fingerprint computation.
 #define RECOGNIZED_LIST(V)                                                     \
-  V(_ObjectArray, get:length, ObjectArrayLength, 405297088)                    \
-  V(_ImmutableArray, get:length, ImmutableArrayLength, 433698233)              \
-  V(_TypedList, get:length, TypedDataLength, 231908172)                        \
-  V(_TypedList, _getInt8, ByteArrayBaseGetInt8, 380843687)                     \
-  V(_TypedList, _getUint8, ByteArrayBaseGetUint8, 380843687)                   \
-  V(_TypedList, _getInt16, ByteArrayBaseGetInt16, 380843687)                   \
-  V(_TypedList, _getUint16, ByteArrayBaseGetUint16, 380843687)                 \
-  V(_TypedList, _getInt32, ByteArrayBaseGetInt32, 380843687)                   \
-  V(_TypedList, _getUint32, ByteArrayBaseGetUint32, 380843687)                 \
-  V(_TypedList, _getFloat32, ByteArrayBaseGetFloat32, 979971573)               \
-  V(_TypedList, _getFloat64, ByteArrayBaseGetFloat64, 979971573)               \
-  V(_TypedList, _getFloat32x4, ByteArrayBaseGetFloat32x4, 690339584)           \
-  V(_TypedList, _setInt8, ByteArrayBaseSetInt8, 287047804)                     \
-  V(_TypedList, _setUint8, ByteArrayBaseSetUint8, 287047804)                   \
-  V(_TypedList, _setInt16, ByteArrayBaseSetInt16, 287047804)                   \
-  V(_TypedList, _setUint16, ByteArrayBaseSetUint16, 287047804)                 \
-  V(_TypedList, _setInt32, ByteArrayBaseSetInt32, 287047804)                   \
-  V(_TypedList, _setUint32, ByteArrayBaseSetUint32, 287047804)                 \
-  V(_TypedList, _setFloat32, ByteArrayBaseSetFloat32, 1032541114)              \
-  V(_TypedList, _setFloat64, ByteArrayBaseSetFloat64, 1032541114)              \
-  V(_TypedList, _setFloat32x4, ByteArrayBaseSetFloat32x4, 1016704782)          \
-  V(_GrowableObjectArray, get:length, GrowableArrayLength, 725548050)          \
-  V(_GrowableObjectArray, get:_capacity, GrowableArrayCapacity, 725548050)     \
-  V(_StringBase, get:length, StringBaseLength, 320803993)                      \
-  V(_StringBase, get:isEmpty, StringBaseIsEmpty, 1026765313)                   \
-  V(_StringBase, codeUnitAt, StringBaseCodeUnitAt, 984449525)                  \
-  V(_StringBase, [], StringBaseCharAt, 1062366987)                             \
-  V(_IntegerImplementation, toDouble, IntegerToDouble, 1267108971)             \
-  V(_Double, toInt, DoubleToInteger, 362666636)                                \
-  V(_Double, truncateToDouble, DoubleTruncate, 620870996)                      \
-  V(_Double, roundToDouble, DoubleRound, 620870996)                            \
-  V(_Double, floorToDouble, DoubleFloor, 620870996)                            \
-  V(_Double, ceilToDouble, DoubleCeil, 620870996)                              \
-  V(_Double, pow, DoublePow, 631903778)                                        \
-  V(_Double, _modulo, DoubleMod, 437099337)                                    \
-  V(::, sqrt, MathSqrt, 1662640002)                                            \
+  V(_ObjectArray, get:length, ObjectArrayLength, 356902443)                    \
+  V(_ImmutableArray, get:length, ImmutableArrayLength, 877585703)              \
+  V(_TypedList, get:length, TypedDataLength, 615410225)                        \
+  V(_TypedList, _getInt8, ByteArrayBaseGetInt8, 619979970)                     \
+  V(_TypedList, _getUint8, ByteArrayBaseGetUint8, 619979970)                   \
+  V(_TypedList, _getInt16, ByteArrayBaseGetInt16, 619979970)                   \
+  V(_TypedList, _getUint16, ByteArrayBaseGetUint16, 619979970)                 \
+  V(_TypedList, _getInt32, ByteArrayBaseGetInt32, 619979970)                   \
+  V(_TypedList, _getUint32, ByteArrayBaseGetUint32, 619979970)                 \
+  V(_TypedList, _getFloat32, ByteArrayBaseGetFloat32, 189397206)               \
+  V(_TypedList, _getFloat64, ByteArrayBaseGetFloat64, 189397206)               \
+  V(_TypedList, _getFloat32x4, ByteArrayBaseGetFloat32x4, 237507269)           \
+  V(_TypedList, _setInt8, ByteArrayBaseSetInt8, 949427055)                     \
+  V(_TypedList, _setUint8, ByteArrayBaseSetUint8, 949427055)                   \
+  V(_TypedList, _setInt16, ByteArrayBaseSetInt16, 949427055)                   \
+  V(_TypedList, _setUint16, ByteArrayBaseSetUint16, 949427055)                 \
+  V(_TypedList, _setInt32, ByteArrayBaseSetInt32, 949427055)                   \
+  V(_TypedList, _setUint32, ByteArrayBaseSetUint32, 949427055)                 \
+  V(_TypedList, _setFloat32, ByteArrayBaseSetFloat32, 239145111)               \
+  V(_TypedList, _setFloat64, ByteArrayBaseSetFloat64, 239145111)               \
+  V(_TypedList, _setFloat32x4, ByteArrayBaseSetFloat32x4, 562890726)           \
+  V(_GrowableObjectArray, get:length, GrowableArrayLength, 532961654)          \
+  V(_GrowableObjectArray, get:_capacity, GrowableArrayCapacity, 532961654)     \
+  V(_StringBase, get:length, StringBaseLength, 635233542)                      \
+  V(_StringBase, get:isEmpty, StringBaseIsEmpty, 473550990)                    \
+  V(_StringBase, codeUnitAt, StringBaseCodeUnitAt, 340266880)                  \
+  V(_StringBase, [], StringBaseCharAt, 196023887)                              \
+  V(_IntegerImplementation, toDouble, IntegerToDouble, 348482151)              \
+  V(_Double, toInt, DoubleToInteger, 854063054)                                \
+  V(_Double, truncateToDouble, DoubleTruncate, 713591793)                      \
+  V(_Double, roundToDouble, DoubleRound, 713591793)                            \
+  V(_Double, floorToDouble, DoubleFloor, 713591793)                            \
+  V(_Double, ceilToDouble, DoubleCeil, 713591793)                              \
+  V(_Double, pow, DoublePow, 1370462735)                                       \
+  V(_Double, _modulo, DoubleMod, 139611740)                                    \
+  V(::, sqrt, MathSqrt, 878372794)                                             \
 
 // Class that recognizes the name and owner of a function and returns the
 // corresponding enum. See RECOGNIZED_LIST above for list of recognizable
@@ -505,6 +505,12 @@ class EmbeddedArray<T, 0> {
   M(GuardField)                                                                \
   M(IfThenElse)                                                                \
   M(BinaryFloat32x4Op)                                                         \
+  M(MaterializeObject)                                                         \
+  M(LoadIndexedFloat64x2)                                                      \
+  M(StoreIndexedFloat64x2)                                                     \
+  M(BinaryFloat64x2Op)                                                         \
+  M(Float64x2Splat)                                                            \
+  M(Float64x2Lane)                                                             \
 
 #define FORWARD_DECLARATION(type) class type##Instr;
 FOR_EACH_INSTRUCTION(FORWARD_DECLARATION)
@@ -767,6 +773,7 @@ FOR_EACH_INSTRUCTION(INSTRUCTION_TYPE_CHECK)
   friend class CheckArrayBoundInstr;
   friend class CheckEitherNonSmiInstr;
   friend class LICM;
+  friend class BoundsCheckHoisting;
   friend class DoubleToSmiInstr;
   friend class DoubleToDoubleInstr;
   friend class InvokeMathCFunctionInstr;
@@ -1120,7 +1127,8 @@ class BackwardInstructionIterator : public ValueObject {
 class GraphEntryInstr : public BlockEntryInstr {
  public:
   GraphEntryInstr(const ParsedFunction& parsed_function,
-                  TargetEntryInstr* normal_entry);
+                  TargetEntryInstr* normal_entry,
+                  intptr_t osr_id);
 
   DECLARE_INSTRUCTION(GraphEntry)
 
@@ -1153,6 +1161,11 @@ class GraphEntryInstr : public BlockEntryInstr {
     return parsed_function_;
   }
 
+  // The deopt id of the stack overflow check at which the graph is entered
+  // from a frame of unoptimized code, or Isolate::kNoDeoptId.
+  intptr_t osr_id() const { return osr_id_; }
+  bool IsCompiledForOsr() const { return osr_id_ != Isolate::kNoDeoptId; }
+
   virtual void PrintTo(BufferFormatter* f) const;
 
  private:
@@ -1163,6 +1176,7 @@ class GraphEntryInstr : public BlockEntryInstr {
   TargetEntryInstr* normal_entry_;
   GrowableArray<CatchBlockEntryInstr*> catch_entries_;
   GrowableArray<Definition*> initial_definitions_;
+  const intptr_t osr_id_;
   intptr_t spill_slot_count_;
 
   DISALLOW_COPY_AND_ASSIGN(GraphEntryInstr);
@@ -3325,6 +3339,7 @@ class AllocateObjectInstr : public TemplateDefinition<0> {
 
   const Function& constructor() const { return ast_node_.constructor(); }
   intptr_t token_pos() const { return ast_node_.token_pos(); }
+  intptr_t cid() const { return cid_; }
 
   virtual void PrintOperandsTo(BufferFormatter* f) const;
 
@@ -3369,6 +3384,62 @@ class AllocateObjectWithBoundsCheckInstr : public TemplateDefinition<2> {
 };
 
 
+// Describes an object whose allocation was removed by allocation sinking.
+// It is not part of the flow graph and only occurs in the deoptimization
+// environments of the instructions the object was live at: on
+// deoptimization the object is allocated and its fields are initialized
+// with the inputs.  The inputs are not recorded in use lists.
+class MaterializeObjectInstr : public Definition {
+ public:
+  MaterializeObjectInstr(const Class& cls,
+                         const ZoneGrowableArray<const Field*>& fields,
+                         ZoneGrowableArray<Value*>* values)
+      : cls_(cls), fields_(fields), values_(values), locations_(NULL) {
+    ASSERT(fields_.length() == values_->length());
+    for (intptr_t i = 0; i < InputCount(); i++) {
+      SetInputAt(i, (*values)[i]);
+    }
+  }
+
+  DECLARE_INSTRUCTION(MaterializeObject)
+
+  const Class& cls() const { return cls_; }
+  const Field& FieldAt(intptr_t i) const { return *fields_[i]; }
+
+  virtual intptr_t InputCount() const { return values_->length(); }
+  virtual Value* InputAt(intptr_t i) const { return (*values_)[i]; }
+
+  virtual intptr_t ArgumentCount() const { return 0; }
+
+  virtual bool CanDeoptimize() const { return false; }
+
+  virtual bool HasSideEffect() const { return false; }
+
+  // Locations of the inputs, assigned by the register allocator.
+  Location* locations() const { return locations_; }
+  void set_locations(Location* locations) { locations_ = locations; }
+
+  Location LocationAt(intptr_t i) const {
+    ASSERT(locations_ != NULL);
+    return locations_[i];
+  }
+
+  virtual void PrintOperandsTo(BufferFormatter* f) const;
+
+ private:
+  virtual void RawSetInputAt(intptr_t i, Value* value) {
+    (*values_)[i] = value;
+  }
+
+  const Class& cls_;
+  const ZoneGrowableArray<const Field*>& fields_;
+  ZoneGrowableArray<Value*>* values_;
+  Location* locations_;
+
+  DISALLOW_COPY_AND_ASSIGN(MaterializeObjectInstr);
+};
+
+
 class CreateArrayInstr : public TemplateDefinition<1> {
  public:
   CreateArrayInstr(intptr_t token_pos,
@@ -4034,11 +4105,11 @@ class BinaryDoubleOpInstr : public TemplateDefinition<2> {
   BinaryDoubleOpInstr(Token::Kind op_kind,
                       Value* left,
                       Value* right,
-                      InstanceCallInstr* instance_call)
+                      intptr_t deopt_id)
       : op_kind_(op_kind) {
     SetInputAt(0, left);
     SetInputAt(1, right);
-    deopt_id_ = instance_call->deopt_id();
+    deopt_id_ = deopt_id;
   }
 
   Value* left() const { return inputs_[0]; }
@@ -4139,6 +4210,216 @@ class BinaryFloat32x4OpInstr : public TemplateDefinition<2> {
 };
 
 
+// Loads the two consecutive elements of a Float32 or Float64 typed data
+// array starting at 'index' as a pair of doubles.  Float32 elements are
+// converted to double precision.
+class LoadIndexedFloat64x2Instr : public TemplateDefinition<2> {
+ public:
+  LoadIndexedFloat64x2Instr(Value* array, Value* index, intptr_t class_id)
+      : class_id_(class_id) {
+    ASSERT((class_id == kTypedDataFloat32ArrayCid) ||
+           (class_id == kTypedDataFloat64ArrayCid));
+    SetInputAt(0, array);
+    SetInputAt(1, index);
+  }
+
+  Value* array() const { return inputs_[0]; }
+  Value* index() const { return inputs_[1]; }
+  intptr_t class_id() const { return class_id_; }
+
+  virtual bool CanDeoptimize() const { return false; }
+
+  virtual bool HasSideEffect() const { return false; }
+
+  virtual bool AffectedBySideEffect() const { return true; }
+
+  virtual bool AttributesEqual(Instruction* other) const {
+    return class_id() == other->AsLoadIndexedFloat64x2()->class_id();
+  }
+
+  virtual Representation representation() const {
+    return kUnboxedFloat64x2;
+  }
+
+  virtual Representation RequiredInputRepresentation(intptr_t idx) const {
+    ASSERT((idx == 0) || (idx == 1));
+    return kTagged;
+  }
+
+  DECLARE_INSTRUCTION(LoadIndexedFloat64x2)
+  virtual CompileType ComputeType() const;
+
+ private:
+  const intptr_t class_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoadIndexedFloat64x2Instr);
+};
+
+
+// Stores a pair of doubles into the two consecutive elements of a Float32
+// or Float64 typed data array starting at 'index'.
+class StoreIndexedFloat64x2Instr : public TemplateDefinition<3> {
+ public:
+  StoreIndexedFloat64x2Instr(Value* array,
+                             Value* index,
+                             Value* value,
+                             intptr_t class_id)
+      : class_id_(class_id) {
+    ASSERT((class_id == kTypedDataFloat32ArrayCid) ||
+           (class_id == kTypedDataFloat64ArrayCid));
+    SetInputAt(0, array);
+    SetInputAt(1, index);
+    SetInputAt(2, value);
+  }
+
+  Value* array() const { return inputs_[0]; }
+  Value* index() const { return inputs_[1]; }
+  Value* value() const { return inputs_[2]; }
+  intptr_t class_id() const { return class_id_; }
+
+  virtual bool CanDeoptimize() const { return false; }
+
+  virtual bool HasSideEffect() const { return true; }
+
+  virtual Representation RequiredInputRepresentation(intptr_t idx) const {
+    ASSERT((idx >= 0) && (idx <= 2));
+    return (idx == 2) ? kUnboxedFloat64x2 : kTagged;
+  }
+
+  DECLARE_INSTRUCTION(StoreIndexedFloat64x2)
+
+ private:
+  const intptr_t class_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(StoreIndexedFloat64x2Instr);
+};
+
+
+// Lane-wise arithmetic on pairs of doubles.  The operations round each lane
+// exactly as the corresponding scalar double operation does.
+class BinaryFloat64x2OpInstr : public TemplateDefinition<2> {
+ public:
+  BinaryFloat64x2OpInstr(Token::Kind op_kind, Value* left, Value* right)
+      : op_kind_(op_kind) {
+    SetInputAt(0, left);
+    SetInputAt(1, right);
+  }
+
+  Value* left() const { return inputs_[0]; }
+  Value* right() const { return inputs_[1]; }
+
+  Token::Kind op_kind() const { return op_kind_; }
+
+  // Returns true if pairs of doubles are supported on the current platform.
+  static bool IsSupported();
+
+  virtual void PrintOperandsTo(BufferFormatter* f) const;
+
+  virtual bool CanDeoptimize() const { return false; }
+
+  virtual bool HasSideEffect() const { return false; }
+
+  virtual bool AffectedBySideEffect() const { return false; }
+
+  virtual bool AttributesEqual(Instruction* other) const {
+    return op_kind() == other->AsBinaryFloat64x2Op()->op_kind();
+  }
+
+  virtual Representation representation() const {
+    return kUnboxedFloat64x2;
+  }
+
+  virtual Representation RequiredInputRepresentation(intptr_t idx) const {
+    ASSERT((idx == 0) || (idx == 1));
+    return kUnboxedFloat64x2;
+  }
+
+  DECLARE_INSTRUCTION(BinaryFloat64x2Op)
+  virtual CompileType ComputeType() const;
+
+ private:
+  const Token::Kind op_kind_;
+
+  DISALLOW_COPY_AND_ASSIGN(BinaryFloat64x2OpInstr);
+};
+
+
+// Creates a pair of doubles with both lanes set to the given double.
+class Float64x2SplatInstr : public TemplateDefinition<1> {
+ public:
+  explicit Float64x2SplatInstr(Value* value) {
+    SetInputAt(0, value);
+  }
+
+  Value* value() const { return inputs_[0]; }
+
+  virtual bool CanDeoptimize() const { return false; }
+
+  virtual bool HasSideEffect() const { return false; }
+
+  virtual bool AffectedBySideEffect() const { return false; }
+
+  virtual bool AttributesEqual(Instruction* other) const { return true; }
+
+  virtual Representation representation() const {
+    return kUnboxedFloat64x2;
+  }
+
+  virtual Representation RequiredInputRepresentation(intptr_t idx) const {
+    ASSERT(idx == 0);
+    return kUnboxedDouble;
+  }
+
+  DECLARE_INSTRUCTION(Float64x2Splat)
+  virtual CompileType ComputeType() const;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(Float64x2SplatInstr);
+};
+
+
+// Extracts one lane of a pair of doubles.
+class Float64x2LaneInstr : public TemplateDefinition<1> {
+ public:
+  Float64x2LaneInstr(Value* value, intptr_t lane) : lane_(lane) {
+    ASSERT((lane == 0) || (lane == 1));
+    SetInputAt(0, value);
+  }
+
+  Value* value() const { return inputs_[0]; }
+  intptr_t lane() const { return lane_; }
+
+  virtual void PrintOperandsTo(BufferFormatter* f) const;
+
+  virtual bool CanDeoptimize() const { return false; }
+
+  virtual bool HasSideEffect() const { return false; }
+
+  virtual bool AffectedBySideEffect() const { return false; }
+
+  virtual bool AttributesEqual(Instruction* other) const {
+    return lane() == other->AsFloat64x2Lane()->lane();
+  }
+
+  virtual Representation representation() const {
+    return kUnboxedDouble;
+  }
+
+  virtual Representation RequiredInputRepresentation(intptr_t idx) const {
+    ASSERT(idx == 0);
+    return kUnboxedFloat64x2;
+  }
+
+  DECLARE_INSTRUCTION(Float64x2Lane)
+  virtual CompileType ComputeType() const;
+
+ private:
+  const intptr_t lane_;
+
+  DISALLOW_COPY_AND_ASSIGN(Float64x2LaneInstr);
+};
+
+
 class BinaryMintOpInstr : public TemplateDefinition<2> {
  public:
   BinaryMintOpInstr(Token::Kind op_kind,
@@ -4411,11 +4692,15 @@ class UnarySmiOpInstr : public TemplateDefinition<1> {
 
 class CheckStackOverflowInstr : public TemplateInstruction<0> {
  public:
-  explicit CheckStackOverflowInstr(intptr_t token_pos)
-      : token_pos_(token_pos) {}
+  CheckStackOverflowInstr(intptr_t token_pos, bool in_loop)
+      : token_pos_(token_pos), in_loop_(in_loop) {}
 
   intptr_t token_pos() const { return token_pos_; }
 
+  // Loop checks count iterations in unoptimized code to trigger on-stack
+  // replacement.
+  bool in_loop() const { return in_loop_; }
+
   DECLARE_INSTRUCTION(CheckStackOverflow)
 
   virtual intptr_t ArgumentCount() const { return 0; }
@@ -4426,6 +4711,7 @@ class CheckStackOverflowInstr : public TemplateInstruction<0> {
 
  private:
   const intptr_t token_pos_;
+  const bool in_loop_;
 
   DISALLOW_COPY_AND_ASSIGN(CheckStackOverflowInstr);
 };
@@ -4685,11 +4971,11 @@ class CheckArrayBoundInstr : public TemplateInstruction<2> {
   CheckArrayBoundInstr(Value* length,
                        Value* index,
                        intptr_t array_type,
-                       InstanceCallInstr* instance_call)
+                       intptr_t deopt_id)
       : array_type_(array_type) {
     SetInputAt(0, length);
     SetInputAt(1, index);
-    deopt_id_ = instance_call->deopt_id();
+    deopt_id_ = deopt_id;
   }
 
   DECLARE_INSTRUCTION(CheckArrayBound)
@@ -2115,6 +2115,12 @@ class CheckStackOverflowSlowPath : public SlowPathCode {
                                   instruction_->deopt_id(),
                                   kStackOverflowRuntimeEntry,
                                   instruction_->locs());
+    if (instruction_->in_loop() && compiler->CanOSRFunction()) {
+      // The runtime call returns here into the OSR code of the loop.
+      compiler->AddCurrentDescriptor(PcDescriptors::kOsrEntry,
+                                     instruction_->deopt_id(),
+                                     instruction_->token_pos());
+    }
     compiler->pending_deoptimization_env_ = NULL;
     compiler->RestoreLiveRegisters(instruction_->locs());
     __ jmp(exit_label());
@@ -2134,6 +2140,15 @@ void CheckStackOverflowInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ movq(temp, Immediate(Isolate::Current()->stack_limit_address()));
   __ cmpq(RSP, Address(temp, 0));
   __ j(BELOW_EQUAL, slow_path->entry_label());
+  if (in_loop() && compiler->CanOSRFunction()) {
+    // Count loop iterations in the usage counter. The slow path replaces
+    // the frame with optimized code once the function is hot.
+    __ LoadObject(temp, compiler->parsed_function().function());
+    __ incq(FieldAddress(temp, Function::usage_counter_offset()));
+    __ cmpq(FieldAddress(temp, Function::usage_counter_offset()),
+            Immediate(FLAG_optimization_counter_threshold));
+    __ j(GREATER_EQUAL, slow_path->entry_label());
+  }
   __ Bind(slow_path->exit_label());
 }
 
@@ -2860,6 +2875,142 @@ void BinaryFloat32x4OpInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 }
 
 
+bool BinaryFloat64x2OpInstr::IsSupported() {
+  return true;
+}
+
+
+LocationSummary* LoadIndexedFloat64x2Instr::MakeLocationSummary() const {
+  const intptr_t kNumInputs = 2;
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary =
+      new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kNoCall);
+  summary->set_in(0, Location::RequiresRegister());
+  summary->set_in(1, Location::RequiresRegister());
+  summary->set_out(Location::RequiresFpuRegister());
+  return summary;
+}
+
+
+void LoadIndexedFloat64x2Instr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  Register array = locs()->in(0).reg();
+  Register index = locs()->in(1).reg();
+  XmmRegister result = locs()->out().fpu_reg();
+  const intptr_t index_scale = FlowGraphCompiler::ElementSizeFor(class_id());
+  const Address element_address = FlowGraphCompiler::ElementAddressForRegIndex(
+      class_id(), index_scale, array, index);
+  if (class_id() == kTypedDataFloat32ArrayCid) {
+    // Load two single precision floats and promote them to doubles.
+    __ movsd(result, element_address);
+    __ cvtps2pd(result, result);
+  } else {
+    ASSERT(class_id() == kTypedDataFloat64ArrayCid);
+    __ movups(result, element_address);
+  }
+}
+
+
+LocationSummary* StoreIndexedFloat64x2Instr::MakeLocationSummary() const {
+  const intptr_t kNumInputs = 3;
+  const intptr_t kNumTemps = 1;
+  LocationSummary* summary =
+      new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kNoCall);
+  summary->set_in(0, Location::RequiresRegister());
+  summary->set_in(1, Location::RequiresRegister());
+  summary->set_in(2, Location::RequiresFpuRegister());
+  // Temp for the conversion to single precision.
+  summary->set_temp(0, Location::RequiresFpuRegister());
+  return summary;
+}
+
+
+void StoreIndexedFloat64x2Instr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  Register array = locs()->in(0).reg();
+  Register index = locs()->in(1).reg();
+  XmmRegister value = locs()->in(2).fpu_reg();
+  const intptr_t index_scale = FlowGraphCompiler::ElementSizeFor(class_id());
+  const Address element_address = FlowGraphCompiler::ElementAddressForRegIndex(
+      class_id(), index_scale, array, index);
+  if (class_id() == kTypedDataFloat32ArrayCid) {
+    // Convert both lanes to single precision and store them.
+    XmmRegister temp = locs()->temp(0).fpu_reg();
+    __ cvtpd2ps(temp, value);
+    __ movsd(element_address, temp);
+  } else {
+    ASSERT(class_id() == kTypedDataFloat64ArrayCid);
+    __ movups(element_address, value);
+  }
+}
+
+
+LocationSummary* BinaryFloat64x2OpInstr::MakeLocationSummary() const {
+  const intptr_t kNumInputs = 2;
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary =
+      new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kNoCall);
+  summary->set_in(0, Location::RequiresFpuRegister());
+  summary->set_in(1, Location::RequiresFpuRegister());
+  summary->set_out(Location::SameAsFirstInput());
+  return summary;
+}
+
+
+void BinaryFloat64x2OpInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  XmmRegister left = locs()->in(0).fpu_reg();
+  XmmRegister right = locs()->in(1).fpu_reg();
+
+  ASSERT(locs()->out().fpu_reg() == left);
+
+  switch (op_kind()) {
+    case Token::kADD: __ addpd(left, right); break;
+    case Token::kSUB: __ subpd(left, right); break;
+    case Token::kMUL: __ mulpd(left, right); break;
+    case Token::kDIV: __ divpd(left, right); break;
+    default: UNREACHABLE();
+  }
+}
+
+
+LocationSummary* Float64x2SplatInstr::MakeLocationSummary() const {
+  const intptr_t kNumInputs = 1;
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary =
+      new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kNoCall);
+  summary->set_in(0, Location::RequiresFpuRegister());
+  summary->set_out(Location::SameAsFirstInput());
+  return summary;
+}
+
+
+void Float64x2SplatInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  XmmRegister value = locs()->in(0).fpu_reg();
+  ASSERT(locs()->out().fpu_reg() == value);
+  // Copy the low lane into the high lane.
+  __ unpcklpd(value, value);
+}
+
+
+LocationSummary* Float64x2LaneInstr::MakeLocationSummary() const {
+  const intptr_t kNumInputs = 1;
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary =
+      new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kNoCall);
+  summary->set_in(0, Location::RequiresFpuRegister());
+  summary->set_out(Location::SameAsFirstInput());
+  return summary;
+}
+
+
+void Float64x2LaneInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  XmmRegister value = locs()->in(0).fpu_reg();
+  ASSERT(locs()->out().fpu_reg() == value);
+  if (lane() == 1) {
+    // Copy the high lane into the low lane.
+    __ unpckhpd(value, value);
+  }
+}
+
+
 LocationSummary* MathSqrtInstr::MakeLocationSummary() const {
   const intptr_t kNumInputs = 1;
   const intptr_t kNumTemps = 0;
@@ -16,106 +16,106 @@ namespace dart {
 // When adding a new function for intrinsification add a 0 as fingerprint,
 // build and run to get the correct fingerprint from the mismatch error.
 #define CORE_LIB_INTRINSIC_LIST(V)                                             \
-  V(_IntegerImplementation, _addFromInteger, Integer_addFromInteger, 726019207)\
-  V(_IntegerImplementation, +, Integer_add, 1768648592)                        \
-  V(_IntegerImplementation, _subFromInteger, Integer_subFromInteger, 726019207)\
-  V(_IntegerImplementation, -, Integer_sub, 1292467582)                        \
-  V(_IntegerImplementation, _mulFromInteger, Integer_mulFromInteger, 726019207)\
-  V(_IntegerImplementation, *, Integer_mul, 1853182047)                        \
-  V(_IntegerImplementation, %, Integer_modulo, 1211518976)                     \
-  V(_IntegerImplementation, ~/, Integer_truncDivide, 142750059)                \
-  V(_IntegerImplementation, unary-, Integer_negate, 676633254)                 \
+  V(_IntegerImplementation, _addFromInteger, Integer_addFromInteger, 931645428)\
+  V(_IntegerImplementation, +, Integer_add, 1554249585)                        \
+  V(_IntegerImplementation, _subFromInteger, Integer_subFromInteger, 931645428)\
+  V(_IntegerImplementation, -, Integer_sub, 1136891446)                        \
+  V(_IntegerImplementation, _mulFromInteger, Integer_mulFromInteger, 931645428)\
+  V(_IntegerImplementation, *, Integer_mul, 665717727)                         \
+  V(_IntegerImplementation, %, Integer_modulo, 1275062101)                     \
+  V(_IntegerImplementation, ~/, Integer_truncDivide, 290893827)                \
+  V(_IntegerImplementation, unary-, Integer_negate, 1760568516)                \
   V(_IntegerImplementation, _bitAndFromInteger,                                \
-    Integer_bitAndFromInteger, 726019207)                                      \
-  V(_IntegerImplementation, &, Integer_bitAnd, 354347153)                      \
+    Integer_bitAndFromInteger, 931645428)                                      \
+  V(_IntegerImplementation, &, Integer_bitAnd, 1415110805)                     \
   V(_IntegerImplementation, _bitOrFromInteger,                                 \
-    Integer_bitOrFromInteger, 726019207)                                       \
-  V(_IntegerImplementation, |, Integer_bitOr, 875694946)                       \
+    Integer_bitOrFromInteger, 931645428)                                       \
+  V(_IntegerImplementation, |, Integer_bitOr, 1975760599)                      \
   V(_IntegerImplementation, _bitXorFromInteger,                                \
-    Integer_bitXorFromInteger, 726019207)                                      \
-  V(_IntegerImplementation, ^, Integer_bitXor, 282155459)                      \
+    Integer_bitXorFromInteger, 931645428)                                      \
+  V(_IntegerImplementation, ^, Integer_bitXor, 883190662)                      \
   V(_IntegerImplementation,                                                    \
     _greaterThanFromInteger,                                                   \
-    Integer_greaterThanFromInt, 79222670)                                      \
-  V(_IntegerImplementation, >, Integer_greaterThan, 462314913)                 \
-  V(_IntegerImplementation, ==, Integer_equal, 1424765465)                     \
-  V(_IntegerImplementation, _equalToInteger, Integer_equalToInteger, 79222670) \
-  V(_IntegerImplementation, <, Integer_lessThan, 1424838471)                   \
-  V(_IntegerImplementation, <=, Integer_lessEqualThan, 949016155)              \
-  V(_IntegerImplementation, >=, Integer_greaterEqualThan, 949045946)           \
-  V(_IntegerImplementation, <<, Integer_shl, 1195917829)                       \
-  V(_IntegerImplementation, >>, Integer_sar, 1980227743)                       \
-  V(_Smi, ~, Smi_bitNegate, 882629793)                                         \
-  V(_Double, >, Double_greaterThan, 301935359)                                 \
-  V(_Double, >=, Double_greaterEqualThan, 1184528952)                          \
-  V(_Double, <, Double_lessThan, 1596251333)                                   \
-  V(_Double, <=, Double_lessEqualThan, 1184499161)                             \
-  V(_Double, ==, Double_equal, 1706047712)                                     \
-  V(_Double, +, Double_add, 210576655)                                         \
-  V(_Double, -, Double_sub, 1605354741)                                        \
-  V(_Double, *, Double_mul, 788270837)                                         \
-  V(_Double, /, Double_div, 1202831412)                                        \
-  V(_Double, get:isNaN, Double_getIsNaN, 54462366)                             \
-  V(_Double, get:isNegative, Double_getIsNegative, 54462366)                   \
-  V(_Double, _mulFromInteger, Double_mulFromInteger, 704314034)                \
-  V(_Double, .fromInteger, Double_fromInteger, 842078193)                      \
-  V(_Double, toInt, Double_toInt, 362666636)                                   \
-  V(_ObjectArray, ., ObjectArray_Allocate, 97987288)                           \
-  V(_ObjectArray, get:length, Array_getLength, 405297088)                      \
-  V(_ObjectArray, [], Array_getIndexed, 71937385)                              \
-  V(_ObjectArray, []=, Array_setIndexed, 255863719)                            \
-  V(_GrowableObjectArray, .withData, GrowableArray_Allocate, 816132033)        \
-  V(_GrowableObjectArray, get:length, GrowableArray_getLength, 725548050)      \
-  V(_GrowableObjectArray, get:_capacity, GrowableArray_getCapacity, 725548050) \
-  V(_GrowableObjectArray, [], GrowableArray_getIndexed, 581838973)             \
-  V(_GrowableObjectArray, []=, GrowableArray_setIndexed, 1048007636)           \
-  V(_GrowableObjectArray, _setLength, GrowableArray_setLength, 796709584)      \
-  V(_GrowableObjectArray, _setData, GrowableArray_setData, 629110947)          \
-  V(_GrowableObjectArray, add, GrowableArray_add, 1904852879)                  \
-  V(_ImmutableArray, [], ImmutableArray_getIndexed, 486821199)                 \
-  V(_ImmutableArray, get:length, ImmutableArray_getLength, 433698233)          \
-  V(Object, ==, Object_equal, 2126897013)                                      \
-  V(_StringBase, get:hashCode, String_getHashCode, 320803993)                  \
-  V(_StringBase, get:isEmpty, String_getIsEmpty, 1026765313)                   \
-  V(_StringBase, get:length, String_getLength, 320803993)                      \
-  V(_StringBase, codeUnitAt, String_codeUnitAt, 984449525)                     \
-  V(_OneByteString, get:hashCode, OneByteString_getHashCode, 682660413)        \
+    Integer_greaterThanFromInt, 836115113)                                     \
+  V(_IntegerImplementation, >, Integer_greaterThan, 1305346334)                \
+  V(_IntegerImplementation, ==, Integer_equal, 1041691339)                     \
+  V(_IntegerImplementation, _equalToInteger, Integer_equalToInteger, 836115113)\
+  V(_IntegerImplementation, <, Integer_lessThan, 1491011988)                   \
+  V(_IntegerImplementation, <=, Integer_lessEqualThan, 1462450810)             \
+  V(_IntegerImplementation, >=, Integer_greaterEqualThan, 1462480601)          \
+  V(_IntegerImplementation, <<, Integer_shl, 2119737680)                       \
+  V(_IntegerImplementation, >>, Integer_sar, 940811475)                        \
+  V(_Smi, ~, Smi_bitNegate, 34889614)                                          \
+  V(_Double, >, Double_greaterThan, 646035777)                                 \
+  V(_Double, >=, Double_greaterEqualThan, 1011114379)                          \
+  V(_Double, <, Double_lessThan, 338071110)                                    \
+  V(_Double, <=, Double_lessEqualThan, 1011084588)                             \
+  V(_Double, ==, Double_equal, 1493319262)                                     \
+  V(_Double, +, Double_add, 649002332)                                         \
+  V(_Double, -, Double_sub, 1559730878)                                        \
+  V(_Double, *, Double_mul, 1231074651)                                        \
+  V(_Double, /, Double_div, 961030014)                                         \
+  V(_Double, get:isNaN, Double_getIsNaN, 1010304415)                           \
+  V(_Double, get:isNegative, Double_getIsNegative, 1010304415)                 \
+  V(_Double, _mulFromInteger, Double_mulFromInteger, 156858929)                \
+  V(_Double, .fromInteger, Double_fromInteger, 101995638)                      \
+  V(_Double, toInt, Double_toInt, 854063054)                                   \
+  V(_ObjectArray, ., ObjectArray_Allocate, 514235087)                          \
+  V(_ObjectArray, get:length, Array_getLength, 356902443)                      \
+  V(_ObjectArray, [], Array_getIndexed, 430612798)                             \
+  V(_ObjectArray, []=, Array_setIndexed, 977620856)                            \
+  V(_GrowableObjectArray, .withData, GrowableArray_Allocate, 862476975)        \
+  V(_GrowableObjectArray, get:length, GrowableArray_getLength, 532961654)      \
+  V(_GrowableObjectArray, get:_capacity, GrowableArray_getCapacity, 532961654) \
+  V(_GrowableObjectArray, [], GrowableArray_getIndexed, 1052091247)            \
+  V(_GrowableObjectArray, []=, GrowableArray_setIndexed, 837657860)            \
+  V(_GrowableObjectArray, _setLength, GrowableArray_setLength, 623052757)      \
+  V(_GrowableObjectArray, _setData, GrowableArray_setData, 998409591)          \
+  V(_GrowableObjectArray, add, GrowableArray_add, 1396028054)                  \
+  V(_ImmutableArray, [], ImmutableArray_getIndexed, 16872600)                  \
+  V(_ImmutableArray, get:length, ImmutableArray_getLength, 877585703)          \
+  V(Object, ==, Object_equal, 812201921)                                       \
+  V(_StringBase, get:hashCode, String_getHashCode, 635233542)                  \
+  V(_StringBase, get:isEmpty, String_getIsEmpty, 473550990)                    \
+  V(_StringBase, get:length, String_getLength, 635233542)                      \
+  V(_StringBase, codeUnitAt, String_codeUnitAt, 340266880)                     \
+  V(_OneByteString, get:hashCode, OneByteString_getHashCode, 1020016087)       \
   V(_OneByteString, _substringUncheckedNative,                                 \
-      OneByteString_substringUnchecked, 713121438)                             \
+      OneByteString_substringUnchecked, 335504796)                             \
 
 
 #define MATH_LIB_INTRINSIC_LIST(V)                                             \
-  V(::, sqrt, Math_sqrt, 1662640002)                                           \
-  V(::, sin, Math_sin, 1273932041)                                             \
-  V(::, cos, Math_cos, 1749547468)                                             \
+  V(::, sqrt, Math_sqrt, 878372794)                                            \
+  V(::, sin, Math_sin, 1791585849)                                             \
+  V(::, cos, Math_cos, 262330142)                                              \
 
 
 #define TYPEDDATA_LIB_INTRINSIC_LIST(V)                                        \
-  V(_TypedList, get:length, TypedData_getLength, 231908172)                    \
-  V(_Int8Array, _new, TypedData_Int8Array_new, 844274443)                      \
-  V(_Uint8Array, _new, TypedData_Uint8Array_new, 997951645)                    \
-  V(_Uint8ClampedArray, _new, TypedData_Uint8ClampedArray_new, 1025045044)     \
-  V(_Int16Array, _new, TypedData_Int16Array_new, 1064563368)                   \
-  V(_Uint16Array, _new, TypedData_Uint16Array_new, 110927177)                  \
-  V(_Int32Array, _new, TypedData_Int32Array_new, 770802406)                    \
-  V(_Uint32Array, _new, TypedData_Uint32Array_new, 856841876)                  \
-  V(_Int64Array, _new, TypedData_Int64Array_new, 941769528)                    \
-  V(_Uint64Array, _new, TypedData_Uint64Array_new, 977566635)                  \
-  V(_Float32Array, _new, TypedData_Float32Array_new, 1053133615)               \
-  V(_Float64Array, _new, TypedData_Float64Array_new, 936673303)                \
-  V(_Float32x4Array, _new, TypedData_Float32x4Array_new, 212088644)            \
-  V(_Int8Array, ., TypedData_Int8Array_factory, 156009974)                     \
-  V(_Uint8Array, ., TypedData_Uint8Array_factory, 1465460956)                  \
-  V(_Uint8ClampedArray, ., TypedData_Uint8ClampedArray_factory, 970170700)     \
-  V(_Int16Array, ., TypedData_Int16Array_factory, 1520309224)                  \
-  V(_Uint16Array, ., TypedData_Uint16Array_factory, 195493071)                 \
-  V(_Int32Array, ., TypedData_Int32Array_factory, 27437702)                    \
-  V(_Uint32Array, ., TypedData_Uint32Array_factory, 1702451035)                \
-  V(_Int64Array, ., TypedData_Int64Array_factory, 225360944)                   \
-  V(_Uint64Array, ., TypedData_Uint64Array_factory, 1730375031)                \
-  V(_Float32Array, ., TypedData_Float32Array_factory, 563498394)               \
-  V(_Float64Array, ., TypedData_Float64Array_factory, 492220296)               \
-  V(_Float32x4Array, ., TypedData_Float32x4Array_factory, 1845796718)          \
+  V(_TypedList, get:length, TypedData_getLength, 615410225)                    \
+  V(_Int8Array, _new, TypedData_Int8Array_new, 892866727)                      \
+  V(_Uint8Array, _new, TypedData_Uint8Array_new, 815661808)                    \
+  V(_Uint8ClampedArray, _new, TypedData_Uint8ClampedArray_new, 800768444)      \
+  V(_Int16Array, _new, TypedData_Int16Array_new, 1054078293)                   \
+  V(_Uint16Array, _new, TypedData_Uint16Array_new, 696446977)                  \
+  V(_Int32Array, _new, TypedData_Int32Array_new, 746373107)                    \
+  V(_Uint32Array, _new, TypedData_Uint32Array_new, 582137715)                  \
+  V(_Int64Array, _new, TypedData_Int64Array_new, 960269095)                    \
+  V(_Uint64Array, _new, TypedData_Uint64Array_new, 12268091)                   \
+  V(_Float32Array, _new, TypedData_Float32Array_new, 3635353)                  \
+  V(_Float64Array, _new, TypedData_Float64Array_new, 988849922)                \
+  V(_Float32x4Array, _new, TypedData_Float32x4Array_new, 486047117)            \
+  V(_Int8Array, ., TypedData_Int8Array_factory, 1584380693)                    \
+  V(_Uint8Array, ., TypedData_Uint8Array_factory, 205386097)                   \
+  V(_Uint8ClampedArray, ., TypedData_Uint8ClampedArray_factory, 1526055430)    \
+  V(_Int16Array, ., TypedData_Int16Array_factory, 1668773383)                  \
+  V(_Uint16Array, ., TypedData_Uint16Array_factory, 830708725)                 \
+  V(_Int32Array, ., TypedData_Int32Array_factory, 752552108)                   \
+  V(_Uint32Array, ., TypedData_Uint32Array_factory, 2057246118)                \
+  V(_Int64Array, ., TypedData_Int64Array_factory, 907052993)                   \
+  V(_Uint64Array, ., TypedData_Uint64Array_factory, 437193238)                 \
+  V(_Float32Array, ., TypedData_Float32Array_factory, 2119867551)              \
+  V(_Float64Array, ., TypedData_Float64Array_factory, 1888794305)              \
+  V(_Float32x4Array, ., TypedData_Float32x4Array_factory, 650454968)           \
 
 // TODO(srdjan): Implement _FixedSizeArrayIterator, get:current and
 //   _FixedSizeArrayIterator, moveNext.
@@ -9,6 +9,7 @@
 #include "platform/json.h"
 #include "lib/mirrors.h"
 #include "vm/code_observers.h"
+#include "vm/compiler.h"
 #include "vm/compiler_stats.h"
 #include "vm/dart_api_state.h"
 #include "vm/dart_entry.h"
@@ -18,6 +19,7 @@
 #include "vm/object_store.h"
 #include "vm/parser.h"
 #include "vm/port.h"
+#include "vm/profiler.h"
 #include "vm/simulator.h"
 #include "vm/stack_frame.h"
 #include "vm/stub_code.h"
@@ -32,7 +34,9 @@ DEFINE_FLAG(bool, report_usage_count, false,
             "Track function usage and report.");
 DEFINE_FLAG(bool, trace_isolates, false,
             "Trace isolate creation and shut down.");
+DECLARE_FLAG(bool, optimize_on_idle);
 DECLARE_FLAG(bool, trace_deoptimization_verbose);
+DECLARE_FLAG(bool, trace_dispatch_table);
 
 class IsolateMessageHandler : public MessageHandler {
  public:
@@ -42,6 +46,7 @@ class IsolateMessageHandler : public MessageHandler {
   const char* name() const;
   void MessageNotify(Message::Priority priority);
   bool HandleMessage(Message* message);
+  bool HandleIdle();
 
 #if defined(DEBUG)
   // Check that it is safe to access this handler.
@@ -143,6 +148,16 @@ bool IsolateMessageHandler::HandleMessage(Message* message) {
   return success;
 }
 
+
+bool IsolateMessageHandler::HandleIdle() {
+  if (!FLAG_optimize_on_idle) return false;
+  StartIsolateScope start_scope(isolate_);
+  StackZone zone(isolate_);
+  HandleScope handle_scope(isolate_);
+  return Compiler::OptimizeQueuedFunction();
+}
+
+
 RawFunction* IsolateMessageHandler::ResolveCallbackFunction() {
   ASSERT(isolate_->object_store()->unhandled_exception_handler() != NULL);
   String& callback_name = String::Handle(isolate_);
@@ -346,8 +361,14 @@ Isolate::Isolate()
       deopt_frame_copy_(NULL),
       deopt_frame_copy_size_(0),
       deferred_objects_(NULL),
+      deopt_materialization_area_(NULL),
+      deopt_materialization_area_size_(0),
+      deferred_object_refs_(NULL),
       stacktrace_(NULL),
-      stack_frame_index_(-1) {
+      stack_frame_index_(-1),
+      scan_queue_(NULL),
+      profiler_samples_(NULL),
+      is_profiling_(false) {
 }
 
 
@@ -717,9 +738,15 @@ void Isolate::Shutdown() {
     PrintInvokedFunctions();
   }
   CompilerStats::Print();
+  Profiler::ShutdownIsolate(this);
   // TODO(asiva): Move this code to Dart::Cleanup when we have that method
   // as the cleanup for Dart::InitOnce.
   CodeObservers::DeleteAll();
+  if (FLAG_trace_dispatch_table) {
+    StackZone zone(this);
+    HandleScope handle_scope(this);
+    dispatch_table()->PrintSizes();
+  }
   if (FLAG_trace_isolates) {
     StackZone zone(this);
     HandleScope handle_scope(this);
@@ -760,6 +787,9 @@ void Isolate::VisitObjectPointers(ObjectPointerVisitor* visitor,
   // Visit objects in the megamorphic cache.
   megamorphic_cache_table()->VisitObjectPointers(visitor);
 
+  // Visit objects in the dispatch table.
+  dispatch_table()->VisitObjectPointers(visitor);
+
   // Visit objects in per isolate stubs.
   StubCode::VisitObjectPointers(visitor);
 
@@ -785,6 +815,14 @@ void Isolate::VisitObjectPointers(ObjectPointerVisitor* visitor,
   // Visit the currently active IC data array.
   visitor->VisitPointer(reinterpret_cast<RawObject**>(&ic_data_array_));
 
+  // Visit the objects referred to by the descriptions of sunk allocations
+  // while a frame is being deoptimized.
+  if (deopt_materialization_area_ != NULL) {
+    visitor->VisitPointers(
+        reinterpret_cast<RawObject**>(deopt_materialization_area_),
+        deopt_materialization_area_size_);
+  }
+
   // Visit objects in the debugger.
   debugger()->VisitObjectPointers(visitor);
 }
@@ -879,6 +917,31 @@ bool Isolate::FetchStackFrameDetails() {
 }
 
 
+bool Isolate::FetchProfile() {
+  Isolate* isolate = Isolate::Current();
+  MonitorLocker ml(status_sync);
+  StackZone zone(isolate);
+  HandleScope handle_scope(isolate);
+  TextBuffer buffer(256);
+  Profiler::PrintJSON(&buffer);
+  isolate->stacktrace_ = OS::StrNDup(buffer.buf(), buffer.length());
+  ml.Notify();
+  return true;
+}
+
+
+bool Isolate::StartProfile() {
+  Profiler::StartIsolate(Isolate::Current());
+  return FetchProfile();
+}
+
+
+bool Isolate::StopProfile() {
+  Profiler::StopIsolate(Isolate::Current());
+  return FetchProfile();
+}
+
+
 char* Isolate::DoStacktraceInterrupt(Dart_IsolateInterruptCallback cb) {
   ASSERT(stacktrace_ == NULL);
   SetVmStatsCallback(cb);
@@ -988,6 +1051,21 @@ char* Isolate::GetStatus(const char* request) {
     }
   }
 
+  // Query "/isolate/<handle>/profile"
+  if (!strcmp(p, "/profile")) {
+    return isolate->DoStacktraceInterrupt(&FetchProfile);
+  }
+
+  // Query "/isolate/<handle>/profile/start"
+  if (!strcmp(p, "/profile/start")) {
+    return isolate->DoStacktraceInterrupt(&StartProfile);
+  }
+
+  // Query "/isolate/<handle>/profile/stop"
+  if (!strcmp(p, "/profile/stop")) {
+    return isolate->DoStacktraceInterrupt(&StopProfile);
+  }
+
   // TODO(tball): "/isolate/<handle>/stacktrace/<frame-index>"/disassemble"
 
   return NULL;  // Unimplemented query.
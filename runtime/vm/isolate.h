@@ -10,6 +10,7 @@
 #include "platform/thread.h"
 #include "vm/base_isolate.h"
 #include "vm/class_table.h"
+#include "vm/dispatch_table.h"
 #include "vm/gc_callbacks.h"
 #include "vm/megamorphic_cache_table.h"
 #include "vm/store_buffer.h"
@@ -45,6 +46,8 @@ class StackZone;
 class StubCode;
 class RawFloat32x4;
 class RawUint32x4;
+class SampleBuffer;
+class ScanQueue;
 
 
 // Used by the deoptimization infrastructure to defer allocation of unboxed
@@ -135,6 +138,28 @@ class DeferredUint32x4 : public DeferredObject {
 };
 
 
+// Used by the deoptimization infrastructure to store an object whose
+// allocation was sunk by the optimizing compiler into a slot of the
+// unoptimized frame once the object is materialized.
+// See callers of Isolate::DeferMaterializedObjectRef.
+class DeferredObjectRef {
+ public:
+  DeferredObjectRef(intptr_t index, RawInstance** slot, DeferredObjectRef* next)
+      : index_(index), slot_(slot), next_(next) { }
+
+  intptr_t index() const { return index_; }
+  RawInstance** slot() const { return slot_; }
+  DeferredObjectRef* next() const { return next_; }
+
+ private:
+  const intptr_t index_;
+  RawInstance** const slot_;
+  DeferredObjectRef* const next_;
+
+  DISALLOW_COPY_AND_ASSIGN(DeferredObjectRef);
+};
+
+
 class Isolate : public BaseIsolate {
  public:
   ~Isolate();
@@ -174,6 +199,8 @@ class Isolate : public BaseIsolate {
     return &megamorphic_cache_table_;
   }
 
+  DispatchTable* dispatch_table() { return &dispatch_table_; }
+
   Dart_MessageNotifyCallback message_notify_callback() const {
     return message_notify_callback_;
   }
@@ -293,6 +320,16 @@ class Isolate : public BaseIsolate {
   IsolateRunState running_state() const { return running_state_; }
   void set_running_state(IsolateRunState value) { running_state_ = value; }
 
+  // Parts of the library being loaded, see vm/scan_queue.h.
+  ScanQueue* scan_queue() const { return scan_queue_; }
+  void set_scan_queue(ScanQueue* value) { scan_queue_ = value; }
+
+  // CPU profiler support, see vm/profiler.h.
+  SampleBuffer* profiler_samples() const { return profiler_samples_; }
+  void set_profiler_samples(SampleBuffer* value) { profiler_samples_ = value; }
+  bool is_profiling() const { return is_profiling_; }
+  void set_is_profiling(bool value) { is_profiling_ = value; }
+
   uword spawn_data() const { return spawn_data_; }
   void set_spawn_data(uword value) { spawn_data_ = value; }
 
@@ -456,6 +493,32 @@ class Isolate : public BaseIsolate {
     return list;
   }
 
+  // The descriptions of the objects whose allocation was sunk, written by
+  // the deoptimization of a frame that refers to such objects.
+  intptr_t* deopt_materialization_area() const {
+    return deopt_materialization_area_;
+  }
+  intptr_t deopt_materialization_area_size() const {
+    return deopt_materialization_area_size_;
+  }
+  void SetDeoptMaterializationArea(intptr_t* value, intptr_t size) {
+    ASSERT((value == NULL) || (size > 0));
+    ASSERT((value == NULL) || (deopt_materialization_area_ == NULL));
+    deopt_materialization_area_ = value;
+    deopt_materialization_area_size_ = size;
+  }
+
+  void DeferMaterializedObjectRef(intptr_t index, RawInstance** slot) {
+    deferred_object_refs_ =
+        new DeferredObjectRef(index, slot, deferred_object_refs_);
+  }
+
+  DeferredObjectRef* DetachDeferredObjectRefs() {
+    DeferredObjectRef* list = deferred_object_refs_;
+    deferred_object_refs_ = NULL;
+    return list;
+  }
+
   static char* GetStatus(const char* request);
 
  private:
@@ -466,6 +529,9 @@ class Isolate : public BaseIsolate {
 
   static bool FetchStacktrace();
   static bool FetchStackFrameDetails();
+  static bool FetchProfile();
+  static bool StartProfile();
+  static bool StopProfile();
   char* GetStatusDetails();
   char* GetStatusStacktrace();
   char* GetStatusStackFrame(intptr_t index);
@@ -476,6 +542,7 @@ class Isolate : public BaseIsolate {
   StoreBuffer store_buffer_;
   ClassTable class_table_;
   MegamorphicCacheTable megamorphic_cache_table_;
+  DispatchTable dispatch_table_;
   Dart_MessageNotifyCallback message_notify_callback_;
   char* name_;
   int64_t start_time_;
@@ -510,11 +577,20 @@ class Isolate : public BaseIsolate {
   intptr_t* deopt_frame_copy_;
   intptr_t deopt_frame_copy_size_;
   DeferredObject* deferred_objects_;
+  intptr_t* deopt_materialization_area_;
+  intptr_t deopt_materialization_area_size_;
+  DeferredObjectRef* deferred_object_refs_;
 
   // Status support.
   char* stacktrace_;
   intptr_t stack_frame_index_;
 
+  ScanQueue* scan_queue_;
+
+  // Profiler support.
+  SampleBuffer* profiler_samples_;
+  volatile bool is_profiling_;
+
   static Dart_IsolateCreateCallback create_callback_;
   static Dart_IsolateInterruptCallback interrupt_callback_;
   static Dart_IsolateUnhandledExceptionCallback unhandled_exception_callback_;
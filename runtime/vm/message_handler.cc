@@ -66,6 +66,12 @@ void MessageHandler::MessageNotify(Message::Priority priority) {
 }
 
 
+bool MessageHandler::HandleIdle() {
+  // By default, there is no idle work.
+  return false;
+}
+
+
 void MessageHandler::Run(ThreadPool* pool,
                          StartCallback start_callback,
                          EndCallback end_callback,
@@ -205,9 +211,18 @@ void MessageHandler::TaskCallback() {
       monitor_.Enter();
     }
 
-    // Handle any pending messages for this message handler.
+    // Handle any pending messages for this message handler. In between,
+    // when there are no messages, do any idle work piece by piece so
+    // that new messages are not delayed for long.
     if (ok) {
       ok = HandleMessages(true, true);
+      bool more_idle_work = true;
+      while (ok && more_idle_work && HasLivePorts()) {
+        monitor_.Exit();
+        more_idle_work = HandleIdle();
+        monitor_.Enter();
+        ok = HandleMessages(true, true);
+      }
     }
     task_ = NULL;  // No task in queue.
 
@@ -101,6 +101,13 @@ class MessageHandler {
   // Returns true on success.
   virtual bool HandleMessage(Message* message) = 0;
 
+  // Does a small piece of work while there are no messages to handle.
+  // Optionally provided by subclass.
+  //
+  // Returns true if there may be more work, in which case it is called
+  // again once any newly arrived messages have been handled.
+  virtual bool HandleIdle();
+
  private:
   friend class PortMap;
   friend class MessageHandlerTestPeer;
@@ -37,6 +37,8 @@ class TestMessageHandler : public MessageHandler {
         port_buffer_size_(0),
         notify_count_(0),
         message_count_(0),
+        idle_count_(0),
+        idle_work_(0),
         start_called_(false),
         end_called_(false),
         result_(true) {
@@ -59,6 +61,12 @@ class TestMessageHandler : public MessageHandler {
     return result_;
   }
 
+  bool HandleIdle() {
+    idle_count_++;
+    if (idle_work_ > 0) idle_work_--;
+    return idle_work_ > 0;
+  }
+
   bool Start() {
     start_called_ = true;
     return true;
@@ -72,10 +80,12 @@ class TestMessageHandler : public MessageHandler {
   Dart_Port* port_buffer() const { return port_buffer_; }
   int notify_count() const { return notify_count_; }
   int message_count() const { return message_count_; }
+  int idle_count() const { return idle_count_; }
   bool start_called() const { return start_called_; }
   bool end_called() const { return end_called_; }
 
   void set_result(bool result) { result_ = result; }
+  void set_idle_work(int idle_work) { idle_work_ = idle_work; }
 
  private:
   void AddPortToBuffer(Dart_Port port) {
@@ -99,6 +109,8 @@ class TestMessageHandler : public MessageHandler {
   int port_buffer_size_;
   int notify_count_;
   int message_count_;
+  int idle_count_;
+  int idle_work_;
   bool start_called_;
   bool end_called_;
   bool result_;
@@ -308,4 +320,40 @@ UNIT_TEST_CASE(MessageHandler_Run) {
   PortMap::ClosePorts(&handler);
 }
 
+
+UNIT_TEST_CASE(MessageHandler_RunIdle) {
+  ThreadPool pool;
+  TestMessageHandler handler;
+  MessageHandlerTestPeer handler_peer(&handler);
+  int sleep = 0;
+  const int kMaxSleep = 20 * 1000;  // 20 seconds.
+
+  handler_peer.increment_live_ports();
+  handler.set_idle_work(3);
+  // Post the message before running the handler, so that it is
+  // handled before any idle work.
+  Dart_Port port = PortMap::CreatePort(&handler);
+  Message* message = new Message(port, 0, NULL, 0, Message::kNormalPriority);
+  handler_peer.PostMessage(message);
+  handler.Run(&pool,
+              TestStartFunction,
+              TestEndFunction,
+              reinterpret_cast<uword>(&handler));
+
+  // The idle work is done in pieces after the message is handled.
+  while (sleep < kMaxSleep && handler.idle_count() < 3) {
+    OS::Sleep(10);
+    sleep += 10;
+  }
+  EXPECT_EQ(1, handler.message_count());
+  EXPECT_EQ(3, handler.idle_count());
+
+  // Once there is no more idle work, the handler waits for messages.
+  OS::Sleep(100);
+  EXPECT_EQ(3, handler.idle_count());
+  handler_peer.decrement_live_ports();
+  EXPECT(!handler.HasLivePorts());
+  PortMap::ClosePorts(&handler);
+}
+
 }  // namespace dart
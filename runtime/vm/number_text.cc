@@ -0,0 +1,564 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/number_text.h"
+
+#include <math.h>
+
+#include "platform/utils.h"
+#include "vm/double_conversion.h"
+
+#if defined(HOST_ARCH_IA32) || defined(HOST_ARCH_X64)
+#define USE_SSE2_NUMBER_TEXT 1
+#include <emmintrin.h>  // NOLINT
+#endif
+
+namespace dart {
+
+// The most significant digits of a decimal number that fit in a uint64_t.
+static const intptr_t kMaxSignificantDigits = 19;
+
+// Powers of ten that are exact doubles.
+static const double kExactPowersOfTen[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+static const intptr_t kMaxExactPowerOfTen = 22;
+
+// Integers up to this are exact doubles.
+static const uint64_t kMaxExactInteger = DART_INT64_C(1) << 53;
+
+// The two digit decimal numbers, used to write integers two digits at once.
+static const char kDigitPairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233"
+    "34353637383940414243444546474849505152535455565758596061626364656667"
+    "68697071727374757677787980818283848586878889909192939495969798990";
+
+
+static inline bool IsWhitespace(uint8_t c) {
+  return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n');
+}
+
+
+static inline bool IsDigit(uint8_t c) {
+  return ('0' <= c) && (c <= '9');
+}
+
+
+static inline bool IsHexDigit(uint8_t c) {
+  return IsDigit(c) || (('a' <= (c | 0x20)) && ((c | 0x20) <= 'f'));
+}
+
+
+static inline intptr_t HexDigitValue(uint8_t c) {
+  return IsDigit(c) ? (c - '0') : ((c | 0x20) - 'a' + 10);
+}
+
+
+// Reads eight bytes as one word. All the targets of the VM are little
+// endian, so the first byte is the least significant one.
+static inline uint64_t LoadEightBytes(const uint8_t* p) {
+  uint64_t word;
+  memmove(&word, p, sizeof(word));
+  return word;
+}
+
+
+static inline bool AreEightDigits(uint64_t word) {
+  // Adding 0x46 to an ASCII byte sets its high bit iff it is above '9', and
+  // subtracting 0x30 sets it iff the byte is below '0'.
+  return ((word |
+           (word + DART_2PART_UINT64_C(0x46464646, 46464646)) |
+           (word - DART_2PART_UINT64_C(0x30303030, 30303030))) &
+          DART_2PART_UINT64_C(0x80808080, 80808080)) == 0;
+}
+
+
+// Returns the value of eight decimal digits, the first one being the most
+// significant, by combining pairs of digits, then of two digit numbers and
+// then of four digit numbers in three multiplications.
+static inline uint64_t EightDigitsValue(uint64_t word) {
+  word -= DART_2PART_UINT64_C(0x30303030, 30303030);
+  word = (word * 10 + (word >> 8)) & DART_2PART_UINT64_C(0x00FF00FF, 00FF00FF);
+  word = (word * 100 + (word >> 16)) &
+      DART_2PART_UINT64_C(0x0000FFFF, 0000FFFF);
+  return (word * 10000 + (word >> 32)) & 0xFFFFFFFF;
+}
+
+
+// Reads the decimal digits at 'p' into 'mantissa', and counts in
+// 'significant_digits' those after the leading zeros. The mantissa is only
+// meaningful while there are at most kMaxSignificantDigits of them.
+static const uint8_t* ScanDecimalDigits(const uint8_t* p,
+                                        const uint8_t* end,
+                                        uint64_t* mantissa,
+                                        intptr_t* significant_digits) {
+  uint64_t m = *mantissa;
+  intptr_t n = *significant_digits;
+  if (m == 0) {
+    while ((p < end) && (*p == '0')) {
+      p++;
+    }
+  }
+  while (((end - p) >= 8) && ((n + 8) <= kMaxSignificantDigits)) {
+    const uint64_t word = LoadEightBytes(p);
+    if (!AreEightDigits(word)) {
+      break;
+    }
+    m = m * 100000000 + EightDigitsValue(word);
+    n = (m == 0) ? 0 : n + 8;
+    p += 8;
+  }
+  while ((p < end) && IsDigit(*p)) {
+    if ((n > 0) || (*p != '0')) {
+      n++;
+    }
+    m = m * 10 + (*p - '0');
+    p++;
+  }
+  *mantissa = m;
+  *significant_digits = n;
+  return p;
+}
+
+
+bool NumberText::ParseDouble(const uint8_t* field,
+                             intptr_t length,
+                             double* value) {
+  const uint8_t* p = field;
+  const uint8_t* end = field + length;
+  const bool negative = (p < end) && (*p == '-');
+  if (negative) {
+    p++;
+  }
+  if ((p < end) && ((*p == 'I') || (*p == 'N'))) {
+    if (((end - p) == 8) && (memcmp(p, "Infinity", 8) == 0)) {
+      *value = negative ? -INFINITY : INFINITY;
+      return true;
+    }
+    if (((end - p) == 3) && (memcmp(p, "NaN", 3) == 0)) {
+      *value = NAN;
+      return true;
+    }
+    return false;
+  }
+
+  uint64_t mantissa = 0;
+  intptr_t significant_digits = 0;
+  intptr_t exponent = 0;
+  const uint8_t* digits = p;
+  p = ScanDecimalDigits(p, end, &mantissa, &significant_digits);
+  bool has_digits = (p != digits);
+  if ((p < end) && (*p == '.')) {
+    p++;
+    digits = p;
+    p = ScanDecimalDigits(p, end, &mantissa, &significant_digits);
+    if (p == digits) {
+      return false;  // '5.' is not a double.
+    }
+    exponent -= p - digits;
+    has_digits = true;
+  }
+  if (!has_digits) {
+    return false;
+  }
+  if ((p < end) && ((*p == 'e') || (*p == 'E'))) {
+    p++;
+    const bool negative_exponent = (p < end) && (*p == '-');
+    if ((p < end) && ((*p == '-') || (*p == '+'))) {
+      p++;
+    }
+    digits = p;
+    intptr_t exponent_value = 0;
+    while ((p < end) && IsDigit(*p)) {
+      // Larger exponents do not change the value.
+      if (exponent_value < 100000) {
+        exponent_value = exponent_value * 10 + (*p - '0');
+      }
+      p++;
+    }
+    if (p == digits) {
+      return false;
+    }
+    exponent += negative_exponent ? -exponent_value : exponent_value;
+  }
+  if (p != end) {
+    return false;
+  }
+
+  // A mantissa and a power of ten that are both exact doubles give the
+  // correctly rounded value in a single multiplication or division.
+  if ((significant_digits <= kMaxSignificantDigits) &&
+      (mantissa <= kMaxExactInteger) &&
+      (-kMaxExactPowerOfTen <= exponent) &&
+      (exponent <= kMaxExactPowerOfTen)) {
+    double result = static_cast<double>(mantissa);
+    if (exponent < 0) {
+      result /= kExactPowersOfTen[-exponent];
+    } else {
+      result *= kExactPowersOfTen[exponent];
+    }
+    *value = negative ? -result : result;
+    return true;
+  }
+  return CStringToDouble(reinterpret_cast<const char*>(field), length, value);
+}
+
+
+bool NumberText::ParseInt64(const uint8_t* field,
+                            intptr_t length,
+                            int64_t* value) {
+  const uint8_t* p = field;
+  const uint8_t* end = field + length;
+  const bool negative = (p < end) && (*p == '-');
+  if (negative) {
+    p++;
+  }
+  uint64_t magnitude = 0;
+  const uint8_t* digits;
+  if (((end - p) >= 2) && (p[0] == '0') && ((p[1] | 0x20) == 'x')) {
+    p += 2;
+    digits = p;
+    while ((p < end) && IsHexDigit(*p)) {
+      if ((magnitude >> 60) != 0) {
+        return false;
+      }
+      magnitude = (magnitude << 4) | HexDigitValue(*p);
+      p++;
+    }
+  } else {
+    digits = p;
+    intptr_t significant_digits = 0;
+    p = ScanDecimalDigits(p, end, &magnitude, &significant_digits);
+    if (significant_digits > kMaxSignificantDigits) {
+      // Only a 20 digit number can still fit in a uint64_t.
+      magnitude = 0;
+      for (const uint8_t* q = p - significant_digits; q < p; q++) {
+        const uint64_t digit = *q - '0';
+        if (magnitude > ((kMaxUint64 - digit) / 10)) {
+          return false;
+        }
+        magnitude = magnitude * 10 + digit;
+      }
+    }
+  }
+  if ((p == digits) || (p != end)) {
+    return false;
+  }
+  const uint64_t limit = static_cast<uint64_t>(kMaxInt64) + (negative ? 1 : 0);
+  if (magnitude > limit) {
+    return false;
+  }
+  *value = negative ? static_cast<int64_t>(0 - magnitude)
+                    : static_cast<int64_t>(magnitude);
+  return true;
+}
+
+
+#if defined(USE_SSE2_NUMBER_TEXT)
+// Finds the separators sixteen bytes at a time.
+class SeparatorScanner : public ValueObject {
+ public:
+  SeparatorScanner(const uint8_t* end, uint8_t separator)
+      : end_(end),
+        separator_(separator),
+        separators_(_mm_set1_epi8(static_cast<char>(separator))) { }
+
+  // Returns the first separator at or after 'p', or the end.
+  const uint8_t* Next(const uint8_t* p) const {
+    while ((end_ - p) >= 16) {
+      const __m128i block =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, separators_));
+      if (mask != 0) {
+        return p + Utils::CountTrailingZeros(mask);
+      }
+      p += 16;
+    }
+    while ((p < end_) && (*p != separator_)) {
+      p++;
+    }
+    return p;
+  }
+
+ private:
+  const uint8_t* end_;
+  const uint8_t separator_;
+  const __m128i separators_;
+
+  DISALLOW_COPY_AND_ASSIGN(SeparatorScanner);
+};
+#else
+class SeparatorScanner : public ValueObject {
+ public:
+  SeparatorScanner(const uint8_t* end, uint8_t separator)
+      : end_(end), separator_(separator) { }
+
+  // Returns the first separator at or after 'p', or the end.
+  const uint8_t* Next(const uint8_t* p) const {
+    const void* separator = memchr(p, separator_, end_ - p);
+    return (separator == NULL) ? end_
+                               : reinterpret_cast<const uint8_t*>(separator);
+  }
+
+ private:
+  const uint8_t* end_;
+  const uint8_t separator_;
+
+  DISALLOW_COPY_AND_ASSIGN(SeparatorScanner);
+};
+#endif  // defined(USE_SSE2_NUMBER_TEXT)
+
+
+template<typename T, bool (*parse)(const uint8_t*, intptr_t, T*)>
+static intptr_t ParseFields(const uint8_t* data,
+                            intptr_t length,
+                            uint8_t separator,
+                            uint8_t* result,
+                            intptr_t capacity,
+                            intptr_t* error_offset,
+                            intptr_t* error_length) {
+  const uint8_t* end = data + length;
+  const SeparatorScanner scanner(end, separator);
+  intptr_t count = 0;
+  const uint8_t* p = data;
+  while (true) {
+    const uint8_t* field_end = scanner.Next(p);
+    const uint8_t* field_start = p;
+    while ((field_start < field_end) && IsWhitespace(*field_start)) {
+      field_start++;
+    }
+    const uint8_t* value_end = field_end;
+    while ((value_end > field_start) && IsWhitespace(value_end[-1])) {
+      value_end--;
+    }
+    if ((value_end == field_start) && (field_end == end)) {
+      // Data of whitespace, or whitespace after the last separator.
+      return count;
+    }
+    T value;
+    if (!parse(field_start, value_end - field_start, &value)) {
+      *error_offset = field_start - data;
+      *error_length = value_end - field_start;
+      return NumberText::kInvalidField;
+    }
+    if (count == capacity) {
+      return NumberText::kTooManyFields;
+    }
+    memmove(result + count * sizeof(value), &value, sizeof(value));
+    count++;
+    if (field_end == end) {
+      return count;
+    }
+    p = field_end + 1;
+  }
+}
+
+
+intptr_t NumberText::ParseDoubles(const uint8_t* data,
+                                  intptr_t length,
+                                  uint8_t separator,
+                                  uint8_t* result,
+                                  intptr_t capacity,
+                                  intptr_t* error_offset,
+                                  intptr_t* error_length) {
+  return ParseFields<double, NumberText::ParseDouble>(
+      data, length, separator, result, capacity, error_offset, error_length);
+}
+
+
+intptr_t NumberText::ParseInt64s(const uint8_t* data,
+                                 intptr_t length,
+                                 uint8_t separator,
+                                 uint8_t* result,
+                                 intptr_t capacity,
+                                 intptr_t* error_offset,
+                                 intptr_t* error_length) {
+  return ParseFields<int64_t, NumberText::ParseInt64>(
+      data, length, separator, result, capacity, error_offset, error_length);
+}
+
+
+// Writes the decimal digits of 'value' and returns their number.
+static intptr_t FormatDigits(uint64_t value, uint8_t* buffer) {
+  uint8_t digits[NumberText::kMaxInt64Length];
+  uint8_t* p = digits + NumberText::kMaxInt64Length;
+  while (value >= 100) {
+    const intptr_t pair = (value % 100) * 2;
+    value /= 100;
+    *--p = kDigitPairs[pair + 1];
+    *--p = kDigitPairs[pair];
+  }
+  if (value >= 10) {
+    *--p = kDigitPairs[value * 2 + 1];
+    *--p = kDigitPairs[value * 2];
+  } else {
+    *--p = '0' + static_cast<uint8_t>(value);
+  }
+  const intptr_t length = digits + NumberText::kMaxInt64Length - p;
+  memmove(buffer, p, length);
+  return length;
+}
+
+
+intptr_t NumberText::FormatInt64(int64_t value, uint8_t* buffer) {
+  if (value < 0) {
+    buffer[0] = '-';
+    return 1 + FormatDigits(0 - static_cast<uint64_t>(value), buffer + 1);
+  }
+  return FormatDigits(value, buffer);
+}
+
+
+// Writes a double that is an integer of at most 53 bits, followed by a
+// decimal point and 'fraction_digits' zeros if there are any.
+static intptr_t FormatIntegralDouble(double value,
+                                     intptr_t fraction_digits,
+                                     uint8_t* buffer) {
+  intptr_t length = 0;
+  if (signbit(value)) {
+    buffer[length++] = '-';
+    value = -value;
+  }
+  length += FormatDigits(static_cast<uint64_t>(value), buffer + length);
+  if (fraction_digits > 0) {
+    buffer[length++] = '.';
+    memset(buffer + length, '0', fraction_digits);
+    length += fraction_digits;
+  }
+  return length;
+}
+
+
+static inline bool IsSmallIntegralDouble(double value) {
+  return (fabs(value) < static_cast<double>(kMaxExactInteger)) &&
+      (value == trunc(value));
+}
+
+
+intptr_t NumberText::FormatDouble(double value, uint8_t* buffer) {
+  if (IsSmallIntegralDouble(value)) {
+    return FormatIntegralDouble(value, 1, buffer);
+  }
+  if (isnan(value)) {
+    memmove(buffer, "NaN", 3);
+    return 3;
+  }
+  if (isinf(value)) {
+    if (value < 0) {
+      memmove(buffer, "-Infinity", 9);
+      return 9;
+    }
+    memmove(buffer, "Infinity", 8);
+    return 8;
+  }
+  char text[kMaxDoubleLength + 1];
+  DoubleToCString(value, text, sizeof(text));
+  const intptr_t length = strlen(text);
+  ASSERT(length <= kMaxDoubleLength);
+  memmove(buffer, text, length);
+  return length;
+}
+
+
+intptr_t NumberText::FormatFixedDouble(double value,
+                                       intptr_t fraction_digits,
+                                       uint8_t* buffer) {
+  ASSERT((0 <= fraction_digits) && (fraction_digits <= 20));
+  if (IsSmallIntegralDouble(value)) {
+    return FormatIntegralDouble(value, fraction_digits, buffer);
+  }
+  // The same special cases as in double.toStringAsFixed.
+  if (isnan(value)) {
+    memmove(buffer, "NaN", 3);
+    return 3;
+  }
+  if ((value >= 1e21) || (value <= -1e21)) {
+    return FormatDouble(value, buffer);
+  }
+  char text[kMaxFixedDoubleLength + 1];
+  DoubleToCStringAsFixed(value, fraction_digits, text, sizeof(text));
+  const intptr_t length = strlen(text);
+  ASSERT(length <= kMaxFixedDoubleLength);
+  memmove(buffer, text, length);
+  return length;
+}
+
+
+static inline intptr_t FormatValue(double value,
+                                   intptr_t fraction_digits,
+                                   uint8_t* buffer) {
+  return (fraction_digits < 0)
+      ? NumberText::FormatDouble(value, buffer)
+      : NumberText::FormatFixedDouble(value, fraction_digits, buffer);
+}
+
+
+static inline intptr_t FormatValue(int64_t value,
+                                   intptr_t fraction_digits,
+                                   uint8_t* buffer) {
+  return NumberText::FormatInt64(value, buffer);
+}
+
+
+template<typename T, intptr_t kMaxLength>
+static intptr_t FormatValues(const uint8_t* values,
+                             intptr_t count,
+                             intptr_t fraction_digits,
+                             uint8_t separator,
+                             uint8_t* output,
+                             intptr_t capacity) {
+  uint8_t text[kMaxLength];
+  intptr_t position = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    if (i > 0) {
+      if (position == capacity) {
+        return -1;
+      }
+      output[position++] = separator;
+    }
+    T value;
+    memmove(&value, values + i * sizeof(value), sizeof(value));
+    // Near the end of the output, the text is written to a local buffer
+    // first to check that it fits.
+    const bool fits = (capacity - position) >= kMaxLength;
+    uint8_t* buffer = fits ? output + position : text;
+    const intptr_t length = FormatValue(value, fraction_digits, buffer);
+    if (!fits) {
+      if (length > (capacity - position)) {
+        return -1;
+      }
+      memmove(output + position, text, length);
+    }
+    position += length;
+  }
+  return position;
+}
+
+
+intptr_t NumberText::FormatDoubles(const uint8_t* values,
+                                   intptr_t count,
+                                   intptr_t fraction_digits,
+                                   uint8_t separator,
+                                   uint8_t* output,
+                                   intptr_t capacity) {
+  if (fraction_digits < 0) {
+    return FormatValues<double, kMaxDoubleLength>(
+        values, count, fraction_digits, separator, output, capacity);
+  }
+  return FormatValues<double, kMaxFixedDoubleLength>(
+      values, count, fraction_digits, separator, output, capacity);
+}
+
+
+intptr_t NumberText::FormatInt64s(const uint8_t* values,
+                                  intptr_t count,
+                                  uint8_t separator,
+                                  uint8_t* output,
+                                  intptr_t capacity) {
+  return FormatValues<int64_t, kMaxInt64Length>(
+      values, count, -1, separator, output, capacity);
+}
+
+}  // namespace dart
@@ -0,0 +1,89 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef VM_NUMBER_TEXT_H_
+#define VM_NUMBER_TEXT_H_
+
+#include "vm/allocation.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+// Parses and formats the ASCII text of numbers in byte buffers, such as the
+// fields of CSV files, without creating a string for each number. The text
+// of a number is the one of double.parse, int.parse, double.toString,
+// double.toStringAsFixed and int.toString.
+//
+// The values are read from and written to typed data, possibly through a
+// view at any byte offset, so they need not be aligned. The buffers are the
+// raw contents of typed data objects, so the callers must not allow a GC
+// while an operation is in progress.
+class NumberText : AllStatic {
+ public:
+  // Results of ParseDoubles and ParseInt64s that are not a number of values.
+  static const intptr_t kInvalidField = -1;
+  static const intptr_t kTooManyFields = -2;
+
+  // Most bytes written for one value by FormatDoubles and FormatInt64s.
+  static const intptr_t kMaxDoubleLength = 25;
+  static const intptr_t kMaxFixedDoubleLength = 43;
+  static const intptr_t kMaxInt64Length = 20;
+
+  // Parses the fields of the 'length' bytes of 'data' that are separated by
+  // 'separator', and stores the values in 'result', which has room for
+  // 'capacity' values. Whitespace around a field is ignored, and so is a
+  // separator at the end of the data. Data of only whitespace has no
+  // fields.
+  //
+  // Returns the number of values, or kTooManyFields, or kInvalidField, in
+  // which case the offset and length of the field that is not a number are
+  // stored in 'error_offset' and 'error_length'.
+  static intptr_t ParseDoubles(const uint8_t* data,
+                               intptr_t length,
+                               uint8_t separator,
+                               uint8_t* result,
+                               intptr_t capacity,
+                               intptr_t* error_offset,
+                               intptr_t* error_length);
+  static intptr_t ParseInt64s(const uint8_t* data,
+                              intptr_t length,
+                              uint8_t separator,
+                              uint8_t* result,
+                              intptr_t capacity,
+                              intptr_t* error_offset,
+                              intptr_t* error_length);
+
+  // Parses one field, with the syntax of double.parse or int.parse. Returns
+  // false if the field is not a number, or not a 64-bit integer.
+  static bool ParseDouble(const uint8_t* field, intptr_t length, double* value);
+  static bool ParseInt64(const uint8_t* field, intptr_t length, int64_t* value);
+
+  // Writes the 'count' values of 'values' separated by 'separator' to
+  // 'output', which has room for 'capacity' bytes. Doubles are written as
+  // by toStringAsFixed if 'fraction_digits' is not negative, and else as by
+  // toString. Returns the number of bytes written, or -1 if they do not fit.
+  static intptr_t FormatDoubles(const uint8_t* values,
+                                intptr_t count,
+                                intptr_t fraction_digits,
+                                uint8_t separator,
+                                uint8_t* output,
+                                intptr_t capacity);
+  static intptr_t FormatInt64s(const uint8_t* values,
+                               intptr_t count,
+                               uint8_t separator,
+                               uint8_t* output,
+                               intptr_t capacity);
+
+  // Writes one value to 'buffer', which has room for the maximal length,
+  // and returns the number of bytes written.
+  static intptr_t FormatDouble(double value, uint8_t* buffer);
+  static intptr_t FormatFixedDouble(double value,
+                                    intptr_t fraction_digits,
+                                    uint8_t* buffer);
+  static intptr_t FormatInt64(int64_t value, uint8_t* buffer);
+};
+
+}  // namespace dart
+
+#endif  // VM_NUMBER_TEXT_H_
@@ -0,0 +1,288 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/assert.h"
+#include "vm/benchmark_test.h"
+#include "vm/double_conversion.h"
+#include "vm/number_text.h"
+#include "vm/os.h"
+#include "vm/timer.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static intptr_t ParseDoubles(const char* text,
+                             double* result,
+                             intptr_t capacity,
+                             intptr_t* error_offset = NULL) {
+  intptr_t offset = -1;
+  intptr_t length = -1;
+  const intptr_t count = NumberText::ParseDoubles(
+      reinterpret_cast<const uint8_t*>(text), strlen(text), ',',
+      reinterpret_cast<uint8_t*>(result), capacity, &offset, &length);
+  if (error_offset != NULL) {
+    *error_offset = offset;
+  }
+  return count;
+}
+
+
+static bool ParseDouble(const char* text, double* value) {
+  return NumberText::ParseDouble(
+      reinterpret_cast<const uint8_t*>(text), strlen(text), value);
+}
+
+
+static bool ParseInt64(const char* text, int64_t* value) {
+  return NumberText::ParseInt64(
+      reinterpret_cast<const uint8_t*>(text), strlen(text), value);
+}
+
+
+TEST_CASE(NumberText_ParseDouble) {
+  double value;
+  EXPECT(ParseDouble("0", &value));
+  EXPECT_EQ(0.0, value);
+  EXPECT(!signbit(value));
+  EXPECT(ParseDouble("-0", &value));
+  EXPECT(signbit(value));
+  EXPECT(ParseDouble("-12.5e-1", &value));
+  EXPECT_EQ(-1.25, value);
+  EXPECT(ParseDouble(".5", &value));
+  EXPECT_EQ(0.5, value);
+  EXPECT(ParseDouble("1E+2", &value));
+  EXPECT_EQ(100.0, value);
+  EXPECT(ParseDouble("0.1", &value));
+  EXPECT_EQ(0.1, value);
+  EXPECT(ParseDouble("9007199254740993", &value));
+  EXPECT_EQ(9007199254740992.0, value);
+  EXPECT(ParseDouble("123456789012345678901234567890", &value));
+  EXPECT_EQ(1.2345678901234568e29, value);
+  EXPECT(ParseDouble("1e400", &value));
+  EXPECT(isinf(value));
+  EXPECT(ParseDouble("-Infinity", &value));
+  EXPECT(isinf(value) && (value < 0));
+  EXPECT(ParseDouble("NaN", &value));
+  EXPECT(isnan(value));
+
+  // Texts that double.parse rejects.
+  EXPECT(!ParseDouble("", &value));
+  EXPECT(!ParseDouble("-", &value));
+  EXPECT(!ParseDouble(".", &value));
+  EXPECT(!ParseDouble("5.", &value));
+  EXPECT(!ParseDouble("+5", &value));
+  EXPECT(!ParseDouble("1e", &value));
+  EXPECT(!ParseDouble("0x10", &value));
+  EXPECT(!ParseDouble("1 2", &value));
+  EXPECT(!ParseDouble("infinity", &value));
+}
+
+
+TEST_CASE(NumberText_ParseInt64) {
+  int64_t value;
+  EXPECT(ParseInt64("007", &value));
+  EXPECT_EQ(7, value);
+  EXPECT(ParseInt64("-0x7fFF", &value));
+  EXPECT_EQ(-0x7FFF, value);
+  EXPECT(ParseInt64("12345678901234567", &value));
+  EXPECT_EQ(DART_INT64_C(12345678901234567), value);
+  EXPECT(ParseInt64("9223372036854775807", &value));
+  EXPECT_EQ(kMaxInt64, value);
+  EXPECT(ParseInt64("-9223372036854775808", &value));
+  EXPECT_EQ(kMinInt64, value);
+  EXPECT(ParseInt64("-0x8000000000000000", &value));
+  EXPECT_EQ(kMinInt64, value);
+  EXPECT(!ParseInt64("9223372036854775808", &value));
+  EXPECT(!ParseInt64("18446744073709551616", &value));
+  EXPECT(!ParseInt64("0x10000000000000000", &value));
+  EXPECT(!ParseInt64("1.0", &value));
+  EXPECT(!ParseInt64("0x", &value));
+  EXPECT(!ParseInt64("", &value));
+}
+
+
+TEST_CASE(NumberText_ParseFields) {
+  double result[4];
+  EXPECT_EQ(3, ParseDoubles(" 1,\t-2.5 ,3e2\r\n", result, 4));
+  EXPECT_EQ(1.0, result[0]);
+  EXPECT_EQ(-2.5, result[1]);
+  EXPECT_EQ(300.0, result[2]);
+  // A separator after the last field is ignored, and whitespace has no
+  // fields.
+  EXPECT_EQ(2, ParseDoubles("1,2,\n", result, 4));
+  EXPECT_EQ(0, ParseDoubles(" \n", result, 4));
+  EXPECT_EQ(0, ParseDoubles("", result, 4));
+
+  intptr_t error_offset;
+  EXPECT_EQ(NumberText::kInvalidField,
+            ParseDoubles("1, 2x ,3", result, 4, &error_offset));
+  EXPECT_EQ(3, error_offset);
+  EXPECT_EQ(NumberText::kInvalidField,
+            ParseDoubles("1,,3", result, 4, &error_offset));
+  EXPECT_EQ(2, error_offset);
+  EXPECT_EQ(NumberText::kInvalidField,
+            ParseDoubles(",", result, 4, &error_offset));
+  EXPECT_EQ(0, error_offset);
+  EXPECT_EQ(NumberText::kTooManyFields, ParseDoubles("1,2,3", result, 2));
+
+  // Long data is searched for separators in blocks, and the values are
+  // stored at any alignment.
+  const intptr_t kCount = 100;
+  char text[kCount * 8];
+  char* p = text;
+  for (intptr_t i = 0; i < kCount; i++) {
+    p += OS::SNPrint(p, 8, (i == 0) ? "%"Pd : ",%"Pd, i * (i % 7));
+  }
+  uint8_t values[kCount * sizeof(int64_t) + 1];
+  intptr_t error_length;
+  EXPECT_EQ(kCount, NumberText::ParseInt64s(
+      reinterpret_cast<uint8_t*>(text), p - text, ',', values + 1, kCount,
+      &error_offset, &error_length));
+  for (intptr_t i = 0; i < kCount; i++) {
+    int64_t value;
+    memmove(&value, values + 1 + i * sizeof(value), sizeof(value));
+    EXPECT_EQ(i * (i % 7), value);
+  }
+}
+
+
+TEST_CASE(NumberText_Format) {
+  const double doubles[] = {
+    0.0, -0.0, 1.0, -2.5, 0.1, 1e21, 1.5e-7, 123456789012.0, NAN, -INFINITY,
+  };
+  const intptr_t kNumDoubles = ARRAY_SIZE(doubles);
+  uint8_t output[256];
+  intptr_t length = NumberText::FormatDoubles(
+      reinterpret_cast<const uint8_t*>(doubles), kNumDoubles, -1, ';',
+      output, sizeof(output));
+  const char* expected =
+      "0.0;-0.0;1.0;-2.5;0.1;1e+21;1.5e-7;123456789012.0;NaN;-Infinity";
+  EXPECT_EQ(static_cast<intptr_t>(strlen(expected)), length);
+  EXPECT(memcmp(expected, output, length) == 0);
+
+  length = NumberText::FormatDoubles(
+      reinterpret_cast<const uint8_t*>(doubles), kNumDoubles, 2, ';',
+      output, sizeof(output));
+  expected =
+      "0.00;-0.00;1.00;-2.50;0.10;1e+21;0.00;123456789012.00;NaN;-Infinity";
+  EXPECT_EQ(static_cast<intptr_t>(strlen(expected)), length);
+  EXPECT(memcmp(expected, output, length) == 0);
+
+  const int64_t ints[] = { 0, -7, 100, kMaxInt64, kMinInt64 };
+  length = NumberText::FormatInt64s(
+      reinterpret_cast<const uint8_t*>(ints), ARRAY_SIZE(ints), ',',
+      output, sizeof(output));
+  expected = "0,-7,100,9223372036854775807,-9223372036854775808";
+  EXPECT_EQ(static_cast<intptr_t>(strlen(expected)), length);
+  EXPECT(memcmp(expected, output, length) == 0);
+
+  // The text must fit exactly, and nothing is written after the capacity.
+  const intptr_t capacity = strlen(expected);
+  output[capacity - 1] = 0;
+  output[capacity] = 0;
+  EXPECT_EQ(capacity, NumberText::FormatInt64s(
+      reinterpret_cast<const uint8_t*>(ints), ARRAY_SIZE(ints), ',',
+      output, capacity));
+  EXPECT_EQ('8', output[capacity - 1]);
+  EXPECT_EQ(0, output[capacity]);
+  EXPECT_EQ(-1, NumberText::FormatInt64s(
+      reinterpret_cast<const uint8_t*>(ints), ARRAY_SIZE(ints), ',',
+      output, capacity - 1));
+  EXPECT_EQ(0, output[capacity]);
+}
+
+
+// Parses a column of 64K doubles of a few digits, as found in CSV files,
+// field by field and in bulk.
+static const intptr_t kNumBenchmarkValues = 64 * KB;
+
+
+static char* NewBenchmarkText(intptr_t* length) {
+  char* text = new char[kNumBenchmarkValues * 16];
+  char* p = text;
+  for (intptr_t i = 0; i < kNumBenchmarkValues; i++) {
+    p += OS::SNPrint(p, 16, "%"Pd".%02"Pd"\n", i % 10000, i % 100);
+  }
+  *length = p - text;
+  return text;
+}
+
+
+BENCHMARK(NumberTextParseDoublesByField) {
+  const intptr_t kNumIterations = 20;
+  intptr_t length;
+  char* text = NewBenchmarkText(&length);
+  double* values = new double[kNumBenchmarkValues];
+  intptr_t count = 0;
+  Timer timer(true, "NumberTextParseDoublesByField benchmark");
+  timer.Start();
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    count = 0;
+    const char* field = text;
+    while (field < text + length) {
+      const char* end = strchr(field, '\n');
+      if (!CStringToDouble(field, end - field, &values[count])) {
+        break;
+      }
+      count++;
+      field = end + 1;
+    }
+  }
+  timer.Stop();
+  EXPECT_EQ(kNumBenchmarkValues, count);
+  delete[] values;
+  delete[] text;
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+
+BENCHMARK(NumberTextParseDoublesInBulk) {
+  const intptr_t kNumIterations = 20;
+  intptr_t length;
+  char* text = NewBenchmarkText(&length);
+  double* values = new double[kNumBenchmarkValues];
+  intptr_t count = 0;
+  Timer timer(true, "NumberTextParseDoublesInBulk benchmark");
+  timer.Start();
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    intptr_t error_offset;
+    intptr_t error_length;
+    count = NumberText::ParseDoubles(
+        reinterpret_cast<const uint8_t*>(text), length, '\n',
+        reinterpret_cast<uint8_t*>(values), kNumBenchmarkValues,
+        &error_offset, &error_length);
+  }
+  timer.Stop();
+  EXPECT_EQ(kNumBenchmarkValues, count);
+  delete[] values;
+  delete[] text;
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+
+BENCHMARK(NumberTextFormatDoubles) {
+  const intptr_t kNumIterations = 20;
+  double* values = new double[kNumBenchmarkValues];
+  for (intptr_t i = 0; i < kNumBenchmarkValues; i++) {
+    values[i] = (i % 10000) + (i % 100) / 100.0;
+  }
+  const intptr_t capacity =
+      kNumBenchmarkValues * (NumberText::kMaxFixedDoubleLength + 1);
+  uint8_t* output = new uint8_t[capacity];
+  intptr_t length = 0;
+  Timer timer(true, "NumberTextFormatDoubles benchmark");
+  timer.Start();
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    length = NumberText::FormatDoubles(
+        reinterpret_cast<const uint8_t*>(values), kNumBenchmarkValues, 2,
+        '\n', output, capacity);
+  }
+  timer.Stop();
+  EXPECT(length > 0);
+  delete[] output;
+  delete[] values;
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+}  // namespace dart
@@ -31,6 +31,8 @@
 #include "vm/runtime_entry.h"
 #include "vm/scopes.h"
 #include "vm/stack_frame.h"
+#include "vm/string_hasher.h"
+#include "vm/string_search.h"
 #include "vm/symbols.h"
 #include "vm/timer.h"
 #include "vm/unicode.h"
@@ -6976,6 +6978,7 @@ const char* PcDescriptors::KindAsStr(intptr_t index) const {
     case PcDescriptors::kIcCall:        return "ic-call      ";
     case PcDescriptors::kFuncCall:      return "fn-call      ";
     case PcDescriptors::kReturn:        return "return       ";
+    case PcDescriptors::kOsrEntry:      return "osr-entry    ";
     case PcDescriptors::kOther:         return "other        ";
   }
   UNREACHABLE();
@@ -7804,6 +7807,18 @@ uword Code::GetPcForDeoptId(intptr_t deopt_id, PcDescriptors::Kind kind) const {
 }
 
 
+intptr_t Code::GetDeoptIdForOsr(uword pc) const {
+  const PcDescriptors& descriptors = PcDescriptors::Handle(pc_descriptors());
+  for (intptr_t i = 0; i < descriptors.Length(); ++i) {
+    if ((descriptors.PC(i) == pc) &&
+        (descriptors.DescriptorKind(i) == PcDescriptors::kOsrEntry)) {
+      return descriptors.DeoptId(i);
+    }
+  }
+  return Isolate::kNoDeoptId;
+}
+
+
 const char* Code::ToCString() const {
   const char* kFormat = "Code entry:%p";
   intptr_t len = OS::SNPrint(NULL, 0, kFormat, EntryPoint()) + 1;
@@ -8285,6 +8300,16 @@ intptr_t ICData::GetCountAt(intptr_t index) const {
 }
 
 
+void ICData::SetCountAt(intptr_t index, intptr_t value) const {
+  ASSERT(index < NumberOfChecks());
+  ASSERT((value >= 0) && Smi::IsValid(value));
+  const Array& data = Array::Handle(ic_data());
+  const intptr_t data_pos = index * TestEntryLength() +
+      CountIndexFor(num_args_tested());
+  data.SetAt(data_pos, Smi::Handle(Smi::New(value)));
+}
+
+
 intptr_t ICData::AggregateCount() const {
   const intptr_t len = NumberOfChecks();
   intptr_t count = 0;
@@ -10898,77 +10923,46 @@ const char* Bigint::ToCString() const {
 }
 
 
-// Synchronize with implementation in compiler (intrinsifier).
-class StringHasher : ValueObject {
- public:
-  StringHasher() : hash_(0) {}
-  void Add(int32_t ch) {
-    hash_ += ch;
-    hash_ += hash_ << 10;
-    hash_ ^= hash_ >> 6;
-  }
-  // Return a non-zero hash of at most 'bits' bits.
-  intptr_t Finalize(int bits) {
-    ASSERT(1 <= bits && bits <= (kBitsPerWord - 1));
-    hash_ += hash_ << 3;
-    hash_ ^= hash_ >> 11;
-    hash_ += hash_ << 15;
-    hash_ = hash_ & ((static_cast<intptr_t>(1) << bits) - 1);
-    ASSERT(hash_ <= static_cast<uint32_t>(kMaxInt32));
-    return hash_ == 0 ? 1 : hash_;
-  }
- private:
-  uint32_t hash_;
-};
-
-
 intptr_t String::Hash(const String& str, intptr_t begin_index, intptr_t len) {
   ASSERT(begin_index >= 0);
   ASSERT(len >= 0);
   ASSERT((begin_index + len) <= str.Length());
   StringHasher hasher;
-  if (str.IsOneByteString()) {
-    for (intptr_t i = 0; i < len; i++) {
-      hasher.Add(*OneByteString::CharAddr(str, i + begin_index));
-    }
-  } else {
-    CodePointIterator it(str, begin_index, len);
-    while (it.Next()) {
-      hasher.Add(it.Current());
+  if (len > 0) {
+    NoGCScope no_gc;
+    if (str.CharSize() == kOneByteChar) {
+      hasher.AddAll(Latin1Chars(str) + begin_index, len);
+    } else {
+      hasher.AddAll(UTF16Chars(str) + begin_index, len);
     }
   }
   return hasher.Finalize(String::kHashBits);
 }
 
 
-template<typename T>
-static intptr_t HashImpl(const T* characters, intptr_t len) {
+intptr_t String::Hash(const uint8_t* characters, intptr_t len) {
   ASSERT(len >= 0);
   StringHasher hasher;
-  for (intptr_t i = 0; i < len; i++) {
-    hasher.Add(characters[i]);
-  }
+  hasher.AddAll(characters, len);
   return hasher.Finalize(String::kHashBits);
 }
 
 
-intptr_t String::Hash(const uint8_t* characters, intptr_t len) {
-  return HashImpl(characters, len);
-}
-
-
 intptr_t String::Hash(const uint16_t* characters, intptr_t len) {
+  ASSERT(len >= 0);
   StringHasher hasher;
-  intptr_t i = 0;
-  while (i < len) {
-    hasher.Add(Utf16::Next(characters, &i, len));
-  }
+  hasher.AddAll(characters, len);
   return hasher.Finalize(String::kHashBits);
 }
 
 
 intptr_t String::Hash(const int32_t* characters, intptr_t len) {
-  return HashImpl(characters, len);
+  ASSERT(len >= 0);
+  StringHasher hasher;
+  for (intptr_t i = 0; i < len; i++) {
+    hasher.AddCodePoint(characters[i]);
+  }
+  return hasher.Finalize(String::kHashBits);
 }
 
 
@@ -11030,6 +11024,27 @@ bool String::Equals(const Instance& other) const {
 }
 
 
+bool String::Equals(const String& str,
+                    intptr_t begin_index,
+                    intptr_t len) const {
+  ASSERT(begin_index >= 0);
+  ASSERT((begin_index == 0) || (begin_index < str.Length()));
+  ASSERT(len >= 0);
+  ASSERT(len <= str.Length());
+  if (len != this->Length()) {
+    return false;  // Lengths don't match.
+  }
+  if (len == 0) {
+    return true;
+  }
+  NoGCScope no_gc;
+  if (str.CharSize() == kOneByteChar) {
+    return Equals(Latin1Chars(str) + begin_index, len);
+  }
+  return Equals(UTF16Chars(str) + begin_index, len);
+}
+
+
 bool String::Equals(const char* cstr) const {
   ASSERT(cstr != NULL);
   CodePointIterator it(*this);
@@ -11058,13 +11073,14 @@ bool String::Equals(const uint8_t* latin1_array, intptr_t len) const {
     // Lengths don't match.
     return false;
   }
-
-  for (intptr_t i = 0; i < len; i++) {
-    if (this->CharAt(i) != latin1_array[i]) {
-      return false;
-    }
+  if (len == 0) {
+    return true;
   }
-  return true;
+  NoGCScope no_gc;
+  if (CharSize() == kOneByteChar) {
+    return StringSearch::Equals(Latin1Chars(*this), latin1_array, len);
+  }
+  return StringSearch::Equals(latin1_array, UTF16Chars(*this), len);
 }
 
 
@@ -11073,13 +11089,14 @@ bool String::Equals(const uint16_t* utf16_array, intptr_t len) const {
     // Lengths don't match.
     return false;
   }
-
-  for (intptr_t i = 0; i < len; i++) {
-    if (this->CharAt(i) != utf16_array[i]) {
-      return false;
-    }
+  if (len == 0) {
+    return true;
   }
-  return true;
+  NoGCScope no_gc;
+  if (CharSize() == kOneByteChar) {
+    return StringSearch::Equals(Latin1Chars(*this), utf16_array, len);
+  }
+  return StringSearch::Equals(UTF16Chars(*this), utf16_array, len);
 }
 
 
@@ -11134,6 +11151,84 @@ bool String::StartsWith(const String& other) const {
 }
 
 
+intptr_t String::IndexOf(const String& str,
+                         const String& pattern,
+                         intptr_t start) {
+  const intptr_t str_len = str.Length();
+  const intptr_t pattern_len = pattern.Length();
+  ASSERT((start >= 0) && (start <= str_len));
+  if (pattern_len == 0) {
+    return start;
+  }
+  const intptr_t len = str_len - start;
+  if (pattern_len > len) {
+    return -1;
+  }
+  const bool is_one_byte = (str.CharSize() == kOneByteChar);
+  if (is_one_byte == (pattern.CharSize() == kOneByteChar)) {
+    NoGCScope no_gc;
+    const intptr_t index = is_one_byte ?
+        StringSearch::IndexOf(Latin1Chars(str) + start, len,
+                              Latin1Chars(pattern), pattern_len) :
+        StringSearch::IndexOf(UTF16Chars(str) + start, len,
+                              UTF16Chars(pattern), pattern_len);
+    return (index < 0) ? -1 : (start + index);
+  }
+  // Compare the pattern at every position if the strings have different
+  // character sizes.
+  const intptr_t last_start = str_len - pattern_len;
+  for (intptr_t i = start; i <= last_start; i++) {
+    if (pattern.Equals(str, i, pattern_len)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+intptr_t String::IndexOfCodeUnit(const String& str,
+                                 int32_t code_unit,
+                                 intptr_t start) {
+  const intptr_t str_len = str.Length();
+  ASSERT((start >= 0) && (start <= str_len));
+  ASSERT((code_unit >= 0) && (code_unit <= 0xFFFF));
+  if (start == str_len) {
+    return -1;
+  }
+  NoGCScope no_gc;
+  intptr_t index;
+  if (str.CharSize() == kOneByteChar) {
+    if (!Utf::IsLatin1(code_unit)) {
+      return -1;
+    }
+    index = StringSearch::IndexOf(Latin1Chars(str) + start,
+                                  str_len - start,
+                                  static_cast<uint8_t>(code_unit));
+  } else {
+    index = StringSearch::IndexOf(UTF16Chars(str) + start,
+                                  str_len - start,
+                                  static_cast<uint16_t>(code_unit));
+  }
+  return (index < 0) ? -1 : (start + index);
+}
+
+
+const uint8_t* String::Latin1Chars(const String& str) {
+  if (str.IsOneByteString()) {
+    return OneByteString::CharAddr(str, 0);
+  }
+  return ExternalOneByteString::CharAddr(str, 0);
+}
+
+
+const uint16_t* String::UTF16Chars(const String& str) {
+  if (str.IsTwoByteString()) {
+    return TwoByteString::CharAddr(str, 0);
+  }
+  return ExternalTwoByteString::CharAddr(str, 0);
+}
+
+
 RawInstance* String::Canonicalize() const {
   if (IsCanonical()) {
     return this->raw();
@@ -11150,6 +11245,12 @@ RawString* String::New(const char* cstr, Heap::Space space) {
 }
 
 
+// Strings decoded from UTF-8 up to this length get their hash computed while
+// their characters are in the cache. They are typically names and keys that
+// are used in lookups soon after.
+static const intptr_t kEagerHashMaxLength = 64;
+
+
 RawString* String::FromUTF8(const uint8_t* utf8_array,
                             intptr_t array_len,
                             Heap::Space space) {
@@ -11159,16 +11260,22 @@ RawString* String::FromUTF8(const uint8_t* utf8_array,
     const String& strobj = String::Handle(OneByteString::New(len, space));
     if (len > 0) {
       NoGCScope no_gc;
-      Utf8::DecodeToLatin1(utf8_array, array_len,
-                           OneByteString::CharAddr(strobj, 0), len);
+      uint8_t* characters = OneByteString::CharAddr(strobj, 0);
+      Utf8::DecodeToLatin1(utf8_array, array_len, characters, len);
+      if (len <= kEagerHashMaxLength) {
+        strobj.SetHash(Hash(characters, len));
+      }
     }
     return strobj.raw();
   }
   ASSERT((type == Utf8::kBMP) || (type == Utf8::kSupplementary));
   const String& strobj = String::Handle(TwoByteString::New(len, space));
   NoGCScope no_gc;
-  Utf8::DecodeToUTF16(utf8_array, array_len,
-                      TwoByteString::CharAddr(strobj, 0), len);
+  uint16_t* characters = TwoByteString::CharAddr(strobj, 0);
+  Utf8::DecodeToUTF16(utf8_array, array_len, characters, len);
+  if (len <= kEagerHashMaxLength) {
+    strobj.SetHash(Hash(characters, len));
+  }
   return strobj.raw();
 }
 
@@ -11183,14 +11290,7 @@ RawString* String::FromLatin1(const uint8_t* latin1_array,
 RawString* String::FromUTF16(const uint16_t* utf16_array,
                              intptr_t array_len,
                              Heap::Space space) {
-  bool is_one_byte_string = true;
-  for (intptr_t i = 0; i < array_len; ++i) {
-    if (!Utf::IsLatin1(utf16_array[i])) {
-      is_one_byte_string = false;
-      break;
-    }
-  }
-  if (is_one_byte_string) {
+  if (StringSearch::IsLatin1(utf16_array, array_len)) {
     return OneByteString::New(utf16_array, array_len, space);
   }
   return TwoByteString::New(utf16_array, array_len, space);
@@ -11268,8 +11368,12 @@ void String::Copy(const String& dst, intptr_t dst_offset,
               len);
     }
   } else if (dst.IsTwoByteString()) {
-    for (intptr_t i = 0; i < len; ++i) {
-      *TwoByteString::CharAddr(dst, i + dst_offset) = characters[i];
+    NoGCScope no_gc;
+    if (len > 0) {
+      uint16_t* dst_chars = TwoByteString::CharAddr(dst, dst_offset);
+      for (intptr_t i = 0; i < len; ++i) {
+        dst_chars[i] = characters[i];
+      }
     }
   }
 }
@@ -11393,20 +11497,29 @@ RawString* String::Concat(const String& str1,
 RawString* String::ConcatAll(const Array& strings,
                              Heap::Space space) {
   ASSERT(!strings.IsNull());
+  return ConcatAllRange(strings, 0, strings.Length(), space);
+}
+
+
+RawString* String::ConcatAllRange(const Array& strings,
+                                  intptr_t start,
+                                  intptr_t end,
+                                  Heap::Space space) {
+  ASSERT(!strings.IsNull());
+  ASSERT((start >= 0) && (start <= end) && (end <= strings.Length()));
   intptr_t result_len = 0;
-  intptr_t strings_len = strings.Length();
   String& str = String::Handle();
   intptr_t char_size = kOneByteChar;
-  for (intptr_t i = 0; i < strings_len; i++) {
+  for (intptr_t i = start; i < end; i++) {
     str ^= strings.At(i);
     result_len += str.Length();
     char_size = Utils::Maximum(char_size, str.CharSize());
   }
   if (char_size == kOneByteChar) {
-    return OneByteString::ConcatAll(strings, result_len, space);
+    return OneByteString::ConcatAll(strings, start, end, result_len, space);
   }
   ASSERT(char_size == kTwoByteChar);
-  return TwoByteString::ConcatAll(strings, result_len, space);
+  return TwoByteString::ConcatAll(strings, start, end, result_len, space);
 }
 
 
@@ -11494,6 +11607,47 @@ void String::ToUTF8(uint8_t* utf8_array, intptr_t array_len) const {
 }
 
 
+void String::ToLatin1(uint8_t* latin1_array, intptr_t array_len) const {
+  ASSERT(array_len >= Length());
+  if (Length() == 0) {
+    return;
+  }
+  NoGCScope no_gc;
+  if (IsOneByteString()) {
+    memmove(latin1_array, OneByteString::CharAddr(*this, 0), Length());
+  } else {
+    ASSERT(IsExternalOneByteString());
+    memmove(latin1_array, ExternalOneByteString::CharAddr(*this, 0), Length());
+  }
+}
+
+
+void String::ToUTF16(uint16_t* utf16_array, intptr_t array_len) const {
+  ASSERT(array_len >= Length());
+  const intptr_t len = Length();
+  if (len == 0) {
+    return;
+  }
+  NoGCScope no_gc;
+  if (IsTwoByteString()) {
+    memmove(utf16_array,
+            TwoByteString::CharAddr(*this, 0),
+            len * sizeof(*utf16_array));
+  } else if (IsExternalTwoByteString()) {
+    memmove(utf16_array,
+            ExternalTwoByteString::CharAddr(*this, 0),
+            len * sizeof(*utf16_array));
+  } else {
+    const uint8_t* latin1_array = IsOneByteString() ?
+        OneByteString::CharAddr(*this, 0) :
+        ExternalOneByteString::CharAddr(*this, 0);
+    for (intptr_t i = 0; i < len; i++) {
+      utf16_array[i] = latin1_array[i];
+    }
+  }
+}
+
+
 static FinalizablePersistentHandle* AddFinalizer(
     const Object& referent,
     void* peer,
@@ -11609,14 +11763,58 @@ RawString* String::Transform(int32_t (*mapping)(int32_t ch),
 }
 
 
+RawString* String::TransformAscii(bool to_upper,
+                                  const String& str,
+                                  Heap::Space space) {
+  ASSERT(str.CharSize() == kOneByteChar);
+  const intptr_t len = str.Length();
+  if (len == 0) {
+    return str.raw();
+  }
+  {
+    NoGCScope no_gc;
+    const uint8_t* chars = Latin1Chars(str);
+    if (!StringSearch::IsAscii(chars, len)) {
+      return String::null();
+    }
+    const uint8_t first_letter = to_upper ? 'a' : 'A';
+    const uint8_t last_letter = to_upper ? 'z' : 'Z';
+    if (StringSearch::IndexOfRange(chars, len, first_letter, last_letter) < 0) {
+      return str.raw();  // No letter changes case.
+    }
+  }
+  const String& result = String::Handle(OneByteString::New(len, space));
+  NoGCScope no_gc;
+  uint8_t* dst = OneByteString::CharAddr(result, 0);
+  if (to_upper) {
+    StringSearch::ToUpperAscii(Latin1Chars(str), dst, len);
+  } else {
+    StringSearch::ToLowerAscii(Latin1Chars(str), dst, len);
+  }
+  return result.raw();
+}
+
+
 RawString* String::ToUpperCase(const String& str, Heap::Space space) {
-  // TODO(cshapiro): create a fast-path for OneByteString instances.
+  if (str.CharSize() == kOneByteChar) {
+    const String& result =
+        String::Handle(TransformAscii(true, str, space));
+    if (!result.IsNull()) {
+      return result.raw();
+    }
+  }
   return Transform(CaseMapping::ToUpper, str, space);
 }
 
 
 RawString* String::ToLowerCase(const String& str, Heap::Space space) {
-  // TODO(cshapiro): create a fast-path for OneByteString instances.
+  if (str.CharSize() == kOneByteChar) {
+    const String& result =
+        String::Handle(TransformAscii(false, str, space));
+    if (!result.IsNull()) {
+      return result.raw();
+    }
+  }
   return Transform(CaseMapping::ToLower, str, space);
 }
 
@@ -11863,13 +12061,14 @@ RawOneByteString* OneByteString::Concat(const String& str1,
 
 
 RawOneByteString* OneByteString::ConcatAll(const Array& strings,
+                                           intptr_t start,
+                                           intptr_t end,
                                            intptr_t len,
                                            Heap::Space space) {
   const String& result = String::Handle(OneByteString::New(len, space));
   String& str = String::Handle();
-  intptr_t strings_len = strings.Length();
   intptr_t pos = 0;
-  for (intptr_t i = 0; i < strings_len; i++) {
+  for (intptr_t i = start; i < end; i++) {
     str ^= strings.At(i);
     intptr_t str_len = str.Length();
     String::Copy(result, pos, str, 0, str_len);
@@ -12026,13 +12225,14 @@ RawTwoByteString* TwoByteString::Concat(const String& str1,
 
 
 RawTwoByteString* TwoByteString::ConcatAll(const Array& strings,
+                                           intptr_t start,
+                                           intptr_t end,
                                            intptr_t len,
                                            Heap::Space space) {
   const String& result = String::Handle(TwoByteString::New(len, space));
   String& str = String::Handle();
-  intptr_t strings_len = strings.Length();
   intptr_t pos = 0;
-  for (intptr_t i = 0; i < strings_len; i++) {
+  for (intptr_t i = start; i < end; i++) {
     str ^= strings.At(i);
     intptr_t str_len = str.Length();
     String::Copy(result, pos, str, 0, str_len);
@@ -2021,6 +2021,7 @@ class Script : public Object {
 
   FINAL_HEAP_OBJECT_IMPLEMENTATION(Script, Object);
   friend class Class;
+  friend class ScanQueue;
 };
 
 
@@ -2400,6 +2401,7 @@ class PcDescriptors : public Object {
     kIcCall,           // IC call.
     kFuncCall,         // Call to known target, e.g. static call, closure call.
     kReturn,           // Return from function.
+    kOsrEntry,         // OSR entry point in unoptimized code.
     kOther
   };
 
@@ -2811,6 +2813,10 @@ class Code : public Object {
 
   uword GetPcForDeoptId(intptr_t deopt_id, PcDescriptors::Kind kind) const;
 
+  // Returns the deopt id of the loop stack check whose OSR entry is pc, or
+  // Isolate::kNoDeoptId if pc is not an OSR entry.
+  intptr_t GetDeoptIdForOsr(uword pc) const;
+
   // Returns true if there is an object in the code between 'start_offset'
   // (inclusive) and 'end_offset' (exclusive).
   bool ObjectExistsInArea(intptr_t start_offest, intptr_t end_offset) const;
@@ -3096,6 +3102,7 @@ class ICData : public Object {
   RawFunction* GetTargetForReceiverClassId(intptr_t class_id) const;
 
   intptr_t GetCountAt(intptr_t index) const;
+  void SetCountAt(intptr_t index, intptr_t value) const;
   intptr_t AggregateCount() const;
 
   // Returns this->raw() if num_args_tested == 1 and arg_nr == 1, otherwise
@@ -4202,9 +4209,9 @@ class String : public Instance {
   intptr_t CharSize() const;
 
   inline bool Equals(const String& str) const;
-  inline bool Equals(const String& str,
-                     intptr_t begin_index,  // begin index on 'str'.
-                     intptr_t len) const;  // len on 'str'.
+  bool Equals(const String& str,
+              intptr_t begin_index,  // begin index on 'str'.
+              intptr_t len) const;  // len on 'str'.
 
   // Compares to a '\0' terminated array of UTF-8 encoded characters.
   bool Equals(const char* cstr) const;
@@ -4224,6 +4231,18 @@ class String : public Instance {
 
   bool StartsWith(const String& other) const;
 
+  // Returns the index of the first occurrence of 'pattern' in 'str' at or
+  // after 'start', or -1 if there is none.
+  static intptr_t IndexOf(const String& str,
+                          const String& pattern,
+                          intptr_t start);
+
+  // Returns the index of the first occurrence of the UTF-16 code unit
+  // 'code_unit' in 'str' at or after 'start', or -1 if there is none.
+  static intptr_t IndexOfCodeUnit(const String& str,
+                                  int32_t code_unit,
+                                  intptr_t start);
+
   virtual RawInstance* Canonicalize() const;
 
   bool IsSymbol() const { return raw()->IsCanonical(); }
@@ -4252,6 +4271,12 @@ class String : public Instance {
 
   void ToUTF8(uint8_t* utf8_array, intptr_t array_len) const;
 
+  // Copies the characters of a one byte string into 'latin1_array'.
+  void ToLatin1(uint8_t* latin1_array, intptr_t array_len) const;
+
+  // Copies the UTF-16 code units of the string into 'utf16_array'.
+  void ToUTF16(uint16_t* utf16_array, intptr_t array_len) const;
+
   // Copies the string characters into the provided external array
   // and morphs the string object into an external string object.
   // The remaining unused part of the original string object is marked as
@@ -4328,6 +4353,11 @@ class String : public Instance {
                            Heap::Space space = Heap::kNew);
   static RawString* ConcatAll(const Array& strings,
                               Heap::Space space = Heap::kNew);
+  // Concatenates the strings at the indices ['start', 'end') of 'strings'.
+  static RawString* ConcatAllRange(const Array& strings,
+                                   intptr_t start,
+                                   intptr_t end,
+                                   Heap::Space space = Heap::kNew);
 
   static RawString* SubString(const String& str,
                               intptr_t begin_index,
@@ -4353,6 +4383,12 @@ class String : public Instance {
       PRINTF_ATTRIBUTE(1, 2);
   static RawString* NewFormattedV(const char* format, va_list args);
 
+  // Returns the address of the first character of a non-empty one byte or
+  // two byte string, internal or external. GC must be disallowed while the
+  // characters are accessed.
+  static const uint8_t* Latin1Chars(const String& str);
+  static const uint16_t* UTF16Chars(const String& str);
+
  protected:
   bool HasHash() const {
     ASSERT(Smi::New(0) == NULL);
@@ -4371,6 +4407,12 @@ class String : public Instance {
     raw_ptr()->hash_ = Smi::New(value);
   }
 
+  // Maps the ASCII letters of the one byte string 'str' to upper or lower
+  // case. Returns null if 'str' has characters that are not ASCII.
+  static RawString* TransformAscii(bool to_upper,
+                                   const String& str,
+                                   Heap::Space space);
+
   template<typename HandleType, typename ElementType, typename CallbackType>
   static void ReadFromImpl(SnapshotReader* reader,
                            String* str_obj,
@@ -4445,6 +4487,8 @@ class OneByteString : public AllStatic {
                                   const String& str2,
                                   Heap::Space space);
   static RawOneByteString* ConcatAll(const Array& strings,
+                                     intptr_t start,
+                                     intptr_t end,
                                      intptr_t len,
                                      Heap::Space space);
 
@@ -4534,6 +4578,8 @@ class TwoByteString : public AllStatic {
                                   const String& str2,
                                   Heap::Space space);
   static RawTwoByteString* ConcatAll(const Array& strings,
+                                     intptr_t start,
+                                     intptr_t end,
                                      intptr_t len,
                                      Heap::Space space);
 
@@ -5431,10 +5477,12 @@ class JSRegExp : public Instance {
   // kUninitialized: the type of th regexp has not been initialized yet.
   // kSimple: A simple pattern to match against, using string indexOf operation.
   // kComplex: A complex pattern to match.
+  // kAutomaton: A pattern without backreferences, matched by an automaton.
   enum RegExType {
     kUnitialized = 0,
     kSimple,
     kComplex,
+    kAutomaton,
   };
 
   // Flags are passed to a regex object as follows:
@@ -5449,6 +5497,7 @@ class JSRegExp : public Instance {
   bool is_initialized() const { return (raw_ptr()->type_ != kUnitialized); }
   bool is_simple() const { return (raw_ptr()->type_ == kSimple); }
   bool is_complex() const { return (raw_ptr()->type_ == kComplex); }
+  bool is_automaton() const { return (raw_ptr()->type_ == kAutomaton); }
 
   bool is_global() const { return (raw_ptr()->flags_ & kGlobal); }
   bool is_ignore_case() const { return (raw_ptr()->flags_ & kIgnoreCase); }
@@ -5466,6 +5515,7 @@ class JSRegExp : public Instance {
   void set_is_multi_line() const { raw_ptr()->flags_ |= kMultiLine; }
   void set_is_simple() const { raw_ptr()->type_ = kSimple; }
   void set_is_complex() const { raw_ptr()->type_ = kComplex; }
+  void set_is_automaton() const { raw_ptr()->type_ = kAutomaton; }
 
   void* GetDataStartAddress() const;
   static RawJSRegExp* FromDataStartAddress(void* data);
@@ -5624,25 +5674,6 @@ bool String::Equals(const String& str) const {
 }
 
 
-bool String::Equals(const String& str,
-                    intptr_t begin_index,
-                    intptr_t len) const {
-  ASSERT(begin_index >= 0);
-  ASSERT((begin_index == 0) || (begin_index < str.Length()));
-  ASSERT(len >= 0);
-  ASSERT(len <= str.Length());
-  if (len != this->Length()) {
-    return false;  // Lengths don't match.
-  }
-  for (intptr_t i = 0; i < len; i++) {
-    if (this->CharAt(i) != str.CharAt(begin_index + i)) {
-      return false;
-    }
-  }
-  return true;
-}
-
-
 void MegamorphicCache::SetEntry(const Array& array,
                                 intptr_t index,
                                 const Smi& class_id,
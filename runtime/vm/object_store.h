@@ -351,6 +351,14 @@ class ObjectStore {
     pending_classes_ = value.raw();
   }
 
+  RawGrowableObjectArray* optimization_queue() const {
+    return optimization_queue_;
+  }
+  void set_optimization_queue(const GrowableObjectArray& value) {
+    ASSERT(!value.IsNull());
+    optimization_queue_ = value.raw();
+  }
+
   RawError* sticky_error() const { return sticky_error_; }
   void set_sticky_error(const Error& value) {
     ASSERT(!value.IsNull());
@@ -488,6 +496,7 @@ class ObjectStore {
   RawLibrary* utf_library_;
   RawGrowableObjectArray* libraries_;
   RawGrowableObjectArray* pending_classes_;
+  RawGrowableObjectArray* optimization_queue_;
   RawError* sticky_error_;
   RawString* unhandled_exception_handler_;
   RawContext* empty_context_;
@@ -638,6 +638,53 @@ TEST_CASE(String) {
 }
 
 
+TEST_CASE(StringHash) {
+  // Odd and even lengths exercise both ends of the two code unit words.
+  const char* kTexts[] = { "", "a", "ab", "abc", "Dart's bescht wos je hets" };
+  for (unsigned i = 0; i < ARRAY_SIZE(kTexts); i++) {
+    const intptr_t len = strlen(kTexts[i]);
+    const uint8_t* latin1 = reinterpret_cast<const uint8_t*>(kTexts[i]);
+    uint16_t utf16[32];
+    int32_t utf32[32];
+    for (intptr_t j = 0; j < len; j++) {
+      utf16[j] = latin1[j];
+      utf32[j] = latin1[j];
+    }
+    const String& one_byte = String::Handle(String::New(kTexts[i]));
+    const String& two_byte =
+        String::Handle(TwoByteString::New(utf16, len, Heap::kNew));
+    EXPECT(one_byte.IsOneByteString());
+    EXPECT(two_byte.IsTwoByteString());
+    const intptr_t hash = one_byte.Hash();
+    EXPECT_EQ(hash, two_byte.Hash());
+    EXPECT_EQ(hash, String::Hash(latin1, len));
+    EXPECT_EQ(hash, String::Hash(utf16, len));
+    EXPECT_EQ(hash, String::Hash(utf32, len));
+    if (len > 1) {
+      const String& sub = String::Handle(String::SubString(one_byte, 1));
+      EXPECT_EQ(sub.Hash(), String::Hash(one_byte, 1, len - 1));
+      EXPECT_EQ(sub.Hash(), String::Hash(two_byte, 1, len - 1));
+      EXPECT_NE(hash, sub.Hash());
+    }
+  }
+
+  // Supplementary code points hash as their surrogate pairs.
+  const int32_t utf32[] = { 'x', 0x1F600, 0xE9 };
+  const uint16_t utf16[] = { 'x', 0xD83D, 0xDE00, 0xE9 };
+  const String& str = String::Handle(String::FromUTF32(utf32, 3));
+  EXPECT_EQ(str.Hash(), String::Hash(utf32, 3));
+  EXPECT_EQ(str.Hash(), String::Hash(utf16, 4));
+
+  // Strings decoded from UTF-8 and symbols agree with the computed hash.
+  const uint8_t utf8[] = { 'x', 0xF0, 0x9F, 0x98, 0x80, 0xC3, 0xA9 };
+  const String& decoded = String::Handle(String::FromUTF8(utf8, 7));
+  EXPECT(decoded.Equals(str));
+  EXPECT_EQ(str.Hash(), decoded.Hash());
+  const String& symbol = String::Handle(Symbols::New(decoded));
+  EXPECT_EQ(str.Hash(), symbol.Hash());
+}
+
+
 TEST_CASE(StringFormat) {
   const char* hello_str = "Hello World!";
   const String& str =
@@ -750,6 +797,16 @@ TEST_CASE(StringConcat) {
     EXPECT_EQ(6, str7.Length());
     EXPECT(str7.Equals("oneone"));
     EXPECT(!str7.Equals("oneoneone"));
+
+    // ConcatAllRange
+
+    const String& str8 =
+        String::Handle(String::ConcatAllRange(array3, 1, 3));
+    EXPECT(str8.IsOneByteString());
+    EXPECT(str8.Equals("one"));
+    const String& str9 =
+        String::Handle(String::ConcatAllRange(array3, 2, 2));
+    EXPECT_EQ(0, str9.Length());
   }
 
   // Create a string by concatenating non-empty 1-byte strings.
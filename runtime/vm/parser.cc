@@ -18,6 +18,7 @@
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/resolver.h"
+#include "vm/scan_queue.h"
 #include "vm/scopes.h"
 #include "vm/symbols.h"
 
@@ -44,6 +45,8 @@ DEFINE_FLAG_HANDLER(CheckedModeHandler,
                     checked,
                     "Enable checked mode.");
 
+DECLARE_FLAG(bool, parallel_scan);
+
 #if defined(DEBUG)
 class TraceParser : public ValueObject {
  public:
@@ -4381,10 +4384,40 @@ void Parser::ParseLibraryPart() {
   ExpectSemicolon();
   const String& canon_url = String::CheckedHandle(
       CallLibraryTagHandler(kCanonicalizeUrl, source_pos, url));
+  ScanQueue* parts = Isolate::Current()->scan_queue();
+  if (parts != NULL) {
+    parts->set_token_pos(source_pos);
+  }
   CallLibraryTagHandler(kSourceTag, source_pos, canon_url);
 }
 
 
+// Parses the part directives and returns the position of the token after
+// the last one.
+intptr_t Parser::ParseLibraryParts(intptr_t metadata_pos) {
+  while (CurrentToken() == Token::kPART) {
+    ParseLibraryPart();
+    metadata_pos = TokenPos();
+    SkipMetadata();
+  }
+  return metadata_pos;
+}
+
+
+void Parser::CompileLibraryParts(const ScanQueue& parts) {
+  Script& script = Script::Handle();
+  Error& error = Error::Handle();
+  for (intptr_t i = 0; i < parts.Length(); i++) {
+    script = parts.ScriptAt(i);
+    parts.TokenizeAt(i);
+    error = Compiler::Compile(library_, script);
+    if (!error.IsNull()) {
+      AppendErrorMsg(error, parts.TokenPosAt(i), "library handler failed");
+    }
+  }
+}
+
+
 void Parser::ParseLibraryDefinition() {
   TRACE_PARSER("ParseLibraryDefinition");
 
@@ -4425,10 +4458,14 @@ void Parser::ParseLibraryDefinition() {
         Namespace::New(core_lib, Array::Handle(), Array::Handle()));
     library_.AddImport(core_ns);
   }
-  while (CurrentToken() == Token::kPART) {
-    ParseLibraryPart();
-    metadata_pos = TokenPos();
-    SkipMetadata();
+  if (FLAG_parallel_scan) {
+    // The sources of the parts are scanned in parallel while they are
+    // loaded, the parts are compiled once all of them are loaded.
+    ScanQueue parts(Isolate::Current(), library_);
+    metadata_pos = ParseLibraryParts(metadata_pos);
+    CompileLibraryParts(parts);
+  } else {
+    metadata_pos = ParseLibraryParts(metadata_pos);
   }
   SetPosition(metadata_pos);
 }
@@ -17,6 +17,7 @@ namespace dart {
 
 // Forward declarations.
 class Function;
+class ScanQueue;
 class Script;
 class TokenStream;
 
@@ -348,6 +349,8 @@ class Parser : public ValueObject {
   void ParseLibraryName();
   void ParseLibraryImportExport();
   void ParseLibraryPart();
+  intptr_t ParseLibraryParts(intptr_t metadata_pos);
+  void CompileLibraryParts(const ScanQueue& parts);
   void ParsePartHeader();
   void ParseLibraryNameObsoleteSyntax();
   void ParseLibraryImportObsoleteSyntax();
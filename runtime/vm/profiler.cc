@@ -0,0 +1,689 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/profiler.h"
+
+#include <stdlib.h>
+
+#include "platform/json.h"
+#include "platform/utils.h"
+#include "vm/code_observers.h"
+#include "vm/flags.h"
+#include "vm/growable_array.h"
+#include "vm/isolate.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/thread.h"
+#include "vm/zone.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool, profile, false,
+    "Record the names of generated code for the CPU profiler.");
+DEFINE_FLAG(int, profile_period, 1000,
+    "Time between CPU profiler samples in microseconds.");
+DEFINE_FLAG(int, profile_buffer_size, 8192,
+    "Number of CPU profiler samples kept per isolate.");
+
+Mutex* Profiler::mutex_ = NULL;
+intptr_t Profiler::profiled_isolates_ = 0;
+
+
+SampleBuffer::SampleBuffer(intptr_t capacity)
+    : samples_(reinterpret_cast<Sample*>(calloc(capacity, sizeof(Sample)))),
+      capacity_(capacity),
+      cursor_(0) {
+  ASSERT(capacity > 0);
+  if (samples_ == NULL) {
+    FATAL("failed to allocate profiler sample buffer");
+  }
+}
+
+
+SampleBuffer::~SampleBuffer() {
+  free(samples_);
+}
+
+
+void SampleBuffer::Add(uword pc, uword fp, uword sp, uword stack_upper) {
+  const uintptr_t cursor = cursor_;
+  Sample* sample = &samples_[cursor % capacity_];
+  // Generations are even and start at 2 so that unwritten samples, which
+  // are zero, are never complete.
+  const uintptr_t generation = 2 * (cursor / capacity_ + 1);
+  sample->generation = generation - 1;
+  sample->timestamp = OS::GetCurrentTimeMicros();
+  intptr_t depth = 0;
+  sample->pcs[depth++] = pc;
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_IA32)
+  // Dart and C++ frames both start with the caller's return address and
+  // frame pointer.  Stop at the first frame outside of the stack or not
+  // strictly above the previous one, e.g. when the sample was taken in a
+  // prologue or in code compiled without frame pointers.
+  while ((depth < Sample::kMaxDepth) &&
+         (fp >= sp) &&
+         (fp + 2 * kWordSize <= stack_upper) &&
+         Utils::IsAligned(fp, kWordSize)) {
+    const uword* frame = reinterpret_cast<const uword*>(fp);
+    const uword caller_fp = frame[0];
+    const uword caller_pc = frame[1];
+    if (caller_pc == 0) break;
+    sample->pcs[depth++] = caller_pc;
+    if (caller_fp <= fp) break;
+    fp = caller_fp;
+  }
+#endif
+  sample->depth = depth;
+  sample->generation = generation;
+  cursor_ = cursor + 1;
+}
+
+
+intptr_t SampleBuffer::Count() const {
+  const uintptr_t cursor = cursor_;
+  return (cursor < static_cast<uintptr_t>(capacity_)) ? cursor : capacity_;
+}
+
+
+bool SampleBuffer::Get(intptr_t index, Sample* sample) const {
+  ASSERT((index >= 0) && (index < capacity_));
+  const uintptr_t cursor = cursor_;
+  // Index 0 is the oldest sample.
+  const uintptr_t position = (cursor < static_cast<uintptr_t>(capacity_))
+      ? index : cursor + index;
+  const Sample* source = &samples_[position % capacity_];
+  const uintptr_t generation = source->generation;
+  if ((generation == 0) || ((generation & 1) != 0)) {
+    return false;
+  }
+  sample->timestamp = source->timestamp;
+  intptr_t depth = source->depth;
+  if (depth > Sample::kMaxDepth) {
+    depth = Sample::kMaxDepth;
+  }
+  for (intptr_t i = 0; i < depth; i++) {
+    sample->pcs[i] = source->pcs[i];
+  }
+  sample->depth = depth;
+  sample->generation = generation;
+  // The sample was overwritten while it was copied.
+  return source->generation == generation;
+}
+
+
+// Names of the code regions reported to the code observers, sorted by
+// start address when looked up.
+class CodeRegionTable : public AllStatic {
+ public:
+  static void Add(const char* name, uword start, uword size, bool optimized);
+
+  // Returns the name of the region containing 'pc' or NULL.
+  static const char* Lookup(uword pc, bool* optimized);
+
+ private:
+  struct Region {
+    const char* name;
+    uword start;
+    uword size;
+    bool optimized;
+  };
+
+  static int CompareRegions(const void* a, const void* b);
+
+  static const intptr_t kCapacityIncrement = 256;
+
+  static Mutex* mutex_;
+  static Region* regions_;
+  static intptr_t length_;
+  static intptr_t capacity_;
+  static bool sorted_;
+
+  friend class Profiler;
+};
+
+
+Mutex* CodeRegionTable::mutex_ = NULL;
+CodeRegionTable::Region* CodeRegionTable::regions_ = NULL;
+intptr_t CodeRegionTable::length_ = 0;
+intptr_t CodeRegionTable::capacity_ = 0;
+bool CodeRegionTable::sorted_ = true;
+
+
+void CodeRegionTable::Add(const char* name,
+                          uword start,
+                          uword size,
+                          bool optimized) {
+  MutexLocker ml(mutex_);
+  if (length_ == capacity_) {
+    capacity_ += kCapacityIncrement;
+    regions_ = reinterpret_cast<Region*>(
+        realloc(regions_, capacity_ * sizeof(*regions_)));
+    if (regions_ == NULL) {
+      FATAL("failed to grow code region table");
+    }
+  }
+  Region region = { strdup(name), start, size, optimized };
+  regions_[length_++] = region;
+  sorted_ = false;
+}
+
+
+int CodeRegionTable::CompareRegions(const void* a, const void* b) {
+  const Region* region_a = reinterpret_cast<const Region*>(a);
+  const Region* region_b = reinterpret_cast<const Region*>(b);
+  if (region_a->start < region_b->start) return -1;
+  if (region_a->start > region_b->start) return 1;
+  return 0;
+}
+
+
+const char* CodeRegionTable::Lookup(uword pc, bool* optimized) {
+  MutexLocker ml(mutex_);
+  if (!sorted_) {
+    qsort(regions_, length_, sizeof(*regions_), CompareRegions);
+    sorted_ = true;
+  }
+  // Find the last region starting at or before pc.
+  intptr_t low = 0;
+  intptr_t high = length_ - 1;
+  intptr_t found = -1;
+  while (low <= high) {
+    const intptr_t mid = low + (high - low) / 2;
+    if (regions_[mid].start <= pc) {
+      found = mid;
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+  if ((found < 0) || (pc >= regions_[found].start + regions_[found].size)) {
+    return NULL;
+  }
+  *optimized = regions_[found].optimized;
+  return regions_[found].name;
+}
+
+
+class ProfilerCodeObserver : public CodeObserver {
+ public:
+  ProfilerCodeObserver() { }
+
+  virtual bool IsActive() const {
+    return FLAG_profile;
+  }
+
+  virtual void Notify(const char* name,
+                      uword base,
+                      uword prologue_offset,
+                      uword size,
+                      bool optimized) {
+    CodeRegionTable::Add(name, base, size, optimized);
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ProfilerCodeObserver);
+};
+
+
+void Profiler::InitOnce() {
+  mutex_ = new Mutex();
+  CodeRegionTable::mutex_ = new Mutex();
+  if (FLAG_profile) {
+    CodeObservers::Register(new ProfilerCodeObserver);
+  }
+}
+
+
+bool Profiler::StartIsolate(Isolate* isolate) {
+  ASSERT(isolate == Isolate::Current());
+  MutexLocker ml(mutex_);
+  if (isolate->is_profiling()) {
+    return true;
+  }
+  if ((profiled_isolates_ == 0) && !StartTimer(FLAG_profile_period)) {
+    return false;
+  }
+  profiled_isolates_++;
+  if (isolate->profiler_samples() == NULL) {
+    isolate->set_profiler_samples(new SampleBuffer(FLAG_profile_buffer_size));
+  }
+  isolate->set_is_profiling(true);
+  return true;
+}
+
+
+void Profiler::StopIsolate(Isolate* isolate) {
+  ASSERT(isolate == Isolate::Current());
+  MutexLocker ml(mutex_);
+  if (!isolate->is_profiling()) {
+    return;
+  }
+  isolate->set_is_profiling(false);
+  profiled_isolates_--;
+  if (profiled_isolates_ == 0) {
+    StopTimer();
+  }
+}
+
+
+void Profiler::ShutdownIsolate(Isolate* isolate) {
+  StopIsolate(isolate);
+  delete isolate->profiler_samples();
+  isolate->set_profiler_samples(NULL);
+}
+
+
+void Profiler::RecordSample(uword pc, uword fp, uword sp) {
+  Isolate* isolate = Isolate::Current();
+  if ((isolate == NULL) || !isolate->is_profiling()) {
+    return;
+  }
+  SampleBuffer* samples = isolate->profiler_samples();
+  ASSERT(samples != NULL);
+  const uword stack_upper =
+      isolate->saved_stack_limit() + Isolate::GetSpecifiedStackSize();
+  samples->Add(pc, fp, sp, stack_upper);
+}
+
+
+// Symbolized samples of the current isolate.  Every frame of every sample
+// is mapped to a function, named after the Dart function of its code, the
+// code region reported to the profiler's code observer or the kind of code
+// it is in.
+class ProfileBuilder : public ValueObject {
+ public:
+  ProfileBuilder();
+
+  intptr_t num_samples() const { return num_samples_; }
+  intptr_t num_functions() const { return functions_.length(); }
+
+  const char* FunctionName(intptr_t function) const {
+    return functions_[function].name;
+  }
+  intptr_t SelfCount(intptr_t function) const {
+    return functions_[function].self_count;
+  }
+  intptr_t TotalCount(intptr_t function) const {
+    return functions_[function].total_count;
+  }
+
+  // Functions ordered by self and then total count, most expensive first.
+  intptr_t* SortedFunctions() const;
+
+  void PrintTree(TextBuffer* buffer) const;
+  void PrintSymbols(TextBuffer* buffer) const;
+  void WriteSamples(WriteStream* stream) const;
+
+ private:
+  struct FunctionInfo {
+    const char* name;
+    intptr_t self_count;
+    intptr_t total_count;
+    intptr_t last_sample;
+  };
+
+  struct Address {
+    uword pc;
+    const char* name;
+    intptr_t function;
+  };
+
+  struct Node {
+    intptr_t function;
+    intptr_t count;
+    intptr_t first_child;
+    intptr_t next_sibling;
+  };
+
+  // The address used to look up frame 'depth' of 'sample': the return
+  // address of a caller lies after its call instruction.
+  static uword LookupPc(const Sample& sample, intptr_t depth) {
+    return (depth == 0) ? sample.pcs[0] : sample.pcs[depth] - 1;
+  }
+
+  const char* Symbolize(uword pc) const;
+  intptr_t FindAddress(uword pc) const;
+  void CollectAddresses();
+  void CountSamples();
+  void BuildTree();
+  void PrintNode(TextBuffer* buffer, intptr_t node, intptr_t level) const;
+
+  static int CompareAddressPcs(const void* a, const void* b);
+  static int CompareAddressNames(const void* a, const void* b);
+
+  Zone* zone_;
+  Sample* samples_;
+  intptr_t num_samples_;
+  Address* addresses_;
+  intptr_t num_addresses_;
+  GrowableArray<FunctionInfo> functions_;
+  GrowableArray<Node> nodes_;
+};
+
+
+ProfileBuilder::ProfileBuilder()
+    : zone_(Isolate::Current()->current_zone()),
+      samples_(NULL),
+      num_samples_(0),
+      addresses_(NULL),
+      num_addresses_(0) {
+  SampleBuffer* buffer = Isolate::Current()->profiler_samples();
+  if (buffer != NULL) {
+    const intptr_t count = buffer->Count();
+    samples_ = zone_->Alloc<Sample>(count);
+    for (intptr_t i = 0; i < count; i++) {
+      if (buffer->Get(i, &samples_[num_samples_])) {
+        num_samples_++;
+      }
+    }
+  }
+  CollectAddresses();
+  CountSamples();
+  BuildTree();
+}
+
+
+const char* ProfileBuilder::Symbolize(uword pc) const {
+  const Code& code = Code::Handle(Code::LookupCode(pc));
+  if (!code.IsNull()) {
+    const Function& function = Function::Handle(code.function());
+    if (!function.IsNull()) {
+      const char* name = function.ToFullyQualifiedCString();
+      return code.is_optimized()
+          ? zone_->PrintToString("%s [optimized]", name) : name;
+    }
+  }
+  bool optimized = false;
+  const char* name = CodeRegionTable::Lookup(pc, &optimized);
+  if (name != NULL) {
+    return optimized
+        ? zone_->PrintToString("%s [optimized]", name)
+        : zone_->MakeCopyOfString(name);
+  }
+  return code.IsNull() ? "[Native]" : "[Stub]";
+}
+
+
+int ProfileBuilder::CompareAddressPcs(const void* a, const void* b) {
+  const Address* address_a = reinterpret_cast<const Address*>(a);
+  const Address* address_b = reinterpret_cast<const Address*>(b);
+  if (address_a->pc < address_b->pc) return -1;
+  if (address_a->pc > address_b->pc) return 1;
+  return 0;
+}
+
+
+int ProfileBuilder::CompareAddressNames(const void* a, const void* b) {
+  const Address* address_a = *reinterpret_cast<Address* const*>(a);
+  const Address* address_b = *reinterpret_cast<Address* const*>(b);
+  return strcmp(address_a->name, address_b->name);
+}
+
+
+intptr_t ProfileBuilder::FindAddress(uword pc) const {
+  intptr_t low = 0;
+  intptr_t high = num_addresses_ - 1;
+  while (low <= high) {
+    const intptr_t mid = low + (high - low) / 2;
+    if (addresses_[mid].pc == pc) return mid;
+    if (addresses_[mid].pc < pc) {
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+  UNREACHABLE();
+  return -1;
+}
+
+
+void ProfileBuilder::CollectAddresses() {
+  intptr_t num_frames = 0;
+  for (intptr_t i = 0; i < num_samples_; i++) {
+    num_frames += samples_[i].depth;
+  }
+  addresses_ = zone_->Alloc<Address>(num_frames);
+  for (intptr_t i = 0; i < num_samples_; i++) {
+    for (intptr_t d = 0; d < samples_[i].depth; d++) {
+      Address address = { LookupPc(samples_[i], d), NULL, -1 };
+      addresses_[num_addresses_++] = address;
+    }
+  }
+  if (num_addresses_ == 0) return;
+
+  // Symbolize every distinct address once.
+  qsort(addresses_, num_addresses_, sizeof(*addresses_), CompareAddressPcs);
+  intptr_t length = 1;
+  for (intptr_t i = 1; i < num_addresses_; i++) {
+    if (addresses_[i].pc != addresses_[length - 1].pc) {
+      addresses_[length++] = addresses_[i];
+    }
+  }
+  num_addresses_ = length;
+  for (intptr_t i = 0; i < num_addresses_; i++) {
+    addresses_[i].name = Symbolize(addresses_[i].pc);
+  }
+
+  // Addresses with the same name belong to the same function.
+  Address** by_name = zone_->Alloc<Address*>(num_addresses_);
+  for (intptr_t i = 0; i < num_addresses_; i++) {
+    by_name[i] = &addresses_[i];
+  }
+  qsort(by_name, num_addresses_, sizeof(*by_name), CompareAddressNames);
+  for (intptr_t i = 0; i < num_addresses_; i++) {
+    if ((i == 0) || (strcmp(by_name[i]->name, by_name[i - 1]->name) != 0)) {
+      FunctionInfo info = { by_name[i]->name, 0, 0, -1 };
+      functions_.Add(info);
+    }
+    by_name[i]->function = functions_.length() - 1;
+  }
+}
+
+
+void ProfileBuilder::CountSamples() {
+  for (intptr_t i = 0; i < num_samples_; i++) {
+    const Sample& sample = samples_[i];
+    for (intptr_t d = 0; d < sample.depth; d++) {
+      const intptr_t function =
+          addresses_[FindAddress(LookupPc(sample, d))].function;
+      FunctionInfo& info = functions_[function];
+      if (d == 0) {
+        info.self_count++;
+      }
+      // Count recursive functions once per sample.
+      if (info.last_sample != i) {
+        info.last_sample = i;
+        info.total_count++;
+      }
+    }
+  }
+}
+
+
+void ProfileBuilder::BuildTree() {
+  Node root = { -1, num_samples_, -1, -1 };
+  nodes_.Add(root);
+  for (intptr_t i = 0; i < num_samples_; i++) {
+    const Sample& sample = samples_[i];
+    intptr_t parent = 0;
+    for (intptr_t d = sample.depth - 1; d >= 0; d--) {
+      const intptr_t function =
+          addresses_[FindAddress(LookupPc(sample, d))].function;
+      intptr_t child = nodes_[parent].first_child;
+      while ((child >= 0) && (nodes_[child].function != function)) {
+        child = nodes_[child].next_sibling;
+      }
+      if (child < 0) {
+        Node node = { function, 0, -1, nodes_[parent].first_child };
+        nodes_.Add(node);
+        child = nodes_.length() - 1;
+        nodes_[parent].first_child = child;
+      }
+      nodes_[child].count++;
+      parent = child;
+    }
+  }
+}
+
+
+intptr_t* ProfileBuilder::SortedFunctions() const {
+  const intptr_t length = num_functions();
+  intptr_t* sorted = zone_->Alloc<intptr_t>(length);
+  for (intptr_t i = 0; i < length; i++) {
+    // Insertion sort: profiles have at most a few thousand functions.
+    intptr_t j = i;
+    while ((j > 0) &&
+           ((SelfCount(sorted[j - 1]) < SelfCount(i)) ||
+            ((SelfCount(sorted[j - 1]) == SelfCount(i)) &&
+             (TotalCount(sorted[j - 1]) < TotalCount(i))))) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = i;
+  }
+  return sorted;
+}
+
+
+void ProfileBuilder::PrintNode(TextBuffer* buffer,
+                               intptr_t node,
+                               intptr_t level) const {
+  // Print the children with the most samples first.
+  intptr_t num_children = 0;
+  for (intptr_t child = nodes_[node].first_child;
+       child >= 0;
+       child = nodes_[child].next_sibling) {
+    num_children++;
+  }
+  intptr_t* children = zone_->Alloc<intptr_t>(num_children);
+  intptr_t i = 0;
+  for (intptr_t child = nodes_[node].first_child;
+       child >= 0;
+       child = nodes_[child].next_sibling) {
+    intptr_t j = i++;
+    while ((j > 0) && (nodes_[children[j - 1]].count < nodes_[child].count)) {
+      children[j] = children[j - 1];
+      j--;
+    }
+    children[j] = child;
+  }
+  for (i = 0; i < num_children; i++) {
+    const Node& child = nodes_[children[i]];
+    buffer->Printf("%6.2f%% %6"Pd"  %*s%s\n",
+                   100.0 * child.count / num_samples_, child.count,
+                   static_cast<int>(2 * level), "",
+                   FunctionName(child.function));
+    PrintNode(buffer, children[i], level + 1);
+  }
+}
+
+
+void ProfileBuilder::PrintTree(TextBuffer* buffer) const {
+  PrintNode(buffer, 0, 0);
+}
+
+
+void ProfileBuilder::PrintSymbols(TextBuffer* buffer) const {
+  for (intptr_t i = 0; i < num_addresses_; i++) {
+    buffer->Printf("0x%"Px" %s\n",
+                   addresses_[i].pc,
+                   FunctionName(addresses_[i].function));
+  }
+}
+
+
+static void WriteWord(WriteStream* stream, uword value) {
+  stream->WriteBytes(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+}
+
+
+void ProfileBuilder::WriteSamples(WriteStream* stream) const {
+  // Legacy binary CPU profile: header, one record per sample with its
+  // count, depth and pcs, and the end of profile record.
+  WriteWord(stream, 0);
+  WriteWord(stream, 3);
+  WriteWord(stream, 0);
+  WriteWord(stream, FLAG_profile_period);
+  WriteWord(stream, 0);
+  for (intptr_t i = 0; i < num_samples_; i++) {
+    const Sample& sample = samples_[i];
+    WriteWord(stream, 1);
+    WriteWord(stream, sample.depth);
+    for (intptr_t d = 0; d < sample.depth; d++) {
+      WriteWord(stream, sample.pcs[d]);
+    }
+  }
+  WriteWord(stream, 0);
+  WriteWord(stream, 1);
+  WriteWord(stream, 0);
+}
+
+
+void Profiler::PrintFlat(TextBuffer* buffer) {
+  ProfileBuilder builder;
+  buffer->Printf("Flat profile: %"Pd" samples every %d us\n",
+                 builder.num_samples(), FLAG_profile_period);
+  if (builder.num_samples() == 0) return;
+  buffer->Printf("  self%%   self  total  function\n");
+  const intptr_t* sorted = builder.SortedFunctions();
+  for (intptr_t i = 0; i < builder.num_functions(); i++) {
+    const intptr_t function = sorted[i];
+    buffer->Printf("%6.2f%% %6"Pd" %6"Pd"  %s\n",
+                   100.0 * builder.SelfCount(function) / builder.num_samples(),
+                   builder.SelfCount(function),
+                   builder.TotalCount(function),
+                   builder.FunctionName(function));
+  }
+}
+
+
+void Profiler::PrintTree(TextBuffer* buffer) {
+  ProfileBuilder builder;
+  buffer->Printf("Tree profile: %"Pd" samples every %d us\n",
+                 builder.num_samples(), FLAG_profile_period);
+  if (builder.num_samples() == 0) return;
+  buffer->Printf(" total%%  total  function\n");
+  builder.PrintTree(buffer);
+}
+
+
+void Profiler::PrintJSON(TextBuffer* buffer) {
+  Isolate* isolate = Isolate::Current();
+  ProfileBuilder builder;
+  buffer->Printf("{ \"handle\": \"0x%"Px64"\", \"profiling\": %s, "
+                 "\"period\": %d, \"samples\": %"Pd", \"functions\": [ ",
+                 reinterpret_cast<int64_t>(isolate),
+                 isolate->is_profiling() ? "true" : "false",
+                 FLAG_profile_period,
+                 builder.num_samples());
+  const intptr_t* sorted = builder.SortedFunctions();
+  for (intptr_t i = 0; i < builder.num_functions(); i++) {
+    const intptr_t function = sorted[i];
+    if (i > 0) {
+      buffer->Printf(", ");
+    }
+    buffer->Printf("{ \"name\": \"");
+    buffer->AddEscapedString(builder.FunctionName(function));
+    buffer->Printf("\", \"self\": %"Pd", \"total\": %"Pd" }",
+                   builder.SelfCount(function),
+                   builder.TotalCount(function));
+  }
+  buffer->Printf("]}");
+}
+
+
+intptr_t Profiler::WritePprof(uint8_t** buffer, ReAlloc alloc) {
+  ProfileBuilder builder;
+  TextBuffer symbols(1024);
+  symbols.Printf("--- symbol\nbinary=dart\n");
+  builder.PrintSymbols(&symbols);
+  symbols.Printf("---\n--- profile\n");
+  WriteStream stream(buffer, alloc, symbols.length() + 1024);
+  stream.WriteBytes(reinterpret_cast<const uint8_t*>(symbols.buf()),
+                    symbols.length());
+  builder.WriteSamples(&stream);
+  return stream.bytes_written();
+}
+
+}  // namespace dart
@@ -0,0 +1,106 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef VM_PROFILER_H_
+#define VM_PROFILER_H_
+
+#include "vm/allocation.h"
+#include "vm/datastream.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+class Isolate;
+class Mutex;
+class TextBuffer;
+
+// A stack sample: the pc that was interrupted followed by the return
+// addresses of its callers.
+struct Sample {
+  static const intptr_t kMaxDepth = 32;
+
+  // Odd while the sample is being written, zero if it was never written.
+  volatile uintptr_t generation;
+  volatile int64_t timestamp;
+  volatile intptr_t depth;
+  volatile uword pcs[kMaxDepth];
+};
+
+
+// Ring buffer of the samples of an isolate.  Samples are only added by the
+// profiling signal handler running on the isolate's thread, which cannot be
+// interrupted by a reader; readers detect samples that were overwritten
+// while they copied them by their generation.
+class SampleBuffer {
+ public:
+  explicit SampleBuffer(intptr_t capacity);
+  ~SampleBuffer();
+
+  // Records a sample, walking the frame pointer chain from 'fp' as long as
+  // the frames lie between 'sp' and 'stack_upper'.  Called in the signal
+  // handler: must not allocate or take locks.
+  void Add(uword pc, uword fp, uword sp, uword stack_upper);
+
+  // Copies the sample at 'index' into 'sample'.  Returns false if there is
+  // no complete sample at the index.
+  bool Get(intptr_t index, Sample* sample) const;
+
+  intptr_t capacity() const { return capacity_; }
+  intptr_t Count() const;
+
+ private:
+  Sample* samples_;
+  const intptr_t capacity_;
+  volatile uintptr_t cursor_;
+
+  DISALLOW_COPY_AND_ASSIGN(SampleBuffer);
+};
+
+
+// Sampling CPU profiler.  While an isolate is profiled, a SIGPROF timer
+// interrupts the running thread every --profile_period microseconds and the
+// stack of the current isolate is recorded in its sample buffer.  Samples
+// are symbolized when the profile is printed, using the names of the code
+// recorded by the profiler's code observer (with --profile) or the Code
+// objects of the isolate's heap.
+class Profiler : public AllStatic {
+ public:
+  static void InitOnce();
+
+  // Start and stop sampling 'isolate'.  Return false if profiling is not
+  // supported on this platform.
+  static bool StartIsolate(Isolate* isolate);
+  static void StopIsolate(Isolate* isolate);
+
+  // Releases the samples of an isolate that is shutting down.
+  static void ShutdownIsolate(Isolate* isolate);
+
+  // Called by the signal handler with the registers of the interrupted
+  // thread.
+  static void RecordSample(uword pc, uword fp, uword sp);
+
+  // Print the samples of the current isolate.  The flat profile lists the
+  // functions by the number of samples in which they were running; the tree
+  // profile shows the sampled call paths from the outermost frame down.
+  static void PrintFlat(TextBuffer* buffer);
+  static void PrintTree(TextBuffer* buffer);
+  static void PrintJSON(TextBuffer* buffer);
+
+  // Writes the samples of the current isolate as a symbolized pprof CPU
+  // profile into '*buffer', which is allocated with 'alloc'.  Returns the
+  // number of bytes written.
+  static intptr_t WritePprof(uint8_t** buffer, ReAlloc alloc);
+
+ private:
+  // Platform specific, see profiler_<os>.cc.
+  static bool StartTimer(intptr_t period_micros);
+  static void StopTimer();
+
+  static Mutex* mutex_;
+  static intptr_t profiled_isolates_;
+};
+
+}  // namespace dart
+
+#endif  // VM_PROFILER_H_
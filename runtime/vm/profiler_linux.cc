@@ -0,0 +1,72 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/globals.h"
+#if defined(TARGET_OS_LINUX)
+
+#include "vm/profiler.h"
+
+#include <errno.h>  // NOLINT
+#include <signal.h>  // NOLINT
+#include <sys/time.h>  // NOLINT
+#include <ucontext.h>  // NOLINT
+
+namespace dart {
+
+static void ProfileSignalHandler(int signal, siginfo_t* info, void* context) {
+  ASSERT(signal == SIGPROF);
+  const int saved_errno = errno;
+  const mcontext_t& mcontext =
+      reinterpret_cast<ucontext_t*>(context)->uc_mcontext;
+#if defined(HOST_ARCH_X64)
+  const uword pc = static_cast<uword>(mcontext.gregs[REG_RIP]);
+  const uword fp = static_cast<uword>(mcontext.gregs[REG_RBP]);
+  const uword sp = static_cast<uword>(mcontext.gregs[REG_RSP]);
+#elif defined(HOST_ARCH_IA32)
+  const uword pc = static_cast<uword>(mcontext.gregs[REG_EIP]);
+  const uword fp = static_cast<uword>(mcontext.gregs[REG_EBP]);
+  const uword sp = static_cast<uword>(mcontext.gregs[REG_ESP]);
+#elif defined(HOST_ARCH_ARM)
+  const uword pc = static_cast<uword>(mcontext.arm_pc);
+  const uword fp = static_cast<uword>(mcontext.arm_fp);
+  const uword sp = static_cast<uword>(mcontext.arm_sp);
+#elif defined(HOST_ARCH_MIPS)
+  const uword pc = static_cast<uword>(mcontext.pc);
+  const uword fp = static_cast<uword>(mcontext.gregs[30]);
+  const uword sp = static_cast<uword>(mcontext.gregs[29]);
+#else
+#error Unsupported architecture.
+#endif
+  Profiler::RecordSample(pc, fp, sp);
+  errno = saved_errno;
+}
+
+
+bool Profiler::StartTimer(intptr_t period_micros) {
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = ProfileSignalHandler;
+  action.sa_flags = SA_RESTART | SA_SIGINFO;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, NULL) != 0) {
+    return false;
+  }
+  struct itimerval timer;
+  timer.it_interval.tv_sec = period_micros / kMicrosecondsPerSecond;
+  timer.it_interval.tv_usec = period_micros % kMicrosecondsPerSecond;
+  timer.it_value = timer.it_interval;
+  return setitimer(ITIMER_PROF, &timer, NULL) == 0;
+}
+
+
+void Profiler::StopTimer() {
+  struct itimerval timer;
+  memset(&timer, 0, sizeof(timer));
+  setitimer(ITIMER_PROF, &timer, NULL);
+  // Leave the handler installed: a signal may still be pending.
+}
+
+}  // namespace dart
+
+#endif  // defined(TARGET_OS_LINUX)
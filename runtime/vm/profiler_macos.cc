@@ -0,0 +1,63 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/globals.h"
+#if defined(TARGET_OS_MACOS)
+
+#include "vm/profiler.h"
+
+#include <errno.h>  // NOLINT
+#include <signal.h>  // NOLINT
+#include <sys/time.h>  // NOLINT
+#include <sys/ucontext.h>  // NOLINT
+
+namespace dart {
+
+static void ProfileSignalHandler(int signal, siginfo_t* info, void* context) {
+  ASSERT(signal == SIGPROF);
+  const int saved_errno = errno;
+  const mcontext_t mcontext =
+      reinterpret_cast<ucontext_t*>(context)->uc_mcontext;
+#if defined(HOST_ARCH_X64)
+  const uword pc = static_cast<uword>(mcontext->__ss.__rip);
+  const uword fp = static_cast<uword>(mcontext->__ss.__rbp);
+  const uword sp = static_cast<uword>(mcontext->__ss.__rsp);
+#elif defined(HOST_ARCH_IA32)
+  const uword pc = static_cast<uword>(mcontext->__ss.__eip);
+  const uword fp = static_cast<uword>(mcontext->__ss.__ebp);
+  const uword sp = static_cast<uword>(mcontext->__ss.__esp);
+#else
+#error Unsupported architecture.
+#endif
+  Profiler::RecordSample(pc, fp, sp);
+  errno = saved_errno;
+}
+
+
+bool Profiler::StartTimer(intptr_t period_micros) {
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = ProfileSignalHandler;
+  action.sa_flags = SA_RESTART | SA_SIGINFO;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, NULL) != 0) {
+    return false;
+  }
+  struct itimerval timer;
+  timer.it_interval.tv_sec = period_micros / kMicrosecondsPerSecond;
+  timer.it_interval.tv_usec = period_micros % kMicrosecondsPerSecond;
+  timer.it_value = timer.it_interval;
+  return setitimer(ITIMER_PROF, &timer, NULL) == 0;
+}
+
+
+void Profiler::StopTimer() {
+  struct itimerval timer;
+  memset(&timer, 0, sizeof(timer));
+  setitimer(ITIMER_PROF, &timer, NULL);
+}
+
+}  // namespace dart
+
+#endif  // defined(TARGET_OS_MACOS)
@@ -0,0 +1,69 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/assert.h"
+#include "vm/globals.h"
+#include "vm/profiler.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+UNIT_TEST_CASE(SampleBuffer) {
+  SampleBuffer buffer(4);
+  Sample sample;
+  EXPECT_EQ(0, buffer.Count());
+  EXPECT(!buffer.Get(0, &sample));
+  // Frame pointers below the stack pointer are not walked.
+  for (uword pc = 1; pc <= 6; pc++) {
+    buffer.Add(pc, 0, 1, 1);
+  }
+  EXPECT_EQ(4, buffer.Count());
+  for (intptr_t i = 0; i < buffer.Count(); i++) {
+    EXPECT(buffer.Get(i, &sample));
+    EXPECT_EQ(1, sample.depth);
+    // The two oldest samples were overwritten.
+    EXPECT_EQ(static_cast<uword>(i + 3), sample.pcs[0]);
+  }
+}
+
+
+#if defined(TARGET_OS_LINUX) || defined(TARGET_OS_MACOS)
+
+TEST_CASE(Profiler_FlatProfile) {
+  const char* kScriptChars =
+      "work() {\n"
+      "  var sum = 0;\n"
+      "  for (var i = 0; i < 100000; i++) sum += i & 7;\n"
+      "  return sum;\n"
+      "}\n"
+      "main() {\n"
+      "  var sum = 0;\n"
+      "  var stopwatch = new Stopwatch()..start();\n"
+      "  while (stopwatch.elapsedMilliseconds < 300) sum += work();\n"
+      "  return sum;\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  EXPECT_VALID(Dart_StartProfiling());
+  EXPECT_VALID(Dart_Invoke(lib, NewString("main"), 0, NULL));
+  EXPECT_VALID(Dart_StopProfiling());
+
+  uint8_t* buffer = NULL;
+  intptr_t size = 0;
+  EXPECT_VALID(Dart_GetProfile(Dart_kFlatProfile, &buffer, &size));
+  EXPECT_LT(0, size);
+  char* text = Isolate::Current()->current_zone()->Alloc<char>(size + 1);
+  memmove(text, buffer, size);
+  text[size] = '\0';
+  EXPECT_SUBSTRING("Flat profile:", text);
+  EXPECT_SUBSTRING("work", text);
+
+  EXPECT_VALID(Dart_GetProfile(Dart_kPprofProfile, &buffer, &size));
+  EXPECT_LT(0, size);
+  EXPECT_EQ(0, strncmp("--- symbol\n", reinterpret_cast<char*>(buffer), 11));
+}
+
+#endif  // defined(TARGET_OS_LINUX) || defined(TARGET_OS_MACOS)
+
+}  // namespace dart
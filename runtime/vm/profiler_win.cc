@@ -0,0 +1,23 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/globals.h"
+#if defined(TARGET_OS_WINDOWS)
+
+#include "vm/profiler.h"
+
+namespace dart {
+
+// The CPU profiler is not supported on this platform yet.
+bool Profiler::StartTimer(intptr_t period_micros) {
+  return false;
+}
+
+
+void Profiler::StopTimer() {
+}
+
+}  // namespace dart
+
+#endif  // defined(TARGET_OS_WINDOWS)
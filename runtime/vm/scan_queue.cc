@@ -0,0 +1,172 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/scan_queue.h"
+
+#include "vm/compiler_stats.h"
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/isolate.h"
+#include "vm/object.h"
+#include "vm/scanner.h"
+#include "vm/thread.h"
+#include "vm/thread_pool.h"
+#include "vm/timer.h"
+#include "vm/zone.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool, parallel_scan, false,
+    "Scan the sources of the parts of a library on thread pool threads.");
+DECLARE_FLAG(bool, compiler_stats);
+
+// Scans a copy of the characters of a source on a thread pool thread.
+class ScanJob {
+ public:
+  explicit ScanJob(const String& source);
+  ~ScanJob();
+
+  // Called on the thread pool thread.
+  void Scan();
+
+  // Waits for the scan to finish.
+  void Wait();
+
+  // Waits for the scan to finish and returns the tokens of the source.
+  const Scanner::GrowableTokenStream& Tokens(const String& private_key);
+
+  intptr_t length() const { return length_; }
+
+ private:
+  uint16_t* characters_;
+  intptr_t length_;
+  Zone zone_;
+  Scanner::TokenBuffer tokens_;
+  Scanner::LiteralBuffer literals_;
+  Monitor monitor_;
+  bool done_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScanJob);
+};
+
+
+class ScanTask : public ThreadPool::Task {
+ public:
+  explicit ScanTask(ScanJob* job) : job_(job) { }
+
+  virtual void Run() {
+    job_->Scan();
+  }
+
+ private:
+  ScanJob* job_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScanTask);
+};
+
+
+ScanJob::ScanJob(const String& source)
+    : characters_(new uint16_t[source.Length() + 1]),
+      length_(source.Length()),
+      zone_(),
+      tokens_(128, &zone_),
+      literals_(64, &zone_),
+      monitor_(),
+      done_(false) {
+  NoGCScope no_gc;
+  for (intptr_t i = 0; i < length_; i++) {
+    characters_[i] = source.CharAt(i);
+  }
+}
+
+
+ScanJob::~ScanJob() {
+  delete[] characters_;
+}
+
+
+void ScanJob::Scan() {
+  Scanner scanner(characters_, length_, &zone_);
+  scanner.ScanAll(&tokens_, &literals_);
+  MonitorLocker ml(&monitor_);
+  done_ = true;
+  ml.Notify();
+}
+
+
+void ScanJob::Wait() {
+  MonitorLocker ml(&monitor_);
+  while (!done_) {
+    ml.Wait();
+  }
+}
+
+
+const Scanner::GrowableTokenStream& ScanJob::Tokens(
+    const String& private_key) {
+  Wait();
+  return Scanner::MaterializeTokens(tokens_,
+                                    literals_,
+                                    characters_,
+                                    private_key);
+}
+
+
+ScanQueue::ScanQueue(Isolate* isolate, const Library& library)
+    : StackResource(isolate),
+      library_(library),
+      scripts_(GrowableObjectArray::ZoneHandle(GrowableObjectArray::New())),
+      token_positions_(),
+      jobs_(),
+      token_pos_(0),
+      previous_(isolate->scan_queue()) {
+  isolate->set_scan_queue(this);
+}
+
+
+ScanQueue::~ScanQueue() {
+  // Scans that were not collected, e.g. because a part failed to compile,
+  // still have to finish before they are freed.
+  for (intptr_t i = 0; i < jobs_.length(); i++) {
+    jobs_[i]->Wait();
+    delete jobs_[i];
+  }
+  Isolate::Current()->set_scan_queue(previous_);
+}
+
+
+bool ScanQueue::Add(const Library& library, const Script& script) {
+  if (library.raw() != library_.raw()) {
+    return false;
+  }
+  ScanJob* job = new ScanJob(String::Handle(script.Source()));
+  scripts_.Add(script);
+  token_positions_.Add(token_pos_);
+  jobs_.Add(job);
+  Dart::thread_pool()->Run(new ScanTask(job));
+  return true;
+}
+
+
+RawScript* ScanQueue::ScriptAt(intptr_t index) const {
+  Script& script = Script::Handle();
+  script ^= scripts_.At(index);
+  return script.raw();
+}
+
+
+void ScanQueue::TokenizeAt(intptr_t index) const {
+  const Script& script = Script::Handle(ScriptAt(index));
+  const String& private_key = String::Handle(library_.private_key());
+  TimerScope timer(FLAG_compiler_stats, &CompilerStats::scanner_timer);
+  const Scanner::GrowableTokenStream& tokens =
+      jobs_[index]->Tokens(private_key);
+  script.set_tokens(TokenStream::Handle(TokenStream::New(tokens,
+                                                         private_key)));
+  if (FLAG_compiler_stats) {
+    CompilerStats::src_length += jobs_[index]->length();
+  }
+}
+
+}  // namespace dart
@@ -0,0 +1,60 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef VM_SCAN_QUEUE_H_
+#define VM_SCAN_QUEUE_H_
+
+#include "vm/allocation.h"
+#include "vm/growable_array.h"
+
+namespace dart {
+
+class GrowableObjectArray;
+class Isolate;
+class Library;
+class RawScript;
+class ScanJob;
+class Script;
+
+// The parts of a library that are loaded while its library definition is
+// parsed. With --parallel_scan, Dart_LoadSource adds the parts of the
+// library to the queue instead of compiling them right away: the source of
+// every part is scanned on a thread pool thread while the isolate's thread
+// loads the following parts, and the parser compiles the parts in order once
+// all of them are loaded.
+class ScanQueue : public StackResource {
+ public:
+  ScanQueue(Isolate* isolate, const Library& library);
+  ~ScanQueue();
+
+  // Adds a part of the queue's library and starts scanning its source.
+  // Returns false if 'library' is not the library of the queue.
+  bool Add(const Library& library, const Script& script);
+
+  // Token position of the part directive whose part is being loaded.
+  void set_token_pos(intptr_t value) { token_pos_ = value; }
+
+  intptr_t Length() const { return jobs_.length(); }
+  RawScript* ScriptAt(intptr_t index) const;
+  intptr_t TokenPosAt(intptr_t index) const {
+    return token_positions_[index];
+  }
+
+  // Sets the tokens of the script at 'index' once its scan has finished.
+  void TokenizeAt(intptr_t index) const;
+
+ private:
+  const Library& library_;
+  const GrowableObjectArray& scripts_;
+  GrowableArray<intptr_t> token_positions_;
+  GrowableArray<ScanJob*> jobs_;
+  intptr_t token_pos_;
+  ScanQueue* previous_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScanQueue);
+};
+
+}  // namespace dart
+
+#endif  // VM_SCAN_QUEUE_H_
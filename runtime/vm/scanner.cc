@@ -8,6 +8,7 @@
 #include "vm/flags.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
+#include "vm/string_hasher.h"
 #include "vm/symbols.h"
 #include "vm/thread.h"
 #include "vm/token.h"
@@ -18,20 +19,28 @@ namespace dart {
 DEFINE_FLAG(bool, disable_privacy, false, "Disable library privacy.");
 DEFINE_FLAG(bool, print_tokens, false, "Print scanned tokens.");
 
-void Scanner::InitKeywordTable() {
+RawArray* Scanner::KeywordSymbols() {
   ObjectStore* object_store = Isolate::Current()->object_store();
-  keyword_symbol_table_ = object_store->keyword_symbols();
-  if (keyword_symbol_table_.IsNull()) {
+  if (object_store->keyword_symbols() == Array::null()) {
     object_store->InitKeywordTable();
-    keyword_symbol_table_ = object_store->keyword_symbols();
-    ASSERT(!keyword_symbol_table_.IsNull());
+    const Array& keyword_symbols =
+        Array::Handle(object_store->keyword_symbols());
+    ASSERT(!keyword_symbols.IsNull());
     String& symbol = String::Handle();
     for (int i = 0; i < Token::numKeywords; i++) {
       Token::Kind token = static_cast<Token::Kind>(Token::kFirstKeyword + i);
       symbol = Symbols::New(Token::Str(token));
-      keyword_symbol_table_.SetAt(i, symbol);
+      keyword_symbols.SetAt(i, symbol);
     }
   }
+  return object_store->keyword_symbols();
+}
+
+
+void Scanner::InitKeywordTable() {
+  if (!IsOffHeap()) {
+    *keyword_symbol_table_ = KeywordSymbols();
+  }
   for (int i = 0; i < Token::numKeywords; i++) {
     Token::Kind token = static_cast<Token::Kind>(Token::kFirstKeyword + i);
     keywords_[i].kind = token;
@@ -63,14 +72,33 @@ void Scanner::Reset() {
 
 Scanner::Scanner(const String& src, const String& private_key)
     : source_(src),
+      characters_(NULL),
       source_length_(src.Length()),
       saved_context_(NULL),
       private_key_(String::ZoneHandle(private_key.raw())),
-      keyword_symbol_table_(Array::ZoneHandle()) {
+      keyword_symbol_table_(&Array::ZoneHandle()),
+      zone_(Isolate::Current()->current_zone()),
+      has_literal_(false) {
+  Reset();
+  InitKeywordTable();
+}
+
+
+Scanner::Scanner(const uint16_t* characters, intptr_t length, Zone* zone)
+    : source_(Symbols::Empty()),
+      characters_(characters),
+      source_length_(length),
+      saved_context_(NULL),
+      private_key_(Symbols::Empty()),
+      keyword_symbol_table_(NULL),
+      zone_(zone),
+      has_literal_(false) {
+  ASSERT(characters != NULL);
   Reset();
   InitKeywordTable();
 }
 
+
 Scanner::~Scanner() {
   while (saved_context_ != NULL) {
     ScanContext* ctx = saved_context_;
@@ -82,13 +110,88 @@ Scanner::~Scanner() {
 
 void Scanner::ErrorMsg(const char* msg) {
   current_token_.kind = Token::kERROR;
-  current_token_.literal = &String::ZoneHandle(Symbols::New(msg));
+  if (IsOffHeap()) {
+    DeferredLiteral literal = { DeferredLiteral::kError, -1, 0, 0, NULL,
+                                zone_->MakeCopyOfString(msg) };
+    current_literal_ = literal;
+    has_literal_ = true;
+  } else {
+    current_token_.literal = &String::ZoneHandle(Symbols::New(msg));
+  }
   current_token_.position = c0_pos_;
   token_start_ = lookahead_pos_;
   current_token_.offset = lookahead_pos_;
 }
 
 
+void Scanner::SetKeywordLiteral(intptr_t keyword_index) {
+  if (IsOffHeap()) {
+    DeferredLiteral literal = { DeferredLiteral::kKeyword, -1,
+                                keyword_index, 0, NULL, NULL };
+    current_literal_ = literal;
+    has_literal_ = true;
+    return;
+  }
+  if (keywords_[keyword_index].keyword_symbol == NULL) {
+    String& symbol = String::ZoneHandle();
+    symbol ^= keyword_symbol_table_->At(keyword_index);
+    ASSERT(!symbol.IsNull());
+    keywords_[keyword_index].keyword_symbol = &symbol;
+  }
+  current_token_.literal = keywords_[keyword_index].keyword_symbol;
+}
+
+
+void Scanner::SetIdentLiteral(intptr_t start,
+                              intptr_t length,
+                              intptr_t hash) {
+  if (IsOffHeap()) {
+    DeferredLiteral literal = { DeferredLiteral::kIdentifier, -1,
+                                start, length, NULL, NULL };
+    current_literal_ = literal;
+    has_literal_ = true;
+    return;
+  }
+  String& literal =
+      String::ZoneHandle(Symbols::New(source_, start, length, hash));
+  if ((CharAt(start) == kPrivateIdentifierStart) && !FLAG_disable_privacy) {
+    // Private identifiers are mangled on a per script basis.
+    literal = String::Concat(literal, private_key_);
+    literal = Symbols::New(literal);
+  }
+  current_token_.literal = &literal;
+}
+
+
+void Scanner::SetNumberLiteral(intptr_t start, intptr_t length) {
+  if (IsOffHeap()) {
+    DeferredLiteral literal = { DeferredLiteral::kNumber, -1,
+                                start, length, NULL, NULL };
+    current_literal_ = literal;
+    has_literal_ = true;
+    return;
+  }
+  current_token_.literal =
+      &String::ZoneHandle(
+          String::SubString(source_, start, length, Heap::kOld));
+}
+
+
+void Scanner::SetStringLiteral(const int32_t* chars, intptr_t length) {
+  if (IsOffHeap()) {
+    // The characters are allocated in the scanner's zone and not reused.
+    DeferredLiteral literal = { DeferredLiteral::kString, -1,
+                                0, length, chars, NULL };
+    current_literal_ = literal;
+    has_literal_ = true;
+    return;
+  }
+  // Strings are canonicalized: Allocate a symbol.
+  current_token_.literal =
+      &String::ZoneHandle(Symbols::FromUTF32(chars, length));
+}
+
+
 void Scanner::PushContext() {
   ScanContext* ctx = new ScanContext;
   ctx->next = saved_context_;
@@ -149,6 +252,11 @@ bool Scanner::IsHexDigit(int32_t c) {
 }
 
 
+int32_t Scanner::CharAt(intptr_t index) const {
+  return IsOffHeap() ? characters_[index] : source_.CharAt(index);
+}
+
+
 bool Scanner::IsIdentStartChar(int32_t c) {
   return IsLetter(c) || (c == '_') || (c == '$');
 }
@@ -211,7 +319,7 @@ void Scanner::ReadChar() {
       newline_seen_ = true;
       c0_pos_.line++;
       c0_pos_.column = 0;
-      if (source_.CharAt(lookahead_pos_) == '\r') {
+      if (CharAt(lookahead_pos_) == '\r') {
         // Replace a sequence of '\r' '\n' with a single '\n'.
         if (LookaheadChar(1) == '\n') {
           lookahead_pos_++;
@@ -236,7 +344,7 @@ int32_t Scanner::LookaheadChar(int how_many) {
   ASSERT(how_many >= 0);
   int32_t lookahead_char = '\0';
   if (lookahead_pos_ + how_many < source_length_) {
-    lookahead_char = source_.CharAt(lookahead_pos_ + how_many);
+    lookahead_char = CharAt(lookahead_pos_ + how_many);
   }
   return lookahead_char;
 }
@@ -291,8 +399,11 @@ void Scanner::ScanIdentChars(bool allow_dollar) {
   ASSERT(allow_dollar || (c0_ != '$'));
   int ident_length = 0;
   int ident_pos = lookahead_pos_;
-  int32_t ident_char0 = source_.CharAt(ident_pos);
+  int32_t ident_char0 = CharAt(ident_pos);
+  // Hash the identifier while reading it, for its symbol lookup.
+  StringHasher hasher;
   while (IsIdentChar(c0_) && (allow_dollar || (c0_ != '$'))) {
+    hasher.Add(static_cast<uint16_t>(c0_));
     ReadChar();
     ident_length++;
   }
@@ -306,17 +417,11 @@ void Scanner::ScanIdentChars(bool allow_dollar) {
       const char* keyword = keywords_[i].keyword_chars;
       int char_pos = 0;
       while ((char_pos < ident_length) &&
-             (keyword[char_pos] == source_.CharAt(ident_pos + char_pos))) {
+             (keyword[char_pos] == CharAt(ident_pos + char_pos))) {
         char_pos++;
       }
       if (char_pos == ident_length) {
-        if (keywords_[i].keyword_symbol == NULL) {
-          String& symbol = String::ZoneHandle();
-          symbol ^= keyword_symbol_table_.At(i);
-          ASSERT(!symbol.IsNull());
-          keywords_[i].keyword_symbol = &symbol;
-        }
-        current_token_.literal = keywords_[i].keyword_symbol;
+        SetKeywordLiteral(i);
         current_token_.kind = keywords_[i].kind;
         return;
       }
@@ -326,14 +431,7 @@ void Scanner::ScanIdentChars(bool allow_dollar) {
 
   // We did not read a keyword.
   current_token_.kind = Token::kIDENT;
-  String& literal =
-      String::ZoneHandle(Symbols::New(source_, ident_pos, ident_length));
-  if ((ident_char0 == kPrivateIdentifierStart) && !FLAG_disable_privacy) {
-    // Private identifiers are mangled on a per script basis.
-    literal = String::Concat(literal, private_key_);
-    literal = Symbols::New(literal);
-  }
-  current_token_.literal = &literal;
+  SetIdentLiteral(ident_pos, ident_length, hasher.Finalize(String::kHashBits));
 }
 
 
@@ -385,9 +483,7 @@ void Scanner::ScanNumber(bool dec_point_seen) {
   }
   if (current_token_.kind != Token::kILLEGAL) {
     intptr_t len = lookahead_pos_ - token_start_;
-    current_token_.literal =
-        &String::ZoneHandle(
-            String::SubString(source_, token_start_, len, Heap::kOld));
+    SetNumberLiteral(token_start_, len);
   }
 }
 
@@ -510,7 +606,7 @@ void Scanner::ScanEscapedCodePoint(int32_t* code_point) {
 
 
 void Scanner::ScanLiteralStringChars(bool is_raw) {
-  GrowableArray<int32_t> string_chars(64);
+  BaseGrowableArray<int32_t, ValueObject> string_chars(64, zone_);
 
   ASSERT(IsScanningString());
   // We are at the first character of a string literal piece. A string literal
@@ -562,9 +658,7 @@ void Scanner::ScanLiteralStringChars(bool is_raw) {
     } else if (c0_ == '$' && !is_raw) {
       // Scanned a string piece.
       ASSERT(string_chars.data() != NULL);
-      // Strings are canonicalized: Allocate a symbol.
-      current_token_.literal = &String::ZoneHandle(
-          Symbols::FromUTF32(string_chars.data(), string_chars.length()));
+      SetStringLiteral(string_chars.data(), string_chars.length());
       // Preserve error tokens.
       if (current_token_.kind != Token::kERROR) {
         current_token_.kind = Token::kSTRING;
@@ -585,9 +679,7 @@ void Scanner::ScanLiteralStringChars(bool is_raw) {
         } else {
           Recognize(Token::kSTRING);
           ASSERT(string_chars.data() != NULL);
-          // Strings are canonicalized: Allocate a symbol.
-          current_token_.literal = &String::ZoneHandle(
-              Symbols::FromUTF32(string_chars.data(), string_chars.length()));
+          SetStringLiteral(string_chars.data(), string_chars.length());
         }
         EndStringLiteral();
         return;
@@ -613,6 +705,7 @@ void Scanner::Scan() {
     current_token_.offset = lookahead_pos_;
     current_token_.position = c0_pos_;
     current_token_.literal = NULL;
+    has_literal_ = false;
     current_token_.kind = Token::kILLEGAL;
     if (IsScanningString()) {
       if (c0_ == '$') {
@@ -887,6 +980,76 @@ void Scanner::ScanAll(GrowableTokenStream* token_stream) {
 }
 
 
+void Scanner::ScanAll(TokenBuffer* tokens, LiteralBuffer* literals) {
+  ASSERT(IsOffHeap());
+  Reset();
+  do {
+    Scan();
+    if (has_literal_) {
+      current_literal_.token_index = tokens->length();
+      literals->Add(current_literal_);
+    }
+    tokens->Add(current_token_);
+  } while (current_token_.kind != Token::kEOS);
+}
+
+
+const Scanner::GrowableTokenStream& Scanner::MaterializeTokens(
+    const TokenBuffer& tokens,
+    const LiteralBuffer& literals,
+    const uint16_t* characters,
+    const String& private_key) {
+  GrowableTokenStream* ts = new GrowableTokenStream(tokens.length());
+  for (intptr_t i = 0; i < tokens.length(); i++) {
+    ts->Add(tokens[i]);
+  }
+  const Array& keyword_symbols = Array::Handle(KeywordSymbols());
+  String* keyword_literals[Token::numKeywords] = { NULL };
+  for (intptr_t i = 0; i < literals.length(); i++) {
+    const DeferredLiteral& literal = literals[i];
+    String* value = NULL;
+    switch (literal.kind) {
+      case DeferredLiteral::kKeyword:
+        if (keyword_literals[literal.start] == NULL) {
+          value = &String::ZoneHandle();
+          *value ^= keyword_symbols.At(literal.start);
+          keyword_literals[literal.start] = value;
+        }
+        value = keyword_literals[literal.start];
+        break;
+      case DeferredLiteral::kIdentifier:
+        value = &String::ZoneHandle(
+            Symbols::FromUTF16(characters + literal.start, literal.length));
+        if ((characters[literal.start] == kPrivateIdentifierStart) &&
+            !FLAG_disable_privacy) {
+          // Private identifiers are mangled on a per script basis.
+          *value = String::Concat(*value, private_key);
+          *value = Symbols::New(*value);
+        }
+        break;
+      case DeferredLiteral::kNumber:
+        value = &String::ZoneHandle(
+            String::FromUTF16(characters + literal.start,
+                              literal.length,
+                              Heap::kOld));
+        break;
+      case DeferredLiteral::kString:
+        value = &String::ZoneHandle(
+            Symbols::FromUTF32(literal.chars, literal.length));
+        break;
+      case DeferredLiteral::kError:
+        value = &String::ZoneHandle(Symbols::New(literal.message));
+        break;
+    }
+    (*ts)[literal.token_index].literal = value;
+  }
+  if (FLAG_print_tokens) {
+    Scanner::PrintTokens(*ts);
+  }
+  return *ts;
+}
+
+
 void Scanner::ScanTo(intptr_t token_index) {
   int index = 0;
   Reset();
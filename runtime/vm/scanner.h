@@ -17,8 +17,10 @@ namespace dart {
 // Forward declarations.
 class Array;
 class Library;
+class RawArray;
 class RawString;
 class String;
+class Zone;
 
 // A call to Scan() scans the source one token at at time.
 // The scanned token is returned by cur_token().
@@ -53,8 +55,35 @@ class Scanner : ValueObject {
 
   typedef ZoneGrowableArray<TokenDescriptor> GrowableTokenStream;
 
+  // A literal of a token scanned off the heap, which is allocated when the
+  // tokens are materialized on the isolate's thread.
+  struct DeferredLiteral {
+    enum Kind {
+      kKeyword,     // Keyword symbol number 'start'.
+      kIdentifier,  // Identifier symbol of the source characters.
+      kNumber,      // Source characters of a number.
+      kString,      // String literal symbol of 'chars'.
+      kError,       // Error message symbol.
+    };
+    Kind kind;
+    intptr_t token_index;
+    intptr_t start;
+    intptr_t length;
+    const int32_t* chars;
+    const char* message;
+  };
+
+  typedef BaseGrowableArray<TokenDescriptor, ValueObject> TokenBuffer;
+  typedef BaseGrowableArray<DeferredLiteral, ValueObject> LiteralBuffer;
+
   // Initializes scanner to scan string source.
   Scanner(const String& source, const String& private_key);
+
+  // Initializes scanner to scan a copy of the characters of a source string
+  // without accessing the heap or the current isolate, e.g. on a thread pool
+  // thread. Temporary data is allocated in 'zone'. Only ScanAll may be used.
+  Scanner(const uint16_t* characters, intptr_t length, Zone* zone);
+
   ~Scanner();
 
   // Scans one token at a time.
@@ -77,6 +106,19 @@ class Scanner : ValueObject {
   // Should be called only once.
   const GrowableTokenStream& GetStream();
 
+  // Scans the characters of an off heap scanner into 'tokens', whose
+  // literals are NULL, and the literals to allocate for them into
+  // 'literals'.
+  void ScanAll(TokenBuffer* tokens, LiteralBuffer* literals);
+
+  // Creates the stream of tokens of a source scanned off the heap. Must be
+  // called on the isolate's thread.
+  static const GrowableTokenStream& MaterializeTokens(
+      const TokenBuffer& tokens,
+      const LiteralBuffer& literals,
+      const uint16_t* characters,
+      const String& private_key);
+
   // Info about most recently recognized token.
   const TokenDescriptor& current_token() const { return current_token_; }
 
@@ -124,6 +166,20 @@ class Scanner : ValueObject {
   // Initialize Scanner tables.
   void InitKeywordTable();
 
+  // Returns the table of keyword symbols, allocating it if needed.
+  static RawArray* KeywordSymbols();
+
+  bool IsOffHeap() const { return characters_ != NULL; }
+
+  int32_t CharAt(intptr_t index) const;
+
+  // Set the literal of the current token. Off the heap the literal is
+  // recorded in current_literal_ instead.
+  void SetKeywordLiteral(intptr_t keyword_index);
+  void SetIdentLiteral(intptr_t start, intptr_t length, intptr_t hash);
+  void SetNumberLiteral(intptr_t start, intptr_t length);
+  void SetStringLiteral(const int32_t* chars, intptr_t length);
+
   // Reads next lookahead character.
   void ReadChar();
 
@@ -205,6 +261,7 @@ class Scanner : ValueObject {
 
   TokenDescriptor current_token_;  // Current token.
   const String& source_;           // The source text being tokenized.
+  const uint16_t* characters_;     // The source characters when off heap.
   intptr_t source_length_;     // The length of the source text.
   intptr_t lookahead_pos_;     // Position of lookahead character
                                // within source_.
@@ -223,7 +280,11 @@ class Scanner : ValueObject {
 
   SourcePosition c0_pos_;      // Source position of lookahead character c0_.
   KeywordTable keywords_[Token::numKeywords];
-  Array& keyword_symbol_table_;  // Access to keyword symbols in object store.
+  Array* keyword_symbol_table_;  // Access to keyword symbols in object store.
+
+  Zone* zone_;
+  DeferredLiteral current_literal_;  // Literal of the current token off heap.
+  bool has_literal_;
 };
 
 
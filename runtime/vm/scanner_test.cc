@@ -429,6 +429,51 @@ void FindLineTest() {
 }
 
 
+// Scans 'source' off the heap and checks that the materialized tokens are
+// the same as the ones of the scanner working on the heap.
+void OffHeapTest(const char* source) {
+  const String& str = String::Handle(String::New(source));
+  const String& private_key = String::Handle(String::New("@key"));
+  Scanner scanner(str, private_key);
+  const Scanner::GrowableTokenStream& expected = scanner.GetStream();
+
+  Zone* zone = Isolate::Current()->current_zone();
+  uint16_t* characters = zone->Alloc<uint16_t>(str.Length());
+  for (intptr_t i = 0; i < str.Length(); i++) {
+    characters[i] = str.CharAt(i);
+  }
+  Scanner::TokenBuffer tokens(16, zone);
+  Scanner::LiteralBuffer literals(16, zone);
+  Scanner off_heap_scanner(characters, str.Length(), zone);
+  off_heap_scanner.ScanAll(&tokens, &literals);
+  const Scanner::GrowableTokenStream& actual =
+      Scanner::MaterializeTokens(tokens, literals, characters, private_key);
+
+  EXPECT_EQ(expected.length(), actual.length());
+  for (intptr_t i = 0; i < expected.length(); i++) {
+    EXPECT_EQ(expected[i].kind, actual[i].kind);
+    EXPECT_EQ(expected[i].offset, actual[i].offset);
+    EXPECT_EQ(expected[i].length, actual[i].length);
+    EXPECT_EQ(expected[i].position.line, actual[i].position.line);
+    EXPECT_EQ(expected[i].position.column, actual[i].position.column);
+    EXPECT_EQ(expected[i].literal == NULL, actual[i].literal == NULL);
+    if ((expected[i].literal != NULL) && (actual[i].literal != NULL)) {
+      EXPECT(expected[i].literal->Equals(*actual[i].literal));
+    }
+  }
+}
+
+
+TEST_CASE(Scanner_OffHeap) {
+  OffHeapTest("class A extends B {\n"
+              "  var _x = 0x1F, y = 1.5e3;\n"
+              "  get z => \"a$_x\\n${y + 1}\" '''\\u{1F600}''';\n"
+              "}\n");
+  OffHeapTest("r'raw\\n' /* comment */ \"unterminated");
+  OffHeapTest("\\");
+}
+
+
 TEST_CASE(Scanner_Test) {
   ScanLargeText();
 
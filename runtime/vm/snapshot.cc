@@ -1404,7 +1404,10 @@ void SnapshotWriter::ThrowException(Exceptions::ExceptionType type,
 }
 
 
-void ScriptSnapshotWriter::WriteScriptSnapshot(const Library& lib) {
+void ScriptSnapshotWriter::WriteScriptSnapshot(
+    const Library& lib,
+    const uint8_t* type_feedback,
+    intptr_t type_feedback_length) {
   ASSERT(kind() == Snapshot::kScript);
   Isolate* isolate = Isolate::Current();
   ASSERT(isolate != NULL);
@@ -1422,6 +1425,10 @@ void ScriptSnapshotWriter::WriteScriptSnapshot(const Library& lib) {
     NoGCScope no_gc;
     ReserveHeader();
     WriteObject(lib.raw());
+    // The type feedback is not part of the object graph, it is loaded once
+    // the library has been read.
+    WriteIntptrValue(type_feedback_length);
+    WriteBytes(type_feedback, type_feedback_length);
     FillHeader(kind());
     UnmarkAll();
     isolate->set_long_jump_base(base);
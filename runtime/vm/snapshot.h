@@ -189,6 +189,10 @@ class BaseReader {
     stream_.Advance(value);
   }
 
+  intptr_t PendingBytes() const {
+    return stream_.PendingBytes();
+  }
+
   RawSmi* ReadAsSmi();
   intptr_t ReadSmiValue();
 
@@ -566,8 +570,11 @@ class ScriptSnapshotWriter : public SnapshotWriter {
   }
   ~ScriptSnapshotWriter() { }
 
-  // Writes a partial snapshot of the script.
-  void WriteScriptSnapshot(const Library& lib);
+  // Writes a partial snapshot of the script, followed by the type feedback
+  // in 'type_feedback' (see TypeFeedback::Save).
+  void WriteScriptSnapshot(const Library& lib,
+                           const uint8_t* type_feedback,
+                           intptr_t type_feedback_length);
 
  private:
   DISALLOW_COPY_AND_ASSIGN(ScriptSnapshotWriter);
@@ -1225,6 +1225,107 @@ UNIT_TEST_CASE(ScriptSnapshot1) {
 }
 
 
+UNIT_TEST_CASE(ScriptSnapshotTypeFeedback) {
+  const char* kScriptChars =
+      "class A { foo() => 1; }\n"
+      "class B { foo() => 2; }\n"
+      "callFoo(x) => x.foo();\n"
+      "main() {\n"
+      "  var sum = 0;\n"
+      "  for (var i = 0; i < 10; i++) {\n"
+      "    sum += callFoo(new A()) + callFoo(new B());\n"
+      "  }\n"
+      "  return sum;\n"
+      "}\n";
+
+  Dart_Handle result;
+  uint8_t* buffer;
+  intptr_t size;
+  intptr_t type_feedback_size;
+  intptr_t script_snapshot_size;
+  uint8_t* full_snapshot = NULL;
+  uint8_t* type_feedback = NULL;
+  uint8_t* script_snapshot = NULL;
+
+  {
+    // Start an Isolate, and create a full snapshot of it.
+    TestIsolateScope __test_isolate__;
+    Dart_EnterScope();  // Start a Dart API scope for invoking API functions.
+    result = Dart_CreateSnapshot(&buffer, &size);
+    EXPECT_VALID(result);
+    full_snapshot = reinterpret_cast<uint8_t*>(malloc(size));
+    memmove(full_snapshot, buffer, size);
+    Dart_ExitScope();
+  }
+
+  {
+    // Run the script and save its type feedback.
+    TestCase::CreateTestIsolateFromSnapshot(full_snapshot);
+    Dart_EnterScope();  // Start a Dart API scope for invoking API functions.
+    Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+    EXPECT_VALID(Dart_Invoke(lib, NewString("main"), 0, NULL));
+    result = Dart_SaveTypeFeedback(&buffer, &type_feedback_size);
+    EXPECT_VALID(result);
+    type_feedback = reinterpret_cast<uint8_t*>(malloc(type_feedback_size));
+    memmove(type_feedback, buffer, type_feedback_size);
+    Dart_ExitScope();
+    Dart_ShutdownIsolate();
+  }
+
+  {
+    // Create a script snapshot that includes the type feedback.
+    TestCase::CreateTestIsolateFromSnapshot(full_snapshot);
+    Dart_EnterScope();  // Start a Dart API scope for invoking API functions.
+    TestCase::LoadTestScript(kScriptChars, NULL);
+    EXPECT_VALID(Dart_LoadTypeFeedback(type_feedback, type_feedback_size));
+    result = Dart_CreateScriptSnapshot(&buffer, &script_snapshot_size);
+    EXPECT_VALID(result);
+    script_snapshot = reinterpret_cast<uint8_t*>(malloc(script_snapshot_size));
+    memmove(script_snapshot, buffer, script_snapshot_size);
+    Dart_ExitScope();
+    Dart_ShutdownIsolate();
+  }
+
+  {
+    // The script loaded from the snapshot starts with the type feedback.
+    TestCase::CreateTestIsolateFromSnapshot(full_snapshot);
+    Dart_EnterScope();  // Start a Dart API scope for invoking API functions.
+    Dart_Handle lib =
+        Dart_LoadScriptFromSnapshot(script_snapshot, script_snapshot_size);
+    EXPECT_VALID(lib);
+    {
+      Isolate* isolate = Isolate::Current();
+      DARTSCOPE(isolate);
+      const Library& library = Library::CheckedHandle(Api::UnwrapHandle(lib));
+      const Function& call_foo = Function::Handle(
+          library.LookupLocalFunction(String::Handle(Symbols::New("callFoo"))));
+      EXPECT(call_foo.HasCode());
+      const Array& feedback = Array::Handle(
+          Code::Handle(call_foo.CurrentCode()).ExtractTypeFeedbackArray());
+      ICData& ic_data = ICData::Handle();
+      intptr_t num_checks = 0;
+      for (intptr_t i = 0; i < feedback.Length(); i++) {
+        if (feedback.At(i) != Object::null()) {
+          ic_data ^= feedback.At(i);
+          num_checks += ic_data.NumberOfChecks();
+        }
+      }
+      EXPECT_EQ(2, num_checks);
+    }
+    result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+    EXPECT_VALID(result);
+    int64_t value = 0;
+    EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+    EXPECT_EQ(30, value);
+    Dart_ExitScope();
+  }
+  Dart_ShutdownIsolate();
+  free(full_snapshot);
+  free(type_feedback);
+  free(script_snapshot);
+}
+
+
 TEST_CASE(IntArrayMessage) {
   StackZone zone(Isolate::Current());
   uint8_t* buffer = NULL;
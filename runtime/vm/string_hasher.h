@@ -0,0 +1,109 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef VM_STRING_HASHER_H_
+#define VM_STRING_HASHER_H_
+
+#include "vm/allocation.h"
+#include "vm/globals.h"
+#include "vm/unicode.h"
+
+namespace dart {
+
+// Computes the hash of the UTF-16 code units of a string. The code units are
+// mixed two at a time as one 32-bit word, using the mixing steps of
+// MurmurHash3, so the hash of a one byte string and of a two byte string with
+// the same characters is the same.
+//
+// The hash is cached in strings and symbols, and the scanner computes it
+// while it reads identifiers, so every string hash must be computed with
+// this class.
+class StringHasher : public ValueObject {
+ public:
+  StringHasher() : hash_(0), pending_(0), has_pending_(false), length_(0) {}
+
+  // Adds one UTF-16 code unit.
+  void Add(uint16_t code_unit) {
+    if (has_pending_) {
+      AddWord(pending_ | (static_cast<uint32_t>(code_unit) << 16));
+      has_pending_ = false;
+    } else {
+      pending_ = code_unit;
+      has_pending_ = true;
+    }
+    length_++;
+  }
+
+  // Adds a code point as one or two UTF-16 code units.
+  void AddCodePoint(int32_t code_point) {
+    if (Utf::IsSupplementary(code_point)) {
+      uint16_t code_units[2];
+      Utf16::Encode(code_point, code_units);
+      Add(code_units[0]);
+      Add(code_units[1]);
+    } else {
+      Add(static_cast<uint16_t>(code_point));
+    }
+  }
+
+  // Adds an array of Latin-1 characters or UTF-16 code units.
+  template<typename CharType>
+  void AddAll(const CharType* chars, intptr_t len) {
+    intptr_t i = 0;
+    if (has_pending_ && (len > 0)) {
+      Add(chars[i++]);
+    }
+    const intptr_t start = i;
+    for (; i + 1 < len; i += 2) {
+      AddWord(chars[i] | (static_cast<uint32_t>(chars[i + 1]) << 16));
+    }
+    length_ += static_cast<uint32_t>(i - start);
+    if (i < len) {
+      Add(chars[i]);
+    }
+  }
+
+  // Returns a non-zero hash of at most 'bits' bits.
+  intptr_t Finalize(int bits) {
+    ASSERT(1 <= bits && bits <= (kBitsPerWord - 1));
+    if (has_pending_) {
+      hash_ ^= Scramble(pending_);
+    }
+    hash_ ^= length_;
+    hash_ ^= hash_ >> 16;
+    hash_ *= 0x85ebca6b;
+    hash_ ^= hash_ >> 13;
+    hash_ *= 0xc2b2ae35;
+    hash_ ^= hash_ >> 16;
+    hash_ = hash_ & ((static_cast<intptr_t>(1) << bits) - 1);
+    ASSERT(hash_ <= static_cast<uint32_t>(kMaxInt32));
+    return hash_ == 0 ? 1 : hash_;
+  }
+
+ private:
+  static uint32_t Rotate(uint32_t value, int bits) {
+    return (value << bits) | (value >> (32 - bits));
+  }
+
+  static uint32_t Scramble(uint32_t word) {
+    word *= 0xcc9e2d51;
+    word = Rotate(word, 15);
+    return word * 0x1b873593;
+  }
+
+  void AddWord(uint32_t word) {
+    hash_ ^= Scramble(word);
+    hash_ = Rotate(hash_, 13);
+    hash_ = hash_ * 5 + 0xe6546b64;
+  }
+
+  uint32_t hash_;
+  uint32_t pending_;  // The first code unit of a word, if 'has_pending_'.
+  bool has_pending_;
+  uint32_t length_;  // Number of code units added.
+};
+
+}  // namespace dart
+
+#endif  // VM_STRING_HASHER_H_
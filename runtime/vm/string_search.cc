@@ -0,0 +1,331 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/string_search.h"
+
+#include "platform/utils.h"
+
+#if defined(HOST_ARCH_IA32) || defined(HOST_ARCH_X64)
+#define USE_SSE2_STRING_SEARCH 1
+#include <emmintrin.h>  // NOLINT
+#endif
+
+namespace dart {
+
+#if defined(USE_SSE2_STRING_SEARCH)
+static const intptr_t kBlockSize = 16;  // Bytes in an SSE2 register.
+
+
+static inline __m128i LoadBlock(const void* address) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(address));
+}
+
+
+static inline void StoreBlock(void* address, __m128i value) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(address), value);
+}
+
+
+// Returns the index of the lowest set bit of a non-zero byte mask.
+static inline intptr_t FirstBit(intptr_t mask) {
+  ASSERT(mask != 0);
+  return Utils::CountTrailingZeros(static_cast<uword>(mask));
+}
+
+
+// Returns a mask of the bytes of 'block' in the range [from, from + limit],
+// where 'from' and 'limit' are broadcast to all bytes.
+static inline __m128i InRange(__m128i block, __m128i from, __m128i limit) {
+  const __m128i offset = _mm_sub_epi8(block, from);
+  return _mm_cmpeq_epi8(_mm_max_epu8(offset, limit), limit);
+}
+#endif  // defined(USE_SSE2_STRING_SEARCH)
+
+
+intptr_t StringSearch::IndexOf(const uint8_t* chars,
+                               intptr_t len,
+                               uint8_t ch) {
+  intptr_t i = 0;
+#if defined(USE_SSE2_STRING_SEARCH)
+  const __m128i needle = _mm_set1_epi8(ch);
+  for (; i + kBlockSize <= len; i += kBlockSize) {
+    const __m128i block = LoadBlock(chars + i);
+    const intptr_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+    if (mask != 0) {
+      return i + FirstBit(mask);
+    }
+  }
+#endif
+  for (; i < len; i++) {
+    if (chars[i] == ch) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+intptr_t StringSearch::IndexOf(const uint16_t* chars,
+                               intptr_t len,
+                               uint16_t ch) {
+  intptr_t i = 0;
+#if defined(USE_SSE2_STRING_SEARCH)
+  const intptr_t kCharsPerBlock = kBlockSize / sizeof(*chars);
+  const __m128i needle = _mm_set1_epi16(ch);
+  for (; i + kCharsPerBlock <= len; i += kCharsPerBlock) {
+    const __m128i block = LoadBlock(chars + i);
+    // Two mask bits per character.
+    const intptr_t mask = _mm_movemask_epi8(_mm_cmpeq_epi16(block, needle));
+    if (mask != 0) {
+      return i + (FirstBit(mask) >> 1);
+    }
+  }
+#endif
+  for (; i < len; i++) {
+    if (chars[i] == ch) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+// The substring searches first look for positions where both the first and
+// the last character of the pattern match, a block of positions at a time,
+// and only compare the remaining characters at these candidates.
+intptr_t StringSearch::IndexOf(const uint8_t* chars,
+                               intptr_t len,
+                               const uint8_t* pattern,
+                               intptr_t pattern_len) {
+  if (pattern_len == 0) {
+    return 0;
+  }
+  if (pattern_len == 1) {
+    return IndexOf(chars, len, pattern[0]);
+  }
+  const intptr_t last_start = len - pattern_len;
+  const intptr_t last = pattern_len - 1;
+  intptr_t i = 0;
+#if defined(USE_SSE2_STRING_SEARCH)
+  const __m128i first_char = _mm_set1_epi8(pattern[0]);
+  const __m128i last_char = _mm_set1_epi8(pattern[last]);
+  for (; i + kBlockSize <= last_start + 1; i += kBlockSize) {
+    const __m128i firsts = _mm_cmpeq_epi8(LoadBlock(chars + i), first_char);
+    const __m128i lasts =
+        _mm_cmpeq_epi8(LoadBlock(chars + i + last), last_char);
+    intptr_t mask = _mm_movemask_epi8(_mm_and_si128(firsts, lasts));
+    while (mask != 0) {
+      const intptr_t candidate = i + FirstBit(mask);
+      if (memcmp(chars + candidate + 1, pattern + 1, last - 1) == 0) {
+        return candidate;
+      }
+      mask &= mask - 1;
+    }
+  }
+#endif
+  for (; i <= last_start; i++) {
+    if ((chars[i] == pattern[0]) &&
+        (chars[i + last] == pattern[last]) &&
+        (memcmp(chars + i + 1, pattern + 1, last - 1) == 0)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+intptr_t StringSearch::IndexOf(const uint16_t* chars,
+                               intptr_t len,
+                               const uint16_t* pattern,
+                               intptr_t pattern_len) {
+  if (pattern_len == 0) {
+    return 0;
+  }
+  if (pattern_len == 1) {
+    return IndexOf(chars, len, pattern[0]);
+  }
+  const intptr_t last_start = len - pattern_len;
+  const intptr_t last = pattern_len - 1;
+  const intptr_t middle_size = (last - 1) * sizeof(*pattern);
+  intptr_t i = 0;
+#if defined(USE_SSE2_STRING_SEARCH)
+  const intptr_t kCharsPerBlock = kBlockSize / sizeof(*chars);
+  const __m128i first_char = _mm_set1_epi16(pattern[0]);
+  const __m128i last_char = _mm_set1_epi16(pattern[last]);
+  for (; i + kCharsPerBlock <= last_start + 1; i += kCharsPerBlock) {
+    const __m128i firsts = _mm_cmpeq_epi16(LoadBlock(chars + i), first_char);
+    const __m128i lasts =
+        _mm_cmpeq_epi16(LoadBlock(chars + i + last), last_char);
+    // Two mask bits per character.
+    intptr_t mask = _mm_movemask_epi8(_mm_and_si128(firsts, lasts));
+    while (mask != 0) {
+      const intptr_t bit = FirstBit(mask);
+      const intptr_t candidate = i + (bit >> 1);
+      if (memcmp(chars + candidate + 1, pattern + 1, middle_size) == 0) {
+        return candidate;
+      }
+      mask &= ~(static_cast<intptr_t>(3) << bit);
+    }
+  }
+#endif
+  for (; i <= last_start; i++) {
+    if ((chars[i] == pattern[0]) &&
+        (chars[i + last] == pattern[last]) &&
+        (memcmp(chars + i + 1, pattern + 1, middle_size) == 0)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+intptr_t StringSearch::IndexOfRange(const uint8_t* chars,
+                                    intptr_t len,
+                                    uint8_t from,
+                                    uint8_t to) {
+  ASSERT(from <= to);
+  intptr_t i = 0;
+#if defined(USE_SSE2_STRING_SEARCH)
+  const __m128i from_block = _mm_set1_epi8(from);
+  const __m128i limit_block = _mm_set1_epi8(to - from);
+  for (; i + kBlockSize <= len; i += kBlockSize) {
+    const __m128i block = LoadBlock(chars + i);
+    const intptr_t mask =
+        _mm_movemask_epi8(InRange(block, from_block, limit_block));
+    if (mask != 0) {
+      return i + FirstBit(mask);
+    }
+  }
+#endif
+  for (; i < len; i++) {
+    if ((chars[i] >= from) && (chars[i] <= to)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+bool StringSearch::Equals(const uint8_t* a, const uint8_t* b, intptr_t len) {
+  return memcmp(a, b, len) == 0;
+}
+
+
+bool StringSearch::Equals(const uint16_t* a,
+                          const uint16_t* b,
+                          intptr_t len) {
+  return memcmp(a, b, len * sizeof(*a)) == 0;
+}
+
+
+bool StringSearch::Equals(const uint8_t* a,
+                          const uint16_t* b,
+                          intptr_t len) {
+  intptr_t i = 0;
+#if defined(USE_SSE2_STRING_SEARCH)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + kBlockSize <= len; i += kBlockSize) {
+    // Widen 16 Latin-1 characters to two blocks of UTF-16 code units.
+    const __m128i latin1 = LoadBlock(a + i);
+    const __m128i low = _mm_unpacklo_epi8(latin1, zero);
+    const __m128i high = _mm_unpackhi_epi8(latin1, zero);
+    const __m128i equal =
+        _mm_and_si128(_mm_cmpeq_epi16(low, LoadBlock(b + i)),
+                      _mm_cmpeq_epi16(high, LoadBlock(b + i + 8)));
+    if (_mm_movemask_epi8(equal) != 0xFFFF) {
+      return false;
+    }
+  }
+#endif
+  for (; i < len; i++) {
+    if (a[i] != b[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+bool StringSearch::IsAscii(const uint8_t* chars, intptr_t len) {
+  intptr_t i = 0;
+#if defined(USE_SSE2_STRING_SEARCH)
+  for (; i + kBlockSize <= len; i += kBlockSize) {
+    // The mask has the top bit of every byte.
+    if (_mm_movemask_epi8(LoadBlock(chars + i)) != 0) {
+      return false;
+    }
+  }
+#endif
+  for (; i < len; i++) {
+    if (chars[i] > 0x7F) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+bool StringSearch::IsLatin1(const uint16_t* chars, intptr_t len) {
+  intptr_t i = 0;
+#if defined(USE_SSE2_STRING_SEARCH)
+  const intptr_t kCharsPerBlock = kBlockSize / sizeof(*chars);
+  const __m128i high_bytes = _mm_set1_epi16(0xFF00);
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + kCharsPerBlock <= len; i += kCharsPerBlock) {
+    const __m128i high = _mm_and_si128(LoadBlock(chars + i), high_bytes);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xFFFF) {
+      return false;
+    }
+  }
+#endif
+  for (; i < len; i++) {
+    if (chars[i] > 0xFF) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+// Flips the case bit of the characters of 'src' in the range [from, to],
+// which is either 'A'-'Z' or 'a'-'z'.
+static void FlipAsciiCase(const uint8_t* src,
+                          uint8_t* dst,
+                          intptr_t len,
+                          uint8_t from,
+                          uint8_t to) {
+  const uint8_t kCaseBit = 'a' - 'A';
+  intptr_t i = 0;
+#if defined(USE_SSE2_STRING_SEARCH)
+  const __m128i from_block = _mm_set1_epi8(from);
+  const __m128i limit_block = _mm_set1_epi8(to - from);
+  const __m128i case_bit = _mm_set1_epi8(kCaseBit);
+  for (; i + kBlockSize <= len; i += kBlockSize) {
+    const __m128i block = LoadBlock(src + i);
+    const __m128i letters = InRange(block, from_block, limit_block);
+    StoreBlock(dst + i,
+               _mm_xor_si128(block, _mm_and_si128(letters, case_bit)));
+  }
+#endif
+  for (; i < len; i++) {
+    const uint8_t ch = src[i];
+    dst[i] = ((ch >= from) && (ch <= to)) ? (ch ^ kCaseBit) : ch;
+  }
+}
+
+
+void StringSearch::ToLowerAscii(const uint8_t* src,
+                                uint8_t* dst,
+                                intptr_t len) {
+  FlipAsciiCase(src, dst, len, 'A', 'Z');
+}
+
+
+void StringSearch::ToUpperAscii(const uint8_t* src,
+                                uint8_t* dst,
+                                intptr_t len) {
+  FlipAsciiCase(src, dst, len, 'a', 'z');
+}
+
+}  // namespace dart
@@ -0,0 +1,63 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef VM_STRING_SEARCH_H_
+#define VM_STRING_SEARCH_H_
+
+#include "vm/allocation.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+// Scanning primitives over the characters of one byte (Latin-1) and two byte
+// (UTF-16) strings. On ia32 and x64 they compare 16 bytes at a time using
+// SSE2, which every supported processor of these architectures implements;
+// on other architectures they fall back to scalar loops.
+//
+// The character arrays are raw string contents, so the callers must not
+// allow a GC while a scan is in progress.
+class StringSearch : AllStatic {
+ public:
+  // Returns the index of the first occurrence of 'ch' in 'chars', or -1.
+  static intptr_t IndexOf(const uint8_t* chars, intptr_t len, uint8_t ch);
+  static intptr_t IndexOf(const uint16_t* chars, intptr_t len, uint16_t ch);
+
+  // Returns the index of the first occurrence of 'pattern' in 'chars', or
+  // -1. An empty pattern occurs at index 0.
+  static intptr_t IndexOf(const uint8_t* chars,
+                          intptr_t len,
+                          const uint8_t* pattern,
+                          intptr_t pattern_len);
+  static intptr_t IndexOf(const uint16_t* chars,
+                          intptr_t len,
+                          const uint16_t* pattern,
+                          intptr_t pattern_len);
+
+  // Returns the index of the first character of 'chars' in the range
+  // ['from', 'to'], or -1.
+  static intptr_t IndexOfRange(const uint8_t* chars,
+                               intptr_t len,
+                               uint8_t from,
+                               uint8_t to);
+
+  // Compares 'len' characters of 'a' and 'b'.
+  static bool Equals(const uint8_t* a, const uint8_t* b, intptr_t len);
+  static bool Equals(const uint16_t* a, const uint16_t* b, intptr_t len);
+  static bool Equals(const uint8_t* a, const uint16_t* b, intptr_t len);
+
+  // Returns true if all characters of 'chars' are ASCII.
+  static bool IsAscii(const uint8_t* chars, intptr_t len);
+
+  // Returns true if all characters of 'chars' are Latin-1.
+  static bool IsLatin1(const uint16_t* chars, intptr_t len);
+
+  // Copies 'len' characters of 'src' to 'dst' and maps the ASCII letters to
+  // lower or upper case. 'src' and 'dst' may be the same array.
+  static void ToLowerAscii(const uint8_t* src, uint8_t* dst, intptr_t len);
+  static void ToUpperAscii(const uint8_t* src, uint8_t* dst, intptr_t len);
+};
+
+}  // namespace dart
+
+#endif  // VM_STRING_SEARCH_H_
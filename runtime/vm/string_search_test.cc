@@ -0,0 +1,155 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/assert.h"
+#include "vm/object.h"
+#include "vm/string_search.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+// Long enough for the scans to use whole blocks and a scalar tail.
+static const intptr_t kTextLength = 53;
+
+
+TEST_CASE(StringSearch_IndexOfChar) {
+  uint8_t latin1[kTextLength];
+  uint16_t utf16[kTextLength];
+  for (intptr_t i = 0; i < kTextLength; i++) {
+    latin1[i] = 'a';
+    utf16[i] = 0x3b1;
+  }
+  EXPECT_EQ(-1, StringSearch::IndexOf(latin1, kTextLength, 'b'));
+  EXPECT_EQ(-1, StringSearch::IndexOf(utf16, kTextLength, 0x3b2));
+  for (intptr_t i = 0; i < kTextLength; i++) {
+    latin1[i] = 0xe9;
+    utf16[i] = 0x3b2;
+    EXPECT_EQ(i, StringSearch::IndexOf(latin1, kTextLength, 0xe9));
+    EXPECT_EQ(i, StringSearch::IndexOf(utf16, kTextLength, 0x3b2));
+    // The first occurrence is found.
+    EXPECT_EQ(i, StringSearch::IndexOf(latin1, i + 1, 0xe9));
+    latin1[i] = 'a';
+    utf16[i] = 0x3b1;
+  }
+  EXPECT_EQ(-1, StringSearch::IndexOf(latin1, 0, 'a'));
+}
+
+
+TEST_CASE(StringSearch_IndexOfPattern) {
+  uint8_t latin1[kTextLength];
+  uint16_t utf16[kTextLength];
+  for (intptr_t i = 0; i < kTextLength; i++) {
+    latin1[i] = 'a' + (i % 3);
+    utf16[i] = 0x3b1 + (i % 3);
+  }
+  const uint8_t latin1_pattern[] = { 'x', 'b', 'c', 'y' };
+  const uint16_t utf16_pattern[] = { 0x3c7, 0x3b2, 0x3b3, 0x3c8 };
+  for (intptr_t pattern_len = 1; pattern_len <= 4; pattern_len++) {
+    EXPECT_EQ(-1, StringSearch::IndexOf(latin1, kTextLength,
+                                        latin1_pattern, pattern_len));
+    EXPECT_EQ(-1, StringSearch::IndexOf(utf16, kTextLength,
+                                        utf16_pattern, pattern_len));
+    for (intptr_t i = 0; i + pattern_len <= kTextLength; i++) {
+      memmove(latin1 + i, latin1_pattern, pattern_len);
+      memmove(utf16 + i, utf16_pattern, pattern_len * sizeof(*utf16));
+      EXPECT_EQ(i, StringSearch::IndexOf(latin1, kTextLength,
+                                         latin1_pattern, pattern_len));
+      EXPECT_EQ(i, StringSearch::IndexOf(utf16, kTextLength,
+                                         utf16_pattern, pattern_len));
+      for (intptr_t j = i; j < i + pattern_len; j++) {
+        latin1[j] = 'a' + (j % 3);
+        utf16[j] = 0x3b1 + (j % 3);
+      }
+    }
+  }
+  const uint8_t prefix[] = { 'a', 'b', 'c' };
+  EXPECT_EQ(0, StringSearch::IndexOf(latin1, kTextLength, prefix, 3));
+  EXPECT_EQ(-1, StringSearch::IndexOf(latin1, 2, prefix, 3));
+  EXPECT_EQ(0, StringSearch::IndexOf(latin1, kTextLength, prefix, 0));
+}
+
+
+TEST_CASE(StringSearch_EqualsAndRanges) {
+  uint8_t latin1[kTextLength];
+  uint16_t utf16[kTextLength];
+  for (intptr_t i = 0; i < kTextLength; i++) {
+    latin1[i] = 'A' + (i % 26);
+    utf16[i] = latin1[i];
+  }
+  EXPECT(StringSearch::Equals(latin1, utf16, kTextLength));
+  EXPECT(StringSearch::IsAscii(latin1, kTextLength));
+  EXPECT(StringSearch::IsLatin1(utf16, kTextLength));
+  EXPECT_EQ(-1, StringSearch::IndexOfRange(latin1, kTextLength, 'a', 'z'));
+  EXPECT_EQ(25, StringSearch::IndexOfRange(latin1, kTextLength, 'Z', 'Z'));
+  for (intptr_t i = 0; i < kTextLength; i++) {
+    utf16[i] = 0x100;
+    EXPECT(!StringSearch::Equals(latin1, utf16, kTextLength));
+    EXPECT(!StringSearch::IsLatin1(utf16, kTextLength));
+    utf16[i] = latin1[i];
+    latin1[i] = 0xff;
+    EXPECT(!StringSearch::IsAscii(latin1, kTextLength));
+    EXPECT_EQ(i, StringSearch::IndexOfRange(latin1, kTextLength, 0x80, 0xff));
+    latin1[i] = utf16[i];
+  }
+}
+
+
+TEST_CASE(StringSearch_AsciiCase) {
+  const char* text = "GET /Index.html?Q=1 HTTP/1.1 200 \xc9t\xe9 [@`{~] ok";
+  const intptr_t len = strlen(text);
+  const uint8_t* chars = reinterpret_cast<const uint8_t*>(text);
+  uint8_t lower[64];
+  uint8_t upper[64];
+  StringSearch::ToLowerAscii(chars, lower, len);
+  StringSearch::ToUpperAscii(chars, upper, len);
+  EXPECT(!memcmp("get /index.html?q=1 http/1.1 200 \xc9t\xe9 [@`{~] ok",
+                 lower, len));
+  EXPECT(!memcmp("GET /INDEX.HTML?Q=1 HTTP/1.1 200 \xc9T\xe9 [@`{~] OK",
+                 upper, len));
+}
+
+
+TEST_CASE(String_IndexOf) {
+  const String& text = String::Handle(
+      String::New("2013-05-20 10:00:01 WARN [worker-3] user=bob retry=2"));
+  const String& user = String::Handle(String::New("user="));
+  const String& missing = String::Handle(String::New("ERROR"));
+  const String& umlaut = String::Handle(String::New("w\xc3\xb6rker"));
+  const String& empty = String::Handle(String::New(""));
+  EXPECT(text.IsOneByteString());
+  EXPECT_EQ(36, String::IndexOf(text, user, 0));
+  EXPECT_EQ(36, String::IndexOf(text, user, 36));
+  EXPECT_EQ(-1, String::IndexOf(text, user, 37));
+  EXPECT_EQ(-1, String::IndexOf(text, missing, 0));
+  EXPECT_EQ(-1, String::IndexOf(text, umlaut, 0));
+  EXPECT_EQ(5, String::IndexOf(text, empty, 5));
+  EXPECT_EQ(4, String::IndexOfCodeUnit(text, '-', 0));
+  EXPECT_EQ(7, String::IndexOfCodeUnit(text, '-', 5));
+  EXPECT_EQ(-1, String::IndexOfCodeUnit(text, 0x3b1, 0));
+
+  const uint16_t greek_chars[] = { 0x3b1, 'x', 0x3b2, 'u', 's', 'e', 'r', '=' };
+  const String& greek = String::Handle(
+      String::FromUTF16(greek_chars, ARRAY_SIZE(greek_chars)));
+  // The one byte pattern is compared at every position of the two byte
+  // string.
+  EXPECT(greek.IsTwoByteString());
+  EXPECT_EQ(3, String::IndexOf(greek, user, 0));
+  EXPECT_EQ(2, String::IndexOfCodeUnit(greek, 0x3b2, 0));
+
+  const String& lower = String::Handle(String::ToLowerCase(text));
+  EXPECT(lower.Equals(
+      "2013-05-20 10:00:01 warn [worker-3] user=bob retry=2"));
+  const String& upper = String::Handle(String::ToUpperCase(lower));
+  EXPECT(upper.Equals(
+      "2013-05-20 10:00:01 WARN [WORKER-3] USER=BOB RETRY=2"));
+  // Strings without letters to map are returned as they are.
+  const String& digits = String::Handle(String::New("12:00"));
+  EXPECT_EQ(digits.raw(), String::ToUpperCase(digits));
+  // Latin-1 letters are mapped outside of the ASCII fast path.
+  const String& latin1 = String::Handle(String::New("\xc3\xa9t\xc3\xa9"));
+  EXPECT(String::Handle(String::ToUpperCase(latin1)).Equals(
+      "\xc3\x89T\xc3\x89"));
+}
+
+}  // namespace dart
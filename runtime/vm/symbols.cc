@@ -228,18 +228,26 @@ RawString* Symbols::New(const String& str) {
 
 
 RawString* Symbols::New(const String& str, intptr_t begin_index, intptr_t len) {
+  // Calculate the String hash for this sequence of characters.
+  intptr_t hash = (begin_index == 0 && len == str.Length()) ? str.Hash() :
+      String::Hash(str, begin_index, len);
+  return New(str, begin_index, len, hash);
+}
+
+
+RawString* Symbols::New(const String& str,
+                        intptr_t begin_index,
+                        intptr_t len,
+                        intptr_t hash) {
   ASSERT(begin_index >= 0);
   ASSERT(len >= 0);
   ASSERT((begin_index + len) <= str.Length());
+  ASSERT(hash == String::Hash(str, begin_index, len));
   Isolate* isolate = Isolate::Current();
   ASSERT(isolate != Dart::vm_isolate());
   String& symbol = String::Handle(isolate, String::null());
   Array& symbol_table = Array::Handle(isolate, Array::null());
 
-  // Calculate the String hash for this sequence of characters.
-  intptr_t hash = (begin_index == 0 && len == str.Length()) ? str.Hash() :
-      String::Hash(str, begin_index, len);
-
   // First check if a symbol exists in the vm isolate for these characters.
   symbol_table = Dart::vm_isolate()->object_store()->symbol_table();
   intptr_t index = FindIndex(symbol_table, str, begin_index, len, hash);
@@ -258,8 +266,8 @@ RawString* Symbols::New(const String& str, intptr_t begin_index, intptr_t len) {
       } else {
         // Allocate a copy in old space.
         symbol = String::SubString(str, begin_index, len, Heap::kOld);
-        symbol.SetHash(hash);
       }
+      symbol.SetHash(hash);
       InsertIntoSymbolTable(symbol_table, symbol, index);
     }
   }
@@ -365,6 +365,12 @@ PREDEFINED_SYMBOLS_LIST(DEFINE_SYMBOL_HANDLE_ACCESSOR)
   static RawString* New(const String& str,
                         intptr_t begin_index,
                         intptr_t length);
+  // Same as above, for callers that computed the hash of the characters
+  // with String::Hash or a StringHasher while reading them.
+  static RawString* New(const String& str,
+                        intptr_t begin_index,
+                        intptr_t length,
+                        intptr_t hash);
 
   // Returns char* of predefined symbol.
   static const char* Name(SymbolId symbol);
@@ -0,0 +1,511 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/type_feedback.h"
+
+#include "vm/class_table.h"
+#include "vm/compiler.h"
+#include "vm/flags.h"
+#include "vm/isolate.h"
+#include "vm/object.h"
+#include "vm/resolver.h"
+#include "vm/scanner.h"
+#include "vm/symbols.h"
+#include "vm/unicode.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool, trace_type_feedback, false,
+    "Trace saving and loading of persisted type feedback.");
+DECLARE_FLAG(int, optimization_counter_threshold);
+
+static const int32_t kTypeFeedbackMagic = 0x54466264;  // 'TFbd'
+static const intptr_t kTypeFeedbackVersion = 1;
+
+// Bits of the per function flags.
+static const intptr_t kHadOptimizedCode = 1 << 0;
+static const intptr_t kNotInlinable = 1 << 1;
+
+
+// Returns the name with the private keys removed, e.g. "_Foo@6be832b.bar"
+// becomes "_Foo.bar". Private keys depend on the order in which libraries
+// are loaded, the name without them is matched with
+// String::EqualsIgnoringPrivateKey when the feedback is loaded.
+static const char* StripPrivateKeys(const String& name) {
+  const char* cstr = name.ToCString();
+  const intptr_t len = strlen(cstr);
+  char* result = Isolate::Current()->current_zone()->Alloc<char>(len + 1);
+  intptr_t pos = 0;
+  intptr_t result_pos = 0;
+  while (pos < len) {
+    if (cstr[pos] == Scanner::kPrivateKeySeparator) {
+      while ((pos < len) && (cstr[pos] != '.')) {
+        pos++;
+      }
+      continue;
+    }
+    result[result_pos++] = cstr[pos++];
+  }
+  result[result_pos] = '\0';
+  return result;
+}
+
+
+// Returns the index of the check of 'ic_data' for the given class ids or -1.
+static intptr_t FindCheck(const ICData& ic_data,
+                          const GrowableArray<intptr_t>& class_ids) {
+  GrowableArray<intptr_t> check_class_ids(class_ids.length());
+  Function& target = Function::Handle();
+  for (intptr_t i = 0; i < ic_data.NumberOfChecks(); i++) {
+    ic_data.GetCheckAt(i, &check_class_ids, &target);
+    bool matches = true;
+    for (intptr_t j = 0; j < class_ids.length(); j++) {
+      if (check_class_ids[j] != class_ids[j]) {
+        matches = false;
+        break;
+      }
+    }
+    if (matches) return i;
+  }
+  return -1;
+}
+
+
+// Type feedback is persisted per function of a class with unoptimized code:
+//
+//   library url, class name, function name, source fingerprint,
+//   usage counter, flags, optimized instruction count,
+//   optimized call site count, number of ICData entries,
+//   for each ICData entry:
+//     deopt id, number of arguments tested, target name, number of checks,
+//     for each check:
+//       count, a class reference per argument tested,
+//       target name, target source fingerprint
+//
+// Strings are written as length and UTF-8 bytes, names without private keys.
+// Predefined classes are referred to by class id, all other classes by
+// kIllegalCid followed by library url and class name.
+class TypeFeedbackWriter : public ValueObject {
+ public:
+  TypeFeedbackWriter(uint8_t** buffer, ReAlloc alloc)
+      : stream_(buffer, alloc, kInitialSize) { }
+
+  intptr_t BytesWritten() const { return stream_.bytes_written(); }
+
+  void WriteHeader() {
+    WriteInt32(kTypeFeedbackMagic);
+    WriteUnsigned(kTypeFeedbackVersion);
+  }
+
+  void WriteFunction(const Function& function) {
+    if (function.IsClosureFunction() || !function.HasCode()) return;
+    const Code& code = Code::Handle(function.HasOptimizedCode() ?
+        function.unoptimized_code() : function.CurrentCode());
+    if (code.IsNull() || code.is_optimized()) return;
+    const Array& ic_data_array =
+        Array::Handle(code.ExtractTypeFeedbackArray());
+    ICData& ic_data = ICData::Handle();
+    intptr_t num_entries = 0;
+    for (intptr_t i = 0; i < ic_data_array.Length(); i++) {
+      ic_data ^= ic_data_array.At(i);
+      if (IsPersistent(ic_data)) num_entries++;
+    }
+    if ((num_entries == 0) && (function.usage_counter() <= 0)) return;
+
+    const Class& owner = Class::Handle(function.Owner());
+    const Library& library = Library::Handle(owner.library());
+    if (library.IsNull()) return;
+    WriteString(String::Handle(library.url()));
+    WriteName(String::Handle(owner.Name()));
+    WriteName(String::Handle(function.name()));
+    WriteInt32(function.SourceFingerprint());
+    WriteInt(function.usage_counter());
+    intptr_t flags = 0;
+    if (function.HasOptimizedCode()) flags |= kHadOptimizedCode;
+    if (!function.IsInlineable()) flags |= kNotInlinable;
+    WriteUnsigned(flags);
+    WriteUnsigned(function.optimized_instruction_count());
+    WriteUnsigned(function.optimized_call_site_count());
+    WriteUnsigned(num_entries);
+
+    GrowableArray<intptr_t> class_ids;
+    Function& target = Function::Handle();
+    Class& cls = Class::Handle();
+    ClassTable* class_table = Isolate::Current()->class_table();
+    for (intptr_t i = 0; i < ic_data_array.Length(); i++) {
+      ic_data ^= ic_data_array.At(i);
+      if (!IsPersistent(ic_data)) continue;
+      WriteUnsigned(ic_data.deopt_id());
+      WriteUnsigned(ic_data.num_args_tested());
+      WriteName(String::Handle(ic_data.target_name()));
+      WriteUnsigned(ic_data.NumberOfChecks());
+      for (intptr_t j = 0; j < ic_data.NumberOfChecks(); j++) {
+        ic_data.GetCheckAt(j, &class_ids, &target);
+        WriteUnsigned(ic_data.GetCountAt(j));
+        for (intptr_t k = 0; k < class_ids.length(); k++) {
+          cls = class_table->At(class_ids[k]);
+          WriteClass(cls);
+        }
+        WriteName(String::Handle(target.name()));
+        WriteInt32(target.SourceFingerprint());
+      }
+    }
+
+    if (FLAG_trace_type_feedback) {
+      OS::Print("TypeFeedback: saved %s (%"Pd" call sites)\n",
+                function.ToFullyQualifiedCString(), num_entries);
+    }
+  }
+
+ private:
+  static const intptr_t kInitialSize = 64 * KB;
+
+  static bool IsPersistent(const ICData& ic_data) {
+    return !ic_data.IsNull() &&
+        (ic_data.num_args_tested() > 0) &&
+        !ic_data.is_closure_call() &&
+        (ic_data.NumberOfChecks() > 0);
+  }
+
+  void WriteUnsigned(intptr_t value) {
+    stream_.WriteUnsigned(value);
+  }
+
+  void WriteInt(intptr_t value) {
+    WriteStream::Raw<sizeof(int64_t), int64_t>::Write(&stream_, value);
+  }
+
+  void WriteInt32(int32_t value) {
+    WriteStream::Raw<sizeof(int32_t), int32_t>::Write(&stream_, value);
+  }
+
+  void WriteCString(const char* cstr) {
+    const intptr_t len = strlen(cstr);
+    WriteUnsigned(len);
+    stream_.WriteBytes(reinterpret_cast<const uint8_t*>(cstr), len);
+  }
+
+  void WriteString(const String& str) {
+    WriteCString(str.ToCString());
+  }
+
+  void WriteName(const String& name) {
+    WriteCString(StripPrivateKeys(name));
+  }
+
+  void WriteClass(const Class& cls) {
+    if (cls.id() < kNumPredefinedCids) {
+      WriteUnsigned(cls.id());
+      return;
+    }
+    WriteUnsigned(kIllegalCid);
+    const Library& library = Library::Handle(cls.library());
+    if (library.IsNull()) {
+      WriteCString("");
+    } else {
+      WriteString(String::Handle(library.url()));
+    }
+    WriteName(String::Handle(cls.Name()));
+  }
+
+  WriteStream stream_;
+
+  DISALLOW_COPY_AND_ASSIGN(TypeFeedbackWriter);
+};
+
+
+// Reads the format written by TypeFeedbackWriter. The buffer comes from a
+// file, every read is checked against the end of the buffer and sets the
+// error bit instead of reading past it.
+class TypeFeedbackReader : public ValueObject {
+ public:
+  TypeFeedbackReader(const uint8_t* buffer, intptr_t size)
+      : buffer_(buffer), size_(size), stream_(buffer, size), error_(false) { }
+
+  bool has_error() const { return error_; }
+  bool AtEnd() const { return error_ || (stream_.Position() == size_); }
+
+  bool ReadHeader() {
+    return (ReadInt32() == kTypeFeedbackMagic) &&
+        (ReadUnsigned() == kTypeFeedbackVersion) &&
+        !error_;
+  }
+
+  intptr_t ReadUnsigned() {
+    if (!HasValue()) return 0;
+    return stream_.ReadUnsigned();
+  }
+
+  intptr_t ReadInt() {
+    if (!HasValue()) return 0;
+    return ReadStream::Raw<sizeof(int64_t), int64_t>::Read(&stream_);
+  }
+
+  int32_t ReadInt32() {
+    if (!HasValue()) return 0;
+    return ReadStream::Raw<sizeof(int32_t), int32_t>::Read(&stream_);
+  }
+
+  // Returns the string as a symbol, or String::null() on error.
+  RawString* ReadString() {
+    // A string is always followed by another value.
+    const intptr_t len = ReadUnsigned();
+    if (error_ || (len >= (size_ - stream_.Position()))) {
+      error_ = true;
+      return String::null();
+    }
+    const uint8_t* utf8 = stream_.AddressOfCurrentPosition();
+    if (len > 0) stream_.Advance(len);
+    if (!Utf8::IsValid(utf8, len)) {
+      error_ = true;
+      return String::null();
+    }
+    return Symbols::FromUTF8(utf8, len);
+  }
+
+  // Returns the class or Class::null() if it does not exist in this program.
+  RawClass* ReadClass() {
+    const intptr_t cid = ReadUnsigned();
+    if (cid != kIllegalCid) {
+      ClassTable* class_table = Isolate::Current()->class_table();
+      if ((cid >= kNumPredefinedCids) ||
+          !class_table->IsValidIndex(cid) ||
+          !class_table->HasValidClassAt(cid)) {
+        return Class::null();
+      }
+      return class_table->At(cid);
+    }
+    const String& url = String::Handle(ReadString());
+    const String& name = String::Handle(ReadString());
+    if (error_) return Class::null();
+    const Library& library = Library::Handle(Library::LookupLibrary(url));
+    if (library.IsNull()) return Class::null();
+    return LookupClass(library, name);
+  }
+
+  static RawClass* LookupClass(const Library& library, const String& name) {
+    Class& cls = Class::Handle(library.LookupLocalClass(name));
+    if (cls.IsNull() && (name.Length() > 0) && (name.CharAt(0) == '_')) {
+      cls = library.LookupLocalClass(
+          String::Handle(library.PrivateName(name)));
+    }
+    return cls.raw();
+  }
+
+ private:
+  // A value ends with the first byte above kMaxUnsignedDataPerByte, both in
+  // the signed and in the unsigned encoding.
+  bool HasValue() {
+    if (error_) return false;
+    const uint8_t* end = buffer_ + size_;
+    for (const uint8_t* current = stream_.AddressOfCurrentPosition();
+         current < end;
+         current++) {
+      if (*current > kMaxUnsignedDataPerByte) return true;
+    }
+    error_ = true;
+    return false;
+  }
+
+  const uint8_t* buffer_;
+  const intptr_t size_;
+  ReadStream stream_;
+  bool error_;
+
+  DISALLOW_COPY_AND_ASSIGN(TypeFeedbackReader);
+};
+
+
+intptr_t TypeFeedback::Save(uint8_t** buffer, ReAlloc alloc) {
+  TypeFeedbackWriter writer(buffer, alloc);
+  writer.WriteHeader();
+  ClassTable* class_table = Isolate::Current()->class_table();
+  Class& cls = Class::Handle();
+  Array& functions = Array::Handle();
+  Function& function = Function::Handle();
+  for (intptr_t cid = kNumPredefinedCids; cid < class_table->NumCids(); cid++) {
+    if (!class_table->HasValidClassAt(cid)) continue;
+    cls = class_table->At(cid);
+    if (!cls.is_finalized()) continue;
+    functions = cls.functions();
+    if (functions.IsNull()) continue;
+    for (intptr_t i = 0; i < functions.Length(); i++) {
+      function ^= functions.At(i);
+      writer.WriteFunction(function);
+    }
+  }
+  return writer.BytesWritten();
+}
+
+
+static RawFunction* LookupFunction(const String& url,
+                                   const String& class_name,
+                                   const String& function_name) {
+  const Library& library = Library::Handle(Library::LookupLibrary(url));
+  if (library.IsNull()) return Function::null();
+  if (class_name.Equals(Symbols::TopLevel())) {
+    return library.LookupLocalFunction(function_name);
+  }
+  const Class& cls =
+      Class::Handle(TypeFeedbackReader::LookupClass(library, class_name));
+  if (cls.IsNull() || !cls.is_finalized()) return Function::null();
+  return cls.LookupFunctionAllowPrivate(function_name);
+}
+
+
+// Makes sure 'function' has unoptimized code and returns its type feedback
+// array, or Array::null() if it cannot be compiled.
+static RawArray* TypeFeedbackArrayOf(const Function& function) {
+  if (!function.HasCode()) {
+    const Error& error = Error::Handle(Compiler::CompileFunction(function));
+    if (!error.IsNull()) return Array::null();
+  }
+  const Code& code = Code::Handle(function.HasOptimizedCode() ?
+      function.unoptimized_code() : function.CurrentCode());
+  if (code.IsNull() || code.is_optimized()) return Array::null();
+  return code.ExtractTypeFeedbackArray();
+}
+
+
+// Returns the target the call site would use for the receiver class, if it
+// is the function that was recorded and it could be compiled.
+static RawFunction* ResolveTarget(const Class& receiver_class,
+                                  const ICData& ic_data,
+                                  const String& target_name,
+                                  int32_t target_fingerprint) {
+  const Function& target = Function::Handle(
+      Resolver::ResolveDynamicAnyArgs(receiver_class,
+                                      String::Handle(ic_data.target_name())));
+  if (target.IsNull() ||
+      !String::EqualsIgnoringPrivateKey(String::Handle(target.name()),
+                                        target_name) ||
+      (target.SourceFingerprint() != target_fingerprint)) {
+    return Function::null();
+  }
+  if (!target.HasCode()) {
+    const Error& error = Error::Handle(Compiler::CompileFunction(target));
+    if (!error.IsNull()) return Function::null();
+  }
+  return target.raw();
+}
+
+
+bool TypeFeedback::Load(const uint8_t* buffer, intptr_t size) {
+  TypeFeedbackReader reader(buffer, size);
+  if (!reader.ReadHeader()) return false;
+  String& url = String::Handle();
+  String& class_name = String::Handle();
+  String& function_name = String::Handle();
+  String& target_name = String::Handle();
+  Function& function = Function::Handle();
+  Function& target = Function::Handle();
+  Array& ic_data_array = Array::Handle();
+  Object& obj = Object::Handle();
+  ICData& ic_data = ICData::Handle();
+  Class& cls = Class::Handle();
+  Class& receiver_class = Class::Handle();
+  GrowableArray<intptr_t> class_ids;
+  while (!reader.AtEnd()) {
+    url = reader.ReadString();
+    class_name = reader.ReadString();
+    function_name = reader.ReadString();
+    const int32_t fingerprint = reader.ReadInt32();
+    const intptr_t usage_counter = reader.ReadInt();
+    const intptr_t flags = reader.ReadUnsigned();
+    const intptr_t instruction_count = reader.ReadUnsigned();
+    const intptr_t call_site_count = reader.ReadUnsigned();
+    const intptr_t num_entries = reader.ReadUnsigned();
+    if (reader.has_error()) return false;
+
+    // The entries are always read, but only merged into a function with
+    // the same source.
+    function = LookupFunction(url, class_name, function_name);
+    if (!function.IsNull() &&
+        (function.SourceFingerprint() != fingerprint)) {
+      function = Function::null();
+    }
+    ic_data_array = function.IsNull() ?
+        Array::null() : TypeFeedbackArrayOf(function);
+    if (FLAG_trace_type_feedback) {
+      OS::Print("TypeFeedback: %s %s.%s\n",
+                ic_data_array.IsNull() ? "ignored" : "loading",
+                class_name.ToCString(),
+                function_name.ToCString());
+    }
+
+    for (intptr_t i = 0; i < num_entries; i++) {
+      const intptr_t deopt_id = reader.ReadUnsigned();
+      const intptr_t num_args_tested = reader.ReadUnsigned();
+      target_name = reader.ReadString();
+      const intptr_t num_checks = reader.ReadUnsigned();
+      if (reader.has_error()) return false;
+      ic_data = ICData::null();
+      if (!ic_data_array.IsNull() && (deopt_id < ic_data_array.Length())) {
+        obj = ic_data_array.At(deopt_id);
+        if (obj.IsICData()) {
+          ic_data ^= obj.raw();
+          if ((ic_data.num_args_tested() != num_args_tested) ||
+              !String::EqualsIgnoringPrivateKey(
+                  String::Handle(ic_data.target_name()), target_name)) {
+            ic_data = ICData::null();
+          }
+        }
+      }
+      for (intptr_t j = 0; j < num_checks; j++) {
+        const intptr_t count = reader.ReadUnsigned();
+        class_ids.Clear();
+        bool resolved = !ic_data.IsNull();
+        for (intptr_t k = 0; k < num_args_tested; k++) {
+          cls = reader.ReadClass();
+          if (cls.IsNull() || !cls.is_finalized()) {
+            resolved = false;
+          } else {
+            class_ids.Add(cls.id());
+          }
+          if (k == 0) receiver_class = cls.raw();
+        }
+        target_name = reader.ReadString();
+        const int32_t target_fingerprint = reader.ReadInt32();
+        if (reader.has_error()) return false;
+        if (!resolved) continue;
+        target = ResolveTarget(receiver_class, ic_data,
+                               target_name, target_fingerprint);
+        if (target.IsNull() || (FindCheck(ic_data, class_ids) >= 0)) continue;
+        if (num_args_tested == 1) {
+          ic_data.AddReceiverCheck(class_ids[0], target);
+        } else {
+          ic_data.AddCheck(class_ids, target);
+        }
+        const intptr_t index = FindCheck(ic_data, class_ids);
+        ASSERT(index >= 0);
+        ic_data.SetCountAt(index, Utils::Minimum(count, Smi::kMaxValue));
+      }
+    }
+
+    if (ic_data_array.IsNull()) continue;
+    // Functions that were optimized get a usage counter that optimizes them
+    // on their next invocation, now with the feedback of the previous run.
+    intptr_t counter = usage_counter;
+    if (((flags & kHadOptimizedCode) != 0) && function.is_optimizable()) {
+      counter = Utils::Maximum(counter,
+                               static_cast<intptr_t>(
+                                   FLAG_optimization_counter_threshold));
+    }
+    if (counter > function.usage_counter()) {
+      function.set_usage_counter(counter);
+    }
+    if ((flags & kNotInlinable) != 0) {
+      function.set_is_inlinable(false);
+    }
+    if (function.optimized_instruction_count() == 0) {
+      function.set_optimized_instruction_count(instruction_count);
+    }
+    if (function.optimized_call_site_count() == 0) {
+      function.set_optimized_call_site_count(call_site_count);
+    }
+  }
+  return !reader.has_error();
+}
+
+}  // namespace dart
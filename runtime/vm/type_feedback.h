@@ -0,0 +1,39 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef VM_TYPE_FEEDBACK_H_
+#define VM_TYPE_FEEDBACK_H_
+
+#include "vm/allocation.h"
+#include "vm/datastream.h"
+
+namespace dart {
+
+// Persists the type feedback collected by unoptimized code so that a later
+// run of the same program can optimize its hot functions early.
+//
+// The feedback consists of the receiver class histograms of the ICData at
+// instance call sites, the usage counters and the inlining related state of
+// the functions. Classes and functions are recorded by library url and name,
+// and are resolved again when the feedback is loaded. Entries that no longer
+// match the program (e.g. the function's source changed or the call now
+// resolves to a different target) are ignored. Feedback that is stale in a
+// less visible way is handled like any other wrong speculation: the
+// optimized code deoptimizes.
+class TypeFeedback : public AllStatic {
+ public:
+  // Writes the feedback of all functions of the current isolate into
+  // '*buffer', which is allocated with 'alloc'. Returns the number of bytes
+  // written.
+  static intptr_t Save(uint8_t** buffer, ReAlloc alloc);
+
+  // Merges the feedback in 'buffer' into the current isolate. Returns false
+  // if the buffer is not a type feedback file or is truncated; entries that
+  // were merged before the error was detected are kept.
+  static bool Load(const uint8_t* buffer, intptr_t size);
+};
+
+}  // namespace dart
+
+#endif  // VM_TYPE_FEEDBACK_H_
@@ -0,0 +1,102 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/assert.h"
+#include "vm/dart_api_impl.h"
+#include "vm/dart_api_state.h"
+#include "vm/type_feedback.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static const char* kScriptChars =
+    "class A { foo() => 1; }\n"
+    "class B { foo() => 2; }\n"
+    "class _C { foo() => 3; }\n"
+    "callFoo(x) => x.foo();\n"
+    "main() {\n"
+    "  var sum = 0;\n"
+    "  for (var i = 0; i < 10; i++) {\n"
+    "    sum += callFoo(new A()) + callFoo(new B()) + callFoo(new _C());\n"
+    "  }\n"
+    "  return sum;\n"
+    "}\n";
+
+
+static RawICData* FooCallOf(const Library& lib) {
+  const Function& function = Function::Handle(
+      lib.LookupLocalFunction(String::Handle(Symbols::New("callFoo"))));
+  EXPECT(!function.IsNull());
+  EXPECT(function.HasCode());
+  const Array& feedback = Array::Handle(
+      Code::Handle(function.CurrentCode()).ExtractTypeFeedbackArray());
+  ICData& ic_data = ICData::Handle();
+  for (intptr_t i = 0; i < feedback.Length(); i++) {
+    if (feedback.At(i) != Object::null()) {
+      ic_data ^= feedback.At(i);
+      if (String::Handle(ic_data.target_name()).Equals("foo")) {
+        return ic_data.raw();
+      }
+    }
+  }
+  return ICData::null();
+}
+
+
+UNIT_TEST_CASE(TypeFeedback) {
+  uint8_t* feedback = NULL;
+  intptr_t size = 0;
+  {
+    // Run the script and save the feedback it collected.
+    TestIsolateScope __test_isolate__;
+    Dart_EnterScope();
+    Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+    EXPECT_VALID(lib);
+    EXPECT_VALID(Dart_Invoke(lib, NewString("main"), 0, NULL));
+    uint8_t* buffer = NULL;
+    EXPECT_VALID(Dart_SaveTypeFeedback(&buffer, &size));
+    EXPECT(size > 0);
+    feedback = reinterpret_cast<uint8_t*>(malloc(size));
+    memmove(feedback, buffer, size);
+    Dart_ExitScope();
+  }
+
+  {
+    // Load the feedback into a fresh isolate running the same script.
+    TestIsolateScope __test_isolate__;
+    Dart_EnterScope();
+    Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+    EXPECT_VALID(lib);
+    EXPECT_VALID(Dart_LoadTypeFeedback(feedback, size));
+    {
+      Isolate* isolate = Isolate::Current();
+      DARTSCOPE(isolate);
+      const Library& library = Library::CheckedHandle(Api::UnwrapHandle(lib));
+      const ICData& ic_data = ICData::Handle(FooCallOf(library));
+      EXPECT(!ic_data.IsNull());
+      EXPECT_EQ(3, ic_data.NumberOfChecks());
+      for (intptr_t i = 0; i < ic_data.NumberOfChecks(); i++) {
+        EXPECT_EQ(10, ic_data.GetCountAt(i));
+        EXPECT(Function::Handle(ic_data.GetTargetAt(i)).HasCode());
+      }
+      const Function& function = Function::Handle(
+          library.LookupLocalFunction(String::Handle(Symbols::New("main"))));
+      EXPECT(function.usage_counter() > 0);
+    }
+    // The script runs with the loaded feedback.
+    Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+    EXPECT_VALID(result);
+    int64_t value = 0;
+    EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+    EXPECT_EQ(60, value);
+
+    // Corrupt and truncated feedback is reported as an error.
+    EXPECT(Dart_IsError(Dart_LoadTypeFeedback(feedback + 1, size - 1)));
+    EXPECT(Dart_IsError(Dart_LoadTypeFeedback(feedback, size - 1)));
+    Dart_ExitScope();
+  }
+  free(feedback);
+}
+
+}  // namespace dart
@@ -0,0 +1,207 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/typed_data_operations.h"
+
+#include "platform/utils.h"
+
+#if defined(HOST_ARCH_IA32) || defined(HOST_ARCH_X64)
+#define USE_SSE2_TYPED_DATA_OPERATIONS 1
+#include <emmintrin.h>  // NOLINT
+#endif
+
+namespace dart {
+
+static const intptr_t kBlockSize = 16;  // Bytes in an SSE2 register.
+
+
+// Reads an element that may not be aligned.
+template<typename T>
+static inline T LoadElement(const uint8_t* address) {
+  T value;
+  memmove(&value, address, sizeof(value));
+  return value;
+}
+
+
+#if defined(USE_SSE2_TYPED_DATA_OPERATIONS)
+static inline __m128i LoadBlock(const void* address) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(address));
+}
+
+
+static inline void StoreBlock(void* address, __m128i value) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(address), value);
+}
+
+
+// Returns a block of copies of the 'element_size' bytes at 'element'.
+static inline __m128i RepeatElement(const void* element,
+                                    intptr_t element_size) {
+  uint8_t bytes[kBlockSize];
+  for (intptr_t i = 0; i < kBlockSize; i += element_size) {
+    memmove(bytes + i, element, element_size);
+  }
+  return LoadBlock(bytes);
+}
+
+
+// Returns a block with all bits set in the elements that are equal in 'a'
+// and 'b', and all bits cleared in the other elements.
+template<typename T>
+static inline __m128i CompareElements(__m128i a, __m128i b);
+
+
+template<>
+inline __m128i CompareElements<uint8_t>(__m128i a, __m128i b) {
+  return _mm_cmpeq_epi8(a, b);
+}
+
+
+template<>
+inline __m128i CompareElements<uint16_t>(__m128i a, __m128i b) {
+  return _mm_cmpeq_epi16(a, b);
+}
+
+
+template<>
+inline __m128i CompareElements<uint32_t>(__m128i a, __m128i b) {
+  return _mm_cmpeq_epi32(a, b);
+}
+
+
+template<>
+inline __m128i CompareElements<uint64_t>(__m128i a, __m128i b) {
+  // SSE2 has no 64-bit comparison, so both 32-bit halves are compared and
+  // each half is combined with the other half of its element.
+  const __m128i halves = _mm_cmpeq_epi32(a, b);
+  return _mm_and_si128(halves, _mm_shuffle_epi32(halves, 0xB1));
+}
+#endif  // defined(USE_SSE2_TYPED_DATA_OPERATIONS)
+
+
+void TypedDataOperations::FillFromFirst(uint8_t* data,
+                                        intptr_t len,
+                                        intptr_t element_size) {
+  ASSERT((element_size > 0) && ((kBlockSize % element_size) == 0));
+  ASSERT((len % element_size) == 0);
+  if (len == 0) {
+    return;
+  }
+  intptr_t filled = element_size;
+#if defined(USE_SSE2_TYPED_DATA_OPERATIONS)
+  // A block holds a whole number of elements, so the blocks stored after
+  // the first element keep the elements in place.
+  const __m128i block = RepeatElement(data, element_size);
+  for (; filled + kBlockSize <= len; filled += kBlockSize) {
+    StoreBlock(data + filled, block);
+  }
+#endif
+  // Doubles the filled part, which is a whole number of elements, until the
+  // rest of the data is filled.
+  while (filled < len) {
+    const intptr_t count = Utils::Minimum(filled, len - filled);
+    memmove(data + filled, data, count);
+    filled += count;
+  }
+}
+
+
+template<typename T>
+static intptr_t IndexOfElement(const uint8_t* data,
+                               intptr_t length,
+                               T element) {
+  const intptr_t kElementSize = sizeof(element);
+  intptr_t i = 0;
+#if defined(USE_SSE2_TYPED_DATA_OPERATIONS)
+  const intptr_t kElementsPerBlock = kBlockSize / kElementSize;
+  const __m128i needle = RepeatElement(&element, kElementSize);
+  for (; i + kElementsPerBlock <= length; i += kElementsPerBlock) {
+    const __m128i block = LoadBlock(data + i * kElementSize);
+    // One mask bit per byte, so kElementSize bits per element.
+    const intptr_t mask =
+        _mm_movemask_epi8(CompareElements<T>(block, needle));
+    if (mask != 0) {
+      return i + Utils::CountTrailingZeros(mask) / kElementSize;
+    }
+  }
+#endif
+  for (; i < length; i++) {
+    if (LoadElement<T>(data + i * kElementSize) == element) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+template<typename T>
+static intptr_t LastIndexOfElement(const uint8_t* data,
+                                   intptr_t length,
+                                   T element) {
+  const intptr_t kElementSize = sizeof(element);
+  intptr_t i = length;  // The elements from 'i' on have been searched.
+#if defined(USE_SSE2_TYPED_DATA_OPERATIONS)
+  const intptr_t kElementsPerBlock = kBlockSize / kElementSize;
+  const __m128i needle = RepeatElement(&element, kElementSize);
+  for (; i >= kElementsPerBlock; i -= kElementsPerBlock) {
+    const intptr_t start = i - kElementsPerBlock;
+    const __m128i block = LoadBlock(data + start * kElementSize);
+    const intptr_t mask =
+        _mm_movemask_epi8(CompareElements<T>(block, needle));
+    if (mask != 0) {
+      return start + Utils::HighestBit(mask) / kElementSize;
+    }
+  }
+#endif
+  while (i > 0) {
+    i--;
+    if (LoadElement<T>(data + i * kElementSize) == element) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+intptr_t TypedDataOperations::IndexOf(const uint8_t* data,
+                                      intptr_t length,
+                                      intptr_t element_size,
+                                      uint64_t element) {
+  switch (element_size) {
+    case 1:
+      return IndexOfElement(data, length, static_cast<uint8_t>(element));
+    case 2:
+      return IndexOfElement(data, length, static_cast<uint16_t>(element));
+    case 4:
+      return IndexOfElement(data, length, static_cast<uint32_t>(element));
+    case 8:
+      return IndexOfElement(data, length, element);
+    default:
+      UNREACHABLE();
+      return -1;
+  }
+}
+
+
+intptr_t TypedDataOperations::LastIndexOf(const uint8_t* data,
+                                          intptr_t length,
+                                          intptr_t element_size,
+                                          uint64_t element) {
+  switch (element_size) {
+    case 1:
+      return LastIndexOfElement(data, length, static_cast<uint8_t>(element));
+    case 2:
+      return LastIndexOfElement(data, length, static_cast<uint16_t>(element));
+    case 4:
+      return LastIndexOfElement(data, length, static_cast<uint32_t>(element));
+    case 8:
+      return LastIndexOfElement(data, length, element);
+    default:
+      UNREACHABLE();
+      return -1;
+  }
+}
+
+}  // namespace dart
@@ -0,0 +1,44 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef VM_TYPED_DATA_OPERATIONS_H_
+#define VM_TYPED_DATA_OPERATIONS_H_
+
+#include "vm/allocation.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+// Bulk operations over the elements of typed data arrays. The elements are
+// 1, 2, 4, 8 or 16 bytes wide and need not be aligned, because views may
+// start at any byte offset of their buffer. On ia32 and x64 the operations
+// process 16 bytes at a time using SSE2; on other architectures they fall
+// back to scalar loops.
+//
+// The data is the raw contents of a typed data object, so the callers must
+// not allow a GC while an operation is in progress.
+class TypedDataOperations : AllStatic {
+ public:
+  // Copies the first element of 'data' over the remaining elements of the
+  // 'len' bytes of 'data'.
+  static void FillFromFirst(uint8_t* data,
+                            intptr_t len,
+                            intptr_t element_size);
+
+  // Returns the index of the first or last of the 'length' elements of
+  // 'data' that is equal to 'element', or -1. The element is given by its
+  // 'element_size' low order bytes, which must be 1, 2, 4 or 8.
+  static intptr_t IndexOf(const uint8_t* data,
+                          intptr_t length,
+                          intptr_t element_size,
+                          uint64_t element);
+  static intptr_t LastIndexOf(const uint8_t* data,
+                              intptr_t length,
+                              intptr_t element_size,
+                              uint64_t element);
+};
+
+}  // namespace dart
+
+#endif  // VM_TYPED_DATA_OPERATIONS_H_
@@ -0,0 +1,112 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/assert.h"
+#include "vm/benchmark_test.h"
+#include "vm/timer.h"
+#include "vm/typed_data_operations.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+// Long enough for the operations to use whole blocks and a scalar tail.
+static const intptr_t kDataLength = 83;
+
+// The data is accessed at every offset from 0 to 7 of this buffer, so that
+// the elements are not always aligned.
+static const intptr_t kBufferLength = kDataLength * 8 + 8;
+
+
+TEST_CASE(TypedDataOperations_FillFromFirst) {
+  uint8_t buffer[kBufferLength];
+  for (intptr_t element_size = 1; element_size <= 16; element_size <<= 1) {
+    for (intptr_t offset = 0; offset < 8; offset++) {
+      const intptr_t len = (kDataLength / element_size) * element_size;
+      memset(buffer, 0xEE, kBufferLength);
+      uint8_t* data = buffer + offset;
+      for (intptr_t i = 0; i < element_size; i++) {
+        data[i] = i + 1;
+      }
+      TypedDataOperations::FillFromFirst(data, len, element_size);
+      for (intptr_t i = 0; i < len; i++) {
+        EXPECT_EQ((i % element_size) + 1, data[i]);
+      }
+      // The bytes around the data are not written.
+      for (intptr_t i = 0; i < offset; i++) {
+        EXPECT_EQ(0xEE, buffer[i]);
+      }
+      EXPECT_EQ(0xEE, data[len]);
+    }
+  }
+  // Filling no bytes does not read the first element.
+  TypedDataOperations::FillFromFirst(NULL, 0, 8);
+}
+
+
+TEST_CASE(TypedDataOperations_IndexOf) {
+  uint8_t buffer[kBufferLength];
+  for (intptr_t element_size = 1; element_size <= 8; element_size <<= 1) {
+    for (intptr_t offset = 0; offset < 8; offset++) {
+      uint8_t* data = buffer + offset;
+      memset(buffer, 0, kBufferLength);
+      // Elements that differ from the searched one in a single byte.
+      const uint64_t element = DART_2PART_UINT64_C(0x80706050, 40302010);
+      for (intptr_t i = 0; i < kDataLength; i++) {
+        memmove(data + i * element_size, &element, element_size);
+        data[i * element_size + (i % element_size)] ^= 1;
+      }
+      EXPECT_EQ(-1, TypedDataOperations::IndexOf(
+          data, kDataLength, element_size, element));
+      EXPECT_EQ(-1, TypedDataOperations::LastIndexOf(
+          data, kDataLength, element_size, element));
+      for (intptr_t i = 0; i < kDataLength; i++) {
+        uint8_t* address = data + i * element_size;
+        address[i % element_size] ^= 1;
+        EXPECT_EQ(i, TypedDataOperations::IndexOf(
+            data, kDataLength, element_size, element));
+        EXPECT_EQ(i, TypedDataOperations::LastIndexOf(
+            data, kDataLength, element_size, element));
+        // The first and the last occurrence are found.
+        EXPECT_EQ(0, TypedDataOperations::IndexOf(
+            address, kDataLength - i, element_size, element));
+        EXPECT_EQ(i, TypedDataOperations::LastIndexOf(
+            data, i + 1, element_size, element));
+        address[i % element_size] ^= 1;
+      }
+    }
+  }
+  EXPECT_EQ(-1, TypedDataOperations::IndexOf(buffer, 0, 1, 0));
+  EXPECT_EQ(-1, TypedDataOperations::LastIndexOf(buffer, 0, 1, 0));
+}
+
+
+// Fills a 64KB buffer and searches it for the last element, as done by
+// codecs that clear buffers and scan for delimiters.
+BENCHMARK(TypedDataFillAndIndexOf) {
+  const intptr_t kNumIterations = 1000;
+  const intptr_t kLength = 64 * KB;
+  uint8_t* data = new uint8_t[kLength];
+  intptr_t found = 0;
+  Timer timer(true, "TypedDataFillAndIndexOf benchmark");
+  timer.Start();
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    for (intptr_t element_size = 1; element_size <= 8; element_size <<= 1) {
+      const intptr_t length = kLength / element_size;
+      memset(data, 0, element_size);
+      TypedDataOperations::FillFromFirst(data, kLength, element_size);
+      memset(data + kLength - element_size, 0xFF, element_size);
+      const intptr_t index =
+          TypedDataOperations::IndexOf(data, length, element_size, kMaxUint64);
+      if (index == (length - 1)) {
+        found++;
+      }
+    }
+  }
+  timer.Stop();
+  EXPECT_EQ(4 * kNumIterations, found);
+  delete[] data;
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+}  // namespace dart
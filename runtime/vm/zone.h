@@ -126,6 +126,7 @@ class Zone {
 
   friend class StackZone;
   friend class ApiZone;
+  friend class ScanJob;
   template<typename T, typename B> friend class BaseGrowableArray;
   DISALLOW_COPY_AND_ASSIGN(Zone);
 };
@@ -111,6 +111,9 @@ patch class _RandomAccessFile {
   patch static _read(int id, int bytes) {
     throw new UnsupportedError("RandomAccessFile._read");
   }
+  patch static _map(int id, int length) {
+    throw new UnsupportedError("RandomAccessFile._map");
+  }
   patch static _readInto(int id, List<int> buffer, int start, int end) {
     throw new UnsupportedError("RandomAccessFile._readInto");
   }
@@ -272,6 +272,43 @@ class JSInt extends JSNumber implements int {
   Type get runtimeType => int;
 
   int operator ~() => JS('int', r'(~#) >>> 0', this);
+
+  int modPow(int exponent, int modulus) {
+    if (exponent is! int) throw new ArgumentError(exponent);
+    if (modulus is! int) throw new ArgumentError(modulus);
+    if (exponent < 0) throw new RangeError("Exponent $exponent is negative");
+    if (modulus <= 0) {
+      throw new RangeError("Modulus $modulus is not positive");
+    }
+    int result = 1 % modulus;
+    int power = this % modulus;
+    while (exponent > 0) {
+      if (exponent.isOdd) result = _mulMod(result, power, modulus);
+      power = _mulMod(power, power, modulus);
+      exponent = exponent ~/ 2;
+    }
+    return result;
+  }
+
+  // Products of doubles are only exact below 2^53. Larger products are
+  // computed by doubling and adding.
+  static int _mulMod(int a, int b, int modulus) {
+    int product = a * b;
+    if (product < 9007199254740992) return product % modulus;
+    int result = 0;
+    while (b > 0) {
+      if (b.isOdd) result = _addMod(result, a, modulus);
+      a = _addMod(a, a, modulus);
+      b = b ~/ 2;
+    }
+    return result;
+  }
+
+  // Adds a and b, which are less than modulus, without computing a sum
+  // that can reach 2^53.
+  static int _addMod(int a, int b, int modulus) {
+    return (a >= modulus - b) ? a - (modulus - b) : a + b;
+  }
 }
 
 class JSDouble extends JSNumber implements double {
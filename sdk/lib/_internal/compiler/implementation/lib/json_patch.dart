@@ -5,6 +5,7 @@
 // Patch file for dart:json library.
 
 import 'dart:_foreign_helper' show JS;
+import 'dart:utf' show decodeUtf8;
 
 /**
  * Parses [json] and builds the corresponding parsed JSON value.
@@ -89,3 +90,33 @@ _convertJsonToDart(json, reviver(key, value)) {
 
   return revive('', walk(json));
 }
+
+/**
+ * Collects the chunks of a [ChunkedJsonParser], which are parsed with
+ * [parse] when it is closed.
+ */
+class _ChunkedJsonBuffer {
+  final reviver;
+  final StringBuffer chunks = new StringBuffer();
+  final List<int> bytes = <int>[];
+
+  _ChunkedJsonBuffer(this.reviver);
+}
+
+patch _newChunkedParser(reviver(var key, var value)) {
+  return new _ChunkedJsonBuffer(reviver);
+}
+
+patch void _addChunk(parser, String chunk) {
+  parser.chunks.write(chunk);
+}
+
+patch void _addBytes(parser, List<int> bytes) {
+  parser.bytes.addAll(bytes);
+}
+
+patch _closeChunked(parser) {
+  String json = parser.bytes.isEmpty ? parser.chunks.toString()
+                                     : decodeUtf8(parser.bytes);
+  return parse(json, parser.reviver);
+}
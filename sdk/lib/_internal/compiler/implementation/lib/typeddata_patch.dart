@@ -225,3 +225,43 @@ patch class ByteData {
     throw new UnsupportedError('ByteData.view');
   }
 }
+
+
+patch class NumberText {
+  patch static int parseDoubles(Uint8List bytes,
+                                int start,
+                                int end,
+                                int separator,
+                                Float64List result,
+                                [int resultStart = 0]) {
+    throw new UnsupportedError('NumberText.parseDoubles');
+  }
+
+  patch static int parseInts(Uint8List bytes,
+                             int start,
+                             int end,
+                             int separator,
+                             Int64List result,
+                             [int resultStart = 0]) {
+    throw new UnsupportedError('NumberText.parseInts');
+  }
+
+  patch static int formatDoubles(Float64List values,
+                                 int start,
+                                 int end,
+                                 int separator,
+                                 Uint8List output,
+                                 [int outputStart = 0,
+                                  int fractionDigits]) {
+    throw new UnsupportedError('NumberText.formatDoubles');
+  }
+
+  patch static int formatInts(Int64List values,
+                              int start,
+                              int end,
+                              int separator,
+                              Uint8List output,
+                              [int outputStart = 0]) {
+    throw new UnsupportedError('NumberText.formatInts');
+  }
+}
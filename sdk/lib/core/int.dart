@@ -49,6 +49,15 @@ abstract class int extends num {
   /** Returns the absolute value of this integer. */
   int abs();
 
+  /**
+   * Returns this integer to the power of [exponent] modulo [modulus].
+   *
+   * The [exponent] must not be negative and the [modulus] must be positive.
+   * The result is in the range 0 to [modulus] - 1, also if this integer is
+   * negative.
+   */
+  int modPow(int exponent, int modulus);
+
   /** Returns `this`. */
   int round();
 
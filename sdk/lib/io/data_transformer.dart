@@ -9,17 +9,13 @@ part of dart.io;
  */
 abstract class _Filter {
   /**
-   * Call to process a chunk of data. A call to [process] should only be made
-   * when [processed] returns [null].
+   * Process the chunks of data in [chunks] and return the processed data.
+   * All chunks are processed in one call, and the filter does not keep any
+   * reference to them. Set [flush] to [true] to also get the data buffered
+   * by the filter, and to [false] for non-final calls to improve
+   * performance of some filters.
    */
-  void process(List<int> data);
-
-  /**
-   * Get a chunk of processed data. When there are no more data available,
-   * [processed] will return [null]. Set [flush] to [false] for non-final
-   * calls to improve performance of some filters.
-   */
-  List<int> processed({bool flush: true});
+  List<List<int>> process(List<List<int>> chunks, bool flush);
 
   /**
    * Mark the filter as closed. Always call this method for any filter created
@@ -36,19 +32,13 @@ abstract class _Filter {
 class _FilterTransformer extends StreamEventTransformer<List<int>, List<int>> {
   final _Filter _filter;
   bool _closed = false;
-  bool _empty = true;
 
   _FilterTransformer(_Filter this._filter);
 
   void handleData(List<int> data, EventSink<List<int>> sink) {
     if (_closed) return;
     try {
-      _empty = false;
-      _filter.process(data);
-      var out;
-      while ((out = _filter.processed(flush: false)) != null) {
-        sink.add(out);
-      }
+      _filter.process([data], false).forEach(sink.add);
     } catch (e, s) {
       _closed = true;
       // TODO(floitsch): we are losing the stack trace.
@@ -59,12 +49,8 @@ class _FilterTransformer extends StreamEventTransformer<List<int>, List<int>> {
 
   void handleDone(EventSink<List<int>> sink) {
     if (_closed) return;
-    if (_empty) _filter.process(const []);
     try {
-      var out;
-      while ((out = _filter.processed()) != null) {
-        sink.add(out);
-      }
+      _filter.process(const [], true).forEach(sink.add);
     } catch (e, s) {
       // TODO(floitsch): we are losing the stack trace.
       sink.addError(e);
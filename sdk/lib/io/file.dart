@@ -222,6 +222,21 @@ abstract class File extends FileSystemEntity {
    */
   List<int> readAsBytesSync();
 
+  /**
+   * Synchronously read the entire file contents as a list of bytes by
+   * mapping the file into memory and copying the mapping into the list.
+   *
+   * This reads a large file with a single copy and a single allocation
+   * of the final size. The mapping is released before the list is
+   * returned, so later changes to the file do not affect the list.
+   *
+   * Small files, and files that cannot be mapped such as pipes and
+   * devices, are read as with [readAsBytesSync].
+   *
+   * Throws a [FileIOException] if the operation fails.
+   */
+  List<int> readAsBytesMappedSync();
+
   /**
    * Read the entire file contents as a string using the given
    * [Encoding].
@@ -205,6 +205,16 @@ const int _READ_LIST_REQUEST = 17;
 const int _WRITE_LIST_REQUEST = 18;
 const int _CREATE_LINK_REQUEST = 19;
 const int _DELETE_LINK_REQUEST = 20;
+const int _READ_AT_REQUEST = 21;
+
+// File.readAsBytesMappedSync maps files of at least _MAP_THRESHOLD
+// bytes. Smaller files are cheaper to copy than to map.
+const int _MAP_THRESHOLD = _BLOCK_SIZE;
+
+// File.readAsBytes reads files in blocks of _READ_AT_BLOCK_SIZE bytes
+// with up to _PARALLEL_READS reads in flight at the same time.
+const int _READ_AT_BLOCK_SIZE = 4 * _BLOCK_SIZE;
+const int _PARALLEL_READS = 4;
 
 // Base class for _File and _RandomAccessFile with shared functions.
 class _FileBase {
@@ -473,6 +483,22 @@ class _File extends _FileBase implements File {
 
   Future<List<int>> readAsBytes() {
     _ensureFileService();
+    return open().then((_RandomAccessFile file) {
+      return file.length()
+          .then((length) {
+            // Pipes and special devices report a length of 0. These
+            // are read through a stream until end of file instead.
+            if (length == 0) return null;
+            return file._readAllAt(length);
+          })
+          .whenComplete(file.close);
+    }).then((result) {
+      if (result != null) return result;
+      return _readAsBytesFromStream();
+    });
+  }
+
+  Future<List<int>> _readAsBytesFromStream() {
     Completer<List<int>> completer = new Completer<List<int>>();
     var chunks = new _BufferList();
     openRead().listen(
@@ -491,15 +517,35 @@ class _File extends _FileBase implements File {
 
   List<int> readAsBytesSync() {
     var opened = openSync();
+    var result = _readRemainingSync(opened);
+    opened.closeSync();
+    return result;
+  }
+
+  static List<int> _readRemainingSync(RandomAccessFile opened) {
     var chunks = new _BufferList();
     var data;
     while ((data = opened.readSync(_BLOCK_SIZE)).length > 0) {
       chunks.add(data);
     }
-    opened.closeSync();
     return chunks.readBytes();
   }
 
+  List<int> readAsBytesMappedSync() {
+    var opened = openSync();
+    try {
+      var length = opened.lengthSync();
+      if (length >= _MAP_THRESHOLD) {
+        var result = _RandomAccessFile._map(opened._id, length);
+        throwIfError(result, "Cannot map file '$_path'");
+        if (result != null) return result;
+      }
+      return _readRemainingSync(opened);
+    } finally {
+      opened.closeSync();
+    }
+  }
+
   Future<String> readAsString({Encoding encoding: Encoding.UTF_8}) {
     _ensureFileService();
     return readAsBytes().then((bytes) {
@@ -685,6 +731,8 @@ class _RandomAccessFile extends _FileBase implements RandomAccessFile {
 
   external static _read(int id, int bytes);
 
+  external static _map(int id, int length);
+
   List<int> readSync(int bytes) {
     _checkNotClosed();
     if (bytes is !int) {
@@ -699,6 +747,66 @@ class _RandomAccessFile extends _FileBase implements RandomAccessFile {
     return result;
   }
 
+  // Reads the first length bytes of the file with positional reads.
+  // The reads are spread over several file service ports, so they can
+  // be handled concurrently, and do not use the file position. If the
+  // file is shorter than length the result is shortened accordingly.
+  Future<List<int>> _readAllAt(int length) {
+    _ensureFileService();
+    Completer<List<int>> completer = new Completer<List<int>>();
+    Uint8List result = new Uint8List(length);
+    int resultLength = length;
+    int nextPosition = 0;
+    int pending = 0;
+    var error;
+
+    void readNext(SendPort service) {
+      if (error != null || nextPosition >= length) {
+        if (pending == 0) {
+          if (error != null) {
+            completer.completeError(error);
+          } else if (resultLength < length) {
+            completer.complete(result.sublist(0, resultLength));
+          } else {
+            completer.complete(result);
+          }
+        }
+        return;
+      }
+      int position = nextPosition;
+      int bytes = min(_READ_AT_BLOCK_SIZE, length - position);
+      nextPosition += bytes;
+      pending++;
+      List request = new List(4);
+      request[0] = _READ_AT_REQUEST;
+      request[1] = _id;
+      request[2] = position;
+      request[3] = bytes;
+      service.call(request).then((response) {
+        pending--;
+        if (_isErrorResponse(response)) {
+          if (error == null) {
+            error = _exceptionFromResponse(response,
+                                           "read failed for file '$_path'");
+          }
+        } else {
+          var data = response[1];
+          result.setRange(position, position + data.length, data);
+          if (data.length < bytes && position + data.length < resultLength) {
+            resultLength = position + data.length;
+          }
+        }
+        readNext(service);
+      });
+    }
+
+    int blocks = (length + _READ_AT_BLOCK_SIZE - 1) ~/ _READ_AT_BLOCK_SIZE;
+    for (int i = 0; i < min(blocks, _PARALLEL_READS); i++) {
+      readNext(i == 0 ? _fileService : _FileUtils._newServicePort());
+    }
+    return completer.future;
+  }
+
   Future<int> readInto(List<int> buffer, [int start, int end]) {
     _ensureFileService();
     if (buffer is !List ||
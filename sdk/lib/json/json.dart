@@ -75,6 +75,42 @@ _parse(String json, reviver(var key, var value)) {
   return listener.result;
 }
 
+/**
+ * Parses JSON text that is received in chunks, e.g. from a socket.
+ *
+ * The chunks are added as strings with [add], or as UTF-8 encoded bytes with
+ * [addBytes]; a parser accepts either strings or bytes, not both. [close]
+ * returns the parsed JSON value of the whole text, as [parse] would.
+ *
+ * Throws [FormatException] if the input is not valid JSON text. The error
+ * may be reported by [add] or [addBytes] as soon as the chunk containing it
+ * is added.
+ */
+class ChunkedJsonParser {
+  final _parser;
+
+  ChunkedJsonParser([reviver(var key, var value)])
+      : _parser = _newChunkedParser(reviver);
+
+  /** Adds the next chunk of the JSON text. */
+  void add(String chunk) {
+    _addChunk(_parser, chunk);
+  }
+
+  /** Adds the next chunk of the UTF-8 encoded JSON text. */
+  void addBytes(List<int> bytes) {
+    _addBytes(_parser, bytes);
+  }
+
+  /** Returns the parsed JSON value of the text added. */
+  close() => _closeChunked(_parser);
+}
+
+external _newChunkedParser(reviver(var key, var value));
+external void _addChunk(parser, String chunk);
+external void _addBytes(parser, List<int> bytes);
+external _closeChunked(parser);
+
 /**
  * Serializes [object] into a JSON string.
  *
@@ -933,3 +933,79 @@ abstract class Uint32x4 {
   /// Returns a bit-wise copy of [this] as a [Float32x4].
   Float32x4 toFloat32x4();
 }
+
+
+/**
+ * Parses and formats the text of numbers in byte lists, such as the fields
+ * of CSV files, without creating a string for each number.
+ *
+ * The text is ASCII. The numbers are parsed as by [double.parse] and
+ * [int.parse], and written as by [double.toString],
+ * [double.toStringAsFixed] and [int.toString].
+ */
+abstract class NumberText {
+  /**
+   * Parses the numbers separated by the byte [separator] in the bytes of
+   * [bytes] from [start] to [end], and stores them in [result] starting at
+   * [resultStart]. Returns the number of numbers.
+   *
+   * Spaces, tabs, carriage returns and line feeds around a number are
+   * ignored, and so is a separator after the last number. Bytes of only
+   * whitespace contain no numbers.
+   *
+   * Throws [FormatException] if a field is not a number, and [RangeError] if
+   * [result] has no room for all the numbers. In both cases some elements of
+   * [result] may have been written.
+   */
+  external static int parseDoubles(Uint8List bytes,
+                                   int start,
+                                   int end,
+                                   int separator,
+                                   Float64List result,
+                                   [int resultStart = 0]);
+
+  /**
+   * Parses the integers separated by the byte [separator] in the bytes of
+   * [bytes] from [start] to [end], as [parseDoubles] parses doubles.
+   *
+   * Throws [FormatException] if a field is not an integer that fits in 64
+   * bits.
+   */
+  external static int parseInts(Uint8List bytes,
+                                int start,
+                                int end,
+                                int separator,
+                                Int64List result,
+                                [int resultStart = 0]);
+
+  /**
+   * Writes the elements of [values] from [start] to [end], separated by the
+   * byte [separator], to [output] starting at [outputStart]. Returns the
+   * index after the last byte written.
+   *
+   * The doubles are written as by [double.toStringAsFixed] if
+   * [fractionDigits] is given, and else as by [double.toString].
+   *
+   * Throws [RangeError] if [output] has no room for the text, in which case
+   * some bytes of [output] may have been written. [output] must not share
+   * bytes with [values].
+   */
+  external static int formatDoubles(Float64List values,
+                                    int start,
+                                    int end,
+                                    int separator,
+                                    Uint8List output,
+                                    [int outputStart = 0,
+                                     int fractionDigits]);
+
+  /**
+   * Writes the elements of [values] from [start] to [end] to [output], as
+   * [formatDoubles] writes doubles.
+   */
+  external static int formatInts(Int64List values,
+                                 int start,
+                                 int end,
+                                 int separator,
+                                 Uint8List output,
+                                 [int outputStart = 0]);
+}
@@ -154,6 +154,32 @@ class BigIntegerTest {
     Expect.equals(true, exceptionCaught);
   }
 
+  static testBigintModPow() {
+    Expect.equals(3075408678,
+                  0x3FFFFFFFFFFFFFFF.modPow(0x3FFFFFFFFFFFFFFD, 0xFFFFFFFF));
+    Expect.equals(2197815291, (-(1 << 40)).modPow(3, 4294967291));
+    Expect.equals(0x6F7867DBE5616937BD3B85B21, 3.modPow(1000, 1 << 100));
+    // Fermat's little theorem for the Mersenne prime 2^521 - 1.
+    var p = (1 << 521) - 1;
+    Expect.equals(1, 3.modPow(p - 1, p));
+    Expect.equals(5, 5.modPow(p, p));
+    Expect.equals(p - 1, (-1).modPow(p, p));
+    // RSA with the primes 2^127 - 1 and 2^521 - 1.
+    var n = ((1 << 127) - 1) * p;
+    var e = 65537;
+    var d = int.parse(
+        "0x2A7FD5802A7FD5802A7FD5802A7FD57F80807F7F80807F7F80807F7F80807F7F"
+        "80807F7F80807F7F80807F7F80807F7F80807F7F80807F7F80807F7F80807F7F80"
+        "55FFAA0055FFAA0055FFAA0055FFAA01");
+    var message = int.parse("0x" + "1234567890ABCDEF" * 8);
+    var cipher = int.parse(
+        "0xA6C9EE859FB47250A55102DADEC57D87147FA4431D8CCF04694C2027E17B5E42"
+        "A41E695E5BE291032ED6AE2F82852E65F2F295717533B8605715A5B83DE84B6C74"
+        "8956375BB2954841109723D4C85CC59B");
+    Expect.equals(cipher, message.modPow(e, n));
+    Expect.equals(message, cipher.modPow(d, n));
+  }
+
   static testMain() {
     Expect.equals(1234567890123456789, foo());
     testSmiOverflow();
@@ -165,6 +191,7 @@ class BigIntegerTest {
     testBigintDiv();
     testBigintNegate();
     testShiftAmount();
+    testBigintModPow();
     Expect.equals(1234567890123456, (1234567890123456).abs());
     Expect.equals(1234567890123456, (-1234567890123456).abs());
     var a = 10000000000000000000;
@@ -0,0 +1,30 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'package:expect/expect.dart';
+
+main() {
+  Expect.equals(445, 4.modPow(13, 497));
+  Expect.equals(1, (-3).modPow(3, 7));
+  Expect.equals(1, 2.modPow(0, 7));
+  Expect.equals(0, 2.modPow(0, 1));
+  Expect.equals(0, 0.modPow(5, 7));
+  Expect.equals(652541198, 123456789.modPow(987654321, 1000000007));
+  // Fermat's little theorem for the prime 2^31 - 1.
+  Expect.equals(1, 16807.modPow(2147483646, 2147483647));
+  // A modulus close to 2^53, where sums of residues can exceed the range of
+  // integers that doubles represent exactly.
+  // 2^53 - 111 is a prime.
+  Expect.equals(1, 3.modPow(9007199254740880, 9007199254740881));
+  Expect.equals(5405740943859323,
+                123456789.modPow(987654321, 9007199254740881));
+  Expect.equals(4824233017139117,
+                4503599627370497.modPow(4503599627370496, 9007199254740881));
+
+  Expect.throws(() => 2.modPow(-1, 7), (e) => e is RangeError);
+  Expect.throws(() => 2.modPow(3, 0), (e) => e is RangeError);
+  Expect.throws(() => 2.modPow(3, -7), (e) => e is RangeError);
+  Expect.throws(() => 2.modPow(null, 7), (e) => e is ArgumentError);
+  Expect.throws(() => 2.modPow(3, null), (e) => e is ArgumentError);
+}
@@ -109,8 +109,81 @@ class LinkedHashMapTest {
     map.values.forEach(testForEachValue);
     verifyValues(valuesAfterAUpdate);
   }
+
+  static void testGrowAndRemove() {
+    Map map = new LinkedHashMap();
+    // Negative keys and keys that differ in high bits only share the low
+    // bits of their hash codes.
+    List keys = [];
+    for (int i = 0; i < 1000; i++) {
+      keys.add(i.isEven ? i : -(i << 20));
+    }
+    keys.add(null);
+    keys.add("1");
+    for (var key in keys) {
+      map[key] = "$key";
+    }
+    Expect.equals(keys.length, map.length);
+    Expect.listEquals(keys, map.keys.toList());
+    for (var key in keys) {
+      Expect.equals("$key", map[key]);
+    }
+
+    // Removing and adding keys keeps the insertion order of the remaining
+    // keys, also when the removed entries are compacted.
+    for (int round = 0; round < 5; round++) {
+      for (int i = 0; i < keys.length; i += 2) {
+        Expect.equals("${keys[i]}", map.remove(keys[i]));
+        Expect.isNull(map.remove(keys[i]));
+        Expect.isFalse(map.containsKey(keys[i]));
+      }
+      List removed = [];
+      for (int i = 0; i < keys.length; i += 2) removed.add(keys[i]);
+      keys.removeWhere((key) => removed.contains(key));
+      for (var key in removed) {
+        map[key] = "$key";
+        keys.add(key);
+      }
+      Expect.listEquals(keys, map.keys.toList());
+      Expect.listEquals(keys.map((key) => "$key").toList(),
+                        map.values.toList());
+    }
+    Expect.isTrue(map.containsKey(null));
+    Expect.isTrue(map.containsValue("null"));
+    Expect.isFalse(map.containsValue(null));
+
+    map.clear();
+    Expect.isTrue(map.isEmpty);
+    Expect.isNull(map[0]);
+    map[0] = 1;
+    Expect.listEquals([0], map.keys.toList());
+  }
+
+  static void testModification() {
+    Map map = new LinkedHashMap();
+    for (int i = 0; i < 10; i++) map[i] = i;
+    Expect.throws(() {
+      for (var key in map.keys) map[key + 100] = key;
+    }, (e) => e is ConcurrentModificationError);
+    Expect.throws(() {
+      map.forEach((key, value) { map.remove(key); });
+    }, (e) => e is ConcurrentModificationError);
+    // Updating the value of a key is not a modification.
+    map = new LinkedHashMap();
+    for (int i = 0; i < 10; i++) map[i] = i;
+    for (var key in map.keys) map[key] = -key;
+    Expect.equals(-9, map[9]);
+    Expect.equals(7, map.putIfAbsent(12, () {
+      map[11] = 0;
+      return 7;
+    }));
+    Expect.listEquals([0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 12],
+                      map.keys.toList());
+  }
 }
 
 main() {
   LinkedHashMapTest.testMain();
+  LinkedHashMapTest.testGrowAndRemove();
+  LinkedHashMapTest.testModification();
 }
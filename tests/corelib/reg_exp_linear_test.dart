@@ -0,0 +1,214 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import "package:expect/expect.dart";
+
+// Dart test program for regular expressions that a backtracking matcher
+// needs exponential time for, and for the match priorities that a matcher
+// without backtracking has to preserve.
+
+void testNestedQuantifiers() {
+  String as = "a" * 40;
+  Expect.isFalse(new RegExp(r"(a+)+b").hasMatch(as));
+  Expect.isFalse(new RegExp(r"^(a|aa)*$").hasMatch("${as}b"));
+  Expect.isFalse(new RegExp(r"(x+x+)+y").hasMatch("x" * 40));
+  Match match = new RegExp(r"(a+)+b").firstMatch("${as}b");
+  Expect.equals("${as}b", match[0]);
+  Expect.equals(as, match[1]);
+}
+
+
+void testPriorities() {
+  Match match = new RegExp(r"(a|ab)(c|bcd)(d*)").firstMatch("abcd");
+  Expect.equals("abcd", match[0]);
+  Expect.equals("a", match[1]);
+  Expect.equals("bcd", match[2]);
+  Expect.equals("", match[3]);
+
+  match = new RegExp(r"<(.*)>").firstMatch("<a><b>");
+  Expect.equals("a><b", match[1]);
+  match = new RegExp(r"<(.*?)>").firstMatch("<a><b>");
+  Expect.equals("a", match[1]);
+  match = new RegExp(r"(a{2,3}?)(a*)").firstMatch("aaaaa");
+  Expect.equals("aa", match[1]);
+  Expect.equals("aaa", match[2]);
+
+  // A group in a repetition holds its last match.
+  match = new RegExp(r"(?:(\w)\.)+").firstMatch("x.y.z.");
+  Expect.equals("x.y.z.", match[0]);
+  Expect.equals("z", match[1]);
+
+  // A group that does not take part in the match is null.
+  match = new RegExp(r"(a)|(b)").firstMatch("b");
+  Expect.isNull(match[1]);
+  Expect.equals("b", match[2]);
+}
+
+
+void testAssertions() {
+  String log = "INFO start\nWARN disk low\nERROR disk full";
+  RegExp levels = new RegExp(r"^(WARN|ERROR) (.*)$", multiLine: true);
+  List<String> messages =
+      levels.allMatches(log).map((m) => "${m[1]}:${m[2]}").toList();
+  Expect.listEquals(["WARN:disk low", "ERROR:disk full"], messages);
+  Expect.isFalse(new RegExp(r"^WARN").hasMatch(log));
+  Expect.isTrue(new RegExp(r"full$").hasMatch(log));
+  Expect.isFalse(new RegExp(r"low$").hasMatch(log));
+
+  Expect.equals("disk", new RegExp(r"\bdisk\b").stringMatch(log));
+  Expect.equals("isk", new RegExp(r"\Bisk").stringMatch(log));
+  Expect.equals(2, new RegExp(r"\bdisk\b").allMatches(log).length);
+}
+
+
+void testCharacters() {
+  RegExp ip = new RegExp(r"(\d{1,3})\.(\d{1,3})\.(\d{1,3})\.(\d{1,3})");
+  Match match = ip.firstMatch("from 192.168.0.12:80");
+  Expect.equals("192.168.0.12", match[0]);
+  Expect.equals("12", match[4]);
+
+  Expect.equals("a-b_c", new RegExp(r"[\w-]+").stringMatch(" a-b_c "));
+  Expect.equals(" \t", new RegExp(r"\s+").stringMatch("x \ty"));
+  Expect.equals("xy", new RegExp(r"[^\s]+").stringMatch("  xy z"));
+  Expect.equals("A", new RegExp(r"\x41").stringMatch("bAb"));
+  Expect.equals("é", new RegExp(r"é").stringMatch("café"));
+  Expect.equals("Ā", new RegExp(r"[ÿ-ā]").stringMatch("aĀ"));
+  Expect.isFalse(new RegExp(r".").hasMatch("\n\r\u2028\u2029"));
+
+  // Like jscre, \s only matches ASCII white space, also in patterns that
+  // are matched by backtracking.
+  Expect.isFalse(new RegExp(r"\s").hasMatch("\u00a0\u2028\u3000\ufeff"));
+  Expect.isFalse(new RegExp(r"[\s]").hasMatch("\u00a0"));
+  Expect.equals("\u00a0", new RegExp(r"\S").stringMatch(" \u00a0"));
+  Expect.equals("\u00a0", new RegExp(r"[^\s]").stringMatch(" \u00a0"));
+  Expect.isFalse(new RegExp(r"(\s)\1").hasMatch("\u00a0\u00a0"));
+  Expect.isTrue(new RegExp(r"(\S)\1").hasMatch("\u00a0\u00a0"));
+  Expect.isFalse(new RegExp(r"\s(?=x)").hasMatch("\u00a0x"));
+  Expect.equals("\u00a0", new RegExp(r"\S(?=x)").stringMatch(" \u00a0x"));
+
+  // Two byte strings.
+  Expect.equals("€42", new RegExp(r".\d+").stringMatch("x€42"));
+  Expect.equals(3, new RegExp(r"€").allMatches("€€€").length);
+}
+
+
+void testIgnoreCase() {
+  RegExp error = new RegExp(r"error|fail(ed|ure)", caseSensitive: false);
+  Expect.equals("ERROR", error.stringMatch("ERROR: x"));
+  Expect.equals("Failed", error.firstMatch("Failed: x")[0]);
+  Expect.equals("ed", error.firstMatch("Failed: x")[1]);
+  Expect.equals("aBc", new RegExp(r"[a-c]+", caseSensitive: false)
+      .stringMatch("-aBc-"));
+  Expect.equals("-", new RegExp(r"[^a-c]", caseSensitive: false)
+      .stringMatch("aBc-"));
+}
+
+
+void testUnsupportedFeatures() {
+  // Backreferences and lookaheads are matched by backtracking.
+  Match match = new RegExp(r"(\w)\1").firstMatch("abccd");
+  Expect.equals("cc", match[0]);
+  Expect.equals("c", match[1]);
+  Expect.equals(7, new RegExp(r"foo(?=bar)").firstMatch("foobaz foobar").start);
+  Expect.throws(() => new RegExp(r"(a"), (e) => e is FormatException);
+  Expect.throws(() => new RegExp(r"a**"), (e) => e is FormatException);
+
+  // Patterns on which jscre gives other results than a backtracking matcher
+  // are left to jscre.
+  Expect.equals("a", new RegExp(r"(?:a(?:a)??)*").stringMatch("aaaa"));
+  Expect.equals(2, new RegExp(r"[^a]*?$").firstMatch("bb").start);
+}
+
+
+// Pattern, multiLine, ignoreCase, subject, and the start, end and groups of
+// the first match, or null if there is none. The expected values are the
+// ones of jscre, which matches the patterns that the automaton does not
+// support.
+const DIFFERENTIAL_CASES = const [
+  [r"[^\s](\w{1,3}){1,3}", true, false, "  \u00e9\u00e9bb_", [3, 7, "bb_"]],
+  [r"[^\s]??(\S\u00e9{0,2}){1,3}", false, false, "1A\n", [0, 2, "A"]],
+  [r"(.{1,3}?)", false, false, "\u00a0 c", [0, 1, "\u00a0"]],
+  [r".(\S{1,3}){2,}[^a]+", false, true, "Ac\u00e9__1_", [0, 7, "_1"]],
+  [r"b(\W+?|[\d_]?.)+?\x41?", false, false, "b_1 A", [0, 3, "_1"]],
+  [r"(a?[\d_]*\D{2})\s", true, true, "a1 A\u00a0 ", [3, 6, "A\u00a0"]],
+  [r"(\w)?", false, false, "a\u00e9", [0, 1, "a"]],
+  [r"(.|\w\d{2}.)?", true, true, "\u00e9\n\u00e91AA a11 ", [0, 1, "\u00e9"]],
+  [r"\D{1,3}\u00e9{1,3}?|(\w{0,2})", true, false, "A\nc\u00a0A", [0, 1, "A"]],
+  [r"(.+){1,3}\D{2,}", true, true, "bb\u00e9\u00a0A", [0, 5, "bb\u00e9"]],
+  [r"(\d{0,2}\S{0,2})", true, false, "cA1", [0, 2, "cA"]],
+  [r"(\x41)", true, true, "1c\u00a0 _Abc \u00e9\n", [5, 6, "A"]],
+  [r"(\s*)", false, true, " \n1", [0, 2, " \n"]],
+  [r"(c{0,2}?\D)?", false, true, " A_ AA", [0, 1, " "]],
+  [r"1{0,2}?(\B\D{1,3}?1*)+", true, true, "\nb  _", [0, 1, "\n"]],
+  [r"(.??1{1,3})", true, true, "aba 1b", [3, 5, " 1"]],
+  [r"(.){2}", true, false, " bab\u00e9a_A\u00a0", [0, 2, "b"]],
+  [r"(b?[\w-]+){0,2}", false, true, "c1\na b\u00e9", [0, 2, "c1"]],
+  [r".{2}(\D{2}?)+\b", false, true, "a \u00e9a_\u00a01cbcc", [0, 6, "_\u00a0"]],
+  [r"(c|A?.)+?", true, false, "_Aac", [0, 1, "_"]],
+  [r".*(.)+|b{0,2}?$a{2}", false, true, "_A\n _A", [0, 2, "A"]],
+  [r"( ?[ab]\.{0,2}?)$", false, true, " b_\na", [4, 5, "a"]],
+  [r"([^\s]*)", true, true, "\u00a0\u00e9 b1 ", [0, 2, "\u00a0\u00e9"]],
+  [r"(.{2})(?:.{2}\S*\B){0,2}?", true, false, " 1 aba\u00a0", [0, 2, " 1"]],
+  [r"b??.{1,3}?(\.?? *?)", true, false, "cAA_Ac 1", [0, 1, ""]],
+  [r"c+(-c{0,2})+\s{2,}?|.{2}.{1,3}.?", true, false, "c c", [0, 3, null]],
+  [r"\s+|(-)??", false, false, " ", [0, 1, null]],
+  [r"b1|a(\b.){0,2}?", true, false, "1 a \n_ab\n\u00e9\n", [2, 3, null]],
+  [r"([\d_])?c{2}.{2,}|\B", false, true, "acb\u00e9cc  c_", [1, 1, null]],
+  [r"^\w*?|( )", false, true, "  \n_\u00a0 A1 ", [0, 0, null]],
+  [r"\B", true, false, " abb 1\u00a0", [0, 0]],
+  [r".\b", true, true, "    _\u00e9\n c", [3, 4]],
+  [r".c{1,3}", true, false, " ab bc\u00e9b1c", [4, 6]],
+  [r"\.*^", true, false, "\u00a0", [0, 0]],
+  [r".{1,3}|b\B", true, true, "\u00e9_1", [0, 3]],
+  [r"[^a]|-+.b", false, true, "c_c\u00a0b\u00e9", [0, 1]],
+  [r"A*", false, false, "", [0, 0]],
+  [r"$", false, true, " \u00a0b 1c\u00e91cc_", [11, 11]],
+  [r"\x41*?", false, false, "a1\u00a0\nc\nb", [0, 0]],
+  [r"b{0,2}", true, true, "A\u00a0 c", [0, 0]],
+  [r"\W", false, false, "c\u00e91", [1, 2]],
+  [r"^a+|[\d_]\b\n{0,2}", true, true, " \n_11", [4, 5]],
+  [r"[\d_]{1,3}c {2}", false, true, "\u00e9a aa__\nb_", null],
+  [r"([A-Z]??_)", false, true, "", null],
+  [r"\n(?:.([\d_]$){2,}? ?){1,3}", true, true, " c _cA c ", null],
+  [r"^([^a]?(A{2,}?^){2,}\w*)+?\n{1,3}", true, true, "_AccaAAA a", null],
+  [r"c?1{2,}\d?", false, false, "\u00a0  \u00a0 a", null],
+  [r"\W\d?|\w*?A*?1{2}", true, false, "", null],
+  [r"[b-]+[^\s]{2}\B|\u00e9[A-Z]{2}?\n", false, false, "\n", null],
+  [r"( $\n{1,3})+(b{0,2}?).", true, false, "\u00a01\nbb cc\u00a0c", null],
+  [r"[^a]{2}c{2}", true, false, "aAb", null],
+  [r"b{2}?(c|\s{0,2}\s{2,}[ab]{1,3}?)", true, false, "\ncb 1ba \u00a0AA", null],
+];
+
+
+void testDifferentialCases() {
+  for (List test in DIFFERENTIAL_CASES) {
+    RegExp re = new RegExp(test[0], multiLine: test[1],
+                           caseSensitive: !test[2]);
+    Match match = re.firstMatch(test[3]);
+    List expected = test[4];
+    String description = "${test[0]} on ${test[3]}";
+    if (expected == null) {
+      Expect.isNull(match, description);
+      continue;
+    }
+    Expect.isNotNull(match, description);
+    Expect.equals(expected[0], match.start, description);
+    Expect.equals(expected[1], match.end, description);
+    Expect.equals(expected.length - 2, match.groupCount, description);
+    for (int i = 1; i <= match.groupCount; i++) {
+      Expect.equals(expected[i + 1], match[i], description);
+    }
+  }
+}
+
+
+main() {
+  testNestedQuantifiers();
+  testPriorities();
+  testAssertions();
+  testCharacters();
+  testIgnoreCase();
+  testUnsupportedFeatures();
+  testDifferentialCases();
+}
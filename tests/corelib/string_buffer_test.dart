@@ -172,7 +172,46 @@ void testWriteCharCode() {
   Expect.throws(() { bf2.writeCharCode(0x110000); });
 }
 
-void main() {
+void void testManyParts() {
+  // Enough small and large parts, mixed with character codes, to fill
+  // and concatenate internal buffers of the implementation several times.
+  StringBuffer bf = new StringBuffer();
+  List<String> expected = [];
+  for (int i = 0; i < 1000; i++) {
+    String part = (i % 100 == 0) ? "x" * 2000 : "$i,";
+    bf.write(part);
+    expected.add(part);
+    if (i % 3 == 0) {
+      bf.writeCharCode(0x41 + i % 26);
+      expected.add(new String.fromCharCode(0x41 + i % 26));
+    }
+    if (i % 250 == 0) {
+      bf.writeCharCode(0x1F600);
+      bf.write("\u20ac");
+      expected.add("\u{1F600}\u20ac");
+    }
+    if (i % 400 == 0) {
+      Expect.equals(expected.join(), bf.toString());
+    }
+  }
+  String result = expected.join();
+  Expect.equals(result.length, bf.length);
+  Expect.equals(result, bf.toString());
+  // The contents are the same when concatenated again.
+  Expect.equals(result, bf.toString());
+  bf.write("end");
+  Expect.equals("${result}end", bf.toString());
+  bf.clear();
+  Expect.equals("", bf.toString());
+  for (int i = 0; i < 300; i++) {
+    bf.writeCharCode(0x61 + i % 26);
+  }
+  Expect.equals(300, bf.length);
+  Expect.equals("abcdefghijklmnopqrstuvwxyz" * 11 + "abcdefghijklmn",
+                bf.toString());
+}
+
+main() {
   testToString();
   testConstructor();
   testLength();
@@ -182,4 +221,5 @@ void main() {
   testWriteAll();
   testClear();
   testChaining();
+  testManyParts();
 }
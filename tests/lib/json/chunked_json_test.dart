@@ -0,0 +1,97 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Test that JSON text split into chunks at any position is parsed as the
+// whole text.
+
+library chunked_json_test;
+import "package:expect/expect.dart";
+import 'dart:json' as json;
+import 'dart:utf';
+
+const String TEXT = '''
+{"users": [
+  {"id": 1, "name": "Ann", "tags": ["a", "b"], "score": -12.5e-1,
+   "active": true, "manager": null, "big": 123456789012345678901234567890},
+  {"id": 2, "name": "B\\u00e9la \\"Bob\\"\\n", "tags": [], "score": 0,
+   "active": false, "manager": {"id": 1}, "big": -9007199254740993},
+  {"id": 3, "name": "ümläut € \u{1F600}", "tags": [{}],
+   "score": 1E3, "active": true, "manager": {"id": 2}, "big": 0.0}
+], "count": 3, "": ""}
+''';
+
+checkParsed(parsed) {
+  Expect.equals(json.stringify(json.parse(TEXT)), json.stringify(parsed));
+  Expect.equals(3, parsed["count"]);
+  var users = parsed["users"];
+  Expect.listEquals(["a", "b"], users[0]["tags"]);
+  Expect.equals(-1.25, users[0]["score"]);
+  Expect.equals(123456789012345678901234567890, users[0]["big"]);
+  Expect.equals(-9007199254740993, users[1]["big"]);
+  Expect.equals('Béla "Bob"\n', users[1]["name"]);
+  Expect.equals("ümläut € \u{1F600}", users[2]["name"]);
+  Expect.equals(1, users[2]["manager"]["id"] - 1);
+  Expect.isTrue(users[2]["tags"][0] is Map);
+  Expect.equals(1000.0, users[2]["score"]);
+  Expect.equals("", parsed[""]);
+}
+
+testStringChunks() {
+  for (int i = 0; i <= TEXT.length; i++) {
+    var parser = new json.ChunkedJsonParser();
+    parser.add(TEXT.substring(0, i));
+    parser.add(TEXT.substring(i));
+    checkParsed(parser.close());
+  }
+  var parser = new json.ChunkedJsonParser();
+  for (int i = 0; i < TEXT.length; i++) {
+    parser.add(TEXT[i]);
+  }
+  checkParsed(parser.close());
+}
+
+testByteChunks() {
+  List<int> bytes = encodeUtf8(TEXT);
+  for (int i = 0; i <= bytes.length; i++) {
+    var parser = new json.ChunkedJsonParser();
+    parser.addBytes(bytes.sublist(0, i));
+    parser.addBytes(bytes.sublist(i));
+    checkParsed(parser.close());
+  }
+}
+
+testReviver() {
+  var keys = [];
+  reviver(key, value) {
+    keys.add(key);
+    return value is num ? value * 2 : value;
+  }
+  var parser = new json.ChunkedJsonParser(reviver);
+  parser.add('{"a": [1, {"b": 2}], ');
+  parser.add('"c": 3}');
+  var result = parser.close();
+  Expect.listEquals([0, "b", 1, "a", "c", ""], keys);
+  Expect.equals(2, result["a"][0]);
+  Expect.equals(4, result["a"][1]["b"]);
+  Expect.equals(6, result["c"]);
+}
+
+testErrors() {
+  for (var text in ['', '{', '[1,]', '{"a" 1}', '"abc', '-', '1.', 'nul',
+                    '[1] 2', '"\\x"', '"\\u12"', '{1: 2}', '01']) {
+    Expect.throws(() => json.parse(text), (e) => e is FormatException);
+    var parser = new json.ChunkedJsonParser();
+    Expect.throws(() {
+      parser.add(text);
+      parser.close();
+    }, (e) => e is FormatException);
+  }
+}
+
+main() {
+  testStringChunks();
+  testByteChunks();
+  testReviver();
+  testErrors();
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=--allocation_sinking --optimization_counter_threshold=10
+// VMOptions=--allocation_sinking --optimization_counter_threshold=10 --deoptimize_alot
+//
+// Test that objects whose allocation was removed by the optimizing compiler
+// are materialized correctly when the optimized code deoptimizes.
+
+import "package:expect/expect.dart";
+
+class Point {
+  final x;
+  final y;
+  Point(this.x, this.y);
+
+  Point operator +(Point other) => new Point(x + other.x, y + other.y);
+}
+
+class Box {
+  var value;
+  var other;
+  Box(this.value);
+}
+
+sumProduct(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) {
+    var p = new Point(i, i + 1);
+    sum += p.x * p.y;
+  }
+  return sum;
+}
+
+// The addition deoptimizes once it sees doubles, the point is then needed
+// by the unoptimized code.
+addFields(a, b) {
+  var p = new Point(a, b);
+  var sum = p.x + p.y;
+  return sum * p.x;
+}
+
+// The box is mutated before the deoptimization point.
+mutate(a) {
+  var box = new Box(a);
+  box.value = box.value + 1;
+  var twice = box.value * 2;
+  return [twice, box.value, box.other];
+}
+
+// Temporaries created by inlined operators.
+addPoints(a, b, c) {
+  var p = new Point(a, a) + new Point(b, b) + new Point(c, c);
+  return p.x - p.y + p.x;
+}
+
+main() {
+  for (var i = 0; i < 100; i++) {
+    Expect.equals(333300, sumProduct(100));
+    Expect.equals(3 * 1, addFields(1, 2));
+    Expect.listEquals([4, 2, null], mutate(1));
+    Expect.equals(6, addPoints(1, 2, 3));
+  }
+  Expect.equals(4.0 * 1.5, addFields(1.5, 2.5));
+  Expect.listEquals([5.0, 2.5, null], mutate(1.5));
+  Expect.equals(6.5, addPoints(1, 2, 3.5));
+  Expect.equals(333300, sumProduct(100));
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=--hoist_bounds_checks --optimization_counter_threshold=10
+// VMOptions=--hoist_bounds_checks --optimization_counter_threshold=10 --deoptimize_alot
+//
+// Test that loops whose bounds checks are replaced by a check before the
+// loop still throw after writing the elements before the failing one.
+
+import "package:expect/expect.dart";
+import "dart:typed_data";
+
+addTo(List src, List dst) {
+  for (var i = 0; i < src.length; i++) {
+    dst[i] = src[i] + dst[i];
+  }
+}
+
+fillFrom(List dst, start, n, value) {
+  for (var i = start; n > i; i++) {
+    dst[i] = value;
+  }
+}
+
+sumWithBreak(Float64List x, n) {
+  var sum = 0.0;
+  for (var i = 0; i < n; i++) {
+    if (x[i] < 0) break;
+    sum += x[i];
+  }
+  return sum;
+}
+
+test(List make(n)) {
+  for (var i = 0; i < 20; i++) {
+    var src = make(10);
+    var dst = make(10);
+    for (var j = 0; j < 10; j++) {
+      src[j] = j;
+      dst[j] = 2 * j;
+    }
+    addTo(src, dst);
+    for (var j = 0; j < 10; j++) Expect.equals(3 * j, dst[j]);
+    addTo(make(0), dst);
+    fillFrom(dst, 2, 10, 7);
+    Expect.equals(0, dst[0]);
+    Expect.equals(7, dst[9]);
+    fillFrom(dst, 5, -1, 8);
+  }
+
+  // Out of bounds: the elements before the failing one are written.
+  var src = make(6);
+  var dst = make(4);
+  for (var j = 0; j < 6; j++) src[j] = 1;
+  for (var j = 0; j < 4; j++) dst[j] = 0;
+  Expect.throws(() => addTo(src, dst), (e) => e is RangeError);
+  for (var j = 0; j < 4; j++) Expect.equals(1, dst[j]);
+  Expect.throws(() => fillFrom(dst, 1, 5, 9), (e) => e is RangeError);
+  Expect.listEquals([1, 9, 9, 9], dst.toList());
+}
+
+main() {
+  test((n) => new List(n));
+  test((n) => new Int32List(n));
+
+  var x = new Float64List(4);
+  x[0] = 1.0;
+  x[1] = 2.0;
+  x[2] = -1.0;
+  for (var i = 0; i < 20; i++) {
+    // Stops before reaching the end of the array.
+    Expect.equals(3.0, sumWithBreak(x, 100));
+    Expect.equals(1.0, sumWithBreak(x, 1));
+  }
+}
@@ -0,0 +1,47 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=--use_dispatch_table --optimization_counter_threshold=10
+// VMOptions=--use_dispatch_table --optimization_counter_threshold=10 --deoptimize_alot
+//
+// Test that megamorphic call sites dispatching through the global dispatch
+// table call the same targets as the megamorphic cache.
+
+import "package:expect/expect.dart";
+
+class A { f() => 1; g(x) => x + 1; }
+class B { f() => 2; g(x) => x + 2; }
+class C extends A { f() => 3; }
+class D extends B { g(x) => x + 4; }
+class E { f() => 5; g(x, [y = 10]) => x + y; }
+class F { f() => 6; g(x) => x + 6; }
+class G { noSuchMethod(invocation) => 7; }
+class H implements A { f() => 8; g(x) => x + 8; }
+
+// Only instantiated after the call sites are optimized.
+class Late { f() => 9; g(x) => x + 9; }
+
+callF(o) => o.f();
+callG(o, x) => o.g(x);
+callToString(o) => o.toString();
+
+main() {
+  var receivers = [new A(), new B(), new C(), new D(), new E(), new F(),
+                   new G(), new H(), 42, "str", null];
+  var expectedF = [1, 2, 3, 2, 5, 6, 7, 8];
+  var expectedG = [11, 12, 11, 14, 20, 16, 7, 18];
+  for (var i = 0; i < 100; i++) {
+    for (var j = 0; j < expectedF.length; j++) {
+      Expect.equals(expectedF[j], callF(receivers[j]));
+      Expect.equals(expectedG[j], callG(receivers[j], 10));
+    }
+    for (var j = 0; j < receivers.length; j++) {
+      Expect.equals(receivers[j].toString(), callToString(receivers[j]));
+    }
+    Expect.throws(() => callF(42), (e) => e is NoSuchMethodError);
+    Expect.throws(() => callG(null, 1), (e) => e is NoSuchMethodError);
+  }
+  Expect.equals(9, callF(new Late()));
+  Expect.equals(19, callG(new Late(), 10));
+}
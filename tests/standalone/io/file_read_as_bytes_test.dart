@@ -0,0 +1,39 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test File.readAsBytes on files of different sizes, including files
+// read with several positional reads in flight.
+
+import "package:expect/expect.dart";
+import 'dart:async';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typeddata';
+
+Future testReadAsBytes(Directory temp, int size) {
+  var data = new Uint8List(size);
+  for (int i = 0; i < size; i++) data[i] = (i * 7 + (i >> 16)) & 0xFF;
+  var file = new File("${temp.path}/test_$size");
+  file.writeAsBytesSync(data);
+  return file.readAsBytes().then((content) {
+    Expect.equals(size, content.length);
+    for (int i = 0; i < size; i++) {
+      if (content[i] != data[i]) {
+        Expect.fail("Byte $i of file with size $size differs");
+      }
+    }
+  });
+}
+
+void main() {
+  ReceivePort port = new ReceivePort();
+  var temp = new Directory('').createTempSync();
+  var sizes = [0, 1, 64 * 1024, 256 * 1024 - 1, 256 * 1024 + 1,
+               5 * 256 * 1024 + 17, 4 * 1024 * 1024];
+  Future.wait(sizes.map((size) => testReadAsBytes(temp, size)))
+      .then((_) {
+        temp.deleteSync(recursive: true);
+        port.close();
+      });
+}
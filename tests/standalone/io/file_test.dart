@@ -8,6 +8,7 @@ import "package:expect/expect.dart";
 import 'dart:async';
 import 'dart:io';
 import 'dart:isolate';
+import 'dart:typeddata';
 
 class MyListOfOneElement implements List {
   int _value;
@@ -982,6 +983,29 @@ class FileTest {
     Expect.equals(bytes.length, 0);
   }
 
+  static void testReadAsBytesMappedSync() {
+    var name = getFilename("tests/vm/data/fixed_length_file");
+    var bytes = new File(name).readAsBytesMappedSync();
+    Expect.listEquals(new File(name).readAsBytesSync(), bytes);
+    name = getFilename("tests/vm/data/empty_file");
+    Expect.equals(0, new File(name).readAsBytesMappedSync().length);
+  }
+
+  static void testReadAsBytesMappedSyncLargeFile() {
+    // Large enough to be read through a mapping.
+    var data = new Uint8List(3 * 64 * 1024 + 17);
+    for (int i = 0; i < data.length; i++) data[i] = (i * 13) & 0xFF;
+    var file = new File("${tempDirectory.path}/out_read_mapped");
+    file.writeAsBytesSync(data);
+    var bytes = file.readAsBytesMappedSync();
+    Expect.listEquals(data, bytes);
+    // The bytes are a copy, which later changes to the file do not affect.
+    file.writeAsBytesSync([1, 2, 3]);
+    Expect.listEquals(data, bytes);
+    file.deleteSync();
+    Expect.throws(file.readAsBytesMappedSync, (e) => e is FileIOException);
+  }
+
   static void testReadAsText() {
     var port = new ReceivePort();
     port.receive((result, replyTo) {
@@ -1091,6 +1115,7 @@ class FileTest {
     });
     var f = new File('.');
     Expect.throws(f.readAsBytesSync, (e) => e is FileIOException);
+    Expect.throws(f.readAsBytesMappedSync, (e) => e is FileIOException);
     Expect.throws(f.readAsStringSync, (e) => e is FileIOException);
     Expect.throws(f.readAsLinesSync, (e) => e is FileIOException);
     var readAsBytesFuture = f.readAsBytes();
@@ -1247,6 +1272,7 @@ class FileTest {
     testReadAsBytesEmptyFile();
     testReadAsBytesSync();
     testReadAsBytesSyncEmptyFile();
+    testReadAsBytesMappedSync();
     testReadAsText();
     testReadAsTextEmptyFile();
     testReadAsTextSync();
@@ -1264,6 +1290,7 @@ class FileTest {
       testReadWriteStream();
       testReadEmptyFileSync();
       testReadEmptyFile();
+      testReadAsBytesMappedSyncLargeFile();
       testReadWriteStreamLargeFile();
       testTruncate();
       testTruncateSync();
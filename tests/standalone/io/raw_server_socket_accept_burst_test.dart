@@ -0,0 +1,87 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test that a burst of pending connections is accepted in batches
+// without losing any connection.
+
+import "package:expect/expect.dart";
+import "dart:io";
+import "dart:isolate";
+
+void testAcceptBurst(int socketCount) {
+  ReceivePort port = new ReceivePort();
+  RawServerSocket.bind("127.0.0.1", 0, socketCount).then((server) {
+    var clients = [];
+    var acceptCount = 0;
+    var connectCount = 0;
+
+    void listen() {
+      server.listen((client) {
+        Expect.isNotNull(client.remotePort);
+        client.close();
+        if (++acceptCount == socketCount) {
+          Expect.equals(socketCount, connectCount);
+          clients.forEach((socket) => socket.close());
+          server.close();
+          port.close();
+        }
+      });
+    }
+
+    // Connect all sockets before listening, so that the connections
+    // are pending in the backlog when the first read event arrives.
+    for (int i = 0; i < socketCount; i++) {
+      RawSocket.connect("127.0.0.1", server.port).then((socket) {
+        clients.add(socket);
+        if (++connectCount == socketCount) listen();
+      });
+    }
+  });
+}
+
+void testAcceptBurstCancel(int socketCount) {
+  ReceivePort port = new ReceivePort();
+  RawServerSocket.bind("127.0.0.1", 0, socketCount).then((server) {
+    var closeCount = 0;
+    var connectCount = 0;
+
+    void checkDone() {
+      if (closeCount == socketCount) port.close();
+    }
+
+    void listen() {
+      var subscription;
+      subscription = server.listen((client) {
+        // Cancelling after the first connection closes the server
+        // socket and every connection not yet delivered.
+        client.close();
+        subscription.cancel();
+      });
+    }
+
+    for (int i = 0; i < socketCount; i++) {
+      RawSocket.connect("127.0.0.1", server.port).then((socket) {
+        socket.writeEventsEnabled = false;
+        socket.listen((event) {
+          if (event == RawSocketEvent.READ_CLOSED) {
+            socket.close();
+            closeCount++;
+            checkDone();
+          }
+        },
+        onError: (e) {
+          closeCount++;
+          checkDone();
+        });
+        if (++connectCount == socketCount) listen();
+      });
+    }
+  });
+}
+
+void main() {
+  testAcceptBurst(10);
+  testAcceptBurst(200);
+  testAcceptBurstCancel(20);
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--short_socket_write
+//
+// Test adding a file stream to a socket, which sends the file directly
+// from the file to the socket.
+
+import "package:expect/expect.dart";
+import "dart:async";
+import "dart:io";
+import "dart:isolate";
+import "dart:typeddata";
+
+Future testSendFile(Directory temp, int size) {
+  var data = new Uint8List(size);
+  for (int i = 0; i < size; i++) data[i] = (i * 13 + (i >> 12)) & 0xFF;
+  var file = new File("${temp.path}/send_$size");
+  file.writeAsBytesSync(data);
+  return ServerSocket.bind("127.0.0.1", 0).then((server) {
+    server.listen((socket) {
+      socket.addStream(file.openRead()).then((s) {
+        Expect.identical(socket, s);
+        return socket.close();
+      });
+    });
+    return Socket.connect("127.0.0.1", server.port).then((socket) {
+      var received = [];
+      return socket.listen(received.addAll).asFuture().then((_) {
+        server.close();
+        socket.destroy();
+        Expect.equals(size, received.length);
+        for (int i = 0; i < size; i++) {
+          if (received[i] != data[i]) {
+            Expect.fail("Byte $i of file with size $size differs");
+          }
+        }
+      });
+    });
+  });
+}
+
+Future testSendMissingFile(Directory temp) {
+  var file = new File("${temp.path}/missing");
+  return ServerSocket.bind("127.0.0.1", 0).then((server) {
+    var completer = new Completer();
+    server.listen((socket) {
+      socket.addStream(file.openRead()).then((_) {
+        Expect.fail("Sending a missing file should fail");
+      }).catchError((error) {
+        Expect.isTrue(error is FileIOException);
+        socket.destroy();
+        server.close();
+        completer.complete(null);
+      });
+    });
+    Socket.connect("127.0.0.1", server.port).then((socket) {
+      socket.listen((_) {}, onDone: socket.destroy, onError: (_) {});
+    });
+    return completer.future;
+  });
+}
+
+Future testSendProcFile() {
+  // Files in /proc report a length of 0, but have content.
+  var file = new File("/proc/version");
+  var data = file.readAsBytesSync();
+  Expect.isTrue(data.length > 0);
+  return ServerSocket.bind("127.0.0.1", 0).then((server) {
+    server.listen((socket) {
+      socket.addStream(file.openRead()).then((_) => socket.close());
+    });
+    return Socket.connect("127.0.0.1", server.port).then((socket) {
+      var received = [];
+      return socket.listen(received.addAll).asFuture().then((_) {
+        server.close();
+        socket.destroy();
+        Expect.listEquals(data, received);
+      });
+    });
+  });
+}
+
+void main() {
+  ReceivePort port = new ReceivePort();
+  var temp = new Directory('').createTempSync();
+  var sizes = [0, 1, 64 * 1024 - 1, 64 * 1024 + 1, 3 * 1024 * 1024 + 17];
+  Future.forEach(sizes, (size) => testSendFile(temp, size))
+      .then((_) => testSendMissingFile(temp))
+      .then((_) {
+        if (Platform.operatingSystem == "linux") return testSendProcFile();
+      })
+      .then((_) {
+        temp.deleteSync(recursive: true);
+        port.close();
+      });
+}
@@ -6,6 +6,7 @@ import "package:expect/expect.dart";
 import 'dart:async';
 import 'dart:io';
 import 'dart:isolate';
+import 'dart:typeddata';
 
 void testZLibDeflate() {
   test(int level, List<int> expected) {
@@ -137,10 +138,48 @@ void testZLibInflate() {
   }
 }
 
+void testZLibInflateLarge() {
+  // Data that does not compress well, so the processed chunks are large.
+  var data = new Uint8List(1024 * 1024);
+  int seed = 42;
+  for (int i = 0; i < data.length; i++) {
+    seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF;
+    data[i] = seed >> 16;
+  }
+  var port = new ReceivePort();
+  var controller = new StreamController();
+  controller.stream
+    .transform(new ZLibDeflater())
+    .transform(new ZLibInflater())
+      .fold([], (buffer, data) {
+        buffer.addAll(data);
+        return buffer;
+      })
+      .then((inflated) {
+        Expect.listEquals(data, inflated);
+        port.close();
+      });
+  // Add both typed data and plain lists of different sizes.
+  int offset = 0;
+  int size = 1;
+  bool typed = true;
+  while (offset < data.length) {
+    int end = offset + size;
+    if (end > data.length) end = data.length;
+    var chunk = data.sublist(offset, end);
+    controller.add(typed ? chunk : chunk.toList());
+    offset = end;
+    size *= 3;
+    typed = !typed;
+  }
+  controller.close();
+}
+
 void main() {
   testZLibDeflate();
   testZLibDeflateEmpty();
   testZLibDeflateGZip();
   testZLibDeflateInvalidLevel();
   testZLibInflate();
+  testZLibInflateLarge();
 }
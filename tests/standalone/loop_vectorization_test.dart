@@ -0,0 +1,127 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=--vectorize_loops --optimization_counter_threshold=10
+// VMOptions=--vectorize_loops --optimization_counter_threshold=10 --deoptimize_alot
+//
+// Test that loops over Float32List and Float64List processed two elements
+// at a time compute the same results as the scalar loops.
+
+import "package:expect/expect.dart";
+import "dart:typed_data";
+
+saxpy(a, Float32List x, Float32List y) {
+  for (var i = 0; i < x.length; i++) {
+    y[i] = a * x[i] + y[i];
+  }
+}
+
+dot(Float64List x, Float64List y) {
+  var sum = 0.0;
+  for (var i = 0; i < x.length; i++) {
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+// Starts at an odd offset, the sum is on the right of the addition.
+sumFrom(Float32List x, start) {
+  var sum = 0.0;
+  for (var i = start; i < x.length; i++) {
+    sum = x[i] + sum;
+  }
+  return sum;
+}
+
+map(Float64List x, Float32List result, n) {
+  for (var i = 0; i < n; i++) {
+    result[i] = (x[i] - 1.0) / 3.0;
+  }
+}
+
+Float32List float32List(n) {
+  var list = new Float32List(n);
+  for (var i = 0; i < n; i++) list[i] = 1.1 * i - 7.3;
+  return list;
+}
+
+Float64List float64List(n) {
+  var list = new Float64List(n);
+  for (var i = 0; i < n; i++) list[i] = 0.7 * i + 0.1;
+  return list;
+}
+
+// Results of the same computations on lists that are not typed data.
+expectedSaxpy(a, List x, List y) {
+  var result = new Float32List(x.length);
+  for (var i = 0; i < x.length; i++) {
+    result[i] = a * x[i] + y[i];
+  }
+  return result;
+}
+
+expectedDot(List x, List y) {
+  var sum = 0.0;
+  for (var i = 0; i < x.length; i++) {
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+expectedSumFrom(List x, start) {
+  var sum = 0.0;
+  for (var i = start; i < x.length; i++) {
+    sum = x[i] + sum;
+  }
+  return sum;
+}
+
+// Rounds to single precision.
+toFloat32(value) => (new Float32List(1)..[0] = value)[0];
+
+test(n) {
+  var x32 = float32List(n);
+  var y32 = float32List(n);
+  var expected = expectedSaxpy(0.25, x32.toList(), y32.toList());
+  saxpy(0.25, x32, y32);
+  Expect.listEquals(expected, y32);
+
+  var x64 = float64List(n);
+  var y64 = float64List(n);
+  Expect.equals(expectedDot(x64.toList(), y64.toList()), dot(x64, y64));
+  Expect.equals(expectedSumFrom(x32.toList(), 1), sumFrom(x32, 1));
+
+  var result = new Float32List(n);
+  map(x64, result, n);
+  for (var i = 0; i < n; i++) {
+    Expect.equals(toFloat32((x64[i] - 1.0) / 3.0), result[i]);
+  }
+}
+
+main() {
+  for (var i = 0; i < 20; i++) {
+    test(0);
+    test(1);
+    test(2);
+    test(17);
+    test(100);
+  }
+
+  // Out of bounds accesses in the vectorized loop deoptimize and throw from
+  // the scalar loop after the elements before the failing one are written.
+  var x = float64List(10);
+  var result = new Float32List(6);
+  Expect.throws(() => map(x, result, 10), (e) => e is RangeError);
+  for (var i = 0; i < 6; i++) {
+    Expect.equals(toFloat32((x[i] - 1.0) / 3.0), result[i]);
+  }
+
+  // Integer coefficients deoptimize the vectorized loop.
+  var x32 = float32List(9);
+  var y32 = float32List(9);
+  saxpy(2, x32, y32);
+  var expected = expectedSaxpy(2, float32List(9).toList(),
+                               float32List(9).toList());
+  Expect.listEquals(expected, y32);
+}
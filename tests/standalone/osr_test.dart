@@ -0,0 +1,92 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=--use_osr --optimization_counter_threshold=10
+// VMOptions=--use_osr --optimization_counter_threshold=10 --deoptimize_alot
+//
+// Test on-stack replacement of long running loops in unoptimized code.
+
+import "package:expect/expect.dart";
+
+int sumTo(int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    sum += i;
+  }
+  return sum;
+}
+
+// Parameters of functions with optional parameters are copied into the
+// frame, like locals.
+int sumWithOptional(int n, [int step = 1, int start = 0]) {
+  var sum = start;
+  var i = 0;
+  while (i < n) {
+    sum += step;
+    i++;
+  }
+  return sum;
+}
+
+int nested(int n) {
+  int count = 0;
+  for (int i = 0; i < n; i++) {
+    int j = 0;
+    do {
+      count++;
+      j++;
+    } while (j < i);
+  }
+  return count;
+}
+
+// The loop keeps running in optimized code after the sum changes from an
+// integer to a double, which deoptimizes.
+sumChangingType(int n) {
+  var sum = 0;
+  for (int i = 0; i < n; i++) {
+    sum += (i == n ~/ 2) ? 0.5 : 1;
+  }
+  return sum;
+}
+
+class Counter {
+  int count = 0;
+  final List<int> values;
+
+  Counter(this.values);
+
+  int run() {
+    var add = (x) => count += x;
+    for (var value in values) {
+      add(value);
+    }
+    return count;
+  }
+}
+
+// The stack overflow in the entry check of a hot function is not an OSR
+// entry.
+int recurse(int n) => recurse(n + 1) + 1;
+
+bool overflowsStack() {
+  try {
+    recurse(0);
+  } on StackOverflowError {
+    return true;
+  }
+  return false;
+}
+
+void main() {
+  Expect.equals(499999500000, sumTo(1000000));
+  Expect.equals(100000, sumWithOptional(100000));
+  Expect.equals(300007, sumWithOptional(100000, 3, 7));
+  Expect.equals(124751, nested(500));
+  Expect.equals(99999.5, sumChangingType(100000));
+  var values = new List<int>.generate(10000, (i) => i);
+  Expect.equals(49995000, new Counter(values).run());
+  Expect.isTrue(overflowsStack());
+  Expect.isTrue(overflowsStack());
+}
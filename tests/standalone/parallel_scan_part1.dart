@@ -0,0 +1,13 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+part of parallel_scan_test;
+
+const _private = 42;
+
+class A {
+  get value => 1;
+}
+
+strings() => "a\nb$_private";
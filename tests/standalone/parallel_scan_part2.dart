@@ -0,0 +1,11 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+part of parallel_scan_test;
+
+class B extends A {
+  get value => super.value + 1;
+}
+
+numbers() => [0x1F, 1.5e3, _private];
@@ -0,0 +1,23 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=--parallel_scan
+// VMOptions=
+//
+// Test that the parts of a library scanned in parallel are compiled as
+// when they are scanned one after the other.
+
+library parallel_scan_test;
+
+import "package:expect/expect.dart";
+
+part "parallel_scan_part1.dart";
+part "parallel_scan_part2.dart";
+
+main() {
+  Expect.equals(3, new A().value + new B().value);
+  Expect.equals("a\nb${_private}", strings());
+  Expect.equals(1.5e3, numbers()[1]);
+  Expect.equals(0x1F, numbers()[0]);
+}
@@ -0,0 +1,159 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for parsing and formatting numbers in byte lists.
+
+library TypedDataNumberTextTest;
+
+import "package:expect/expect.dart";
+import 'dart:typeddata';
+
+const int COMMA = 44;
+const int NEWLINE = 10;
+
+Uint8List bytesOf(String text) => new Uint8List.fromList(text.codeUnits);
+
+String textOf(Uint8List bytes, int start, int end) {
+  return new String.fromCharCodes(bytes.sublist(start, end));
+}
+
+
+void testParseDoubles() {
+  var bytes = bytesOf(" 1.5, -2e3 ,.25,NaN,-Infinity,0.1\r\n");
+  var result = new Float64List(8);
+  Expect.equals(6, NumberText.parseDoubles(
+      bytes, 0, bytes.length, COMMA, result));
+  Expect.equals(1.5, result[0]);
+  Expect.equals(-2000.0, result[1]);
+  Expect.equals(0.25, result[2]);
+  Expect.isTrue(result[3].isNaN);
+  Expect.equals(double.NEGATIVE_INFINITY, result[4]);
+  Expect.equals(0.1, result[5]);
+
+  // The values are the ones of double.parse.
+  var texts = ["0", "-0", "123456789012345678901234567890", "4.9e-324",
+               "1.7976931348623157e308", "2.2250738585072011e-308",
+               "9007199254740993", "0.30000000000000004"];
+  bytes = bytesOf(texts.join(","));
+  Expect.equals(texts.length, NumberText.parseDoubles(
+      bytes, 0, bytes.length, COMMA, result));
+  for (int i = 0; i < texts.length; i++) {
+    double expected = double.parse(texts[i]);
+    Expect.equals(expected, result[i]);
+    Expect.equals(expected.isNegative, result[i].isNegative);
+  }
+
+  // A range of bytes, into a range of a view of the result.
+  bytes = bytesOf("xx1;2;3xx");
+  var view = new Float64List.view(result.buffer, 8, 4);
+  Expect.equals(3, NumberText.parseDoubles(bytes, 2, 7, 59, view, 1));
+  Expect.listEquals([1.0, 2.0, 3.0], result.sublist(2, 5));
+
+  // A separator after the last number and whitespace are ignored.
+  bytes = bytesOf("1,2,\n");
+  Expect.equals(2, NumberText.parseDoubles(
+      bytes, 0, bytes.length, COMMA, result));
+  bytes = bytesOf(" \t\n");
+  Expect.equals(0, NumberText.parseDoubles(
+      bytes, 0, bytes.length, COMMA, result));
+  Expect.equals(0, NumberText.parseDoubles(bytes, 1, 1, COMMA, result));
+}
+
+
+void testParseInts() {
+  var bytes = bytesOf("0\n-42\n0x7fffffffffffffff\n-9223372036854775808\n");
+  var result = new Int64List(4);
+  Expect.equals(4, NumberText.parseInts(
+      bytes, 0, bytes.length, NEWLINE, result));
+  Expect.listEquals(
+      [0, -42, 9223372036854775807, -9223372036854775808], result);
+}
+
+
+void testParseErrors() {
+  var result = new Float64List(2);
+  for (var text in ["1,2x,3", "1,,3", "5.", "+5", "1 2", ","]) {
+    var bytes = bytesOf(text);
+    Expect.throws(() => NumberText.parseDoubles(
+                            bytes, 0, bytes.length, COMMA, result),
+                  (e) => e is FormatException);
+  }
+  var bytes = bytesOf("1,2,3");
+  Expect.throws(() => NumberText.parseDoubles(
+                          bytes, 0, bytes.length, COMMA, result),
+                (e) => e is RangeError);
+  Expect.throws(() => NumberText.parseDoubles(
+                          bytes, 0, bytes.length, COMMA, result, 3),
+                (e) => e is RangeError);
+  Expect.throws(() => NumberText.parseDoubles(bytes, 3, 2, COMMA, result),
+                (e) => e is RangeError);
+  Expect.throws(() => NumberText.parseDoubles(bytes, 0, 6, COMMA, result),
+                (e) => e is RangeError);
+  Expect.throws(() => NumberText.parseDoubles(bytes, 0, 5, 256, result),
+                (e) => e is ArgumentError);
+
+  var ints = new Int64List(2);
+  for (var text in ["1.0", "9223372036854775808", "0x", "-"]) {
+    bytes = bytesOf(text);
+    Expect.throws(() => NumberText.parseInts(
+                            bytes, 0, bytes.length, COMMA, ints),
+                  (e) => e is FormatException);
+  }
+}
+
+
+void testFormatDoubles() {
+  var values = new Float64List.fromList(
+      [0.0, -0.0, 1.0, -2.5, 0.1, 1e21, 1.5e-7, 1 / 3, double.NAN,
+       double.INFINITY]);
+  var output = new Uint8List(200);
+  int end = NumberText.formatDoubles(
+      values, 0, values.length, COMMA, output);
+  Expect.equals(values.map((v) => v.toString()).join(","),
+                textOf(output, 0, end));
+
+  end = NumberText.formatDoubles(
+      values, 0, values.length, COMMA, output, 5, 3);
+  Expect.equals(values.map((v) => v.toStringAsFixed(3)).join(","),
+                textOf(output, 5, end));
+
+  // A range of the values, at the end of the output.
+  output = new Uint8List(9);
+  Expect.equals(9, NumberText.formatDoubles(
+      values, 2, 4, NEWLINE, output, 1));
+  Expect.equals("1.0\n-2.5", textOf(output, 1, 9));
+
+  // The output is too short.
+  Expect.throws(() => NumberText.formatDoubles(
+                          values, 2, 4, NEWLINE, output, 2),
+                (e) => e is RangeError);
+  Expect.throws(() => NumberText.formatDoubles(
+                          values, 0, 1, COMMA, output, 0, 21),
+                (e) => e is RangeError);
+}
+
+
+void testFormatInts() {
+  var values = new Int64List.fromList(
+      [0, -7, 1234567890123, 9223372036854775807, -9223372036854775808]);
+  var output = new Uint8List(100);
+  int end = NumberText.formatInts(values, 0, values.length, COMMA, output);
+  Expect.equals(values.join(","), textOf(output, 0, end));
+  Expect.equals(0, NumberText.formatInts(values, 2, 2, COMMA, output));
+
+  // The text parses back to the same values.
+  var result = new Int64List(values.length);
+  Expect.equals(values.length, NumberText.parseInts(
+      output, 0, end, COMMA, result));
+  Expect.listEquals(values, result);
+}
+
+
+main() {
+  testParseDoubles();
+  testParseInts();
+  testParseErrors();
+  testFormatDoubles();
+  testFormatInts();
+}
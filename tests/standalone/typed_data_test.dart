@@ -182,6 +182,101 @@ void testIndexOf() {
   testIndexOfHelper(new Uint8ClampedList(10));
 }
 
+void testFillRangeHelper(list, value, otherValue) {
+  list.fillRange(0, list.length, otherValue);
+  list.fillRange(3, list.length - 2, value);
+  for (int i = 0; i < list.length; i++) {
+    bool filled = (i >= 3) && (i < list.length - 2);
+    Expect.equals(filled ? value : otherValue, list[i]);
+  }
+  list.fillRange(5, 5, otherValue);
+  Expect.equals(value, list[5]);
+  Expect.throws(() => list.fillRange(-1, 2, value),
+                (e) => e is RangeError);
+  Expect.throws(() => list.fillRange(2, list.length + 1, value),
+                (e) => e is RangeError);
+}
+
+void testFillRange() {
+  testFillRangeHelper(new Int8List(37), -3, 7);
+  testFillRangeHelper(new Uint8List(37), 200, 7);
+  testFillRangeHelper(new Int16List(37), -1000, 7);
+  testFillRangeHelper(new Uint32List(37), 0xFFFFFFFF, 7);
+  testFillRangeHelper(new Int64List(37), -0x123456789, 7);
+  testFillRangeHelper(new Uint64List(37), 0xFFFFFFFFFFFFFFFF, 7);
+  testFillRangeHelper(new Float32List(37), 1.5, 7.0);
+  testFillRangeHelper(new Float64List(37), -0.25, 7.0);
+
+  // The value is converted once, like by the element setter.
+  var clamped = new Uint8ClampedList(37);
+  clamped.fillRange(0, 37, 300);
+  Expect.equals(255, clamped[36]);
+  var bytes = new Uint8List(37);
+  bytes.fillRange(0, 37, 0x1FF);
+  Expect.equals(0xFF, bytes[36]);
+
+  // Views are filled at any offset of their buffer.
+  var buffer = new Uint8List(8 * 37 + 1);
+  var view = new Uint16List.view(buffer.buffer, 1, 37);
+  testFillRangeHelper(view, 0xABCD, 7);
+  Expect.equals(0, buffer[0]);
+  Expect.equals(0, buffer[2 * 37 + 1]);
+  testFillRangeHelper(new Float64List.view(buffer.buffer, 1, 37), 0.5, 7.0);
+}
+
+void testBulkIndexOfHelper(list, value, otherValue) {
+  list.fillRange(0, list.length, otherValue);
+  Expect.equals(-1, list.indexOf(value));
+  Expect.equals(-1, list.lastIndexOf(value));
+  Expect.isFalse(list.contains(value));
+  list[5] = value;
+  list[list.length - 3] = value;
+  Expect.equals(5, list.indexOf(value));
+  Expect.equals(5, list.indexOf(value, 5));
+  Expect.equals(list.length - 3, list.indexOf(value, 6));
+  Expect.equals(-1, list.indexOf(value, list.length - 2));
+  Expect.equals(list.length - 3, list.lastIndexOf(value));
+  Expect.equals(5, list.lastIndexOf(value, list.length - 4));
+  Expect.equals(-1, list.lastIndexOf(value, 4));
+  Expect.equals(5, list.indexOf(value, -10));
+  Expect.equals(-1, list.lastIndexOf(value, -1));
+  Expect.isTrue(list.contains(value));
+}
+
+void testBulkIndexOf() {
+  testBulkIndexOfHelper(new Int8List(37), -3, 7);
+  testBulkIndexOfHelper(new Uint16List(37), 0xABCD, 7);
+  testBulkIndexOfHelper(new Int32List(37), -0x12345678, 7);
+  testBulkIndexOfHelper(new Uint32List(37), 0xFFFFFFFF, 7);
+  testBulkIndexOfHelper(new Int64List(37), -0x123456789, 7);
+  testBulkIndexOfHelper(new Uint64List(37), 0xFFFFFFFFFFFFFFFF, 7);
+  testBulkIndexOfHelper(new Float64List(37), -0.25, 7.0);
+  var buffer = new Uint8List(8 * 37 + 1);
+  testBulkIndexOfHelper(
+      new Int64List.view(buffer.buffer, 1, 37), 0x123456789, 7);
+  testBulkIndexOfHelper(
+      new Uint8List.view(buffer.buffer, 3, 37), 0xFF, 7);
+
+  // Values outside of the range of the elements are not found, even if
+  // their low order bytes are.
+  var bytes = new Uint8List(37);
+  bytes[7] = 0xFF;
+  Expect.equals(-1, bytes.indexOf(-1));
+  Expect.equals(-1, bytes.indexOf(0x1FF));
+  Expect.equals(-1, bytes.indexOf(0x100000000000000FF));
+  Expect.equals(-1, bytes.indexOf(null));
+  Expect.equals(-1, bytes.indexOf("a"));
+  Expect.equals(7, bytes.indexOf(255.0));
+  var int64s = new Int64List(37);
+  int64s[7] = -1;
+  Expect.equals(-1, int64s.indexOf(0xFFFFFFFFFFFFFFFF));
+  Expect.equals(7, int64s.indexOf(-1));
+  var uint64s = new Uint64List(37);
+  uint64s[7] = 0xFFFFFFFFFFFFFFFF;
+  Expect.equals(-1, uint64s.indexOf(-1));
+  Expect.equals(7, uint64s.indexOf(0xFFFFFFFFFFFFFFFF));
+}
+
 void testGetAtIndex(TypedData list, num initial_value) {
   var bdata = new ByteData.view(list.buffer);
   for (int i = 0; i < bdata.lengthInBytes; i++) {
@@ -313,6 +408,8 @@ main() {
     testSetRange();
     testIndexOutOfRange();
     testIndexOf();
+    testFillRange();
+    testBulkIndexOf();
 
     var int8list = new Int8List(128);
     testSetAtIndex(int8list, 42);